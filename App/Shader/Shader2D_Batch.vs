@@ -0,0 +1,29 @@
+#version 330 core
+// Each sprite of the sprite batch is one instance, whose axes are already transformed to clip space on the CPU
+layout (location = 0) in vec2 aCorner;
+layout (location = 1) in vec4 aCentre;
+layout (location = 2) in vec4 aXAxis;
+layout (location = 3) in vec4 aYAxis;
+layout (location = 4) in vec4 aColour;
+layout (location = 5) in vec4 aUVRect;
+// The frame (x) in the sprite sheet, which has z rows of y columns of frames
+layout (location = 6) in vec4 aFrame;
+
+out vec2 TexCoord;
+out vec4 Colour;
+
+void main()
+{
+	// The corner of the unit quad is (0, 0) at the bottom left and (1, 1) at the top right
+	gl_Position = aCentre + (aCorner.x * 2.0 - 1.0) * aXAxis + (aCorner.y * 2.0 - 1.0) * aYAxis;
+	Colour = aColour;
+
+	// The frames are numbered from the top left, row by row. The 0.5 keeps floor from rounding an exact row down
+	float fNumCols = aFrame.y;
+	float fNumRows = aFrame.z;
+	float fRow = floor((aFrame.x + 0.5) / fNumCols);
+	float fCol = aFrame.x - fRow * fNumCols;
+	vec2 vec2FrameSize = (aUVRect.zw - aUVRect.xy) / vec2(fNumCols, fNumRows);
+	vec2 vec2FrameOrigin = aUVRect.xy + vec2(fCol, fNumRows - 1.0 - fRow) * vec2FrameSize;
+	TexCoord = vec2FrameOrigin + aCorner * vec2FrameSize;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#version 330 core
+// The vertices of the HUD are in pixels, with the origin at the top left of the screen
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec4 aColour;
+layout (location = 3) in vec2 aTexCoord;
+
+out vec2 TexCoord;
+out vec4 Colour;
+
+uniform mat4 projection;
+
+void main()
+{
+	gl_Position = projection * vec4(aPos, 0.0, 1.0);
+	Colour = aColour;
+	TexCoord = aTexCoord;
+}
\ No newline at end of file
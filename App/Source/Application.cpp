@@ -10,6 +10,7 @@
 //Include the standard C++ headers
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -21,6 +22,14 @@
 #include "GameControl\Settings.h"
 // Include CShaderManager which manages the shaders used in this App
 #include "RenderControl\ShaderManager.h"
+// Include CSpriteBatch which draws the sprites of the 2D scene in batches
+#include "RenderControl\SpriteBatch.h"
+// Include CSpriteSheetManager which shares the sprite sheets between the entities
+#include "Primitives\SpriteSheetManager.h"
+// Include CGLStateCache which skips the redundant OpenGL state changes
+#include "RenderControl\GLStateCache.h"
+// Include CAsyncFileWriter which writes the save games on a background thread
+#include "System\AsyncFileWriter.h"
 
 // Inputs
 #include "Inputs\KeyboardController.h"
@@ -28,6 +37,11 @@
 
 // Add your include files here
 #include "SoundController/SoundController.h"
+// Include the audio backends, which CSettings chooses from
+#ifdef _WIN32
+#include "SoundController/AudioBackendIrrKlang.h"
+#endif
+#include "SoundController/AudioBackendSoftware.h"
 // Include CGameStateManager
 
 #include <iostream>
@@ -67,7 +81,14 @@ static void error_callback(int error, const char* description)
  */
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
-	CKeyboardController::GetInstance()->Update(key, action);
+	// The key repeats do not change the status of a key
+	if (action == GLFW_REPEAT)
+		return;
+
+	// Queue the event for the tick which it happened before. glfwGetTime is read here, as GLFW calls the callback
+	// while it handles the event, and it uses the same high resolution timer as the fixed time step
+	CInputEventQueue::GetInstance()->Push(CInputEventQueue::KEY, key, (action == GLFW_PRESS ? 1 : 0), 0.0, 0.0,
+										  glfwGetTime());
 }
 
 /**
@@ -109,11 +130,9 @@ void resize_callback(GLFWwindow* window, int width, int height)
  */
 void MouseButtonCallbacks(GLFWwindow* window, int button, int action, int mods)
 {
-	// Send the callback to the mouse controller to handle
-	if (action == GLFW_PRESS)
-		CMouseController::GetInstance()->UpdateMouseButtonPressed(button);
-	else
-		CMouseController::GetInstance()->UpdateMouseButtonReleased(button);
+	// Queue the event for the tick which it happened before
+	CInputEventQueue::GetInstance()->Push(CInputEventQueue::MOUSE_BUTTON, button, (action == GLFW_PRESS ? 1 : 0), 0.0, 0.0,
+										  glfwGetTime());
 }
 
 /**
@@ -124,7 +143,34 @@ void MouseButtonCallbacks(GLFWwindow* window, int button, int action, int mods)
  */
 void MouseScrollCallbacks(GLFWwindow* window, double xoffset, double yoffset)
 {
-	CMouseController::GetInstance()->UpdateMouseScroll(xoffset, yoffset);
+	// Queue the event for the tick which it happened before
+	CInputEventQueue::GetInstance()->Push(CInputEventQueue::MOUSE_SCROLL, 0, 0, xoffset, yoffset, glfwGetTime());
+}
+
+/**
+ @brief Create the audio backend which CSettings asks for. irrKlang is used on Windows, unless the software
+		mixer is asked for or its output is written to a file. The software mixer mixes in real time,
+		except in headless mode, where it follows the simulation time
+ @return The audio backend, which CSoundController deletes
+ */
+static CAudioBackend* CreateAudioBackend(void)
+{
+	CSettings* cSettings = CSettings::GetInstance();
+
+	bool bUseSoftwareMixer = true;
+#ifdef _WIN32
+	bUseSoftwareMixer = ((cSettings->sAudioOutputFile != NULL) ||
+						 ((cSettings->sAudioBackend != NULL) && (strcmp(cSettings->sAudioBackend, "software") == 0)));
+	if (bUseSoftwareMixer == false)
+		return new CAudioBackendIrrKlang();
+#endif
+
+	CAudioSink* cAudioSink = NULL;
+	if (cSettings->sAudioOutputFile != NULL)
+		cAudioSink = new CAudioSinkWaveFile(cSettings->sAudioOutputFile);
+	else
+		cAudioSink = new CAudioSinkNull();
+	return new CAudioBackendSoftware(cAudioSink, cSettings->bHeadless == false);
 }
 
 /**
@@ -148,8 +194,14 @@ bool Application::Init(void)
 		return false;
 	}
 
+	// Create the CProfiler instance before any other thread is started, as their profile zones use it
+	// and it is not created in a thread-safe way
+	CProfiler::GetInstance();
+
 	// Initialise the CSoundController singleton
-	if (CSoundController::GetInstance()->Init() == false)
+	CSoundController::GetInstance()->SetAudioMemoryBudget(CSettings::GetInstance()->iAudioMemoryBudget);
+	CSoundController::GetInstance()->SetAudioStreamThreshold(CSettings::GetInstance()->iAudioStreamThreshold);
+	if (CSoundController::GetInstance()->Init(CreateAudioBackend()) == false)
 	{
 		cout << "Failed to initialise CSoundController class instance." << endl;
 		return false;
@@ -158,6 +210,9 @@ bool Application::Init(void)
 	// Get the CSettings instance
 	cSettings = CSettings::GetInstance();
 
+	// Name this thread in the profiler's trace
+	PROFILE_THREAD("Main");
+
 	// Set the file location for the digital assets
 	// This is backup, in case filesystem cannot find the current directory
 	cSettings->logl_root = "C:/Users/tohdj/Documents/2022_2023_SEM1/DM2213 2D Game Creation/Teaching Materials/";
@@ -174,6 +229,10 @@ bool Application::Init(void)
 	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // uncomment this statement to fix compilation on OS X
 #endif
 
+	// Nothing is rendered in headless mode, so do not show the window
+	if (cSettings->bHeadless == true)
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
 	//Create a window and create its OpenGL context
 	cSettings->pWindow = glfwCreateWindow(	cSettings->iWindowWidth, cSettings->iWindowHeight,
 											"Maze Runner", NULL, NULL);
@@ -191,6 +250,9 @@ bool Application::Init(void)
 	//This function makes the context of the specified window current on the calling thread. 
 	glfwMakeContextCurrent(cSettings->pWindow);
 
+	// Synchronise the buffer swaps with the monitor refresh rate, if required
+	glfwSwapInterval(cSettings->bUseVSync == true ? 1 : 0);
+
 	//Sets the callback functions for GLFW
 	//Set the window position callback function
 	glfwSetWindowPosCallback(cSettings->pWindow, repos_callback);
@@ -234,11 +296,68 @@ bool Application::Init(void)
 	CShaderManager::GetInstance()->Add("Shader2D", "Shader//Shader2D_Ray.vs", "Shader//Shader2D_Ray.fs");
 	// Allows tinting of textures
 	CShaderManager::GetInstance()->Add("Shader2D_Colour", "Shader//Shader2D_Ray.vs", "Shader//Shader2D_Ray.fs");
+	// Draws the sprite batch, whose vertices are already in clip space
+	CShaderManager::GetInstance()->Add("Shader2D_Batch", "Shader//Shader2D_Batch.vs", "Shader//Shader2D_Batch.fs");
+	// Draws the retained HUD, whose vertices are in pixels
+	CShaderManager::GetInstance()->Add("Shader2D_HUD", "Shader//Shader2D_HUD.vs", "Shader//Shader2D_HUD.fs");
+
+	// Initialise the CSpriteBatch instance
+	if (CSpriteBatch::GetInstance()->Init("Shader2D_Batch") == false)
+	{
+		cout << "Failed to initialise the sprite batch." << endl;
+		return false;
+	}
+
+	// Initialise the CUIRuntime instance once, so that the game states do not rebuild the UI when they are switched
+	cUIRuntime = CUIRuntime::GetInstance();
+	if (cUIRuntime->Init(cSettings->pWindow) == false)
+	{
+		cout << "Failed to initialise the UI." << endl;
+		return false;
+	}
 
 	// Initialise the CFPSCounter instance
 	cFPSCounter = CFPSCounter::GetInstance();
 	cFPSCounter->Init();
 
+	// Initialise the CFramePacer instance
+	cFramePacer = CFramePacer::GetInstance();
+	cFramePacer->Init(1.0 / cSettings->FPS);
+
+	// Start replaying or recording the input. A replay uses the random seed and tick rate of its recording
+	cInputRecorder = CInputRecorder::GetInstance();
+	cInputEventQueue = CInputEventQueue::GetInstance();
+	unsigned int uiRandomSeed = cSettings->iRandomSeed;
+	if (cSettings->sReplayInputFile != NULL)
+	{
+		if (cInputRecorder->StartReplay(cSettings->sReplayInputFile) == false)
+		{
+			cout << "Failed to load the input recording." << endl;
+			return false;
+		}
+		uiRandomSeed = cInputRecorder->GetSeed();
+		cSettings->iTickRate = cInputRecorder->GetTickRate();
+	}
+
+	// Seed the random number generator before the game states use it
+	CRandom::GetInstance()->Seed(uiRandomSeed);
+	cout << "Random seed: " << CRandom::GetInstance()->GetSeed() << endl;
+
+	if ((cSettings->sRecordInputFile != NULL) && (cInputRecorder->IsReplaying() == false))
+	{
+		cInputRecorder->StartRecording(cSettings->sRecordInputFile, CRandom::GetInstance()->GetSeed(), cSettings->iTickRate);
+	}
+
+	// Get the frame arena of the main thread, for the data which only lives until the end of a frame
+	cFrameArena = CFrameArena::GetThreadArena();
+
+	// Set the budget of heap allocations per frame, which is only checked if the memory tracker is enabled
+	CMemoryTracker::SetFrameAllocBudget(cSettings->iFrameAllocBudget);
+
+	// Initialise the CFixedTimeStep instance
+	cFixedTimeStep = CFixedTimeStep::GetInstance();
+	cFixedTimeStep->Init(cSettings->iTickRate, cSettings->iMaxTicksPerFrame);
+
 	// Create the Game States
 	CGameStateManager::GetInstance()->AddGameState("IntroState", new CIntroState());
 	CGameStateManager::GetInstance()->AddGameState("MenuState", new CMenuState());
@@ -260,69 +379,318 @@ bool Application::Init(void)
 */ 
 void Application::Run(void)
 {
-	// Start timer to calculate how long it takes to render this frame
-	cStopWatch.StartTimer();
+	// Replays run one tick per frame, with or without rendering
+	if (cInputRecorder->IsReplaying() == true)
+	{
+		RunReplay();
+		return;
+	}
+
+	// In headless mode, run the simulation as fast as possible without rendering
+	if (cSettings->bHeadless == true)
+	{
+		RunHeadless(cSettings->iHeadlessTicks);
+		return;
+	}
+
+	// Start pacing the frames to the target frame rate
+	cFramePacer->Init(1.0 / cSettings->FPS);
 
 	double dElapsedTime = 0.0;
-	double dDelayTime = 0.0;
-	double dTotalFrameTime = 0.0;
+	bool bIsRunning = true;
 
 	// Render loop
-	while (!glfwWindowShouldClose(cSettings->pWindow))
+	while (bIsRunning && !glfwWindowShouldClose(cSettings->pWindow))
 	{
-		// This is to prevent the program from crashing due to long dElapsedTime
-		// Causing Physics to calculate a large jump/fall for the player
-		if (dElapsedTime > 0.0166666666666667)
-			dElapsedTime = 0.0166666666666667;
+		// Mark the start of the frame for the profiler's flame view
+		PROFILE_FRAME();
+
+		// Poll the input as late as possible, after the frame rate limiter's wait and just before the ticks
+		if (cSettings->bLateInputPolling == true)
+			PollInputDevices();
 
-		// Call the active Game State's Update method
-		if (CGameStateManager::GetInstance()->Update(dElapsedTime) == false)
+		// Add the real time taken by the last frame to the simulation.
+		// Long frames are capped here instead of passing a large dElapsedTime to the game states,
+		// which would cause Physics to calculate a large jump/fall for the player
+		cFixedTimeStep->AddFrameTime(dElapsedTime);
+		const double dCatchUpTime = glfwGetTime();
+
+		// Run the fixed simulation ticks until the simulation has caught up with real time
+		while (cFixedTimeStep->ConsumeTick())
 		{
-			break;
+			// Each tick takes the input events up to the real time which it stands for.
+			// The last tick of the frame takes all of them, so no input waits for the next frame
+			double dInputTime = dCatchUpTime;
+			if (cFixedTimeStep->GetAccumulatedTime() >= cFixedTimeStep->GetTickTime())
+				dInputTime -= cFixedTimeStep->GetAccumulatedTime();
+
+			if (Tick(cFixedTimeStep->GetTickTime(), dInputTime) == false)
+			{
+				bIsRunning = false;
+				break;
+			}
 		}
+		if (bIsRunning == false)
+			break;
 
-		// Call the active Game State's Render method
+		// Call the active Game State's Render method. 
+		// The entities are rendered between the last two ticks using CFixedTimeStep::GetAlpha()
 		CGameStateManager::GetInstance()->Render();
 
-		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
-		// -------------------------------------------------------------------------------
-		glfwSwapBuffers(cSettings->pWindow);
+		// Draw the UI of the game states over them
+		cUIRuntime->Render();
 
-		// Perform Post Update Input Devices
-		PostUpdateInputDevices();
+		// Free the per-frame allocations of the ticks and the render
+		cFrameArena->Reset();
 
-		// Poll events
-		glfwPollEvents();
+		// Count the heap allocations of this frame
+		MEMORY_FRAME();
 
-		// Update Input Devices
-		UpdateInputDevices();
+		// Count the OpenGL calls which the state cache made and saved in this frame
+		CGLStateCache::GetInstance()->EndFrame();
 
-		// Calculate the elapsed time since the last frame
-		dElapsedTime = cStopWatch.GetElapsedTime();
+		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
+		// -------------------------------------------------------------------------------
+		{
+			PROFILE_SCOPE("glfwSwapBuffers");
+			glfwSwapBuffers(cSettings->pWindow);
+		}
 
-		// Frame rate limiter. Limits each frame to a specified time in ms by sleeping.  
-		dDelayTime = cSettings->frameTime - dElapsedTime * 1000;
-		cStopWatch.WaitUntil((const long long)dDelayTime);
+		// Poll the input before the frame rate limiter's wait, if it is not polled late
+		if (cSettings->bLateInputPolling == false)
+			PollInputDevices();
+
+		// Frame rate limiter. Sleeps and then spins until the target frame time has passed.
+		// The elapsed time is the whole frame's time, including the wait
+		if (cSettings->bLimitFrameRate == true)
+		{
+			PROFILE_SCOPE("CFramePacer::WaitForNextFrame");
+			dElapsedTime = cFramePacer->WaitForNextFrame();
+		}
+		else
+			dElapsedTime = cFramePacer->EndFrame();
 
 		// Update the FPS Counter
-		dTotalFrameTime = dElapsedTime + dDelayTime * 0.001;
-		cFPSCounter->Update(dTotalFrameTime);
+		cFPSCounter->Update(dElapsedTime);
 
 		// cout << cFPSCounter->GetFrameRateString() << endl;
 	}
 }
 
+/**
+@brief Run the simulation ticks back to back without rendering or frame pacing.
+	   This lets the game run faster than real time, e.g. for testing and profiling.
+@param uiNumTicks The number of ticks to run. 0 to run until the window is closed or a game state quits
+*/
+void Application::RunHeadless(const unsigned int uiNumTicks)
+{
+	cout << "Application::RunHeadless - Running " << uiNumTicks << " ticks at "
+		<< cFixedTimeStep->GetTickRate() << " ticks per second" << endl;
+
+	// Start timer to calculate how long it takes to run the ticks
+	cStopWatch.StartTimer();
+
+	unsigned int uiTicksRun = 0;
+	while (((uiNumTicks == 0) || (uiTicksRun < uiNumTicks)) && !glfwWindowShouldClose(cSettings->pWindow))
+	{
+		// Poll events, so that the window stays responsive
+		PollInputDevices();
+
+		if (Tick(cFixedTimeStep->GetTickTime(), glfwGetTime()) == false)
+			break;
+
+		// Free the per-frame allocations of the tick
+		cFrameArena->Reset();
+
+		// Count the heap allocations of this frame
+		MEMORY_FRAME();
+
+		uiTicksRun++;
+	}
+
+	// Nothing will render the UI of the last tick
+	cUIRuntime->DiscardFrame();
+
+	double dRealTime = cStopWatch.GetElapsedTime();
+	double dSimulatedTime = uiTicksRun * cFixedTimeStep->GetTickTime();
+	cout << "Application::RunHeadless - Ran " << uiTicksRun << " ticks (" << dSimulatedTime
+		<< "s of simulation) in " << dRealTime << "s";
+	if (dRealTime > 0.0)
+		cout << ", " << dSimulatedTime / dRealTime << "x real time";
+	cout << endl;
+}
+
+/**
+@brief Replay the recorded input with exactly one tick per frame and no frame rate limit,
+	   so that every run of the same recording does the same work in each frame.
+	   The timings of every frame are printed as a summary, and written to a CSV file if requested.
+*/
+void Application::RunReplay(void)
+{
+	const unsigned int uiNumTicks = cInputRecorder->GetNumTicks();
+	cout << "Application::RunReplay - Replaying " << uiNumTicks << " ticks at "
+		<< cFixedTimeStep->GetTickRate() << " ticks per second"
+		<< (cSettings->bHeadless == true ? " without rendering" : "") << endl;
+
+	CFrameTimeLog cFrameTimeLog;
+	cFrameTimeLog.Reserve(uiNumTicks);
+
+	while (!glfwWindowShouldClose(cSettings->pWindow))
+	{
+		PROFILE_FRAME();
+
+		cStopWatch.StartTimer();
+
+		// Poll events, so that the window stays responsive. The recorded input replaces the live input in Tick
+		PollInputDevices();
+
+		// Feed exactly one tick's worth of time, so that the interpolation alpha is the same in every run
+		cFixedTimeStep->AddFrameTime(cFixedTimeStep->GetTickTime());
+		bool bIsRunning = true;
+		while (cFixedTimeStep->ConsumeTick())
+		{
+			if (Tick(cFixedTimeStep->GetTickTime(), glfwGetTime()) == false)
+			{
+				bIsRunning = false;
+				break;
+			}
+		}
+		if (bIsRunning == false)
+			break;
+		const double dTickTime = cStopWatch.PeekElapsedTime();
+
+		if (cSettings->bHeadless == false)
+		{
+			CGameStateManager::GetInstance()->Render();
+			cUIRuntime->Render();
+			PROFILE_SCOPE("glfwSwapBuffers");
+			glfwSwapBuffers(cSettings->pWindow);
+		}
+		else
+		{
+			// Nothing will render the UI of this tick
+			cUIRuntime->DiscardFrame();
+		}
+
+		// Free the per-frame allocations of the tick and the render
+		cFrameArena->Reset();
+
+		// Count the heap allocations of this frame
+		MEMORY_FRAME();
+
+		// Count the OpenGL calls which the state cache made and saved in this frame
+		CGLStateCache::GetInstance()->EndFrame();
+
+		const double dFrameTime = cStopWatch.GetElapsedTime();
+		cFrameTimeLog.Add(dTickTime, dFrameTime - dTickTime, dFrameTime);
+		cFPSCounter->Update(dFrameTime);
+	}
+
+	// Nothing will render the UI of the tick which ended the replay
+	cUIRuntime->DiscardFrame();
+
+	cout << "Application::RunReplay - Replayed " << cInputRecorder->GetCurrentTick() << " of " << uiNumTicks << " ticks" << endl;
+	cFrameTimeLog.PrintSummary();
+	if (cSettings->sReplayTimingsFile != NULL)
+		cFrameTimeLog.WriteCSV(cSettings->sReplayTimingsFile);
+}
+
+/**
+@brief Run one fixed simulation tick
+@param dTickTime The duration of one simulation tick in seconds
+@param dInputTime The real time which this tick stands for. The input events up to it are applied
+@return false if the active game state wants to quit, otherwise true
+*/
+bool Application::Tick(const double dTickTime, const double dInputTime)
+{
+	PROFILE_SCOPE("Application::Tick");
+
+	// If several ticks run before a render, the UI frame started by the previous tick was not rendered
+	cUIRuntime->DiscardFrame();
+
+	// Apply the input events which happened before this tick, in order
+	cInputEventQueue->ApplyEvents(dInputTime, glfwGetTime());
+
+	// Record the input of this tick, or replace it with the recorded input.
+	// The end of a replay ends the run
+	if (cInputRecorder->ProcessTick() == false)
+	{
+		return false;
+	}
+
+	// Call the active Game State's Update method
+	if (CGameStateManager::GetInstance()->Update(dTickTime) == false)
+	{
+		return false;
+	}
+
+	// Advance the audio by this tick. The software mixer mixes it here if it follows the simulation time
+	CSoundController::GetInstance()->Update(dTickTime);
+
+	// Perform Post Update Input Devices after every tick, so that a key press or release
+	// is only seen by one tick. If no tick is run in a frame, the input is kept for the next one.
+	PostUpdateInputDevices();
+
+	return true;
+}
+
 /**
  @brief Destroy this class instance
  */
 void Application::Destroy(void)
 {
-	//Destroy the CSoundController singleton
+	// Destroy the game states first. This waits for the threads which prepare levels and preload images,
+	// so none of them is still running when the CProfiler instance is destroyed
+	CGameStateManager::GetInstance()->Destroy();
+
+	// Write the profile zones to a trace file, if requested
+	if (cSettings->sProfileTraceFile != NULL)
+		CProfiler::GetInstance()->ExportChromeTrace(cSettings->sProfileTraceFile);
+
+	// Print the time from the input events to the ticks which applied them, and destroy the CInputEventQueue instance
+	if (cInputEventQueue)
+	{
+		cInputEventQueue->PrintLatencyReport();
+		cInputEventQueue->Destroy();
+		cInputEventQueue = NULL;
+	}
+
+	// Finish the input recording, and destroy the CInputRecorder instance
+	if (cInputRecorder)
+	{
+		cInputRecorder->Destroy();
+		cInputRecorder = NULL;
+	}
+
+	// Finish writing the queued save games, and destroy the CAsyncFileWriter instance
+	CAsyncFileWriter::GetInstance()->Destroy();
+
+	// Destroy the CRandom instance
+	CRandom::GetInstance()->Destroy();
+
+	// Report the decoded audio which the sounds keep in memory, and destroy the CSoundController singleton
+	CSoundController::GetInstance()->PrintMemoryReport();
 	CSoundController::GetInstance()->Destroy();
 
+	// Destroy the CUIRuntime instance, which deletes the IMGUI context and backends
+	if (cUIRuntime)
+	{
+		cUIRuntime->Destroy();
+		cUIRuntime = NULL;
+	}
+
+	// Destroy the CSpriteBatch instance before the shaders it uses
+	CSpriteBatch::GetInstance()->Destroy();
+
+	// Destroy the CSpriteSheetManager instance, which deletes the shared sprite sheets
+	CSpriteSheetManager::GetInstance()->Destroy();
+
 	// Destory the ShaderManager
 	CShaderManager::GetInstance()->Destroy();
 
+	// Destroy the CGLStateCache instance after the CShaderManager, which uses it when deleting the shaders
+	CGLStateCache::GetInstance()->Destroy();
+
 	// Destroy the mouse instance
 	CMouseController::GetInstance()->Destroy();
 	// Destroy the keyboard instance
@@ -335,6 +703,24 @@ void Application::Destroy(void)
 		cFPSCounter = NULL;
 	}
 
+	// Report how well the frames were paced, and destroy the CFramePacer instance
+	if (cFramePacer)
+	{
+		cout << "Frame pacing: target " << cFramePacer->GetTargetFrameTime() * 1000.0 << "ms, average "
+			<< cFramePacer->GetAverageFrameTime() * 1000.0 << "ms (+/- "
+			<< cFramePacer->GetFrameTimeDeviation() * 1000.0 << "ms), missed "
+			<< cFramePacer->GetMissedDeadlines() << " of " << cFramePacer->GetFrameCount() << " deadlines" << endl;
+		cFramePacer->Destroy();
+		cFramePacer = NULL;
+	}
+
+	// Destroy the CFixedTimeStep instance
+	if (cFixedTimeStep)
+	{
+		cFixedTimeStep->Destroy();
+		cFixedTimeStep = NULL;
+	}
+
 	//Close OpenGL window and terminate GLFW
 	glfwDestroyWindow(cSettings->pWindow);
 	//Finalize and clean up GLFW
@@ -342,6 +728,14 @@ void Application::Destroy(void)
 
 	// Destroy the CSettings instance
 	CSettings::GetInstance()->Destroy();
+
+	// Destroy the CProfiler instance
+	CProfiler::GetInstance()->Destroy();
+
+#ifdef ENABLE_MEMORY_TRACKER
+	// Print the allocations and OpenGL objects which are still alive, i.e. leaked or kept by the game states
+	CMemoryTracker::PrintReport();
+#endif
 }
 
 /**
@@ -365,13 +759,34 @@ int Application::GetWindowWidth(void) const
  */
 Application::Application(void)
 	: cFPSCounter(NULL)
+	, cFramePacer(NULL)
+	, cFixedTimeStep(NULL)
+	, cInputRecorder(NULL)
+	, cInputEventQueue(NULL)
+	, cFrameArena(NULL)
+	, cUIRuntime(NULL)
 	, cSettings(NULL)
 {
 }
 
 /**
-@brief Get updates from the input devices
+@brief Poll the input events, and get updates from the input devices
 */
+void Application::PollInputDevices(void)
+{
+	// Poll events. The input callbacks queue the key and mouse events for the ticks
+	{
+		PROFILE_SCOPE("glfwPollEvents");
+		glfwPollEvents();
+	}
+
+	// Update Input Devices
+	UpdateInputDevices();
+}
+
+/**
+ @brief Update the input devices which are read instead of queued, i.e. the mouse position
+ */
 void Application::UpdateInputDevices(void)
 {
 	// Update Mouse Position
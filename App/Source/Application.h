@@ -14,6 +14,35 @@
 // FPS Counter
 #include "TimeControl\FPSCounter.h"
 
+// Frame Pacer
+#include "TimeControl\FramePacer.h"
+
+// Fixed simulation tick rate
+#include "TimeControl\FixedTimeStep.h"
+
+// Profiler
+#include "TimeControl\Profiler.h"
+
+// Frame timings of a replay
+#include "TimeControl\FrameTimeLog.h"
+
+// Input recording and replay
+#include "Inputs\InputRecorder.h"
+// Timestamped input events for the ticks
+#include "Inputs\InputEventQueue.h"
+
+// Seeded random number generator
+#include "System\Random.h"
+
+// Per-frame arena allocator
+#include "System\FrameArena.h"
+
+// Heap allocation and OpenGL object tracking
+#include "System\MemoryTracker.h"
+
+// Shared IMGUI context and backends
+#include "RenderControl\UIRuntime.h"
+
 // Add your include files here
 
 struct GLFWwindow;
@@ -46,13 +75,41 @@ protected:
 	// The handler to the CFPSCounter instance
 	CFPSCounter* cFPSCounter;
 
+	// The handler to the CFramePacer instance
+	CFramePacer* cFramePacer;
+
+	// The handler to the CFixedTimeStep instance
+	CFixedTimeStep* cFixedTimeStep;
+
+	// The handler to the CInputRecorder instance
+	CInputRecorder* cInputRecorder;
+
+	// The handler to the CInputEventQueue instance, which passes the input events to the ticks
+	CInputEventQueue* cInputEventQueue;
+
+	// The frame arena of the main thread, which is reset at the end of every frame
+	CFrameArena* cFrameArena;
+
+	// The handler to the CUIRuntime instance, which every game state draws its UI with
+	CUIRuntime* cUIRuntime;
+
 	// Constructor
 	Application(void);
 
 	// Destructor
 	virtual ~Application(void);
 
-	// Update input devices
+	// Poll the input events, and update input devices
+	void PollInputDevices(void);
 	void UpdateInputDevices(void);
 	void PostUpdateInputDevices(void);
+
+	// Run the simulation ticks back to back without rendering
+	void RunHeadless(const unsigned int uiNumTicks);
+
+	// Replay the recorded input one tick per frame, and log the frame timings
+	void RunReplay(void);
+
+	// Run one fixed simulation tick
+	bool Tick(const double dTickTime, const double dInputTime);
 };
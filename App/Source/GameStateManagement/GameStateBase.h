@@ -15,8 +15,17 @@ public:
 	virtual ~CGameStateBase(void) {}
 
 	// These are pure virtual functions
+	// Init is called when the state is entered, and Destroy when it is exited
 	virtual bool Init() = 0;
 	virtual bool Update(const double dElapsedTime) = 0;
 	virtual void Render() = 0;
 	virtual void Destroy() = 0;
+
+	// Load the resources which are kept while the state is not active, e.g. its textures and meshes.
+	// CGameStateManager calls it once, before the state is entered for the first time
+	virtual bool Load() { return true; }
+	// Start reading the resources of Load in the background, so that Load does not wait for the disk
+	virtual void Preload() {}
+	// Release the resources of Load. CGameStateManager calls it when the state is removed
+	virtual void Unload() {}
 };
@@ -1,5 +1,12 @@
 #include "GameStateManager.h"
 
+// Include CProfiler to measure the game states
+#include "TimeControl/Profiler.h"
+// Include CMemoryTracker to count the allocations of the game states
+#include "System/MemoryTracker.h"
+// Include CImageLoader to wait for the images which are preloaded for the game states
+#include "System/ImageLoader.h"
+
 #include <iostream>
 
 using namespace std;
@@ -29,6 +36,13 @@ CGameStateManager::~CGameStateManager(void)
  */
 void CGameStateManager::Destroy(void)
 {
+	// Exit the active CGameState, e.g. so that its scene waits for the level it is preparing on another thread
+	if (activeGameState)
+		activeGameState->Destroy();
+
+	// Wait for the images which are being preloaded on other threads
+	CImageLoader::GetInstance()->CancelPreloads();
+
 	// Set the handlers to CGameState to nullptr
 	activeGameState = nullptr;
 	nextGameState = nullptr;
@@ -37,11 +51,12 @@ void CGameStateManager::Destroy(void)
 	optionsGameState = nullptr;
 	jumpscareState = nullptr;
 
-	// Delete all scenes stored and empty the entire map
+	// Unload and delete all scenes stored and empty the entire map
 	std::map<std::string, CGameStateBase*>::iterator it, end;
 	end = GameStateMap.end();
 	for (it = GameStateMap.begin(); it != end; ++it)
 	{
+		UnloadGameState(it->second);
 		delete it->second;
 	}
 	// Clear the map
@@ -53,6 +68,9 @@ void CGameStateManager::Destroy(void)
  */
 bool CGameStateManager::Update(const double dElapsedTime)
 {
+	PROFILE_SCOPE("CGameStateManager::Update");
+	MEMORY_TAG("CGameStateManager::Update");
+
 	// Check for change of scene
 	if (nextGameState != activeGameState)
 	{
@@ -66,7 +84,8 @@ bool CGameStateManager::Update(const double dElapsedTime)
 		prevGameState = activeGameState;
 		// Set the new active CGameState
 		activeGameState = nextGameState;
-		// Init the new active CGameState
+		// Load the new active CGameState if it was not loaded before, and Init it
+		LoadGameState(activeGameState);
 		activeGameState->Init();
 	}
 
@@ -103,6 +122,9 @@ bool CGameStateManager::Update(const double dElapsedTime)
  */
 void CGameStateManager::Render(void)
 {
+	PROFILE_SCOPE("CGameStateManager::Render");
+	MEMORY_TAG("CGameStateManager::Render");
+
 	if (activeGameState)
 		activeGameState->Render();
 	if (pauseGameState)
@@ -163,7 +185,8 @@ bool CGameStateManager::RemoveGameState(const std::string& _name)
 		return false;
 	}
 
-	// Delete and remove from our map
+	// Unload, delete and remove from our map
+	UnloadGameState(target);
 	delete target;
 	GameStateMap.erase(_name);
 
@@ -215,6 +238,7 @@ bool CGameStateManager::SetPauseGameState(const std::string& _name)
 	// Scene exist, set the next scene pointer to that scene
 	pauseGameState = GameStateMap[_name];
 	// Init the new pause CGameState
+	LoadGameState(pauseGameState);
 	pauseGameState->Init();
 
 	return true;
@@ -242,9 +266,14 @@ bool CGameStateManager::SetJumpscareState(const std::string& _name)
 		return false;
 	}
 
+	// The jumpscare is requested on every tick while it is shown, so only Init it when it appears
+	if (jumpscareState == GameStateMap[_name])
+		return true;
+
 	// Scene exist, set the next scene pointer to that scene
 	jumpscareState = GameStateMap[_name];
 	// Init the new pause CGameState
+	LoadGameState(jumpscareState);
 	jumpscareState->Init();
 
 	return true;
@@ -275,6 +304,7 @@ bool CGameStateManager::SetOptionsGameState(const std::string& _name)
 	// Scene exist, set the next scene pointer to that scene
 	optionsGameState = GameStateMap[_name];
 	// Init the new pause CGameState
+	LoadGameState(optionsGameState);
 	optionsGameState->Init();
 
 	return true;
@@ -298,3 +328,58 @@ bool CGameStateManager::CheckCurrentGameState(const std::string& _name)
 	}
 	return true;
 }
+
+/**
+ @brief Start loading a CGameState in the background, e.g. the states which may be entered soon.
+		It is ignored if the CGameState has been loaded already
+ @param _name A const std::string& variable which is the name of the CGameState
+ */
+bool CGameStateManager::PreloadGameState(const std::string& _name)
+{
+	// Check if this _name does not exists in the map...
+	if (!CheckGameStateExist(_name))
+	{
+		// If it does not exist, then unable to proceed
+		cout << "CGameStateManager::PreloadGameState - scene name does not exists" << endl;
+		return false;
+	}
+
+	CGameStateBase* target = GameStateMap[_name];
+	if (loadedGameStates.count(target) == 0)
+		target->Preload();
+
+	return true;
+}
+
+/**
+ @brief Load a CGameState, if it has not been loaded yet. Its resources are kept until it is removed,
+		so entering it again does not load them again
+ @param _scene A CGameState* variable which is the CGameState
+ */
+bool CGameStateManager::LoadGameState(CGameStateBase* _scene)
+{
+	if (loadedGameStates.count(_scene) != 0)
+		return true;
+
+	PROFILE_SCOPE("CGameStateManager::LoadGameState");
+	MEMORY_TAG("CGameStateManager::LoadGameState");
+
+	if (_scene->Load() == false)
+	{
+		cout << "CGameStateManager::LoadGameState - Unable to load the scene" << endl;
+		return false;
+	}
+
+	loadedGameStates.insert(_scene);
+	return true;
+}
+
+/**
+ @brief Unload a CGameState, if it has been loaded
+ @param _scene A CGameState* variable which is the CGameState
+ */
+void CGameStateManager::UnloadGameState(CGameStateBase* _scene)
+{
+	if (loadedGameStates.erase(_scene) != 0)
+		_scene->Unload();
+}
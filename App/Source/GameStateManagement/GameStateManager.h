@@ -2,6 +2,7 @@
 
 #include "DesignPatterns/SingletonTemplate.h"
 #include <map>
+#include <set>
 #include <string>
 
 #include "GameStateBase.h"
@@ -40,6 +41,9 @@ public:
 
 	bool CheckCurrentGameState(const std::string& _name);
 
+	// Start loading a CGameState in the background, e.g. a state which may be entered soon
+	bool PreloadGameState(const std::string& _name);
+
 protected:
 	// Constructor
 	CGameStateManager();
@@ -50,4 +54,11 @@ protected:
 	std::map<std::string, CGameStateBase*> GameStateMap;
 	// The handlers containing the active and next CGameState
 	CGameStateBase* activeGameState, *nextGameState, *prevGameState, *pauseGameState, *optionsGameState, *jumpscareState;
+	// The CGameStates which have been loaded. They keep their resources until they are removed
+	std::set<CGameStateBase*> loadedGameStates;
+
+	// Load a CGameState, if it has not been loaded yet
+	bool LoadGameState(CGameStateBase* _scene);
+	// Unload a CGameState, if it has been loaded
+	void UnloadGameState(CGameStateBase* _scene);
 };
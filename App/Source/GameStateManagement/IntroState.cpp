@@ -23,6 +23,8 @@
 #include "System\ImageLoader.h"
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CUIRuntime to draw the UI into the shared UI frame
+#include "RenderControl\UIRuntime.h"
 
  // Include shader
 #include "RenderControl\shader.h"
@@ -76,20 +78,6 @@ bool CIntroState::Init(void)
 	background->SetShader("Shader2D");
 	background->Init();
 
-	// Setup Dear ImGui context
-	IMGUI_CHECKVERSION();
-	ImGui::CreateContext();
-	ImGuiIO& io = ImGui::GetIO(); (void)io;
-
-	// Setup Dear ImGui style
-	ImGui::StyleColorsDark();
-	//ImGui::StyleColorsClassic();
-
-	// Setup Platform/Renderer bindings
-	ImGui_ImplGlfw_InitForOpenGL(CSettings::GetInstance()->pWindow, true);
-	const char* glsl_version = "#version 330";
-	ImGui_ImplOpenGL3_Init(glsl_version);
-
 	// Load the images for buttons
 	CImageLoader* il = CImageLoader::GetInstance();
 	logoData.fileName = "Image\\GUI\\Logo.png";
@@ -102,12 +90,12 @@ bool CIntroState::Init(void)
 	cSoundController = CSoundController::GetInstance();
 
 	// Menu
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\MenuBGM.wav"), 1, true, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\ui_button_confirm.wav"), 2, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\LoseBGM.wav"), 3, true, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\WinBGM.wav"), 4, true, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\MenuBGM.wav"), SOUND_MENU_BGM, true, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\ui_button_confirm.wav"), SOUND_UI_CONFIRM, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\LoseBGM.wav"), SOUND_LOSE_BGM, true, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\WinBGM.wav"), SOUND_WIN_BGM, true, true);
 
-	cSoundController->PlaySoundByID(1);
+	cSoundController->PlaySoundByID(SOUND_MENU_BGM);
 
 	cSettings = CSettings::GetInstance();
 
@@ -123,10 +111,8 @@ bool CIntroState::Update(const double dElapsedTime)
 	const float relativeScale_x = cSettings->iWindowWidth / 1366.0f;
 	const float relativeScale_y = cSettings->iWindowHeight / 768.0f;
 
-	// Start the Dear ImGui frame
-	ImGui_ImplOpenGL3_NewFrame();
-	ImGui_ImplGlfw_NewFrame();
-	ImGui::NewFrame();
+	// Start the shared UI frame
+	CUIRuntime::GetInstance()->BeginFrame();
 
 	ImGuiWindowFlags window_flags = 0;
 	window_flags |= ImGuiWindowFlags_NoTitleBar;
@@ -161,7 +147,7 @@ bool CIntroState::Update(const double dElapsedTime)
 	//cout << "CIntroState::Update()\n" << endl;
 	if (CKeyboardController::GetInstance()->IsKeyReleased(GLFW_KEY_SPACE))
 	{
-		cSoundController->PlaySoundByID(2);
+		cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
 		// Reset the CKeyboardController
 		CKeyboardController::GetInstance()->Reset();
 
@@ -184,10 +170,6 @@ void CIntroState::Render()
 
 	//Draw the background
  	background->Render();
-
-	// Rendering
-	ImGui::Render();
-	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
 /**
@@ -202,10 +184,12 @@ void CIntroState::Destroy(void)
 		background = NULL;
 	}
 
-	// Cleanup
-	ImGui_ImplOpenGL3_Shutdown();
-	ImGui_ImplGlfw_Shutdown();
-	ImGui::DestroyContext();
+	// Release the images for buttons
+	CImageLoader* il = CImageLoader::GetInstance();
+	il->ReleaseTexture(logoData.textureID);
+	logoData.textureID = 0;
+	il->ReleaseTexture(TextData.textureID);
+	TextData.textureID = 0;
 
 	cout << "CIntroState::Destroy()\n" << endl;
 }
\ No newline at end of file
@@ -23,6 +23,8 @@
 #include "System\ImageLoader.h"
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CUIRuntime to draw the UI into the shared UI frame
+#include "RenderControl\UIRuntime.h"
 
  // Include shader
 #include "RenderControl\shader.h"
@@ -68,6 +70,14 @@ bool JumpscareState::Init(void)
 
 	cSoundController = CSoundController::GetInstance();
 
+	return true;
+}
+
+/**
+ @brief Load the images of this state. They are kept until the state is removed
+ */
+bool JumpscareState::Load(void)
+{
 	// Load the images for buttons
 	CImageLoader* il = CImageLoader::GetInstance();
 	BG.fileName = "Image\\GUI\\jumpscare2.png";
@@ -76,11 +86,22 @@ bool JumpscareState::Init(void)
 	return true;
 }
 
+/**
+ @brief Start reading the images of this state in the background, e.g. while the game is played
+ */
+void JumpscareState::Preload(void)
+{
+	CImageLoader::GetInstance()->PreloadTexture("Image\\GUI\\jumpscare2.png", false);
+}
+
 /**
  @brief Update this class instance
  */
 bool JumpscareState::Update(const double dElapsedTime)
 {
+	// Start the shared UI frame, if the state below this overlay has not started it
+	CUIRuntime::GetInstance()->BeginFrame();
+
 	ImGuiWindowFlags window_flags = 0;
 	window_flags |= ImGuiWindowFlags_NoTitleBar;
 	window_flags |= ImGuiWindowFlags_NoScrollbar;
@@ -132,3 +153,13 @@ void JumpscareState::Destroy(void)
 {
 	// cout << "JumpscareState::Destroy()\n" << endl;
 }
+
+/**
+ @brief Release the resources of Load
+ */
+void JumpscareState::Unload(void)
+{
+	// Release the image
+	CImageLoader::GetInstance()->ReleaseTexture(BG.textureID);
+	BG.textureID = 0;
+}
@@ -23,6 +23,8 @@
 #include "System\ImageLoader.h"
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CUIRuntime to draw the UI into the shared UI frame
+#include "RenderControl\UIRuntime.h"
 
  // Include shader
 #include "RenderControl\shader.h"
@@ -71,43 +73,51 @@ bool CLoseState::Init(void)
 	CShaderManager::GetInstance()->Use("Shader2D");
 	CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
 
+	// Load sounds into CSoundController
+	cSoundController = CSoundController::GetInstance();
+
+	cSoundController->StopSoundByID(SOUND_GAME_BGM);
+	cSoundController->StopSoundByID(SOUND_JUMPSCARE);
+	cSoundController->PlaySoundByID(SOUND_LOSE_BGM);
+	CGameStateManager::GetInstance()->OffJumpscareState();
+
+	cSettings = CSettings::GetInstance();
+
+	return true;
+}
+
+/**
+ @brief Load the background and images of this state. They are kept until the state is removed
+ */
+bool CLoseState::Load(void)
+{
+	cout << "CLoseState::Load()\n" << endl;
+
+	// Include Shader Manager
+	CShaderManager::GetInstance()->Use("Shader2D");
+
 	//Create Background Entity
 	background = new CBackgroundEntity("Image/SceneLose.png");
 	background->SetShader("Shader2D");
 	background->Init();
 
-	// Setup Dear ImGui context
-	IMGUI_CHECKVERSION();
-	ImGui::CreateContext();
-	ImGuiIO& io = ImGui::GetIO(); (void)io;
-
-	// Setup Dear ImGui style
-	ImGui::StyleColorsDark();
-	//ImGui::StyleColorsClassic();
-
-	// Setup Platform/Renderer bindings
-	ImGui_ImplGlfw_InitForOpenGL(CSettings::GetInstance()->pWindow, true);
-	const char* glsl_version = "#version 330";
-	ImGui_ImplOpenGL3_Init(glsl_version);
-
 	// Load the images for buttons
 	CImageLoader* il = CImageLoader::GetInstance();
 	loseData.fileName = "Image\\GUI\\LostMenu.png";
 	loseData.textureID = il->LoadTextureGetID(loseData.fileName.c_str(), false);
 
-	// Load sounds into CSoundController
-	cSoundController = CSoundController::GetInstance();
-
-	cSoundController->StopSoundByID(5);
-	cSoundController->StopSoundByID(27);
-	cSoundController->PlaySoundByID(3);
-	CGameStateManager::GetInstance()->OffJumpscareState();
-
-	cSettings = CSettings::GetInstance();
-
 	return true;
 }
 
+/**
+ @brief Start reading the images of this state in the background, e.g. while the game is played
+ */
+void CLoseState::Preload(void)
+{
+	CImageLoader::GetInstance()->PreloadTexture("Image/SceneLose.png", true);
+	CImageLoader::GetInstance()->PreloadTexture("Image\\GUI\\LostMenu.png", false);
+}
+
 /**
  @brief Update this class instance
  */
@@ -117,10 +127,8 @@ bool CLoseState::Update(const double dElapsedTime)
 	const float relativeScale_x = cSettings->iWindowWidth / 1366.0f;
 	const float relativeScale_y = cSettings->iWindowHeight / 768.0f;
 
-	// Start the Dear ImGui frame
-	ImGui_ImplOpenGL3_NewFrame();
-	ImGui_ImplGlfw_NewFrame();
-	ImGui::NewFrame();
+	// Start the shared UI frame
+	CUIRuntime::GetInstance()->BeginFrame();
 
 	ImGuiWindowFlags window_flags = 0;
 	window_flags |= ImGuiWindowFlags_NoTitleBar;
@@ -140,8 +148,8 @@ bool CLoseState::Update(const double dElapsedTime)
 	//cout << "CLoseState::Update()\n" << endl;
 	if (CKeyboardController::GetInstance()->IsKeyReleased(GLFW_KEY_SPACE))
 	{
-		cSoundController->PlaySoundByID(5);
-		cSoundController->StopSoundByID(3);
+		cSoundController->PlaySoundByID(SOUND_GAME_BGM);
+		cSoundController->StopSoundByID(SOUND_LOSE_BGM);
 		// Reset the CKeyboardController
 		CKeyboardController::GetInstance()->Reset();
 
@@ -164,16 +172,20 @@ void CLoseState::Render()
 
 	//Draw the background
  	background->Render();
-
-	// Rendering
-	ImGui::Render();
-	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
 /**
  @brief Destroy this class instance
  */
 void CLoseState::Destroy(void)
+{
+	cout << "CLoseState::Destroy()\n" << endl;
+}
+
+/**
+ @brief Release the resources of Load
+ */
+void CLoseState::Unload(void)
 {
 	// Delete the background
 	if (background)
@@ -182,10 +194,8 @@ void CLoseState::Destroy(void)
 		background = NULL;
 	}
 
-	// Cleanup
-	ImGui_ImplOpenGL3_Shutdown();
-	ImGui_ImplGlfw_Shutdown();
-	ImGui::DestroyContext();
-
-	cout << "CLoseState::Destroy()\n" << endl;
+	// Release the images for buttons
+	CImageLoader* il = CImageLoader::GetInstance();
+	il->ReleaseTexture(loseData.textureID);
+	loseData.textureID = 0;
 }
\ No newline at end of file
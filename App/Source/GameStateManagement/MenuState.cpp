@@ -23,6 +23,8 @@
 #include "System\ImageLoader.h"
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CUIRuntime to draw the UI into the shared UI frame
+#include "RenderControl\UIRuntime.h"
 
  // Include shader
 #include "RenderControl\shader.h"
@@ -75,25 +77,33 @@ bool CMenuState::Init(void)
 	CShaderManager::GetInstance()->Use("Shader2D");
 	//CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
 
+	// Enable the cursor
+	if (CSettings::GetInstance()->bDisableMousePointer == true)
+		glfwSetInputMode(CSettings::GetInstance()->pWindow, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+
+	// Get handler for sound controller
+	cSoundController = CSoundController::GetInstance();
+
+	cSettings = CSettings::GetInstance();
+
+	return true;
+}
+
+/**
+ @brief Load the background and images of this state. They are kept until the state is removed,
+		so returning to the menu does not load them again
+ */
+bool CMenuState::Load(void)
+{
+	cout << "CMenuState::Load()\n" << endl;
+
+	CShaderManager::GetInstance()->Use("Shader2D");
+
 	//Create Background Entity
 	background = new CBackgroundEntity("Image/MainMenu.png");
 	background->SetShader("Shader2D");
 	background->Init();
 
-	// Setup Dear ImGui context
-	IMGUI_CHECKVERSION();
-	ImGui::CreateContext();
-	ImGuiIO& io = ImGui::GetIO(); (void)io;
-
-	// Setup Dear ImGui style
-	ImGui::StyleColorsDark();
-	//ImGui::StyleColorsClassic();
-
-	// Setup Platform/Renderer bindings
-	ImGui_ImplGlfw_InitForOpenGL(CSettings::GetInstance()->pWindow, true);
-	const char* glsl_version = "#version 330";
-	ImGui_ImplOpenGL3_Init(glsl_version);
-
 	// Load the images for buttons
 	CImageLoader* il = CImageLoader::GetInstance();
 	startButtonData.fileName = "Image\\GUI\\ButtonPlay.png";
@@ -108,15 +118,6 @@ bool CMenuState::Init(void)
 	logoData.fileName = "Image\\GUI\\MenuLogo.png";
 	logoData.textureID = il->LoadTextureGetID(logoData.fileName.c_str(), false);
 
-	// Enable the cursor
-	if (CSettings::GetInstance()->bDisableMousePointer == true)
-		glfwSetInputMode(CSettings::GetInstance()->pWindow, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-
-	// Get handler for sound controller
-	cSoundController = CSoundController::GetInstance();
-
-	cSettings = CSettings::GetInstance();
-
 	return true;
 }
 
@@ -149,10 +150,8 @@ bool CMenuState::Update(const double dElapsedTime)
 	const float relativeScale_x = cSettings->iWindowWidth / 1366.0f;
 	const float relativeScale_y = cSettings->iWindowHeight / 768.0f;
 
-	// Start the Dear ImGui frame
-	ImGui_ImplOpenGL3_NewFrame();
-	ImGui_ImplGlfw_NewFrame();
-	ImGui::NewFrame();
+	// Start the shared UI frame
+	CUIRuntime::GetInstance()->BeginFrame();
 
 	ImGuiWindowFlags window_flags = 0;
 	window_flags |= ImGuiWindowFlags_NoTitleBar;
@@ -204,8 +203,8 @@ bool CMenuState::Update(const double dElapsedTime)
 		if (ImGui::ImageButton((ImTextureID)startButtonData.textureID, 
 			ImVec2(buttonWidth * 2, buttonHeight), ImVec2(0.0, 0.0), ImVec2(1.0, 1.0)))
 		{
-			cSoundController->PlaySoundByID(2);
-			cSoundController->StopSoundByID(1);
+			cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
+			cSoundController->StopSoundByID(SOUND_MENU_BGM);
 			// Reset the CKeyboardController
 			CKeyboardController::GetInstance()->Reset();
 
@@ -216,7 +215,7 @@ bool CMenuState::Update(const double dElapsedTime)
 		if (ImGui::ImageButton((ImTextureID)optionsButtonData.textureID,
 			ImVec2(buttonWidth * 2, buttonHeight), ImVec2(0.0, 0.0), ImVec2(1.0, 1.0)))
 		{
-			cSoundController->PlaySoundByID(2);
+			cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
 			// Reset the CKeyboardController
 			CKeyboardController::GetInstance()->Reset();
 
@@ -228,7 +227,7 @@ bool CMenuState::Update(const double dElapsedTime)
 		if (ImGui::ImageButton((ImTextureID)exitButtonData.textureID,
 			ImVec2(buttonWidth * 2, buttonHeight), ImVec2(0.0, 0.0), ImVec2(1.0, 1.0)))
 		{
-			cSoundController->PlaySoundByID(2);
+			cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
 			// Reset the CKeyboardController
 			CKeyboardController::GetInstance()->Reset();
 
@@ -244,8 +243,8 @@ bool CMenuState::Update(const double dElapsedTime)
 	//For keyboard controls
 	if (CKeyboardController::GetInstance()->IsKeyReleased(GLFW_KEY_SPACE))
 	{
-		cSoundController->StopSoundByID(1);
-		cSoundController->PlaySoundByID(2);
+		cSoundController->StopSoundByID(SOUND_MENU_BGM);
+		cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
 		// Reset the CKeyboardController
 		CKeyboardController::GetInstance()->Reset();
 
@@ -256,7 +255,7 @@ bool CMenuState::Update(const double dElapsedTime)
 	}
 	else if (CKeyboardController::GetInstance()->IsKeyReleased(GLFW_KEY_ESCAPE))
 	{
-		cSoundController->PlaySoundByID(2);
+		cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
 		// Reset the CKeyboardController
 		CKeyboardController::GetInstance()->Reset();
 
@@ -279,10 +278,6 @@ void CMenuState::Render(void)
 	//Render Background
 	background->Render();
 
-	// Rendering
-	ImGui::Render();
-	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
 	//cout << "CMenuState::Render()\n" << endl;
 }
 
@@ -299,6 +294,14 @@ void CMenuState::Destroy(void)
 		if (CSettings::GetInstance()->bShowMousePointer == false)
 			glfwSetInputMode(CSettings::GetInstance()->pWindow, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
 
+	cout << "CMenuState::Destroy()\n" << endl;
+}
+
+/**
+ @brief Release the resources of Load
+ */
+void CMenuState::Unload(void)
+{
 	// Delete the background
 	if (background)
 	{
@@ -306,10 +309,14 @@ void CMenuState::Destroy(void)
 		background = NULL;
 	}
 
-	// Cleanup
-	ImGui_ImplOpenGL3_Shutdown();
-	ImGui_ImplGlfw_Shutdown();
-	ImGui::DestroyContext();
-
-	cout << "CMenuState::Destroy()\n" << endl;
+	// Release the images for buttons
+	CImageLoader* il = CImageLoader::GetInstance();
+	il->ReleaseTexture(startButtonData.textureID);
+	startButtonData.textureID = 0;
+	il->ReleaseTexture(optionsButtonData.textureID);
+	optionsButtonData.textureID = 0;
+	il->ReleaseTexture(exitButtonData.textureID);
+	exitButtonData.textureID = 0;
+	il->ReleaseTexture(logoData.textureID);
+	logoData.textureID = 0;
 }
@@ -42,6 +42,11 @@ public:
 	// Destroy this class instance
 	virtual void Destroy(void);
 
+	// Load the background and images of this state
+	virtual bool Load(void);
+	// Release the resources of Load
+	virtual void Unload(void);
+
 protected:
 	struct ButtonData
 	{
@@ -23,6 +23,8 @@
 #include "System\ImageLoader.h"
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CUIRuntime to draw the UI into the shared UI frame
+#include "RenderControl\UIRuntime.h"
 
  // Include shader
 #include "RenderControl\shader.h"
@@ -69,6 +71,14 @@ bool COptionsState::Init(void)
 
 	cSoundController = CSoundController::GetInstance();
 
+	return true;
+}
+
+/**
+ @brief Load the images of this state. They are kept until the state is removed
+ */
+bool COptionsState::Load(void)
+{
 	// Load the images for buttons
 	CImageLoader* il = CImageLoader::GetInstance();
 	OptionsButtonData.fileName = "Image\\GUI\\ButtonOptions.png";
@@ -78,11 +88,24 @@ bool COptionsState::Init(void)
 	return true;
 }
 
+/**
+ @brief Start reading the images of this state in the background, e.g. while the game is paused
+ */
+void COptionsState::Preload(void)
+{
+	CImageLoader* il = CImageLoader::GetInstance();
+	il->PreloadTexture("Image\\GUI\\ButtonOptions.png", false);
+	il->PreloadTexture("Image\\GUI\\Save.png", false);
+}
+
 /**
  @brief Update this class instance
  */
 bool COptionsState::Update(const double dElapsedTime)
 {
+	// Start the shared UI frame, if the state below this overlay has not started it
+	CUIRuntime::GetInstance()->BeginFrame();
+
 	ImGuiWindowFlags window_flags = 0;
 	window_flags |= ImGuiWindowFlags_NoTitleBar;
 	window_flags |= ImGuiWindowFlags_NoScrollbar;
@@ -114,13 +137,13 @@ bool COptionsState::Update(const double dElapsedTime)
 		ImGui::Image((ImTextureID)OptionsButtonData.textureID,
 			ImVec2(buttonWidth , buttonHeight * 0.5), ImVec2(0.0, 0.0), ImVec2(1.0, 1.0));
 
-		static float masterVolume = cSoundController->getCurrentVolume(0);
+		static float masterVolume = cSoundController->getCurrentVolume(SOUND_MASTER);
 		ImGui::SliderFloat("Master Volume", &masterVolume, 0, 1);
 
-		static float bgmVolume = cSoundController->getCurrentVolume(1);
+		static float bgmVolume = cSoundController->getCurrentVolume(SOUND_MENU_BGM);
 		ImGui::SliderFloat("Background Music", &bgmVolume, 0, 1);
 
-		static float sfxVolume = cSoundController->getCurrentVolume(2);
+		static float sfxVolume = cSoundController->getCurrentVolume(SOUND_UI_CONFIRM);
 		ImGui::SliderFloat("SFX", &sfxVolume, 0, 1);
 
 		cSoundController->SetMasterVolume(masterVolume);
@@ -151,30 +174,30 @@ bool COptionsState::Update(const double dElapsedTime)
 	if (ImGui::ImageButton((ImTextureID)SaveButtonData.textureID,
 		ImVec2(buttonWidth, buttonHeight), ImVec2(0.0, 0.0), ImVec2(1.0, 1.0)))
 	{
-		cSoundController->PlaySoundByID(2);
+		cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
 		// Reset the CKeyboardController
 		CKeyboardController::GetInstance()->Reset();
 
 		//Restart BGMs
-		if (cSoundController->isPlaying(1))
+		if (cSoundController->isPlaying(SOUND_MENU_BGM))
 		{
-			cSoundController->StopSoundByID(1);
-			cSoundController->PlaySoundByID(1);
+			cSoundController->StopSoundByID(SOUND_MENU_BGM);
+			cSoundController->PlaySoundByID(SOUND_MENU_BGM);
 		}
-		if (cSoundController->isPlaying(3))
+		if (cSoundController->isPlaying(SOUND_LOSE_BGM))
 		{
-			cSoundController->StopSoundByID(3);
-			cSoundController->PlaySoundByID(3);
+			cSoundController->StopSoundByID(SOUND_LOSE_BGM);
+			cSoundController->PlaySoundByID(SOUND_LOSE_BGM);
 		}
-		if (cSoundController->isPlaying(4))
+		if (cSoundController->isPlaying(SOUND_WIN_BGM))
 		{
-			cSoundController->StopSoundByID(4);
-			cSoundController->PlaySoundByID(4);
+			cSoundController->StopSoundByID(SOUND_WIN_BGM);
+			cSoundController->PlaySoundByID(SOUND_WIN_BGM);
 		}
-		if (cSoundController->isPlaying(5))
+		if (cSoundController->isPlaying(SOUND_GAME_BGM))
 		{
-			cSoundController->StopSoundByID(5);
-			cSoundController->PlaySoundByID(5);
+			cSoundController->StopSoundByID(SOUND_GAME_BGM);
+			cSoundController->PlaySoundByID(SOUND_GAME_BGM);
 		}
 		// Load the menu state
 		CGameStateManager::GetInstance()->OffOptionsGameState();
@@ -218,3 +241,16 @@ void COptionsState::Destroy(void)
 {
 	// cout << "COptionsState::Destroy()\n" << endl;
 }
+
+/**
+ @brief Release the resources of Load
+ */
+void COptionsState::Unload(void)
+{
+	// Release the images for buttons
+	CImageLoader* il = CImageLoader::GetInstance();
+	il->ReleaseTexture(OptionsButtonData.textureID);
+	OptionsButtonData.textureID = 0;
+	il->ReleaseTexture(SaveButtonData.textureID);
+	SaveButtonData.textureID = 0;
+}
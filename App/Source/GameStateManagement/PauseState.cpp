@@ -23,6 +23,8 @@
 #include "System\ImageLoader.h"
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CUIRuntime to draw the UI into the shared UI frame
+#include "RenderControl\UIRuntime.h"
 
  // Include shader
 #include "RenderControl\shader.h"
@@ -69,6 +71,17 @@ bool CPauseState::Init(void)
 
 	cSoundController = CSoundController::GetInstance();
 
+	// The options may be opened from the pause menu
+	CGameStateManager::GetInstance()->PreloadGameState("OptionsState");
+
+	return true;
+}
+
+/**
+ @brief Load the images of this state. They are kept until the state is removed, so pausing again is instant
+ */
+bool CPauseState::Load(void)
+{
 	// Load the images for buttons
 	CImageLoader* il = CImageLoader::GetInstance();
 	ContinuteButtonData.fileName = "Image\\GUI\\Continue.png";
@@ -81,11 +94,25 @@ bool CPauseState::Init(void)
 	return true;
 }
 
+/**
+ @brief Start reading the images of this state in the background, e.g. while the game is played
+ */
+void CPauseState::Preload(void)
+{
+	CImageLoader* il = CImageLoader::GetInstance();
+	il->PreloadTexture("Image\\GUI\\Continue.png", false);
+	il->PreloadTexture("Image\\GUI\\Options.png", false);
+	il->PreloadTexture("Image\\GUI\\Return.png", false);
+}
+
 /**
  @brief Update this class instance
  */
 bool CPauseState::Update(const double dElapsedTime)
 {
+	// Start the shared UI frame, if the state below this overlay has not started it
+	CUIRuntime::GetInstance()->BeginFrame();
+
 	ImGuiWindowFlags window_flags = 0;
 	window_flags |= ImGuiWindowFlags_NoTitleBar;
 	window_flags |= ImGuiWindowFlags_NoScrollbar;
@@ -121,7 +148,7 @@ bool CPauseState::Update(const double dElapsedTime)
 		if (ImGui::ImageButton((ImTextureID)ContinuteButtonData.textureID,
 			ImVec2(buttonWidth * 2, buttonHeight), ImVec2(0.0, 0.0), ImVec2(1.0, 1.0)))
 		{
-			cSoundController->PlaySoundByID(2);
+			cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
 			// Reset the CKeyboardController
 			CKeyboardController::GetInstance()->Reset();
 			CGameStateManager::GetInstance()->OffPauseGameState();
@@ -130,7 +157,7 @@ bool CPauseState::Update(const double dElapsedTime)
 		if (ImGui::ImageButton((ImTextureID)OptionsButtonData.textureID,
 			ImVec2(buttonWidth * 2, buttonHeight), ImVec2(0.0, 0.0), ImVec2(1.0, 1.0)))
 		{
-			cSoundController->PlaySoundByID(2);
+			cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
 			// Reset the CKeyboardController
 			CKeyboardController::GetInstance()->Reset();
 
@@ -142,9 +169,9 @@ bool CPauseState::Update(const double dElapsedTime)
 		if (ImGui::ImageButton((ImTextureID)MenuButtonData.textureID,
 			ImVec2(buttonWidth * 2, buttonHeight), ImVec2(0.0, 0.0), ImVec2(1.0, 1.0)))
 		{
-			cSoundController->PlaySoundByID(2);
-			cSoundController->StopSoundByID(3);
-			cSoundController->PlaySoundByID(1);
+			cSoundController->PlaySoundByID(SOUND_UI_CONFIRM);
+			cSoundController->StopSoundByID(SOUND_LOSE_BGM);
+			cSoundController->PlaySoundByID(SOUND_MENU_BGM);
 			// Reset the CKeyboardController
 			CKeyboardController::GetInstance()->Reset();
 
@@ -188,3 +215,18 @@ void CPauseState::Destroy(void)
 {
 	// cout << "CPauseState::Destroy()\n" << endl;
 }
+
+/**
+ @brief Release the resources of Load
+ */
+void CPauseState::Unload(void)
+{
+	// Release the images for buttons
+	CImageLoader* il = CImageLoader::GetInstance();
+	il->ReleaseTexture(ContinuteButtonData.textureID);
+	ContinuteButtonData.textureID = 0;
+	il->ReleaseTexture(OptionsButtonData.textureID);
+	OptionsButtonData.textureID = 0;
+	il->ReleaseTexture(MenuButtonData.textureID);
+	MenuButtonData.textureID = 0;
+}
@@ -51,6 +51,12 @@ bool CPlayGameState::Init(void)
 	} 
 
 	screentimer = 20;
+
+	// Start loading the states which may be shown during the game, so that they appear without a hitch
+	CGameStateManager::GetInstance()->PreloadGameState("PauseState");
+	CGameStateManager::GetInstance()->PreloadGameState("JumpscareState");
+	CGameStateManager::GetInstance()->PreloadGameState("LoseState");
+	CGameStateManager::GetInstance()->PreloadGameState("WinState");
 	return true;
 }
 
@@ -84,7 +90,7 @@ bool CPlayGameState::Update(const double dElapsedTime)
 		{
 			CGameStateManager::GetInstance()->OffJumpscareState();
 			CGameManager::GetInstance()->bPLayerJumpscared = false;
-			CSoundController::GetInstance()->StopSoundByID(27);
+			CSoundController::GetInstance()->StopSoundByID(SOUND_JUMPSCARE);
 			screentimer = 20;
 		}
 	}
@@ -125,4 +131,30 @@ void CPlayGameState::Destroy(void)
 		cScene2D->Destroy();
 		cScene2D = NULL;
 	}
-}
\ No newline at end of file
+}
+
+/**
+ @brief Load the resources of the scene which are kept between games, so that retrying does not load them again
+ */
+bool CPlayGameState::Load(void)
+{
+	cout << "CPlayGameState::Load()\n" << endl;
+
+	if (CScene2D::LoadResources() == false)
+	{
+		cout << "Failed to load the resources of Scene2D" << endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ @brief Release the resources of Load
+ */
+void CPlayGameState::Unload(void)
+{
+	cout << "CPlayGameState::Unload()\n" << endl;
+
+	CScene2D::UnloadResources();
+}
@@ -28,6 +28,11 @@ public:
 	// Destroy this class instance
 	virtual void Destroy(void);
 
+	// Load the resources of the scene which are kept between games
+	virtual bool Load(void);
+	// Release the resources of Load
+	virtual void Unload(void);
+
 protected:
 	// The handler to the CScene2D instance
 	CScene2D* cScene2D;
@@ -23,6 +23,8 @@
 #include "System\ImageLoader.h"
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CUIRuntime to draw the UI into the shared UI frame
+#include "RenderControl\UIRuntime.h"
 
  // Include shader
 #include "RenderControl\shader.h"
@@ -72,41 +74,49 @@ bool CWinState::Init(void)
 	CShaderManager::GetInstance()->Use("Shader2D");
 	CShaderManager::GetInstance()->activeShader->setInt("texture1", 0);
 
+	// Load sounds into CSoundController
+	cSoundController = CSoundController::GetInstance();
+
+	cSoundController->StopSoundByID(SOUND_GAME_BGM);
+	cSoundController->PlaySoundByID(SOUND_WIN_BGM);
+
+	cSettings = CSettings::GetInstance();
+
+	return true;
+}
+
+/**
+ @brief Load the background and images of this state. They are kept until the state is removed
+ */
+bool CWinState::Load(void)
+{
+	cout << "CWinState::Load()\n" << endl;
+
+	// Include Shader Manager
+	CShaderManager::GetInstance()->Use("Shader2D");
+
 	//Create Background Entity
 	background = new CBackgroundEntity("Image/SceneWin.png");
 	background->SetShader("Shader2D");
 	background->Init();
 
-	// Setup Dear ImGui context
-	IMGUI_CHECKVERSION();
-	ImGui::CreateContext();
-	ImGuiIO& io = ImGui::GetIO(); (void)io;
-
-	// Setup Dear ImGui style
-	ImGui::StyleColorsDark();
-	//ImGui::StyleColorsClassic();
-
-	// Setup Platform/Renderer bindings
-	ImGui_ImplGlfw_InitForOpenGL(CSettings::GetInstance()->pWindow, true);
-	const char* glsl_version = "#version 330";
-	ImGui_ImplOpenGL3_Init(glsl_version);
-
 	// Load the images for buttons
 	CImageLoader* il = CImageLoader::GetInstance();
 	winData.fileName = "Image\\GUI\\WinMenu.png";
 	winData.textureID = il->LoadTextureGetID(winData.fileName.c_str(), false);
 
-	// Load sounds into CSoundController
-	cSoundController = CSoundController::GetInstance();
-
-	cSoundController->StopSoundByID(5);
-	cSoundController->PlaySoundByID(4);
-
-	cSettings = CSettings::GetInstance();
-
 	return true;
 }
 
+/**
+ @brief Start reading the images of this state in the background, e.g. while the game is played
+ */
+void CWinState::Preload(void)
+{
+	CImageLoader::GetInstance()->PreloadTexture("Image/SceneWin.png", true);
+	CImageLoader::GetInstance()->PreloadTexture("Image\\GUI\\WinMenu.png", false);
+}
+
 /**
  @brief Update this class instance
  */
@@ -116,10 +126,8 @@ bool CWinState::Update(const double dElapsedTime)
 	const float relativeScale_x = cSettings->iWindowWidth / 1366.0f;
 	const float relativeScale_y = cSettings->iWindowHeight / 768.0f;
 
-	// Start the Dear ImGui frame
-	ImGui_ImplOpenGL3_NewFrame();
-	ImGui_ImplGlfw_NewFrame();
-	ImGui::NewFrame();
+	// Start the shared UI frame
+	CUIRuntime::GetInstance()->BeginFrame();
 
 	ImGuiWindowFlags window_flags = 0;
 	window_flags |= ImGuiWindowFlags_NoTitleBar;
@@ -139,8 +147,8 @@ bool CWinState::Update(const double dElapsedTime)
 	//cout << "CWinState::Update()\n" << endl;
 	if (CKeyboardController::GetInstance()->IsKeyReleased(GLFW_KEY_ESCAPE))
 	{
-		cSoundController->StopSoundByID(4);
-		cSoundController->PlaySoundByID(1);
+		cSoundController->StopSoundByID(SOUND_WIN_BGM);
+		cSoundController->PlaySoundByID(SOUND_MENU_BGM);
 		// Reset the CKeyboardController
 		CKeyboardController::GetInstance()->Reset();
 
@@ -162,16 +170,20 @@ void CWinState::Render()
 
 	//Draw the background
  	background->Render();
-
-	// Rendering
-	ImGui::Render();
-	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
 /**
  @brief Destroy this class instance
  */
 void CWinState::Destroy(void)
+{
+	cout << "CWinState::Destroy()\n" << endl;
+}
+
+/**
+ @brief Release the resources of Load
+ */
+void CWinState::Unload(void)
 {
 	// Delete the background
 	if (background)
@@ -180,10 +192,8 @@ void CWinState::Destroy(void)
 		background = NULL;
 	}
 
-	// Cleanup
-	ImGui_ImplOpenGL3_Shutdown();
-	ImGui_ImplGlfw_Shutdown();
-	ImGui::DestroyContext();
-
-	cout << "CWinState::Destroy()\n" << endl;
+	// Release the images for buttons
+	CImageLoader* il = CImageLoader::GetInstance();
+	il->ReleaseTexture(winData.textureID);
+	winData.textureID = 0;
 }
\ No newline at end of file
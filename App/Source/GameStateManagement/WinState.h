@@ -41,6 +41,13 @@ public:
 	// Destroy this class instance
 	virtual void Destroy(void);
 
+	// Load the images of this state
+	virtual bool Load(void);
+	// Start reading the images of this state in the background
+	virtual void Preload(void);
+	// Release the resources of Load
+	virtual void Unload(void);
+
 protected:
 	struct ButtonData
 	{
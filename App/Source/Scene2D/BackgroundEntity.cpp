@@ -6,11 +6,16 @@
  */
 #include "BackgroundEntity.h"
 
+// Include CMemoryTracker to count the OpenGL objects
+#include "System\MemoryTracker.h"
+
 //For allowing creating of Quad Mesh 
 #include "Primitives/MeshBuilder.h"
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "RenderControl\GLStateCache.h"
 
 // Include ImageLoader
 #include "System\ImageLoader.h"
@@ -34,12 +39,17 @@ CBackgroundEntity::~CBackgroundEntity()
 		delete mesh;
 		mesh = NULL;
 	}
+
+	// Release the texture, so it is deleted if no other entity uses it
+	CImageLoader::GetInstance()->ReleaseTexture(iTextureID);
+	iTextureID = 0;
 }
 
 bool CBackgroundEntity::Init()
 {
 	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
 
 	// Load a texture 
 	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID(textureName.c_str(), true);
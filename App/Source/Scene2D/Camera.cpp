@@ -37,7 +37,9 @@ glm::mat4 Camera::GetMVP()
 	//);
 	//projection = glm::ortho(0, (int)cSettings->iWindowWidth, 0, (int)cSettings->iWindowHeight, -10, 10);
 
-	// Load identity
+	// Load identity. The stacks are cleared first, as they only need the matrices of this call.
+	// Clearing keeps their capacity, so this does not allocate after the first call
+	projectionStack.clear();
 	projectionStack.push_back(glm::mat4(1.0f));
 	projectionStack.back() = projection;
 
@@ -49,10 +51,12 @@ glm::mat4 Camera::GetMVP()
 		glm::vec3(up.x, up.y, up.z)
 	);
 	// Load identity
+	viewStack.clear();
 	viewStack.push_back(glm::mat4(1.0f));
 	viewStack.back() = viewStack.back() * viewMatrix;
 
 	// Model matrix : an identity matrix (model will be at the origin)
+	modelStack.clear();
 	modelStack.push_back(glm::mat4(1.0f));
 
 	//unsigned int MVPLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "MVP");
@@ -80,7 +84,7 @@ glm::mat4 Camera::GetMV()
 	return MV;
 }
 
-std::vector<glm::mat4> Camera::GetViewStack()
+const std::vector<glm::mat4>& Camera::GetViewStack() const
 {
 	return viewStack;
 }
@@ -55,7 +55,7 @@ public:
 	void Init(const glm::vec3& pos, const glm::vec3& target, const glm::vec3& up);
 	glm::mat4 GetMVP();
 	glm::mat4 GetMV();
-	std::vector<glm::mat4> GetViewStack();
+	const std::vector<glm::mat4>& GetViewStack() const;
 	void Reset();
 	void Update(const glm::vec3& pos, const glm::vec3& target, const glm::vec3& up);
 
@@ -6,11 +6,16 @@
  */
 #include "Enemy2D.h"
 
+// Include CMemoryTracker to count the OpenGL objects
+#include "System\MemoryTracker.h"
+
 #include <iostream>
 using namespace std;
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "RenderControl\GLStateCache.h"
 // Include Mesh Builder
 #include "Primitives/MeshBuilder.h"
 
@@ -74,9 +79,12 @@ CEnemy2D::~CEnemy2D(void)
 	camera = NULL;
 
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
+	CGLStateCache::GetInstance()->DeleteVertexArrays(1, &VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, -1);
+	CGLStateCache::GetInstance()->DeleteBuffers(1, &VBO);
+	MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
+	CGLStateCache::GetInstance()->DeleteBuffers(1, &EBO);
+	MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
 }
 
 /**
@@ -107,7 +115,8 @@ bool CEnemy2D::Init(void)
 	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
 
 	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
 
 	//CS: Create the Quad Mesh using the mesh builder
 	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
@@ -239,15 +248,12 @@ void CEnemy2D::PreRender(void)
 	if (!bIsActive)
 		return;
 
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CGLStateCache::GetInstance()->SetBlend(true);
+	CGLStateCache::GetInstance()->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	CShaderManager::GetInstance()->Use(iShaderHandle);
 }
 
 /**
@@ -258,11 +264,9 @@ void CEnemy2D::Render(void)
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
 	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	GLint transformLoc = CShaderManager::GetInstance()->activeShader->getUniformLocation("transform");
+	GLint colorLoc = CShaderManager::GetInstance()->activeShader->getUniformLocation("runtimeColour");
 
 	glm::mat4 MVP = camera->GetMVP();
 	glm::mat4 transformMVP;
@@ -280,14 +284,11 @@ void CEnemy2D::Render(void)
 	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
 
 	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
+	CGLStateCache::GetInstance()->BindTexture(0, iTextureID);
 
 	// Render the tile
 	//glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 	quadMesh->Render();
-
-	glBindVertexArray(0);
-
 }
 
 /**
@@ -295,11 +296,6 @@ void CEnemy2D::Render(void)
  */
 void CEnemy2D::PostRender(void)
 {
-	if (!bIsActive)
-		return;
-
-	// Disable blending
-	glDisable(GL_BLEND);
 }
 
 /**
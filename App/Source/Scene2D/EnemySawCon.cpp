@@ -11,14 +11,16 @@ using namespace std;
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
-// Include Mesh Builder
-#include "Primitives/MeshBuilder.h"
+// Include CSpriteBatch
+#include "RenderControl\SpriteBatch.h"
 
 // Include GLEW
 #include <GL/glew.h>
 
 // Include ImageLoader
 #include "System\ImageLoader.h"
+// Include CSnapshotBuffer for the save games
+#include "System\SnapshotBuffer.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
@@ -27,6 +29,9 @@ using namespace std;
 
 #include "System\filesystem.h"
 
+// Include CFixedTimeStep to convert the FSM durations into simulation ticks
+#include "TimeControl\FixedTimeStep.h"
+
 //To get rays
 #include "Map2D.h"
 
@@ -39,11 +44,11 @@ CEnemySawCon::CEnemySawCon(void)
 	, cSettings(NULL)
 	, cPlayer2D(NULL)
 	, sCurrentFSM(FSM::IDLE)
-	, quadMesh(NULL)
 	, camera(NULL)
-	, animatedSprites(NULL)
 	, cSoundController(NULL)
+	, uiLaughInstance(CVoiceManager::INVALID_INSTANCE)
 	, cInventoryManager(NULL)
+	, cRandom(NULL)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
@@ -65,19 +70,6 @@ CEnemySawCon::CEnemySawCon(void)
  */
 CEnemySawCon::~CEnemySawCon(void)
 {
-	// Delete the quadMesh
-	if (quadMesh)
-	{
-		delete quadMesh;
-		quadMesh = NULL;
-	}
-
-	if (animatedSprites)
-	{
-		delete animatedSprites;
-		animatedSprites = NULL;
-	}
-
 	// We won't delete this since it was created elsewhere
 	cPlayer2D = NULL;
 
@@ -86,20 +78,39 @@ CEnemySawCon::~CEnemySawCon(void)
 
 	camera = NULL;
 
+	// Stop the laugh of this enemy
+	if (cSoundController)
+		cSoundController->DestroySoundInstance(uiLaughInstance);
 	cSoundController = NULL;
 
 	cInventoryManager = NULL;
-
-	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
 }
 
 /**
-  @brief Initialise this instance
+  @brief Initialise this instance at the position of the next enemy marker (303) in the current level
   */
 bool CEnemySawCon::Init(void)
+{
+	// Get the handler to the CMap2D instance
+	cMap2D = CMap2D::GetInstance();
+
+	// Find the indices for the player in arrMapInfo, and assign it to cPlayer2D
+	unsigned int uiRow = -1;
+	unsigned int uiCol = -1;
+	if (cMap2D->FindValue(303, uiRow, uiCol) == false)
+		return false;	// Unable to find the start position of the player, so quit this game
+
+	// Erase the value of the player in the arrMapInfo
+	cMap2D->SetMapInfo(uiRow, uiCol, 2);
+
+	return Init(glm::i32vec2(uiCol, uiRow));
+}
+
+/**
+  @brief Initialise this instance at a position, e.g. from the spawn list of a level prepared by CLevelStreamer
+  @param i32vec2SpawnIndex The indices (column, row) to spawn at
+  */
+bool CEnemySawCon::Init(const glm::i32vec2& i32vec2SpawnIndex)
 {
 	//CSettings instance
 	cSettings = CSettings::GetInstance();
@@ -113,21 +124,14 @@ bool CEnemySawCon::Init(void)
 	cInventoryManager = CInventoryManager::GetInstance();
 
 	cSoundController = CSoundController::GetInstance();
-	// Find the indices for the player in arrMapInfo, and assign it to cPlayer2D
-	unsigned int uiRow = -1;
-	unsigned int uiCol = -1;
-	if (cMap2D->FindValue(303, uiRow, uiCol) == false)
-		return false;	// Unable to find the start position of the player, so quit this game
+	if (uiLaughInstance == CVoiceManager::INVALID_INSTANCE)
+		uiLaughInstance = cSoundController->CreateSoundInstance(SOUND_CREEPY_LAUGH);
 
-	// Erase the value of the player in the arrMapInfo
-	cMap2D->SetMapInfo(uiRow, uiCol, 2);
-	// Set the start position of the Player to iRow and iCol
-	vec2Index = glm::i32vec2(uiCol, uiRow);
-	// By default, microsteps should be zero
-	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
+	// Use the shared random number generator, unless another one was set
+	if (cRandom == NULL)
+		cRandom = CRandom::GetInstance();
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	// The enemies are drawn by CSpriteBatch, so they have no VAO or mesh of their own
 
 	// Load the EnemySawCon texture
 	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/enemy3.png", true);
@@ -136,33 +140,22 @@ bool CEnemySawCon::Init(void)
 		cout << "Unable to load Image/enemy3.png" << endl;
 		return false;
 	}
-	//Down = 0 - 7
-	//idleDown = 8 - 10
-	//idleUp = 12 - 14
-	//Up = 16 - 23
-	//Left = 24 - 31
-	//idleLeft = 32 - 34
-	//Right = 36 - 43
-	//idleRight = 45 - 47
-	animatedSprites = CMeshBuilder::GenerateSpriteAnimation(12, 4,cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-	animatedSprites->AddAnimation("idleRight", 45, 47);
-	animatedSprites->AddAnimation("idleLeft", 32, 34);
-	animatedSprites->AddAnimation("idleDown", 8, 10);
-	animatedSprites->AddAnimation("idleUp", 12, 14);
-	animatedSprites->AddAnimation("down", 0, 7);
-	animatedSprites->AddAnimation("up", 16, 23);
-	animatedSprites->AddAnimation("left", 24, 31);
-	animatedSprites->AddAnimation("right", 36, 43);
-
-	animatedSprites->PlayAnimation("idleLeft", -1, 0.5f);
-
-	//CS: Init the color to white
-	runtimeColour = glm::vec4(0.f, 0.f, 0.f, 1.0);
-
-	// Create the quad mesh for the player
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH,cSettings->TILE_HEIGHT);
+	// Load the frames and animations of the sprite sheet. It is loaded once, and shared by all the enemies
+	const CSpriteSheet* pSpriteSheet = CSpriteSheetManager::GetInstance()->Load("Image/enemy3.sheet");
+	if (pSpriteSheet == NULL)
+	{
+		cout << "Unable to load Image/enemy3.sheet" << endl;
+		return false;
+	}
+	cSpriteAnimator.Init(pSpriteSheet);
+	arrAnimationIDs[ANIM_IDLE_RIGHT] = pSpriteSheet->GetAnimationID("idleRight");
+	arrAnimationIDs[ANIM_IDLE_LEFT] = pSpriteSheet->GetAnimationID("idleLeft");
+	arrAnimationIDs[ANIM_IDLE_DOWN] = pSpriteSheet->GetAnimationID("idleDown");
+	arrAnimationIDs[ANIM_IDLE_UP] = pSpriteSheet->GetAnimationID("idleUp");
+	arrAnimationIDs[ANIM_DOWN] = pSpriteSheet->GetAnimationID("down");
+	arrAnimationIDs[ANIM_UP] = pSpriteSheet->GetAnimationID("up");
+	arrAnimationIDs[ANIM_LEFT] = pSpriteSheet->GetAnimationID("left");
+	arrAnimationIDs[ANIM_RIGHT] = pSpriteSheet->GetAnimationID("right");
 
 	// Generate mesh for enemy vision rays
 	visionTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/enemyFlashlight.png", true);
@@ -174,6 +167,37 @@ bool CEnemySawCon::Init(void)
 
 	// Set the Physics to fall status by default
 	cPhysics2D.Init();
+
+	displaytest = false; //<<<<<<<<<<<<<<<<<,,togle on to display troubleshoot  must togle on to see others
+	pathtest = false;    //<<<<<<<<<<<<<<<<<,,togle on to path troubleshoot
+	statetest = true;   //<<<<<<<<<<<<<<<<<,,togle on to state troubleshoot
+
+	if (!displaytest)//let others know that the enemysawcon couts is dissable if its off
+		cout << "toggled off cout for EnemySawCon.cpp" << endl;
+
+	rays = Rays::GetInstance()->GetRays();
+
+	Spawn(i32vec2SpawnIndex);
+
+	return true;
+}
+
+/**
+  @brief Reset this instance to a position, without loading its textures and sprite sheet again, e.g. when a new level is swapped in
+  @param i32vec2SpawnIndex The indices (column, row) to spawn at
+  */
+void CEnemySawCon::Spawn(const glm::i32vec2& i32vec2SpawnIndex)
+{
+	// Set the start position of the Player to iRow and iCol
+	vec2Index = i32vec2SpawnIndex;
+	// By default, microsteps should be zero
+	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
+
+	cSpriteAnimator.PlayAnimation(arrAnimationIDs[ANIM_IDLE_LEFT], -1, 0.5f);
+
+	//CS: Init the color to white
+	runtimeColour = glm::vec4(0.f, 0.f, 0.f, 1.0);
+
 	cPhysics2D.SetStatus(CPhysics2D::STATUS::IDLE);
 	dir = DIRECTION::LEFT;
 
@@ -188,27 +212,22 @@ bool CEnemySawCon::Init(void)
 	InvestigateCounter = 0;
 	ScaredCounter = 0;
 
-	displaytest = false; //<<<<<<<<<<<<<<<<<,,togle on to display troubleshoot  must togle on to see others
-	pathtest = false;    //<<<<<<<<<<<<<<<<<,,togle on to path troubleshoot
-	statetest = true;   //<<<<<<<<<<<<<<<<<,,togle on to state troubleshoot
-	
-	
-
+	// The counters are incremented once per simulation tick, so convert the durations into ticks
+	const unsigned int uiTickRate = CFixedTimeStep::GetInstance()->GetTickRate();
+	iMaxFSMCounter = (int)(dMaxFSMTime * uiTickRate);
+	MaxAtkCounter = (int)(MaxAtkTime * uiTickRate);
+	MaxScaredCounter = (int)(MaxScaredTime * uiTickRate);
+	MaxInvestigateCounter = (int)(MaxInvestigateTime * uiTickRate);
 
 	//-----------------------change here----------------------------
 	chaseRange = 3.f;//how far enemy can detect u
 	atkrange = .05f;//how close must the enemy be to atk u
 	movementspeed = .9;// speed of enemy
 	increasespeed = 0.2;//increment of speed each time player collected paper
-	
-	
 
-	if (!displaytest)//let others know that the enemysawcon couts is dissable if its off
-		cout << "toggled off cout for EnemySawCon.cpp" << endl;
 	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
 
-	rays = Rays::GetInstance()->GetRays();
 	enemyRay.direction = glm::vec3(-1, 0, 0);
 	enemyRay.length = 50.f;
 
@@ -221,9 +240,92 @@ bool CEnemySawCon::Init(void)
 
 	maxScanRotate = false;
 	scanRotate = -0.5f;
+}
 
-	srand(time(NULL));
-	return true;
+/**
+ @brief Write the position, FSM and timers of this enemy to a snapshot
+ @param cSnapshot The snapshot to write to
+ */
+void CEnemySawCon::WriteSnapshot(CSnapshotBuffer& cSnapshot) const
+{
+	cSnapshot.Write(bIsActive);
+	cSnapshot.Write(vec2Index);
+	cSnapshot.Write(i32vec2NumMicroSteps);
+	cSnapshot.Write(vec2UVCoordinate);
+	cSnapshot.Write(i32vec2OldIndex);
+	cSnapshot.Write(i32vec2Destination);
+	cSnapshot.Write(i32vec2Direction);
+	cSnapshot.Write(spotDestination);
+	cSnapshot.Write(spotDirection);
+	cSnapshot.Write(runtimeColour);
+	cSnapshot.Write(cPhysics2D.GetStatus());
+	cSnapshot.Write(dir);
+
+	cSnapshot.Write(sCurrentFSM);
+	cSnapshot.Write(iFSMCounter);
+	cSnapshot.Write(AtkCounter);
+	cSnapshot.Write(ScaredCounter);
+	cSnapshot.Write(InvestigateCounter);
+	cSnapshot.Write(movementspeed);
+	cSnapshot.Write(health);
+	cSnapshot.Write(armour);
+	cSnapshot.Write(iframeElapsed);
+	cSnapshot.Write(lastAttackElapsed);
+
+	cSnapshot.Write(playerInteractWithBox);
+	cSnapshot.Write(shun);
+	cSnapshot.Write(sawPlayer);
+	cSnapshot.Write(enemyRay);
+	cSnapshot.Write(maxScanRotate);
+	cSnapshot.Write(scanRotate);
+}
+
+/**
+ @brief Read the position, FSM and timers of this enemy from a snapshot.
+		The enemy must have been initialised, as the textures and sprites are not in the snapshot
+ @param cSnapshot The snapshot to read from
+ @return false if the snapshot ended too early
+ */
+bool CEnemySawCon::ReadSnapshot(CSnapshotBuffer& cSnapshot)
+{
+	CPhysics2D::STATUS sStatus = CPhysics2D::STATUS::IDLE;
+
+	cSnapshot.Read(bIsActive);
+	cSnapshot.Read(vec2Index);
+	cSnapshot.Read(i32vec2NumMicroSteps);
+	cSnapshot.Read(vec2UVCoordinate);
+	cSnapshot.Read(i32vec2OldIndex);
+	cSnapshot.Read(i32vec2Destination);
+	cSnapshot.Read(i32vec2Direction);
+	cSnapshot.Read(spotDestination);
+	cSnapshot.Read(spotDirection);
+	cSnapshot.Read(runtimeColour);
+	cSnapshot.Read(sStatus);
+	cSnapshot.Read(dir);
+
+	cSnapshot.Read(sCurrentFSM);
+	cSnapshot.Read(iFSMCounter);
+	cSnapshot.Read(AtkCounter);
+	cSnapshot.Read(ScaredCounter);
+	cSnapshot.Read(InvestigateCounter);
+	cSnapshot.Read(movementspeed);
+	cSnapshot.Read(health);
+	cSnapshot.Read(armour);
+	cSnapshot.Read(iframeElapsed);
+	cSnapshot.Read(lastAttackElapsed);
+
+	cSnapshot.Read(playerInteractWithBox);
+	cSnapshot.Read(shun);
+	cSnapshot.Read(sawPlayer);
+	cSnapshot.Read(enemyRay);
+	cSnapshot.Read(maxScanRotate);
+	cSnapshot.Read(scanRotate);
+
+	cPhysics2D.SetStatus(sStatus);
+	// Do not blend the restored position with the position before the load
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
+	return (cSnapshot.HasReadError() == false);
 }
 
 /**
@@ -248,42 +350,28 @@ void CEnemySawCon::Update(const double dElapsedTime)
 	rays = Rays::GetInstance()->GetRays();
 
 	//change volume based on distance of enemy to player
+	float fLaughVolume = 0.5f;
 	if (cPlayer2D->vec2Index.y >= vec2Index.y && cPlayer2D->vec2Index.y <= vec2Index.y + 3 ||
 		cPlayer2D->vec2Index.y <= vec2Index.y && cPlayer2D->vec2Index.y >= vec2Index.y - 3)
 	{
 		if (cPlayer2D->vec2Index.x >= vec2Index.x - 3 && cPlayer2D->vec2Index.x < vec2Index.x)
-			cSoundController->SetVolume(26, 1);
+			fLaughVolume = 1.0f;
 		//Player is to the right of the enemy
 		else if (cPlayer2D->vec2Index.x > vec2Index.x && cPlayer2D->vec2Index.x <= vec2Index.x + 3)
-			cSoundController->SetVolume(26, 1);
+			fLaughVolume = 1.0f;
 		else 
-			cSoundController->SetVolume(26, 0.75);
+			fLaughVolume = 0.75f;
 	}
-	else
-		//Sound is very soft as 
-		cSoundController->SetVolume(26, 0.5);
-
-	//If enemy is below or above player
-	if (cPlayer2D->vec2Index.x == vec2Index.x)
-		cSoundController->SetSoundType(26, 2);
-	else
-		cSoundController->SetSoundType(26, 3);
 
-	//Update sound position based on enemy position
-	if (cSoundController->GetSoundType(26) == 3)
-	{
-		cSoundController->SetSoundPosition(vec2Index.x, vec2Index.y, 0, 26);
-
-		//Set player as the listener position
-		cSoundController->SetListenerPosition(cPlayer2D->vec2Index.x, cPlayer2D->vec2Index.y, 0);
-	}
-	cSoundController->PlaySoundByID(26);
+	//Play the laugh of this enemy at its position. The player is the listener, and a laugh which is
+	//directly above or below the player is not panned. Only the nearest laughs are mixed
+	cSoundController->PlaySoundInstance(uiLaughInstance, vec2Index.x, vec2Index.y, 0, fLaughVolume);
 	
 
 	
 	if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < chaseRange)
 	{
-		cSoundController->PlaySoundByID(15);
+		cSoundController->PlaySoundByID(SOUND_PLAYER_FOUND);
 		sawPlayer = true;
 	}
 	else
@@ -372,7 +460,7 @@ void CEnemySawCon::Update(const double dElapsedTime)
 			if (cInvenytoryItem->GetCount() >= 0)
 			{
 				cInvenytoryItem->Remove(1);
-				cSoundController->PlaySoundByID(27);
+				cSoundController->PlaySoundByID(SOUND_JUMPSCARE);
 				CGameManager::GetInstance()->bPLayerJumpscared = true;
 			}
 			else
@@ -622,7 +710,7 @@ void CEnemySawCon::Update(const double dElapsedTime)
 	}
 
 	// Update the animated sprite
-	animatedSprites->Update(dElapsedTime);
+	cSpriteAnimator.Update(dElapsedTime);
 
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
@@ -634,9 +722,9 @@ void CEnemySawCon::Update(const double dElapsedTime)
 		// Update ray's direction based on the direction the enemy is facing currently
 		// Scan left to right as well
 		if (maxScanRotate)
-			scanRotate -= 0.01;
+			scanRotate -= scanRotateSpeed * dElapsedTime;
 		else
-			scanRotate += 0.01;
+			scanRotate += scanRotateSpeed * dElapsedTime;
 
 		if (scanRotate >= 0.5)
 			maxScanRotate = true;
@@ -681,7 +769,7 @@ void CEnemySawCon::Update(const double dElapsedTime)
 			if (intersectionDist <= 0.05 && intersectionDist <= enemyRay.length)
 			{
 				sawPlayer = true;
-				cSoundController->PlaySoundByID(15);
+				cSoundController->PlaySoundByID(SOUND_PLAYER_FOUND);
 			}
 			else
 				sawPlayer = false;
@@ -698,18 +786,7 @@ void CEnemySawCon::Update(const double dElapsedTime)
  */
 void CEnemySawCon::PreRender(void)
 {
-	if (!bIsActive)
-		return;
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	// The sprite batch sets the blending mode and shader when it is flushed
 }
 
 /**
@@ -720,25 +797,14 @@ void CEnemySawCon::Render(void)
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
 	glm::mat4 MVP = camera->GetMVP();
 	glm::mat4 transformMVP;
-	//transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	//transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-	//												vec2UVCoordinate.y,
-	//												0.0f));
-	// 
+	// Render between the last two simulation ticks
+	glm::vec2 vec2RenderUVCoordinate = GetInterpolatedUVCoordinate();
 	transformMVP = MVP; // make sure to initialize matrix to identity matrix first
-	transformMVP = glm::translate(transformMVP, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
+	transformMVP = glm::translate(transformMVP, glm::vec3(vec2RenderUVCoordinate.x,
+		vec2RenderUVCoordinate.y,
 		0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transformMVP));
 
 	if (vec2Index.y <= cPlayer2D->vec2Index.y + 10 && vec2Index.y >= cPlayer2D->vec2Index.y - 10 &&
 		vec2Index.x <= cPlayer2D->vec2Index.x + 10 && vec2Index.x >= cPlayer2D->vec2Index.x - 10 &&
@@ -767,7 +833,7 @@ void CEnemySawCon::Render(void)
 			// Stun da enemy
 			if (intersectionDist <= 0.03)
 			{
-				cSoundController->PlaySoundByID(25);
+				cSoundController->PlaySoundByID(SOUND_ENEMY_STUN);
 				shun = true;
 			}
 		}
@@ -776,36 +842,30 @@ void CEnemySawCon::Render(void)
 	{
 		runtimeColour = glm::vec4(0.f, 0.f, 0.f, 0.f);
 	}
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
 
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-	//CS: Render the animated sprite
-	glBindVertexArray(VAO);
-	animatedSprites->Render();
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	//CS: Add the current frame of the animated sprite to the sprite batch. It is skipped if it is not visible.
+	// The graphics card works out the texture coordinates of the frame, so all the enemies are drawn together
+	const CSpriteSheet* pSpriteSheet = cSpriteAnimator.GetSpriteSheet();
+	CSpriteBatch::GetInstance()->DrawFrame(SPRITE_LAYER_ENTITIES,
+										   iTextureID,
+										   transformMVP,
+										   glm::vec2(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT),
+										   cSpriteAnimator.GetCurrentFrame(),
+										   pSpriteSheet->GetNumRows(),
+										   pSpriteSheet->GetNumCols(),
+										   runtimeColour);
 
 	// Render the enemy vision if not scared and enemy is visible
 	if (sCurrentFSM != SCARED &&
 		runtimeColour.x > 0.f)
 	{
-		glBindVertexArray(VAO);
-		glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
 		for (int i = 0; i < (sizeof(enemyRenderRays) / sizeof(enemyRenderRays[0])); i++)
 		{
-			quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), 0.0025f, enemyRenderRays[i].length);
-
-			glm::mat4 MVP = camera->GetMVP();
 			glm::mat4 transformMVP;
 			transformMVP = MVP; // make sure to initialize matrix to identity matrix first
 
-			float xTranslate = vec2UVCoordinate.x;
-			float yTranslate = vec2UVCoordinate.y;
+			float xTranslate = vec2RenderUVCoordinate.x;
+			float yTranslate = vec2RenderUVCoordinate.y;
 
 			float dy = enemyRay.direction.y;
 			float dx = enemyRay.direction.x;
@@ -837,23 +897,18 @@ void CEnemySawCon::Render(void)
 				break;
 			}
 
-			// Update the shaders with the latest transform
 			transformMVP = glm::translate(transformMVP, glm::vec3(xTranslate,
 				yTranslate,
 				0.0f));
 			transformMVP = glm::rotate(transformMVP, overallRotate, glm::vec3(0, 0, 1));
-			glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transformMVP));
-			glUniform4fv(colorLoc, 1, glm::value_ptr(glm::vec4(1.f, 0.f, 0.f, 1.f)));
-
-			// bind textures on corresponding texture units
-			glActiveTexture(GL_TEXTURE0);
-			// Get the texture to be rendered
-			glBindTexture(GL_TEXTURE_2D, visionTextureID);
-
-			glBindVertexArray(VAO);
-			quadMesh->Render();
-			glBindVertexArray(0);
-			glBindTexture(GL_TEXTURE_2D, 0);
+
+			// Add the vision ray to the sprite batch, instead of building a new quad mesh for it
+			CSpriteBatch::GetInstance()->Draw(SPRITE_LAYER_EFFECTS,
+											  visionTextureID,
+											  transformMVP,
+											  glm::vec2(0.0025f, enemyRenderRays[i].length),
+											  glm::vec4(0.f, 0.f, 1.f, 1.f),
+											  glm::vec4(1.f, 0.f, 0.f, 1.f));
 		}
 	}
 
@@ -867,11 +922,6 @@ void CEnemySawCon::Render(void)
  */
 void CEnemySawCon::PostRender(void)
 {
-	if (!bIsActive)
-		return;
-
-	// Disable blending
-	glDisable(GL_BLEND);
 }
 
 /**
@@ -908,6 +958,15 @@ void CEnemySawCon::SetPlayer2D(CPlayer2D* cPlayer2D)
 	UpdateDirection();
 }
 
+/**
+ @brief Set the random number generator used by this class instance, e.g. to give it a separate seeded stream
+ @param cRandom A CRandom* variable which is the handle to the random number generator
+ */
+void CEnemySawCon::SetRandom(CRandom* cRandom)
+{
+	this->cRandom = cRandom;
+}
+
 
 /**
  @brief Constraint the EnemySawCon's position within a boundary
@@ -1097,7 +1156,7 @@ bool CEnemySawCon::InteractWithPlayer(void)
 				(vec2Index.y <= i32vec2PlayerPos.y + 1.5))) 
 		{
 			armour -= 10;
-			cSoundController->PlaySoundByID(19);
+			cSoundController->PlaySoundByID(SOUND_ENEMY_ATTACK);
 			iframeElapsed = 0;
 		}
 
@@ -1116,7 +1175,7 @@ bool CEnemySawCon::InteractWithPlayer(void)
 			{
 				health -= 5;
 				cInventoryManager->GetItem("Soul")->Add(10);
-				cSoundController->PlaySoundByID(21);
+				cSoundController->PlaySoundByID(SOUND_ENEMY_HURT);
 				iframeElapsed = 0;
 			}
 		}
@@ -1210,7 +1269,7 @@ void CEnemySawCon::UpdatePosition(void)
 	//left
 	if (i32vec2Direction.x < 0)
 	{
-		animatedSprites->PlayAnimation("left", -1, 0.5f);
+		cSpriteAnimator.PlayAnimation(arrAnimationIDs[ANIM_LEFT], -1, 0.5f);
 		dir = DIRECTION::LEFT;
 		// Move left
 		const int iOldIndex = vec2Index.x;
@@ -1243,7 +1302,7 @@ void CEnemySawCon::UpdatePosition(void)
 	//right
 	else if (i32vec2Direction.x > 0)
 	{
-		animatedSprites->PlayAnimation("right", -1, 0.5f);
+		cSpriteAnimator.PlayAnimation(arrAnimationIDs[ANIM_RIGHT], -1, 0.5f);
 		dir = DIRECTION::RIGHT;
 		// Move right
 		const int iOldIndex = vec2Index.x;
@@ -1277,7 +1336,7 @@ void CEnemySawCon::UpdatePosition(void)
 	// up
 	else if (i32vec2Direction.y > 0)
 	{
-		animatedSprites->PlayAnimation("up", -1, 0.5f);
+		cSpriteAnimator.PlayAnimation(arrAnimationIDs[ANIM_UP], -1, 0.5f);
 		//dir equal to up
 		dir = DIRECTION::UP;
 		//move upward
@@ -1307,7 +1366,7 @@ void CEnemySawCon::UpdatePosition(void)
 	//down
 	else if (i32vec2Direction.y < 0)
 	{
-	animatedSprites->PlayAnimation("down", -1, 0.5f);
+	cSpriteAnimator.PlayAnimation(arrAnimationIDs[ANIM_DOWN], -1, 0.5f);
 		//dir equal to down
 		dir = DIRECTION::DOWN;
 		// Move down
@@ -1357,7 +1416,7 @@ void CEnemySawCon::UpdatePositionPatrol(void)
 	//left
 	if (i32vec2Direction.x < 0)
 	{
-		animatedSprites->PlayAnimation("left", -1, 0.5f);
+		cSpriteAnimator.PlayAnimation(arrAnimationIDs[ANIM_LEFT], -1, 0.5f);
 		dir = DIRECTION::LEFT;
 		// Move left
 		const int iOldIndex = vec2Index.x;
@@ -1391,7 +1450,7 @@ void CEnemySawCon::UpdatePositionPatrol(void)
 	//right
 	else if (i32vec2Direction.x > 0)
 	{
-		animatedSprites->PlayAnimation("right", -1, 0.5f);
+		cSpriteAnimator.PlayAnimation(arrAnimationIDs[ANIM_RIGHT], -1, 0.5f);
 		dir = DIRECTION::RIGHT;
 		// Move right
 		const int iOldIndex = vec2Index.x;
@@ -1428,7 +1487,7 @@ void CEnemySawCon::UpdatePositionPatrol(void)
 	// up
 	else if (i32vec2Direction.y > 0)
 	{
-		animatedSprites->PlayAnimation("up", -1, 0.5f);
+		cSpriteAnimator.PlayAnimation(arrAnimationIDs[ANIM_UP], -1, 0.5f);
 		//dir equal to up
 		dir = DIRECTION::UP;
 		//move upward
@@ -1460,7 +1519,7 @@ void CEnemySawCon::UpdatePositionPatrol(void)
 	//down
 	else if (i32vec2Direction.y < 0)
 	{
-		animatedSprites->PlayAnimation("down", -1, 0.5f);
+		cSpriteAnimator.PlayAnimation(arrAnimationIDs[ANIM_DOWN], -1, 0.5f);
 		//dir equal to down
 		dir = DIRECTION::DOWN;
 		// Move down
@@ -1494,7 +1553,7 @@ void CEnemySawCon::RandDirection(void)
 {
 	int tempdir = 999;
 
-	tempdir = rand() % 4;
+	tempdir = cRandom->Range(0, 3);
 	if(pathtest)
 		cout << "tempdir" << tempdir << endl;
 	switch (tempdir)
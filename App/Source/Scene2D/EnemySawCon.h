@@ -19,6 +19,8 @@
 
 // Include the Map2D as we will use it to check the player's movements and actions
 class CMap2D;
+// Include CSnapshotBuffer for the save games
+class CSnapshotBuffer;
 
 // Include Settings
 #include "GameControl\Settings.h"
@@ -29,8 +31,9 @@ class CMap2D;
 // Include Player2D
 #include "Player2D.h"
 
-// Include AnimatedSprites
-#include "Primitives/SpriteAnimation.h"
+// Include CSpriteAnimator and CSpriteSheetManager to play the shared sprite sheet
+#include "Primitives/SpriteAnimator.h"
+#include "Primitives/SpriteSheetManager.h"
 
 #include "Camera.h"
 
@@ -40,6 +43,9 @@ class CMap2D;
 
 #include "Rays.h"
 
+// Include CRandom to make the random movement repeatable
+#include "System\Random.h"
+
 struct EnemyRay {
 	glm::vec3 direction;
 	float length;
@@ -59,8 +65,18 @@ public:
 	// Destructor
 	virtual ~CEnemySawCon(void);
 
-	// Init
+	// Init at the next enemy marker in the current level
 	bool Init(void);
+	// Init at a position
+	bool Init(const glm::i32vec2& i32vec2SpawnIndex);
+
+	// Reset to a position, without loading the textures and sprite sheet again
+	void Spawn(const glm::i32vec2& i32vec2SpawnIndex);
+
+	// Write the position, FSM and timers of this enemy to a snapshot
+	void WriteSnapshot(CSnapshotBuffer& cSnapshot) const;
+	// Read the position, FSM and timers of this enemy from a snapshot
+	bool ReadSnapshot(CSnapshotBuffer& cSnapshot);
 
 	// Update
 	void Update(const double dElapsedTime);
@@ -95,6 +111,9 @@ public:
 	// Set the handle to cPlayer to this class instance
 	void SetPlayer2D(CPlayer2D* cPlayer2D);
 
+	// Set the random number generator used by this class instance
+	void SetRandom(CRandom* cRandom);
+
 	// boolean flag to indicate if this enemy is active
 	bool bIsActive;
 
@@ -108,6 +127,20 @@ protected:
 		NUM_DIRECTIONS
 	};
 
+	// The animations of the sprite
+	enum ANIMATION
+	{
+		ANIM_RIGHT = 0,
+		ANIM_LEFT,
+		ANIM_UP,
+		ANIM_DOWN,
+		ANIM_IDLE_RIGHT,
+		ANIM_IDLE_LEFT,
+		ANIM_IDLE_DOWN,
+		ANIM_IDLE_UP,
+		NUM_ANIMATIONS
+	};
+
 	enum FSM
 	{
 		IDLE = 0,
@@ -121,9 +154,6 @@ protected:
 
 	glm::vec2 i32vec2OldIndex;
 
-	//CS: The quadMesh for drawing the tiles
-	CMesh* quadMesh;
-
 	// Handler to the CMap2D instance
 	CMap2D* cMap2D;
 
@@ -137,9 +167,6 @@ protected:
 	// A tile's width or height is in multiples of these microsteps
 	glm::vec2 i32vec2NumMicroSteps;
 
-	// The vec2 variable which stores the UV coordinates to render the EnemyFalseKnight
-	glm::vec2 vec2UVCoordinate;
-
 	// The vec2 which stores the indices of the destination for EnemySawCon in the Map2D
 	glm::vec2 i32vec2Destination;
 	// The vec2 which stores the direction for EnemySawCon movement in the Map2D
@@ -164,9 +191,16 @@ protected:
 	CPlayer2D* cPlayer2D;
 	
 	CSoundController* cSoundController;
+	// The instance of the laugh of this enemy, which is played and moved on its own
+	unsigned int uiLaughInstance;
+
+	// Handle to the random number generator
+	CRandom* cRandom;
 
-	//CS: Animated Sprite
-	CSpriteAnimation* animatedSprites;
+	// The playback of the animations in the sprite sheet, which all the enemies share
+	CSpriteAnimator cSpriteAnimator;
+	// The indices of the animations in the sprite sheet, so they are played without looking up their names
+	int arrAnimationIDs[NUM_ANIMATIONS];
 
 	Ray* rays;
 
@@ -175,15 +209,19 @@ protected:
 	unsigned int visionTextureID;
 	bool maxScanRotate;
 	float scanRotate;
+	// How fast the vision scans from side to side, per second
+	const float scanRotateSpeed = 0.3f;
 
 	// Current FSM
 	FSM sCurrentFSM;
 
-	// FSM counter - count how many frames it has been in this FSM
+	// FSM counter - count how many simulation ticks it has been in this FSM
 	int iFSMCounter;
 
-	// Max count in a state
-	const int iMaxFSMCounter = 60;
+	// Max count in a state, converted from dMaxFSMTime using the tick rate
+	int iMaxFSMCounter;
+	// Max time in a state in seconds
+	const double dMaxFSMTime = 2.0;
 
 	// Health for player attack
 	int health;
@@ -225,12 +263,15 @@ protected:
 	double movementspeed;//change via the microsteps 
 	double increasespeed;//the more collectable, the more faster enemy gets
 
-	int AtkCounter; // atk counter - count how many frames it has been in this FSM
-	const int MaxAtkCounter = 150;// Max count in a state
-	int ScaredCounter; // atk counter - count how many frames it has been in this FSM
-	const int MaxScaredCounter = 60;// Max count in a state
-	int InvestigateCounter; // investigate counter - count how many frames it has been in this FSM
-	const int MaxInvestigateCounter = 240;// Max count in a state
+	int AtkCounter; // atk counter - count how many ticks it has been in this FSM
+	int MaxAtkCounter;// Max count in a state
+	const double MaxAtkTime = 5.0;// Max time in a state in seconds
+	int ScaredCounter; // atk counter - count how many ticks it has been in this FSM
+	int MaxScaredCounter;// Max count in a state
+	const double MaxScaredTime = 2.0;// Max time in a state in seconds
+	int InvestigateCounter; // investigate counter - count how many ticks it has been in this FSM
+	int MaxInvestigateCounter;// Max count in a state
+	const double MaxInvestigateTime = 8.0;// Max time in a state in seconds
 
 	bool playerInteractWithBox;//interact with box
 
@@ -5,6 +5,9 @@
 
 #include "Player2D.h"
 
+// Include CCollisionManager for the ray-box test
+#include "Primitives/CollisionManager.h"
+
 Flashlight::Flashlight()
 	: camera(NULL)
 	, cSettings(NULL)
@@ -146,118 +149,11 @@ glm::vec3 Flashlight::toWorldCoords(glm::vec4 eyeCoords, glm::mat4 viewMatrix)
 	return mouseRay;
 }
 
+/**
+ @brief Test if a ray intersects an oriented box in the x-y plane
+ @return true if the ray intersects the box, and intersection_distance is set to the distance along the ray
+ */
 bool Flashlight::TestRayOBBIntersection(glm::vec3 ray_origin, glm::vec3 ray_direction, glm::vec3 aabb_min, glm::vec3 aabb_max, glm::mat4 ModelMatrix, float& intersection_distance)
 {
-	float tMin = 0.f;
-	float tMax = 100000.f;
-
-	glm::vec3 OBBposition_worldspace(ModelMatrix[3][0], ModelMatrix[3][1], ModelMatrix[3][2]);
-	glm::vec3 delta = OBBposition_worldspace - ray_origin;
-
-
-	//Test intersection with the 2 perpendicular planes to the OBB's X axis
-	{
-		glm::vec3 xaxis(ModelMatrix[0][0], ModelMatrix[0][1], ModelMatrix[0][2]);
-		float e = glm::dot(xaxis, delta);
-		float f = glm::dot(ray_direction, xaxis);
-
-
-		if (fabs(f) > 0.001f) //standard case
-		{
-			float t1 = (e + aabb_min.x) / f; //Intersect with 'left' plane
-			float t2 = (e + aabb_max.x) / f; //Intersection with the 'right' plane
-			//t1 and t2 now contain dist btw ray origin & ray plane intersections
-
-			//t1 should be nearest intersection,
-			//so if it's not the case, swap t1 and t2
-			if (t1 > t2)
-			{
-				float w = t1;
-				t1 = t2;
-				t2 = w;
-			}
-
-			//tMax is the nearest 'far' intersection (amongst X/Y/Z planes pairs)
-			if (t2 < tMax)
-				tMax = t2;
-			//tMin is the farthest 'near' intersection (amongst X/Y/Z planes pairs)
-			if (t1 > tMin)
-				tMin = t1;
-
-			//If 'far' is closer than 'near', then NO intersection
-			if (tMax < tMin)
-				return false;
-		}
-		else { //Rare case: ray is almost parallel to the planes, so don't have any intersections
-			if (-e + aabb_min.x > 0.0f || -e + aabb_max.x < 0.0f)
-				return false;
-		}
-	}
-
-	//Repeat the above method for Y axes
-	{
-		glm::vec3 yaxis(ModelMatrix[1][0], ModelMatrix[1][1], ModelMatrix[1][2]);
-		float e = glm::dot(yaxis, delta);
-		float f = glm::dot(ray_direction, yaxis);
-
-		if (fabs(f) > 0.001f) //standard case
-		{
-			float t1 = (e + aabb_min.y) / f;
-			float t2 = (e + aabb_max.y) / f;
-
-			if (t1 > t2)
-			{
-				float w = t1;
-				t1 = t2;
-				t2 = w;
-			}
-
-			if (t2 < tMax)
-				tMax = t2;
-
-			if (t1 > tMin)
-				tMin = t1;
-
-			if (tMax < tMin)
-				return false;
-		}
-		else { //Rare case: ray is almost parallel to the planes, so don't have any intersections
-			if (-e + aabb_min.y > 0.0f || -e + aabb_max.y < 0.0f)
-				return false;
-		}
-	}
-
-	//{
-	//	glm::vec3 zaxis(ModelMatrix[2][0], ModelMatrix[2][1], ModelMatrix[2][2]);
-	//	float e = glm::dot(zaxis, delta);
-	//	float f = glm::dot(ray_direction, zaxis);
-
-	//	if (fabs(f) > 0.001f) //standard case
-	//	{
-	//		float t1 = (e + aabb_min.z) / f;
-	//		float t2 = (e + aabb_max.z) / f;
-
-	//		if (t1 > t2)
-	//		{
-	//			float w = t1;
-	//			t1 = t2;
-	//			t2 = w;
-	//		}
-
-	//		if (t2 < tMax)
-	//			tMax = t2;
-
-	//		if (t1 > tMin)
-	//			tMin = t1;
-
-	//		if (tMax < tMin)
-	//			return false;
-	//	}
-	//	else { //Rare case: ray is almost parallel to the planes, so don't have any intersections
-	//		if (-e + aabb_min.z > 0.0f || -e + aabb_max.z < 0.0f)
-	//			return false;
-	//	}
-	//}
-	intersection_distance = tMin;
-	return true;
+	return CCollisionManager::RayOBBCollision(ray_origin, ray_direction, aabb_min, aabb_max, ModelMatrix, intersection_distance);
 }
@@ -10,6 +10,9 @@
 
 using namespace std;
 
+// Refresh the frame statistics twice a second
+const double CGUI_Scene2D::STATS_REFRESH_TIME = 0.5;
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -19,6 +22,10 @@ CGUI_Scene2D::CGUI_Scene2D(void)
 	, m_fProgressBar(0.0f)
 	, cInventoryManager(NULL)
 	, cInventoryItem(NULL)
+	, bShowProfiler(false)
+	, cRetainedHUD(NULL)
+	, dStatsElapsedTime(0.0)
+	, iStatsRefreshes(0)
 {
 }
 
@@ -37,11 +44,11 @@ CGUI_Scene2D::~CGUI_Scene2D(void)
 		cPlayer2D->Destroy();
 		cPlayer2D = NULL;
 	}
-	// Cleanup
-	ImGui_ImplOpenGL3_Shutdown();
-	ImGui_ImplGlfw_Shutdown();
-	ImGui::DestroyContext();
-
+	if (cRetainedHUD)
+	{
+		delete cRetainedHUD;
+		cRetainedHUD = NULL;
+	}
 	// We won't delete this since it was created elsewhere
 	cSettings = NULL;
 }
@@ -56,21 +63,10 @@ bool CGUI_Scene2D::Init(void)
 
 	// Store the CFPSCounter singleton instance here
 	cFPSCounter = CFPSCounter::GetInstance();
+	// Store the CFramePacer singleton instance here
+	cFramePacer = CFramePacer::GetInstance();
 
 	cPlayer2D = CPlayer2D::GetInstance();
-	// Setup Dear ImGui context
-	IMGUI_CHECKVERSION();
-	ImGui::CreateContext();
-	ImGuiIO& io = ImGui::GetIO(); (void)io;
-
-	// Setup Dear ImGui style
-	ImGui::StyleColorsDark();
-	//ImGui::StyleColorsClassic();
-
-	// Setup Platform/Renderer bindings
-	ImGui_ImplGlfw_InitForOpenGL(CSettings::GetInstance()->pWindow, true);
-	const char* glsl_version = "#version 330";
-	ImGui_ImplOpenGL3_Init(glsl_version);
 
 	// Define the window flags
 	window_flags = 0;
@@ -96,11 +92,24 @@ bool CGUI_Scene2D::Init(void)
 
 	m_fProgressBar = 0.0f;
 
+	// Initialise the retained HUD, which caches the geometry of the HUD widgets
+	if (cRetainedHUD == NULL)
+		cRetainedHUD = new CRetainedHUD();
+	if (cRetainedHUD->Init("Shader2D_HUD", NUM_HUD_WIDGETS) == false)
+	{
+		cout << "CGUI_Scene2D::Init - Unable to initialise the retained HUD" << endl;
+		return false;
+	}
+	dStatsElapsedTime = 0.0;
+	iStatsRefreshes = 0;
+
 	return true;
 }
 
 /**
- @brief Update this instance
+ @brief Update this instance.
+		The state of each HUD widget is checked first, and only the widgets whose state changed are rebuilt with IMGUI.
+		If nothing changed, IMGUI is not run at all and Render draws the cached HUD
  */
 void CGUI_Scene2D::Update(const double dElapsedTime)
 {
@@ -108,19 +117,110 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	const float relativeScale_x = cSettings->iWindowWidth / 1366.0f;
 	const float relativeScale_y = cSettings->iWindowHeight / 768.0f;
 
-	// Start the Dear ImGui frame
-	ImGui_ImplOpenGL3_NewFrame();
-	ImGui_ImplGlfw_NewFrame();
-	ImGui::NewFrame();
+	// Refresh the frame statistics at a fixed interval, as they change every frame
+	dStatsElapsedTime += dElapsedTime;
+	if (dStatsElapsedTime >= STATS_REFRESH_TIME)
+	{
+		dStatsElapsedTime = 0.0;
+		iStatsRefreshes++;
+	}
 
-	// Create an invisible window which covers the entire OpenGL window
-	ImGui::Begin("Invisible window", NULL, window_flags);
-	ImGui::SetWindowPos(ImVec2(0.0f, 0.0f));
-	ImGui::SetWindowSize(ImVec2((float)cSettings->iWindowWidth, (float)cSettings->iWindowHeight));
-	ImGui::SetWindowFontScale(1.5f * relativeScale_y);
+	// Find the item which the radar tracks
+	CInventoryItem* cRadarItem = NULL;
+	if (cPlayer2D->getitemTracked() == 0)
+		cRadarItem = cInventoryManager->GetItem("Paper");
+	else if (cPlayer2D->getitemTracked() == 1)
+		cRadarItem = cInventoryManager->GetItem("Battery");
+	else
+		cRadarItem = cInventoryManager->GetItem("Door");
+	const bool bAllCollected = (cPlayer2D->getClosestCollectible() == 0) &&
+								(cRadarItem != cInventoryManager->GetItem("Door"));
+
+	// Set the state of the widgets, so that only the widgets which display something new are rebuilt
+	cRetainedHUD->SetScreenSize(cSettings->iWindowWidth, cSettings->iWindowHeight);
+	cRetainedHUD->SetWidgetState(HUD_WIDGET_STATS,
+		CRetainedHUD::WidgetState(cFPSCounter->GetFrameRate(), iStatsRefreshes));
+	cRetainedHUD->SetWidgetState(HUD_WIDGET_LIVES, CRetainedHUD::WidgetState());
+	cRetainedHUD->SetWidgetState(HUD_WIDGET_HEALTH,
+		CRetainedHUD::WidgetState(cInventoryManager->GetItem("Health")->GetCount()));
+	cRetainedHUD->SetWidgetState(HUD_WIDGET_PAPER,
+		CRetainedHUD::WidgetState(cInventoryManager->GetItem("Paper")->GetCount(),
+			cInventoryManager->GetItem("Paper")->GetMaxCount()));
+	cRetainedHUD->SetWidgetState(HUD_WIDGET_FLASHLIGHT,
+		CRetainedHUD::WidgetState(cInventoryManager->GetItem("Flashlight")->GetCount(),
+			cInventoryManager->GetItem("Flashlight")->GetMaxCount()));
+	cRetainedHUD->SetWidgetState(HUD_WIDGET_CYCLE, CRetainedHUD::WidgetState());
+	cRetainedHUD->SetWidgetState(HUD_WIDGET_RADAR,
+		CRetainedHUD::WidgetState(cPlayer2D->getitemTracked(), cPlayer2D->getClosestCollectible()));
+	if (bAllCollected)
+		cRetainedHUD->SetWidgetState(HUD_WIDGET_COLLECTED, CRetainedHUD::WidgetState());
+	else
+		cRetainedHUD->ClearWidget(HUD_WIDGET_COLLECTED);
 
-	// Display the FPS
-	ImGui::TextColored(ImVec4(1, 1, 0, 1), "FPS: %d", cFPSCounter->GetFrameRate());
+	// Toggle the profiler's flame view, and export the recorded profile zones as a Chrome trace
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_F9))
+		bShowProfiler = !bShowProfiler;
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_F10))
+		CProfiler::GetInstance()->ExportChromeTrace("ProfileTrace.json");
+
+	// Skip IMGUI if no widget changed, and no other IMGUI window is shown
+	if ((cRetainedHUD->IsRebuildNeeded() == false) && (bShowProfiler == false))
+		return;
+
+	// Start the shared UI frame
+	CUIRuntime::GetInstance()->BeginFrame();
+
+	// The flags of the widgets' windows
+	ImGuiWindowFlags widgetWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
+		ImGuiWindowFlags_NoBackground |
+		ImGuiWindowFlags_NoTitleBar |
+		ImGuiWindowFlags_NoMove |
+		ImGuiWindowFlags_NoResize |
+		ImGuiWindowFlags_NoCollapse |
+		ImGuiWindowFlags_NoScrollbar;
+
+	if (cRetainedHUD->IsRebuildNeeded(HUD_WIDGET_STATS))
+	{
+		// Create an invisible window which covers the entire OpenGL window
+		ImGui::Begin("Invisible window", NULL, window_flags);
+		ImGui::SetWindowPos(ImVec2(0.0f, 0.0f));
+		ImGui::SetWindowSize(ImVec2((float)cSettings->iWindowWidth, (float)cSettings->iWindowHeight));
+		ImGui::SetWindowFontScale(1.5f * relativeScale_y);
+
+		// Display the FPS
+		ImGui::TextColored(ImVec4(1, 1, 0, 1), "FPS: %d", cFPSCounter->GetFrameRate());
+		// Display the achieved versus target frame time
+		ImGui::TextColored(ImVec4(1, 1, 0, 1), "Frame: %.2f/%.2fms (+/-%.2f) Missed: %u",
+			cFramePacer->GetAverageFrameTime() * 1000.0,
+			cFramePacer->GetTargetFrameTime() * 1000.0,
+			cFramePacer->GetFrameTimeDeviation() * 1000.0,
+			cFramePacer->GetMissedDeadlines());
+		// Display the sprites drawn by the sprite batch, and the draw calls it needed
+		ImGui::TextColored(ImVec4(1, 1, 0, 1), "Sprites: %u in %u draws",
+			CSpriteBatch::GetInstance()->GetSpriteCount(),
+			CSpriteBatch::GetInstance()->GetDrawCalls());
+		// Display the OpenGL state changes which were made, and those which the state cache skipped
+		ImGui::TextColored(ImVec4(1, 1, 0, 1), "GL state calls: %u (%u skipped)",
+			CGLStateCache::GetInstance()->GetCallsIssued(),
+			CGLStateCache::GetInstance()->GetCallsSkipped());
+		// Display the draw calls of the retained HUD
+		ImGui::TextColored(ImVec4(1, 1, 0, 1), "HUD: %u draws", cRetainedHUD->GetDrawCalls());
+#ifdef ENABLE_MEMORY_TRACKER
+		// Display the heap allocations of the last frame, the live heap and the OpenGL objects
+		ImGui::TextColored(ImVec4(1, 1, 0, 1), "Allocs/frame: %llu (%llu B) Over budget: %u",
+			CMemoryTracker::GetFrameAllocs(),
+			CMemoryTracker::GetFrameAllocBytes(),
+			CMemoryTracker::GetFramesOverBudget());
+		ImGui::TextColored(ImVec4(1, 1, 0, 1), "Heap: %.2f MB in %lld blocks GL: %d buffers, %d VAOs, %d textures",
+			CMemoryTracker::GetLiveBytes() / (1024.0 * 1024.0),
+			CMemoryTracker::GetLiveAllocs(),
+			CMemoryTracker::GetGLObjectCount(CMemoryTracker::BUFFER_OBJECT),
+			CMemoryTracker::GetGLObjectCount(CMemoryTracker::VERTEX_ARRAY_OBJECT),
+			CMemoryTracker::GetGLObjectCount(CMemoryTracker::TEXTURE_OBJECT));
+#endif
+		cRetainedHUD->SetWidgetDrawList(HUD_WIDGET_STATS, ImGui::GetWindowDrawList());
+		ImGui::End();
+	}
 
 	// Render a progress bar
 	/*m_fProgressBar += 0.001f;
@@ -170,178 +270,144 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	//ImGui::PopStyleColor();
 	//ImGui::End();
 
-
 	// Display Lives left
-	ImGuiWindowFlags LivesWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
-		ImGuiWindowFlags_NoBackground |
-		ImGuiWindowFlags_NoTitleBar |
-		ImGuiWindowFlags_NoMove |
-		ImGuiWindowFlags_NoResize |
-		ImGuiWindowFlags_NoCollapse |
-		ImGuiWindowFlags_NoScrollbar;
-	ImGui::Begin("Text", NULL, LivesWindowFlags);
-	ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.01f,
-			cSettings->iWindowHeight * 0.05f));
-	ImGui::TextColored(ImVec4(1, 1, 1, 1), "Lives left: ");
-	ImGui::SetWindowFontScale(2.f * relativeScale_y);
-	ImGui::End();
+	if (cRetainedHUD->IsRebuildNeeded(HUD_WIDGET_LIVES))
+	{
+		ImGui::Begin("Text", NULL, widgetWindowFlags);
+		ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.01f,
+				cSettings->iWindowHeight * 0.05f));
+		ImGui::SetWindowFontScale(2.f * relativeScale_y);
+		ImGui::TextColored(ImVec4(1, 1, 1, 1), "Lives left: ");
+		cRetainedHUD->SetWidgetDrawList(HUD_WIDGET_LIVES, ImGui::GetWindowDrawList());
+		ImGui::End();
+	}
 
 	// Render Health
-	ImGuiWindowFlags healthWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
-		ImGuiWindowFlags_NoBackground |
-		ImGuiWindowFlags_NoTitleBar |
-		ImGuiWindowFlags_NoMove |
-		ImGuiWindowFlags_NoResize |
-		ImGuiWindowFlags_NoCollapse |
-		ImGuiWindowFlags_NoScrollbar;
-	ImGui::Begin("Health", NULL, healthWindowFlags);
-	ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.01f,
-		cSettings->iWindowHeight * 0.1f));
-	ImGui::SetWindowSize(ImVec2(100.0f * relativeScale_x, 25.0f * relativeScale_y));
-	ImGui::SetWindowFontScale(1.5f * relativeScale_y);
-
-	cInventoryItem = cInventoryManager->GetItem("Health");
-	for (int i = 0; i < cInventoryItem->GetCount(); i++)
+	if (cRetainedHUD->IsRebuildNeeded(HUD_WIDGET_HEALTH))
 	{
-		ImGui::SameLine();
-		ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
-		ImVec2(cInventoryItem->vec2Size.x * relativeScale_x,
-			cInventoryItem->vec2Size.y * relativeScale_y),
-		ImVec2(0, 1), ImVec2(1, 0));
+		ImGui::Begin("Health", NULL, widgetWindowFlags);
+		ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.01f,
+			cSettings->iWindowHeight * 0.1f));
+		ImGui::SetWindowSize(ImVec2(100.0f * relativeScale_x, 25.0f * relativeScale_y));
+		ImGui::SetWindowFontScale(1.5f * relativeScale_y);
+
+		cInventoryItem = cInventoryManager->GetItem("Health");
+		for (int i = 0; i < cInventoryItem->GetCount(); i++)
+		{
+			ImGui::SameLine();
+			ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
+			ImVec2(cInventoryItem->vec2Size.x * relativeScale_x,
+				cInventoryItem->vec2Size.y * relativeScale_y),
+			ImVec2(0, 1), ImVec2(1, 0));
+		}
+		cRetainedHUD->SetWidgetDrawList(HUD_WIDGET_HEALTH, ImGui::GetWindowDrawList());
+		ImGui::End();
 	}
-	ImGui::End();
 
 
 	//PASSCODE
 	// Render the inventory items
-	cInventoryItem = cInventoryManager->GetItem("Paper");
-	ImGuiWindowFlags PaperWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
-		ImGuiWindowFlags_NoBackground |
-		ImGuiWindowFlags_NoTitleBar |
-		ImGuiWindowFlags_NoMove |
-		ImGuiWindowFlags_NoResize |
-		ImGuiWindowFlags_NoCollapse |
-		ImGuiWindowFlags_NoScrollbar;
-	ImGui::Begin("Image", NULL, PaperWindowFlags);
-	ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.015f, cSettings->iWindowHeight * 0.85f));
-	ImGui::SetWindowSize(ImVec2(200.0f * relativeScale_x, 25.0f * relativeScale_y));
-	ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
-		ImVec2(cInventoryItem->vec2Size.x * relativeScale_x, cInventoryItem->vec2Size.y * relativeScale_y),
-		ImVec2(0, 1), ImVec2(1, 0));
-	ImGui::SameLine();
-	ImGui::SetWindowFontScale(2.f * relativeScale_y);
-	ImGui::TextColored(ImVec4(1, 1, 1, 1), "Paper: %d / %d", cInventoryItem->GetCount() , cInventoryItem->GetMaxCount());
-	ImGui::SameLine();
-	ImGui::End();
+	if (cRetainedHUD->IsRebuildNeeded(HUD_WIDGET_PAPER))
+	{
+		cInventoryItem = cInventoryManager->GetItem("Paper");
+		ImGui::Begin("Image", NULL, widgetWindowFlags);
+		ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.015f, cSettings->iWindowHeight * 0.85f));
+		ImGui::SetWindowSize(ImVec2(200.0f * relativeScale_x, 25.0f * relativeScale_y));
+		ImGui::SetWindowFontScale(2.f * relativeScale_y);
+		ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
+			ImVec2(cInventoryItem->vec2Size.x * relativeScale_x, cInventoryItem->vec2Size.y * relativeScale_y),
+			ImVec2(0, 1), ImVec2(1, 0));
+		ImGui::SameLine();
+		ImGui::TextColored(ImVec4(1, 1, 1, 1), "Paper: %d / %d", cInventoryItem->GetCount() , cInventoryItem->GetMaxCount());
+		ImGui::SameLine();
+		cRetainedHUD->SetWidgetDrawList(HUD_WIDGET_PAPER, ImGui::GetWindowDrawList());
+		ImGui::End();
+	}
 
 	//FLASHLIGHT
 	// Render the inventory items
-	cInventoryItem = cInventoryManager->GetItem("Flashlight");
-	ImGuiWindowFlags FlashlightWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
-		ImGuiWindowFlags_NoBackground |
-		ImGuiWindowFlags_NoTitleBar |
-		ImGuiWindowFlags_NoMove |
-		ImGuiWindowFlags_NoResize |
-		ImGuiWindowFlags_NoCollapse |
-		ImGuiWindowFlags_NoScrollbar;
-	ImGui::Begin("Flashlight", NULL, FlashlightWindowFlags);
-	ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.75f, cSettings->iWindowHeight * 0.85f));
-	ImGui::SetWindowSize(ImVec2(200.0f * relativeScale_x, 25.0f * relativeScale_y));
-	ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
-		ImVec2(cInventoryItem->vec2Size.x * relativeScale_x, cInventoryItem->vec2Size.y * relativeScale_y),
-		ImVec2(0, 1), ImVec2(1, 0), ImVec4(1,1,1,1));
-	ImGui::SameLine();
-	ImGui::SetWindowFontScale(2.f * relativeScale_y);
-	if (cInventoryItem->GetCount() <= 10)
-		ImGui::TextColored(ImVec4(0.863, 0.078, 0.235, 1), "Flashlight : %d / %d ", cInventoryItem->GetCount(), cInventoryItem->GetMaxCount());
-	else if (cInventoryItem->GetCount() <= 30)
-		ImGui::TextColored(ImVec4(1.000, 0.388, 0.278, 1), "Flashlight : %d / %d ", cInventoryItem->GetCount(), cInventoryItem->GetMaxCount());
-	else if (cInventoryItem->GetCount() <= 50)
-		ImGui::TextColored(ImVec4(1.000, 0.894, 0.710, 1), "Flashlight : %d / %d ", cInventoryItem->GetCount(), cInventoryItem->GetMaxCount());
-	else
-		ImGui::TextColored(ImVec4(1, 1, 1, 1), "Flashlight : %d / %d ", cInventoryItem->GetCount(), cInventoryItem->GetMaxCount());
-	ImGui::SameLine();
-	ImGui::End();
+	if (cRetainedHUD->IsRebuildNeeded(HUD_WIDGET_FLASHLIGHT))
+	{
+		cInventoryItem = cInventoryManager->GetItem("Flashlight");
+		ImGui::Begin("Flashlight", NULL, widgetWindowFlags);
+		ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.75f, cSettings->iWindowHeight * 0.85f));
+		ImGui::SetWindowSize(ImVec2(200.0f * relativeScale_x, 25.0f * relativeScale_y));
+		ImGui::SetWindowFontScale(2.f * relativeScale_y);
+		ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
+			ImVec2(cInventoryItem->vec2Size.x * relativeScale_x, cInventoryItem->vec2Size.y * relativeScale_y),
+			ImVec2(0, 1), ImVec2(1, 0), ImVec4(1,1,1,1));
+		ImGui::SameLine();
+		if (cInventoryItem->GetCount() <= 10)
+			ImGui::TextColored(ImVec4(0.863, 0.078, 0.235, 1), "Flashlight : %d / %d ", cInventoryItem->GetCount(), cInventoryItem->GetMaxCount());
+		else if (cInventoryItem->GetCount() <= 30)
+			ImGui::TextColored(ImVec4(1.000, 0.388, 0.278, 1), "Flashlight : %d / %d ", cInventoryItem->GetCount(), cInventoryItem->GetMaxCount());
+		else if (cInventoryItem->GetCount() <= 50)
+			ImGui::TextColored(ImVec4(1.000, 0.894, 0.710, 1), "Flashlight : %d / %d ", cInventoryItem->GetCount(), cInventoryItem->GetMaxCount());
+		else
+			ImGui::TextColored(ImVec4(1, 1, 1, 1), "Flashlight : %d / %d ", cInventoryItem->GetCount(), cInventoryItem->GetMaxCount());
+		ImGui::SameLine();
+		cRetainedHUD->SetWidgetDrawList(HUD_WIDGET_FLASHLIGHT, ImGui::GetWindowDrawList());
+		ImGui::End();
+	}
 
 	//Display Radar cycle
-	ImGuiWindowFlags CycleWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
-		ImGuiWindowFlags_NoBackground |
-		ImGuiWindowFlags_NoTitleBar |
-		ImGuiWindowFlags_NoMove |
-		ImGuiWindowFlags_NoResize |
-		ImGuiWindowFlags_NoCollapse |
-		ImGuiWindowFlags_NoScrollbar;
-	ImGui::Begin("Cycle", NULL, CycleWindowFlags);
-	ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.815f,cSettings->iWindowHeight * 0.06f));
-	ImGui::TextColored(ImVec4(1, 1, 1, 1), "Press");
-	ImGui::SameLine();
-	ImGui::TextColored(ImVec4(0, 1, 0, 1), "'Q'");
-	ImGui::SameLine();
-	ImGui::TextColored(ImVec4(1, 1, 1, 1), "to Cycle");
-	ImGui::SameLine();
-	ImGui::SetWindowFontScale(2.f * relativeScale_y);
-	ImGui::End();
+	if (cRetainedHUD->IsRebuildNeeded(HUD_WIDGET_CYCLE))
+	{
+		ImGui::Begin("Cycle", NULL, widgetWindowFlags);
+		ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.815f,cSettings->iWindowHeight * 0.06f));
+		ImGui::SetWindowFontScale(2.f * relativeScale_y);
+		ImGui::TextColored(ImVec4(1, 1, 1, 1), "Press");
+		ImGui::SameLine();
+		ImGui::TextColored(ImVec4(0, 1, 0, 1), "'Q'");
+		ImGui::SameLine();
+		ImGui::TextColored(ImVec4(1, 1, 1, 1), "to Cycle");
+		ImGui::SameLine();
+		cRetainedHUD->SetWidgetDrawList(HUD_WIDGET_CYCLE, ImGui::GetWindowDrawList());
+		ImGui::End();
+	}
 
 
 	//RADAR
 	// Render the inventory items
-	if (cPlayer2D->getitemTracked() == 0)
-		cInventoryItem = cInventoryManager->GetItem("Paper");
-	else if (cPlayer2D->getitemTracked() == 1)
-		cInventoryItem = cInventoryManager->GetItem("Battery");
-	else
-		cInventoryItem = cInventoryManager->GetItem("Door");
-		
-	ImGuiWindowFlags RadarWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
-		ImGuiWindowFlags_NoBackground |
-		ImGuiWindowFlags_NoTitleBar |
-		ImGuiWindowFlags_NoMove |
-		ImGuiWindowFlags_NoResize |
-		ImGuiWindowFlags_NoCollapse |
-		ImGuiWindowFlags_NoScrollbar;
-	ImGui::Begin("Radar", NULL, RadarWindowFlags);
-	ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.815f, cSettings->iWindowHeight * 0.1f));
-	ImGui::SetWindowSize(ImVec2(200.0f * relativeScale_x, 25.0f * relativeScale_y));
-	ImGui::SetWindowFontScale(2.f * relativeScale_y);
-	ImGui::TextColored(ImVec4(1, 1, 1, 1), "Nearest ");
-	ImGui::SameLine();
-	ImGui::Image((void*)(intptr_t)cInventoryItem->GetTextureID(),
-		ImVec2(cInventoryItem->vec2Size.x * relativeScale_x, cInventoryItem->vec2Size.y * relativeScale_y),
-		ImVec2(0, 1), ImVec2(1, 0));
-	ImGui::SameLine();
-	ImGui::TextColored(ImVec4(1, 1, 1, 1), ":");
-	ImGui::SameLine();
-	if (cPlayer2D->getClosestCollectible() != 0 && cInventoryItem != cInventoryManager->GetItem("Door"))
+	if (cRetainedHUD->IsRebuildNeeded(HUD_WIDGET_RADAR))
 	{
-		ImGui::TextColored(ImVec4(1, 1, 0, 1), "%d m", cPlayer2D->getClosestCollectible());
+		ImGui::Begin("Radar", NULL, widgetWindowFlags);
+		ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.815f, cSettings->iWindowHeight * 0.1f));
+		ImGui::SetWindowSize(ImVec2(200.0f * relativeScale_x, 25.0f * relativeScale_y));
+		ImGui::SetWindowFontScale(2.f * relativeScale_y);
+		ImGui::TextColored(ImVec4(1, 1, 1, 1), "Nearest ");
 		ImGui::SameLine();
+		ImGui::Image((void*)(intptr_t)cRadarItem->GetTextureID(),
+			ImVec2(cRadarItem->vec2Size.x * relativeScale_x, cRadarItem->vec2Size.y * relativeScale_y),
+			ImVec2(0, 1), ImVec2(1, 0));
+		ImGui::SameLine();
+		ImGui::TextColored(ImVec4(1, 1, 1, 1), ":");
+		ImGui::SameLine();
+		if (cPlayer2D->getClosestCollectible() != 0 && cRadarItem != cInventoryManager->GetItem("Door"))
+		{
+			ImGui::TextColored(ImVec4(1, 1, 0, 1), "%d m", cPlayer2D->getClosestCollectible());
+			ImGui::SameLine();
+		}
+		else if (bAllCollected)
+			ImGui::TextColored(ImVec4(1, 1, 0, 1), " ");
+		else
+			ImGui::TextColored(ImVec4(1, 1, 0, 1), "%d m", cPlayer2D->getClosestCollectible());
+		cRetainedHUD->SetWidgetDrawList(HUD_WIDGET_RADAR, ImGui::GetWindowDrawList());
+		ImGui::End();
 	}
-	else if (cPlayer2D->getClosestCollectible() == 0 && cInventoryItem != cInventoryManager->GetItem("Door"))
-		ImGui::TextColored(ImVec4(1, 1, 0, 1), " ");
-	else
-		ImGui::TextColored(ImVec4(1, 1, 0, 1), "%d m", cPlayer2D->getClosestCollectible());
-	ImGui::End();
 
 
-	if (cPlayer2D->getClosestCollectible() == 0 && cInventoryItem != cInventoryManager->GetItem("Door"))
+	if (cRetainedHUD->IsRebuildNeeded(HUD_WIDGET_COLLECTED))
 	{
-		ImGuiWindowFlags CollectedWindowFlags = ImGuiWindowFlags_AlwaysAutoResize |
-			ImGuiWindowFlags_NoBackground |
-			ImGuiWindowFlags_NoTitleBar |
-			ImGuiWindowFlags_NoMove |
-			ImGuiWindowFlags_NoResize |
-			ImGuiWindowFlags_NoCollapse |
-			ImGuiWindowFlags_NoScrollbar;
-		ImGui::Begin("Collected", NULL, CollectedWindowFlags);
+		ImGui::Begin("Collected", NULL, widgetWindowFlags);
 		ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.815f, cSettings->iWindowHeight * 0.15f));
+		ImGui::SetWindowFontScale(2.f * relativeScale_y);
 		ImGui::TextColored(ImVec4(1, 1, 0, 1), "All Collected!");
 		ImGui::SameLine();
-		ImGui::SetWindowFontScale(2.f * relativeScale_y);
+		cRetainedHUD->SetWidgetDrawList(HUD_WIDGET_COLLECTED, ImGui::GetWindowDrawList());
 		ImGui::End();
 	}
 
-
-
 	//ImGui::Begin("HealthBar", NULL, soulWindowFlags);
 	//ImGui::SetWindowPos(ImVec2(cSettings->iWindowWidth * 0.09f,
 	//	cSettings->iWindowHeight * 0.1f));
@@ -356,7 +422,8 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	//ImGui::PopStyleColor();
 	//ImGui::End();
 
-	ImGui::End();
+	if (bShowProfiler)
+		CProfiler::GetInstance()->RenderFlameView(&bShowProfiler);
 
 	// 1. Show the big demo window (Most of the sample code is in ImGui::ShowDemoWindow()! 
 // You can browse its code to learn more about Dear ImGui!).
@@ -414,9 +481,36 @@ void CGUI_Scene2D::PreRender(void)
  */
 void CGUI_Scene2D::Render(void)
 {
-	// Rendering
-	ImGui::Render();
-	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	// Finish the shared UI frame, if this or an overlay state started it.
+	// If no tick ran in this frame, the last frame is drawn again, and its widgets were already captured
+	const bool bNewFrame = CUIRuntime::GetInstance()->IsFrameStarted();
+	ImDrawData* pDrawData = CUIRuntime::GetInstance()->EndFrame();
+
+	if ((bNewFrame == true) || (pDrawData == NULL))
+		vOtherDrawLists.clear();
+	if ((bNewFrame == true) && (pDrawData != NULL))
+	{
+		// Keep the IMGUI windows which are not HUD widgets, e.g. the pause menu, to draw them over the HUD
+		for (int i = 0; i < pDrawData->CmdListsCount; i++)
+		{
+			if (cRetainedHUD->IsWidgetDrawList(pDrawData->CmdLists[i]) == false)
+				vOtherDrawLists.push_back(pDrawData->CmdLists[i]);
+		}
+
+		// Copy the rebuilt widgets into the retained HUD
+		cRetainedHUD->Capture(pDrawData);
+	}
+
+	// Draw the cached HUD
+	cRetainedHUD->Render();
+
+	if (vOtherDrawLists.size() > 0)
+	{
+		ImDrawData otherDrawData = *pDrawData;
+		otherDrawData.CmdLists = &vOtherDrawLists[0];
+		otherDrawData.CmdListsCount = (int)vOtherDrawLists.size();
+		CUIRuntime::GetInstance()->RenderDrawData(&otherDrawData);
+	}
 }
 
 /**
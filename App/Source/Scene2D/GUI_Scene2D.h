@@ -14,6 +14,20 @@
 
 // FPS Counter
 #include "TimeControl\FPSCounter.h"
+// Frame Pacer
+#include "TimeControl\FramePacer.h"
+// Profiler
+#include "TimeControl\Profiler.h"
+// Memory Tracker
+#include "System\MemoryTracker.h"
+// Sprite Batch
+#include "RenderControl\SpriteBatch.h"
+// GL State Cache
+#include "RenderControl\GLStateCache.h"
+// Retained HUD
+#include "RenderControl\RetainedHUD.h"
+// Shared UI frame
+#include "RenderControl\UIRuntime.h"
 
 // Include CInventoryManager
 #include "InventoryManager.h"
@@ -43,8 +57,23 @@
 #include "GameControl/Settings.h"
 
 #include <string>
+#include <vector>
 using namespace std;
 
+// The widgets of the HUD, in the order which they are drawn
+enum HUD_WIDGET
+{
+	HUD_WIDGET_STATS = 0,
+	HUD_WIDGET_LIVES,
+	HUD_WIDGET_HEALTH,
+	HUD_WIDGET_PAPER,
+	HUD_WIDGET_FLASHLIGHT,
+	HUD_WIDGET_CYCLE,
+	HUD_WIDGET_RADAR,
+	HUD_WIDGET_COLLECTED,
+	NUM_HUD_WIDGETS
+};
+
 class CGUI_Scene2D : public CSingletonTemplate<CGUI_Scene2D>, public CEntity2D
 {
 	friend CSingletonTemplate<CGUI_Scene2D>;
@@ -73,6 +102,8 @@ protected:
 
 	// FPS Control
 	CFPSCounter* cFPSCounter;
+	// Frame Pacer
+	CFramePacer* cFramePacer;
 
 	// Flags for IMGUI
 	ImGuiWindowFlags window_flags;
@@ -87,6 +118,20 @@ protected:
 
 	CPlayer2D* cPlayer2D;
 
+	// Show the profiler's flame view. Toggled with F9
+	bool bShowProfiler;
+
+	// The HUD widgets, which are only rebuilt with IMGUI when what they display changes
+	CRetainedHUD* cRetainedHUD;
+	// The IMGUI draw lists which are not HUD widgets, e.g. the profiler's window
+	std::vector<ImDrawList*> vOtherDrawLists;
+
+	// The frame statistics change every frame, so the stats widget is refreshed at this interval in seconds
+	static const double STATS_REFRESH_TIME;
+	// The time since the stats widget was refreshed, and the number of refreshes
+	double dStatsElapsedTime;
+	int iStatsRefreshes;
+
 	// These variables are for IMGUI demo only
 	bool show_demo_window;
 	bool show_another_window;
@@ -8,6 +8,9 @@
 #include "InventoryManager.h"
 #include <stdexcept>      // std::invalid_argument
 
+// Include CSnapshotBuffer for the save games
+#include "System\SnapshotBuffer.h"
+
 /**
 @brief Constructor
 */
@@ -115,3 +118,51 @@ int CInventoryManager::GetNumItems(void) const
 {
 	return inventoryMap.size();
 }
+
+/**
+@brief Write the counts of the items to a snapshot. The items are written with their names,
+		so that a snapshot still loads if items are added to the game later
+@param cSnapshot The snapshot to write to
+*/
+void CInventoryManager::WriteSnapshot(CSnapshotBuffer& cSnapshot) const
+{
+	cSnapshot.Write((unsigned int)inventoryMap.size());
+	for (std::map<std::string, CInventoryItem*>::const_iterator it = inventoryMap.begin(); it != inventoryMap.end(); ++it)
+	{
+		cSnapshot.WriteString(it->first);
+		cSnapshot.Write(it->second->iItemCount);
+		cSnapshot.Write(it->second->iItemMaxCount);
+	}
+}
+
+/**
+@brief Read the counts of the items from a snapshot. Items which are not in this inventory are skipped
+@param cSnapshot The snapshot to read from
+@return false if the snapshot ended too early
+*/
+bool CInventoryManager::ReadSnapshot(CSnapshotBuffer& cSnapshot)
+{
+	unsigned int uiNumItems = 0;
+	if (cSnapshot.Read(uiNumItems) == false)
+		return false;
+
+	for (unsigned int i = 0; i < uiNumItems; i++)
+	{
+		std::string sName;
+		int iItemCount = 0, iItemMaxCount = 0;
+		cSnapshot.ReadString(sName);
+		cSnapshot.Read(iItemCount);
+		cSnapshot.Read(iItemMaxCount);
+		if (cSnapshot.HasReadError())
+			return false;
+
+		CInventoryItem* cInventoryItem = GetItem(sName);
+		if (cInventoryItem == NULL)
+			continue;
+
+		cInventoryItem->iItemCount = iItemCount;
+		cInventoryItem->iItemMaxCount = iItemMaxCount;
+	}
+
+	return true;
+}
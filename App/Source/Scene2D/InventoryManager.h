@@ -13,6 +13,9 @@
 #include <string>
 #include "InventoryItem.h"
 
+// Include CSnapshotBuffer for the save games
+class CSnapshotBuffer;
+
 class CInventoryManager : public CSingletonTemplate<CInventoryManager>
 {
 	friend CSingletonTemplate<CInventoryManager>;
@@ -34,6 +37,11 @@ public:
 	// Get the number of items
 	int GetNumItems(void) const;
 
+	// Write the counts of the items to a snapshot
+	void WriteSnapshot(CSnapshotBuffer& cSnapshot) const;
+	// Read the counts of the items from a snapshot
+	bool ReadSnapshot(CSnapshotBuffer& cSnapshot);
+
 protected:
 	// Constructor
 	CInventoryManager(void);
@@ -0,0 +1,162 @@
+/**
+ CLevelStreamer
+ @brief A class which prepares the next level on a worker thread while the current level is played.
+		The worker parses the map and builds the spawn list of the enemies, so that the scene only has
+		to copy the tile values and move the entities when it swaps the level in.
+ */
+#include "LevelStreamer.h"
+
+// Include CMapGrid for the cache of the CSV files
+#include "MapGrid.h"
+// Include CProfiler to measure the preparing of levels
+#include "TimeControl/Profiler.h"
+
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+// The tile value which marks the spawn position of an enemy, and the value which replaces it
+static const unsigned int ENEMY_SPAWN_VALUE = 303;
+static const unsigned int EMPTY_TILE_VALUE = 2;
+
+/**
+ @brief Constructor
+ */
+CLevelStreamer::CLevelStreamer(void)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CLevelStreamer::~CLevelStreamer(void)
+{
+	Cancel();
+}
+
+/**
+ @brief Start preparing a level on the worker thread. A level which is still being prepared is discarded
+ @param uiLevel The level which the map is for
+ @param sFilePath The full path of the CSV file of the map
+ @param uiNumRows The number of rows which the map must have
+ @param uiNumCols The number of columns which the map must have
+ */
+bool CLevelStreamer::RequestLevel(	const unsigned int uiLevel, const std::string& sFilePath,
+									const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	Cancel();
+
+	// Copy the map from the cache here, as the cache is only used by the main thread.
+	// The worker thread reads the file if it was not cached
+	rapidcsv::Document doc;
+	const bool bDocumentLoaded = CMapGrid::GetCachedCSV(sFilePath, doc);
+
+	futureLevel = std::async(std::launch::async, &CLevelStreamer::Prepare,
+							 uiLevel, doc, sFilePath, bDocumentLoaded, uiNumRows, uiNumCols);
+	return true;
+}
+
+/**
+ @brief Check if a level is being prepared, or is ready to be taken
+ */
+bool CLevelStreamer::IsPending(void) const
+{
+	return futureLevel.valid();
+}
+
+/**
+ @brief Check if the requested level is ready to be taken, without waiting for it
+ */
+bool CLevelStreamer::IsReady(void) const
+{
+	if (futureLevel.valid() == false)
+		return false;
+
+	return futureLevel.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+/**
+ @brief Take the prepared level. It waits for the worker thread if the level is not ready yet,
+		so check IsReady first to avoid blocking
+ @param levelData The prepared level
+ @return false if no level was requested
+ */
+bool CLevelStreamer::TakeLevel(LevelData& levelData)
+{
+	if (futureLevel.valid() == false)
+		return false;
+
+	levelData = futureLevel.get();
+	return true;
+}
+
+/**
+ @brief Wait for the worker thread, and discard the level which it prepared
+ */
+void CLevelStreamer::Cancel(void)
+{
+	if (futureLevel.valid())
+		futureLevel.get();
+}
+
+/**
+ @brief Parse a map and build its spawn list. It is run on the worker thread, so it only uses its parameters
+ @param uiLevel The level which the map is for
+ @param doc The map, if bDocumentLoaded is true
+ @param sFilePath The full path of the CSV file, to read if bDocumentLoaded is false
+ @param bDocumentLoaded true if doc contains the map
+ @param uiNumRows The number of rows which the map must have
+ @param uiNumCols The number of columns which the map must have
+ */
+CLevelStreamer::LevelData CLevelStreamer::Prepare(	const unsigned int uiLevel, rapidcsv::Document doc, const std::string sFilePath,
+													const bool bDocumentLoaded, const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	PROFILE_SCOPE("CLevelStreamer::Prepare");
+
+	LevelData levelData;
+	levelData.uiLevel = uiLevel;
+
+	try
+	{
+		if (bDocumentLoaded == false)
+			doc = rapidcsv::Document(sFilePath.c_str());
+
+		// Check if the sizes of CSV data matches the sizes of the levels
+		if ((uiNumCols != (unsigned int)doc.GetColumnCount()) ||
+			(uiNumRows != (unsigned int)doc.GetRowCount()))
+		{
+			cout << "CLevelStreamer::Prepare - Sizes of " << sFilePath << " do not match the sizes of the levels" << endl;
+			return levelData;
+		}
+
+		levelData.vValues.resize(uiNumRows * uiNumCols);
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+		{
+			// Read a row from the CSV file
+			std::vector<std::string> row = doc.GetRow<std::string>(uiRow);
+
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+			{
+				unsigned int uiValue = (unsigned int)stoi(row[uiCol]);
+
+				// Add the enemy markers to the spawn list, in the same order and with the same inverted rows
+				// as CMapGrid::FindValue returns them, and erase them from the map
+				if (uiValue == ENEMY_SPAWN_VALUE)
+				{
+					levelData.vEnemySpawns.push_back(glm::i32vec2(uiCol, uiNumRows - uiRow - 1));
+					uiValue = EMPTY_TILE_VALUE;
+				}
+
+				levelData.vValues[uiRow * uiNumCols + uiCol] = uiValue;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		cout << "CLevelStreamer::Prepare - Unable to read " << sFilePath << ": " << e.what() << endl;
+		return levelData;
+	}
+
+	levelData.bValid = true;
+	return levelData;
+}
@@ -0,0 +1,69 @@
+/**
+ CLevelStreamer
+ @brief A class which prepares the next level on a worker thread while the current level is played.
+		The worker parses the map and builds the spawn list of the enemies, so that the scene only has
+		to copy the tile values and move the entities when it swaps the level in.
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include the RapidCSV
+#include "System/rapidcsv.h"
+
+#include <future>
+#include <string>
+#include <vector>
+
+class CLevelStreamer
+{
+public:
+	// The data of a level which was prepared by the worker thread
+	struct LevelData
+	{
+		// The level which the data is for
+		unsigned int uiLevel;
+		// The tile values, row by row as in the CSV file, with the enemy markers erased
+		std::vector<unsigned int> vValues;
+		// The indices (column, row) which the enemies spawn at
+		std::vector<glm::i32vec2> vEnemySpawns;
+		// false if the map could not be read
+		bool bValid;
+
+		LevelData(void)
+			: uiLevel(0)
+			, bValid(false)
+		{
+		}
+	};
+
+	// Constructor
+	CLevelStreamer(void);
+
+	// Destructor
+	virtual ~CLevelStreamer(void);
+
+	// Start preparing a level on the worker thread
+	bool RequestLevel(const unsigned int uiLevel, const std::string& sFilePath,
+					  const unsigned int uiNumRows, const unsigned int uiNumCols);
+
+	// Check if a level is being prepared, or is ready to be taken
+	bool IsPending(void) const;
+	// Check if the requested level is ready to be taken, without waiting for it
+	bool IsReady(void) const;
+
+	// Take the prepared level. It returns false if no level was requested
+	bool TakeLevel(LevelData& levelData);
+
+	// Wait for the worker thread, and discard the level which it prepared
+	void Cancel(void);
+
+protected:
+	// The level which the worker thread is preparing
+	std::future<LevelData> futureLevel;
+
+	// Parse a map and build its spawn list. It is run on the worker thread
+	static LevelData Prepare(const unsigned int uiLevel, rapidcsv::Document doc, const std::string sFilePath,
+							 const bool bDocumentLoaded, const unsigned int uiNumRows, const unsigned int uiNumCols);
+};
@@ -6,28 +6,35 @@
  */
 #include "Map2D.h"
 
+// Include CMemoryTracker to count the allocations and OpenGL objects
+#include "System\MemoryTracker.h"
+
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "RenderControl\GLStateCache.h"
 
 // Include Filesystem
 #include "System\filesystem.h"
 // Include ImageLoader
 #include "System\ImageLoader.h"
 #include "Primitives/MeshBuilder.h"
+// Include CProfiler to measure the rendering and path finding
+#include "TimeControl/Profiler.h"
+// Include CRandom
+#include "System\Random.h"
 
 #include <iostream>
 #include <vector>
 using namespace std;
 
-// For AStar PathFinding
-using namespace std::placeholders;
-
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
 CMap2D::CMap2D(void)
-	: uiCurLevel(0)
+	: random(0)
 	, quadMesh(NULL)
+	, iRuntimeColourLoc(-1)
 	, cPlayer2D(NULL)
 	, cInventoryManager(NULL)
 	, camera(NULL)
@@ -40,16 +47,7 @@ CMap2D::CMap2D(void)
  */
 CMap2D::~CMap2D(void)
 {
-	// Dynamically deallocate the 3D array used to store the map information
-	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
-	{
-		for (unsigned int iRow = 0; iRow < cSettings->NUM_TILES_YAXIS; iRow++)
-		{
-			delete[] arrMapInfo[uiLevel][iRow];
-		}
-		delete [] arrMapInfo[uiLevel];
-	}
-	delete[] arrMapInfo;
+	// The map information and AStar lists are deleted by CMapGrid
 
 	if (quadMesh)
 	{
@@ -58,9 +56,12 @@ CMap2D::~CMap2D(void)
 	}
 
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
+	CGLStateCache::GetInstance()->DeleteVertexArrays(1, &VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, -1);
+	CGLStateCache::GetInstance()->DeleteBuffers(1, &VBO);
+	MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
+	CGLStateCache::GetInstance()->DeleteBuffers(1, &EBO);
+	MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
 
 	// Set this to NULL since it was created elsewhere, so we let it be deleted there.
 	cSettings = NULL;
@@ -68,9 +69,6 @@ CMap2D::~CMap2D(void)
 	cInventoryManager = NULL;
 	camera = NULL;
 	cSoundController = NULL;
-
-	// Delete AStar lists
-	DeleteAStarLists();
 }
 
 /**
@@ -91,32 +89,18 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 	// Get the handler to the camera instance
 	camera = Camera::GetInstance();
 
-	// Create the arrMapInfo and initialise to 0
-	// Start by initialising the number of levels
-	arrMapInfo = new Grid** [uiNumLevels];
-	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
-	{
-		arrMapInfo[uiLevel] = new Grid* [uiNumRows];
-		for (unsigned uiRow = 0; uiRow < uiNumRows; uiRow++)
-		{
-			arrMapInfo[uiLevel][uiRow] = new Grid[uiNumCols];
-			for (unsigned uiCol = 0; uiCol < uiNumCols; uiCol++)
-			{
-				arrMapInfo[uiLevel][uiRow][uiCol].value = 0;
-				arrMapInfo[uiLevel][uiRow][uiCol].runtimeColour = glm::vec4(0.f, 0.f, 0.f, 1.0);
-			}
-		}
-	}
+	// Create the arrMapInfo and initialise to 0, and set up the AStar lists
+	InitGrid(uiNumLevels, uiNumRows, uiNumCols);
 
 	// Store the map sizes in cSettings
-	uiCurLevel = 0;
-	this->uiNumLevels = uiNumLevels;
 	cSettings->NUM_TILES_XAXIS = uiNumCols;
 	cSettings->NUM_TILES_YAXIS = uiNumRows;
 	cSettings->UpdateSpecifications();
+	SetTileSize(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
 
 	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
 
 	//CS: Create the Quad Mesh using the mesh builder
 	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
@@ -182,8 +166,8 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 		MapOfTextureIDs.insert(pair<int, int>(110, iTextureID));
 	}
 
-	srand(time(NULL));
-	random = rand() % 3 + 1;
+	// Pick the passcode with the seeded random number generator, so that replays pick the same one
+	random = CRandom::GetInstance()->Range(1, 3);
 	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/passcode.png", true);
 	if (iTextureID == 0)
 	{
@@ -210,20 +194,6 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 		MapOfTextureIDs.insert(pair<int, int>(80, iTextureID));
 	}
 
-	// Initialise the variables for AStar
-	m_weight = 1;
-	m_startPos = glm::vec2(0, 0);
-	m_targetPos = glm::vec2(0, 0);
-	//m_size = cSettings->NUM_TILES_YAXIS* cSettings->NUM_TILES_XAXIS;
-
-	m_nrOfDirections = 4;
-	m_directions = { { -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 },
-						{ -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
-
-	// Resize these 2 lists
-	m_cameFromList.resize(cSettings->NUM_TILES_YAXIS* cSettings->NUM_TILES_XAXIS);
-	m_closedList.resize(cSettings->NUM_TILES_YAXIS* cSettings->NUM_TILES_XAXIS, false);
-
 	rays = Rays::GetInstance()->GetRays();
 
 	return true;
@@ -243,14 +213,11 @@ void CMap2D::Update(const double dElapsedTime)
 void CMap2D::PreRender(void)
 {
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
+	CGLStateCache::GetInstance()->SetBlend(true);
+	CGLStateCache::GetInstance()->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	CShaderManager::GetInstance()->Use(iShaderHandle);
 }
 
 /**
@@ -258,8 +225,12 @@ void CMap2D::PreRender(void)
  */
 void CMap2D::Render(void)
 {
+	PROFILE_SCOPE("CMap2D::Render");
+	MEMORY_TAG("CMap2D::Render");
+
 	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
+	GLint transformLoc = CShaderManager::GetInstance()->activeShader->getUniformLocation("transform");
+	iRuntimeColourLoc = CShaderManager::GetInstance()->activeShader->getUniformLocation("runtimeColour");
 	//unsigned int MVLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "MV");
 	//unsigned int inverseLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "MV_inverse_transpose");
 
@@ -407,11 +378,10 @@ void CMap2D::Render(void)
 
 /**
  @brief PostRender Set up the OpenGL display environment after rendering.
+		Blending is left on for the entities which are rendered next
  */
 void CMap2D::PostRender(void)
 {
-	// Disable blending
-	glDisable(GL_BLEND);
 }
 
 // Set the specifications of the map
@@ -474,100 +444,29 @@ void CMap2D::SetNumSteps(const CSettings::AXIS sAxis, const unsigned int uiValue
 	}
 }
 
-/**
- @brief Set the value at certain indices in the arrMapInfo
- @param iRow A const int variable containing the row index of the element to set to
- @param iCol A const int variable containing the column index of the element to set to
- @param iValue A const int variable containing the value to assign to this arrMapInfo
- */
-void CMap2D::SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert)
-{
-	if (bInvert)
-	{
-		arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value = iValue;
-	}
-	else
-	{
-		arrMapInfo[uiCurLevel][uiRow][uiCol].value = iValue;
-	}
-}
-
-/**
- @brief Set the runtime colour at certain indices in the arrMapInfo, used for lighting
- @param iRow A const int variable containing the row index of the element to set to
- @param iCol A const int variable containing the column index of the element to set to
- @param runtimeColour The colour to set the tile at this position to
- */
-void CMap2D::SetMapColour(const unsigned int uiRow, const unsigned int uiCol, const glm::vec4 runtimeColour, const bool bInvert)
-{
-	if (bInvert)
-	{
-		arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].runtimeColour = runtimeColour;
-	}
-	else
-	{
-		arrMapInfo[uiCurLevel][uiRow][uiCol].runtimeColour = runtimeColour;
-	}
-}
-
 int CMap2D::GetRandomPattern()
 {
 	return random;
 }
 
-/**
- @brief Get the value at certain indices in the arrMapInfo
- @param iRow A const int variable containing the row index of the element to get from
- @param iCol A const int variable containing the column index of the element to get from
- @param bInvert A const bool variable which indicates if the row information is inverted
- */
-int CMap2D::GetMapInfo(const unsigned int uiRow, const int unsigned uiCol, const bool bInvert) const
-{
-	if (bInvert)
-		return arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value;
-	else
-		return arrMapInfo[uiCurLevel][uiRow][uiCol].value;
-}
-
-glm::vec4 CMap2D::GetMapColour(const unsigned int uiRow, const int unsigned uiCol, const bool bInvert) const
-{
-	if (bInvert)
-		return arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].runtimeColour;
-	else
-		return arrMapInfo[uiCurLevel][uiRow][uiCol].runtimeColour;
-}
-
 /**
  @brief Load a map
  */ 
 bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 {
-	doc = rapidcsv::Document(FileSystem::getPath(filename).c_str());
-
-	// Check if the sizes of CSV data matches the declared arrMapInfo sizes
-	if ((cSettings->NUM_TILES_XAXIS != (unsigned int)doc.GetColumnCount()) ||
-		(cSettings->NUM_TILES_YAXIS != (unsigned int)doc.GetRowCount()))
-	{
-		cout << "Sizes of CSV map does not match declared arrMapInfo sizes." << endl;
-		cout << "Num Tiles:" << cSettings->NUM_TILES_XAXIS << "X" << cSettings->NUM_TILES_YAXIS << endl;
-		cout << "Doc tiles: " << (unsigned int)doc.GetColumnCount() << "X" << (unsigned int)doc.GetRowCount() << endl;
-		return false;
-	}
+	PROFILE_SCOPE("CMap2D::LoadMap");
+	MEMORY_TAG("CMap2D::LoadMap");
 
-	// Read the rows and columns of CSV data into arrMapInfo
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
-	{
-		// Read a row from the CSV file
-		std::vector<std::string> row = doc.GetRow<std::string>(uiRow);
-		
-		// Load a particular CSV value into the arrMapInfo
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; ++uiCol)
-		{
-			arrMapInfo[uiCurLevel][uiRow][uiCol].value = (int)stoi(row[uiCol]);
-		}
-	}
+	return LoadCSV(FileSystem::getPath(filename), uiCurLevel);
+}
 
-	return true;
+/**
+ @brief Read a map into the cache, so that loading it again, e.g. when the game is restarted, does not read the file
+ @param filename A string variable containing the name of the map file
+ */
+bool CMap2D::CacheMap(string filename)
+{
+	return CacheCSV(FileSystem::getPath(filename));
 }
 
 /**
@@ -576,65 +475,30 @@ bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
  */
 bool CMap2D::SaveMap(string filename, const unsigned int uiCurLevel)
 {
-	// Update the rapidcsv::Document from arrMapInfo
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
-	{
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
-		{
-			doc.SetCell(uiCol, uiRow, arrMapInfo[uiCurLevel][uiRow][uiCol].value);
-		}
-		cout << endl;
-	}
-
-	// Save the rapidcsv::Document to a file
-	doc.Save(FileSystem::getPath(filename).c_str());
-
-	return true;
+	return SaveCSV(FileSystem::getPath(filename), uiCurLevel);
 }
 
 /**
-@brief Find the indices of a certain value in arrMapInfo
-@param iValue A const int variable containing the row index of the found element
-@param iRow A const int variable containing the row index of the found element
-@param iCol A const int variable containing the column index of the found element
-@param bInvert A const bool variable which indicates if the row information is inverted
-*/
-bool CMap2D::FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert)
-{
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
-	{
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
-		{
-			if (arrMapInfo[uiCurLevel][uiRow][uiCol].value == iValue)
-			{
-				if (bInvert)
-					uirRow = cSettings->NUM_TILES_YAXIS - uiRow - 1;
-				else
-					uirRow = uiRow;
-				uirCol = uiCol;
-				return true;	// Return true immediately if the value has been found
-			}
-		}
-	}
-	return false;
-}
-
-/**
- @brief Set current level
+ @brief Write the tiles and the passcode pattern to a snapshot
+ @param cSnapshot The snapshot to write to
  */
-void CMap2D::SetCurrentLevel(unsigned int uiCurLevel)
+void CMap2D::WriteSnapshot(CSnapshotBuffer& cSnapshot) const
 {
-	if (uiCurLevel < uiNumLevels)
-	{
-		this->uiCurLevel = uiCurLevel;
-	}
+	CMapGrid::WriteSnapshot(cSnapshot);
+	cSnapshot.Write(random);
 }
+
 /**
- @brief Get current level
+ @brief Read the tiles and the passcode pattern from a snapshot
+ @param cSnapshot The snapshot to read from
+ @return false if the snapshot does not match this map
  */
-unsigned int CMap2D::GetCurrentLevel(void) const
+bool CMap2D::ReadSnapshot(CSnapshotBuffer& cSnapshot)
 {
-	return uiCurLevel;
+	if (CMapGrid::ReadSnapshot(cSnapshot) == false)
+		return false;
+
+	return cSnapshot.Read(random);
 }
 
 /**
@@ -652,20 +516,16 @@ void CMap2D::RenderTile(const unsigned int uiRow, const unsigned int uiCol)
 		unsigned int specularLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "material.kSpecular");
 		unsigned int shininessLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "material.kShininess");*/
 		//if (arrMapInfo[uiCurLevel][uiRow][uiCol].value < 3)
-		glBindTexture(GL_TEXTURE_2D, MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value));
+		CGLStateCache::GetInstance()->BindTexture(0, MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value));
 
-		unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-		glUniform4fv(colorLoc, 1, glm::value_ptr(arrMapInfo[uiCurLevel][uiRow][uiCol].runtimeColour));
-
-		glBindVertexArray(VAO);
+		glUniform4fv(iRuntimeColourLoc, 1, glm::value_ptr(arrMapInfo[uiCurLevel][uiRow][uiCol].runtimeColour));
 
 		//glUniform3fv(ambientLoc, 1, &quadMesh->material.kAmbient.r);
 		//glUniform3fv(diffuseLoc, 1, &quadMesh->material.kDiffuse.r);
 		//glUniform3fv(specularLoc, 1, &quadMesh->material.kSpecular.r);
 		//glUniform1f(shininessLoc, quadMesh->material.kShininess);
-		//CS: Render the tile
+		//CS: Render the tile. The quad mesh binds its own vertex array
 		quadMesh->Render();
-		glBindVertexArray(0);
 	}
 }
 
@@ -700,283 +560,3 @@ void CMap2D::PrintSelf(void) const
 
 	cout << "===== AStar::PrintSelf() =====" << endl;
 }
-
-void CMap2D::CheckIntersect(glm::vec2 enemy_index, glm::vec2 enemy_UVpos, glm::vec3 ray_direction, float& ray_length )
-{
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
-	{
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
-		{
-			if (uiRow <= enemy_index.y + 10 && uiRow >= enemy_index.y - 10 &&
-				uiCol <= enemy_index.x + 10 && uiCol >= enemy_index.x - 10)
-			{
-				glm::mat4 tileTransform;
-				tileTransform = glm::mat4(1.f);
-				// Top left corner is (-0.9875, 0.977778, 0)
-				// Each tile is +0.0248 to X and -0.045 to Y
-				float xTranslate = -0.9875 + (uiCol * 0.0248);
-				float yTranslate = 0.977778 - ((45 - uiRow) * 0.045);
-				tileTransform = glm::translate(tileTransform, glm::vec3(xTranslate, yTranslate, 0));
-
-				float intersectionDist = 9999;
-				if (Rays::GetInstance()->flashlight.TestRayOBBIntersection(
-					glm::vec3(enemy_UVpos.x, enemy_UVpos.y, 0.f),
-					ray_direction,
-					glm::vec3(-cSettings->TILE_WIDTH, -cSettings->TILE_HEIGHT * 0.5, -1.f),
-					glm::vec3(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT, 1.f),
-					tileTransform,
-					intersectionDist))
-				{
-					// Cut off ray when hit a wall, only highlight tiles that are within the distance
-					if (intersectionDist <= ray_length)
-					{
-						if (GetMapInfo(uiRow, uiCol) >= 100)
-						{
-							ray_length = intersectionDist;
-						}
-					}
-				}
-			}
-		}
-	}
-}
-
-/**
- @brief Find a path
- */
-std::vector<glm::vec2> CMap2D::PathFind(const glm::vec2& startPos, const glm::vec2& targetPos, HeuristicFunction heuristicFunc, int weight)
-{
-	// Check if the startPos and targetPost are blocked
-	if (isBlocked(startPos.y, startPos.x) ||
-		(isBlocked(targetPos.y, targetPos.x)))
-	{
-		//cout << "Invalid start or target position." << endl;
-		// Return an empty path
-		std::vector<glm::vec2> path;
-		return path;
-	}
-
-	// Set up the variables and lists
-	m_startPos = startPos;
-	m_targetPos = targetPos;
-	m_weight = weight;
-	m_heuristic = std::bind(heuristicFunc, _1, _2, _3);
-
-	// Reset AStar lists
-	ResetAStarLists();
-
-	// Add the start pos to 2 lists
-	m_cameFromList[ConvertTo1D(m_startPos)].parent = m_startPos;
-	m_openList.push(Grid(m_startPos, 0));
-
-	unsigned int fNew, gNew, hNew;
-	glm::vec2 currentPos;
-
-	// Start the path finding...
-	while (!m_openList.empty())
-	{
-		// Get the node with the least f value
-		currentPos = m_openList.top().pos;
-		//cout << endl << "*** New position to check: " << currentPos.x << ", " << currentPos.y << endl;
-		//cout << "*** targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
-
-		// If the targetPos was reached, then quit this loop
-		if (currentPos == m_targetPos)
-		{
-			//cout << "=== Found the targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
-			while (m_openList.size() != 0)
-				m_openList.pop();
-			break;
-		}
-
-		m_openList.pop();
-		m_closedList[ConvertTo1D(currentPos)] = true;
-
-		// Check the neighbors of the current node
-		for (unsigned int i = 0; i < m_nrOfDirections; ++i)
-		{
-			const auto neighborPos = currentPos + m_directions[i];
-			const auto neighborIndex = ConvertTo1D(neighborPos);
-
-			//cout << "\t#" << i << ": Check this: " << neighborPos.x << ", " << neighborPos.y << ":\t";
-			if (!isValid(neighborPos) ||
-				isBlocked(neighborPos.y, neighborPos.x) ||
-				m_closedList[neighborIndex] == true)
-			{
-				//cout << "This position is not valid. Going to next neighbour." << endl;
-				continue;
-			}
-
-			gNew = m_cameFromList[ConvertTo1D(currentPos)].g + 1; //NOTE: This restricts enemy movement to only linear, no diagonal. If want diagonal jumping, need algorithm to calculate whether + 1 or + 1.414
-			hNew = m_heuristic(neighborPos, m_targetPos, m_weight);
-			fNew = gNew + hNew;
-
-			if (m_cameFromList[neighborIndex].f == 0 || fNew < m_cameFromList[neighborIndex].f)
-			{
-				//cout << "Adding to Open List: " << neighborPos.x << ", " << neighborPos.y;
-				//cout << ". [ f : " << fNew << ", g : " << gNew << ", h : " << hNew << "]" << endl;
-				m_openList.push(Grid(neighborPos, fNew));
-				m_cameFromList[neighborIndex] = { neighborPos, currentPos, fNew, gNew, hNew };
-			}
-			else
-			{
-				//cout << "Not adding this" << endl;
-			}
-		}
-		//system("pause");
-	}
-
-	return BuildPath();
-}
-
-/**
- @brief Build a path
- */
-std::vector<glm::vec2> CMap2D::BuildPath() const
-{
-	std::vector<glm::vec2> path;
-	auto currentPos = m_targetPos;
-	auto currentIndex = ConvertTo1D(currentPos);
-
-	while (!(m_cameFromList[currentIndex].parent == currentPos))
-	{
-		path.push_back(currentPos);
-		currentPos = m_cameFromList[currentIndex].parent;
-		currentIndex = ConvertTo1D(currentPos);
-	}
-
-	// If the path has only 1 entry, then it is the the target position
-	if (path.size() == 1)
-	{
-		// if m_startPos is next to m_targetPos, then having 1 path point is OK
-		if (m_nrOfDirections == 4)
-		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
-				path.clear();
-		}
-		else //check for 8 directions (including diagonals)
-		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 2)
-				path.clear();
-			else if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
-				path.clear();
-		}
-	}
-	else
-		std::reverse(path.begin(), path.end());
-
-	return path;
-}
-
-/**
- @brief Toggle the checks for diagonal movements
- */
-void CMap2D::SetDiagonalMovement(const bool bEnable)
-{
-	m_nrOfDirections = (bEnable) ? 8 : 4;
-}
-
-/**
- @brief Check if a position is valid
- */
-bool CMap2D::isValid(const glm::vec2& pos) const
-{
-	//return (pos.x >= 0) && (pos.x < m_dimensions.x) &&
-	//	(pos.y >= 0) && (pos.y < m_dimensions.y);
-	return (pos.x >= 0) && (pos.x < cSettings->NUM_TILES_XAXIS) &&
-		(pos.y >= 0) && (pos.y < cSettings->NUM_TILES_YAXIS);
-}
-
-/**
- @brief Check if a grid is blocked
- */
-bool CMap2D::isBlocked(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert) const
-{
-	if (bInvert == true)
-	{
-		if ((arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value >= 100) &&
-			(arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value < 200))
-			return true;
-		else
-			return false;
-	}
-	else
-	{
-		if ((arrMapInfo[uiCurLevel][uiRow][uiCol].value >= 100) &&
-			(arrMapInfo[uiCurLevel][uiRow][uiCol].value < 200))
-			return true;
-		else
-			return false;
-	}
-}
-
-/**
- @brief Returns a 1D index based on a 2D coordinate using row-major layout
- */
-int CMap2D::ConvertTo1D(const glm::vec2& pos) const
-{
-	//return (pos.y * m_dimensions.x) + pos.x;
-	return (pos.y * cSettings->NUM_TILES_XAXIS) + pos.x;
-}
-
-/**
- @brief Delete AStar lists
- */
-bool CMap2D::DeleteAStarLists(void)
-{
-	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
-	// Delete m_cameFromList
-	m_cameFromList.clear();
-	// Delete m_closedList
-	m_closedList.clear();
-
-	return true;
-}
-
-
-/**
- @brief Reset AStar lists
- */
-bool CMap2D::ResetAStarLists(void)
-{
-	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
-	// Reset m_cameFromList
-	for (int i = 0; i < m_cameFromList.size(); i++)
-	{
-		m_cameFromList[i].pos = glm::vec2(0, 0);
-		m_cameFromList[i].parent = glm::vec2(0, 0);
-		m_cameFromList[i].f = 0;
-		m_cameFromList[i].g = 0;
-		m_cameFromList[i].h = 0;
-	}
-	// Reset m_closedList
-	for (int i = 0; i < m_closedList.size(); i++)
-	{
-		m_closedList[i] = false;
-	}
-
-	return true;
-}
-
-
-/**
- @brief manhattan calculation method for calculation of h
- */
-unsigned int heuristic::manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight)
-{
-	glm::vec2 delta = v2 - v1;
-	return static_cast<unsigned int>(weight * (delta.x + delta.y));
-}
-
-/**
- @brief euclidean calculation method for calculation of h
- */
-unsigned int heuristic::euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight)
-{
-	glm::vec2 delta = v2 - v1;
-	return static_cast<unsigned int>(weight * sqrt((delta.x * delta.x) + (delta.y * delta.y)));
-}
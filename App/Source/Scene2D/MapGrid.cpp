@@ -0,0 +1,764 @@
+/**
+ CMapGrid
+ @brief A class which stores the tile values of the map levels, loads them from CSV files and
+		runs the A* path finding and ray checks on them. It does not use OpenGL or the window,
+		so it can also be used by tools and benchmarks.
+ */
+#include "MapGrid.h"
+
+// Include CCollisionManager for the ray-box test
+#include "Primitives/CollisionManager.h"
+// Include CProfiler to measure the path finding
+#include "TimeControl/Profiler.h"
+
+#include <algorithm>
+#include <iostream>
+using namespace std;
+
+std::map<std::string, rapidcsv::Document> CMapGrid::mapCSVCache;
+
+/**
+ @brief Constructor
+ */
+CMapGrid::CMapGrid(void)
+	: m_weight(1)
+	, m_nrOfDirections(4)
+	, m_startPos(0, 0)
+	, m_targetPos(0, 0)
+	, arrMapInfo(NULL)
+	, uiCurLevel(0)
+	, uiNumLevels(0)
+	, uiNumRows(0)
+	, uiNumCols(0)
+	, fTileWidth(0.0f)
+	, fTileHeight(0.0f)
+{
+	m_directions = { { -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 },
+						{ -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
+}
+
+/**
+ @brief Destructor
+ */
+CMapGrid::~CMapGrid(void)
+{
+	DeleteGrid();
+
+	// Delete AStar lists
+	DeleteAStarLists();
+}
+
+/**
+ @brief Create the levels of tiles and initialise them to 0, and set up the A* lists for this size
+ @param uiNumLevels The number of levels
+ @param uiNumRows The number of rows in each level
+ @param uiNumCols The number of columns in each level
+ */
+void CMapGrid::InitGrid(const unsigned int uiNumLevels,
+						const unsigned int uiNumRows,
+						const unsigned int uiNumCols)
+{
+	DeleteGrid();
+
+	// Create the arrMapInfo and initialise to 0
+	// Start by initialising the number of levels
+	arrMapInfo = new Grid** [uiNumLevels];
+	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
+	{
+		arrMapInfo[uiLevel] = new Grid* [uiNumRows];
+		for (unsigned uiRow = 0; uiRow < uiNumRows; uiRow++)
+		{
+			arrMapInfo[uiLevel][uiRow] = new Grid[uiNumCols];
+			for (unsigned uiCol = 0; uiCol < uiNumCols; uiCol++)
+			{
+				arrMapInfo[uiLevel][uiRow][uiCol].value = 0;
+				arrMapInfo[uiLevel][uiRow][uiCol].runtimeColour = glm::vec4(0.f, 0.f, 0.f, 1.0);
+			}
+		}
+	}
+
+	uiCurLevel = 0;
+	this->uiNumLevels = uiNumLevels;
+	this->uiNumRows = uiNumRows;
+	this->uiNumCols = uiNumCols;
+
+	// Initialise the variables for AStar
+	m_weight = 1;
+	m_startPos = glm::vec2(0, 0);
+	m_targetPos = glm::vec2(0, 0);
+	m_nrOfDirections = 4;
+
+	// Resize these 2 lists
+	m_cameFromList.resize(uiNumRows * uiNumCols);
+	m_closedList.resize(uiNumRows * uiNumCols, false);
+
+	// Reserve the open list for every tile, so that the path finding does not grow it during a frame
+	std::vector<Grid> vOpenList;
+	vOpenList.reserve(uiNumRows * uiNumCols);
+	m_openList = std::priority_queue<Grid>(std::less<Grid>(), std::move(vOpenList));
+}
+
+/**
+ @brief Set the size of a tile in UV space, used by CheckIntersect
+ @param fTileWidth The width of a tile
+ @param fTileHeight The height of a tile
+ */
+void CMapGrid::SetTileSize(const float fTileWidth, const float fTileHeight)
+{
+	this->fTileWidth = fTileWidth;
+	this->fTileHeight = fTileHeight;
+}
+
+/**
+ @brief Get the number of rows in each level
+ */
+unsigned int CMapGrid::GetNumRows(void) const
+{
+	return uiNumRows;
+}
+
+/**
+ @brief Get the number of columns in each level
+ */
+unsigned int CMapGrid::GetNumCols(void) const
+{
+	return uiNumCols;
+}
+
+/**
+ @brief Load a level from a CSV file
+ @param sFilePath The full path of the CSV file
+ @param uiCurLevel The level to load the values into
+ */
+bool CMapGrid::LoadCSV(const std::string& sFilePath, const unsigned int uiCurLevel)
+{
+	if (uiCurLevel >= uiNumLevels)
+	{
+		cout << "CMapGrid::LoadCSV - Level " << uiCurLevel << " does not exist" << endl;
+		return false;
+	}
+
+	// Copy the CSV file from the cache if it was read before, otherwise read it
+	std::map<std::string, rapidcsv::Document>::const_iterator it = mapCSVCache.find(sFilePath);
+	if (it != mapCSVCache.end())
+		doc = it->second;
+	else
+		doc = rapidcsv::Document(sFilePath.c_str());
+
+	// Check if the sizes of CSV data matches the declared arrMapInfo sizes
+	if ((uiNumCols != (unsigned int)doc.GetColumnCount()) ||
+		(uiNumRows != (unsigned int)doc.GetRowCount()))
+	{
+		cout << "Sizes of CSV map does not match declared arrMapInfo sizes." << endl;
+		cout << "Num Tiles:" << uiNumCols << "X" << uiNumRows << endl;
+		cout << "Doc tiles: " << (unsigned int)doc.GetColumnCount() << "X" << (unsigned int)doc.GetRowCount() << endl;
+		return false;
+	}
+
+	// Read the rows and columns of CSV data into arrMapInfo
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		// Read a row from the CSV file
+		std::vector<std::string> row = doc.GetRow<std::string>(uiRow);
+		
+		// Load a particular CSV value into the arrMapInfo
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; ++uiCol)
+		{
+			arrMapInfo[uiCurLevel][uiRow][uiCol].value = (int)stoi(row[uiCol]);
+		}
+	}
+
+	return true;
+}
+
+/**
+ @brief Save a level to a CSV file, using the layout of the last loaded CSV file
+ @param sFilePath The full path of the CSV file
+ @param uiCurLevel The level to save
+ */
+bool CMapGrid::SaveCSV(const std::string& sFilePath, const unsigned int uiCurLevel)
+{
+	// Update the rapidcsv::Document from arrMapInfo
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			doc.SetCell(uiCol, uiRow, arrMapInfo[uiCurLevel][uiRow][uiCol].value);
+		}
+	}
+
+	// Save the rapidcsv::Document to a file
+	doc.Save(sFilePath.c_str());
+
+	// The cached copy of this file is out of date now
+	mapCSVCache.erase(sFilePath);
+
+	return true;
+}
+
+/**
+ @brief Read a CSV file into the cache, so that loading it again, e.g. when a game is restarted,
+		copies it from memory instead of reading the file
+ @param sFilePath The full path of the CSV file
+ */
+bool CMapGrid::CacheCSV(const std::string& sFilePath)
+{
+	if (mapCSVCache.count(sFilePath) != 0)
+		return true;
+
+	try
+	{
+		mapCSVCache[sFilePath] = rapidcsv::Document(sFilePath.c_str());
+	}
+	catch (const std::exception& e)
+	{
+		cout << "CMapGrid::CacheCSV - Unable to read " << sFilePath << ": " << e.what() << endl;
+		mapCSVCache.erase(sFilePath);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ @brief Remove all the CSV files from the cache
+ */
+void CMapGrid::ClearCSVCache(void)
+{
+	mapCSVCache.clear();
+}
+
+/**
+ @brief Get a copy of a CSV file from the cache, e.g. to parse it on another thread
+ @param sFilePath The full path of the CSV file
+ @param doc The copy of the CSV file
+ @return false if the CSV file is not in the cache
+ */
+bool CMapGrid::GetCachedCSV(const std::string& sFilePath, rapidcsv::Document& doc)
+{
+	std::map<std::string, rapidcsv::Document>::const_iterator it = mapCSVCache.find(sFilePath);
+	if (it == mapCSVCache.end())
+		return false;
+
+	doc = it->second;
+	return true;
+}
+
+/**
+ @brief Set the values of a level, e.g. from a level which was prepared on another thread
+ @param uiLevel The level to set the values of
+ @param vValues The values, row by row as in the CSV file of the level
+ */
+bool CMapGrid::SetLevelValues(const unsigned int uiLevel, const std::vector<unsigned int>& vValues)
+{
+	if ((uiLevel >= uiNumLevels) || (vValues.size() != uiNumRows * uiNumCols))
+	{
+		cout << "CMapGrid::SetLevelValues - The values do not match level " << uiLevel << endl;
+		return false;
+	}
+
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			arrMapInfo[uiLevel][uiRow][uiCol].value = vValues[uiRow * uiNumCols + uiCol];
+			arrMapInfo[uiLevel][uiRow][uiCol].runtimeColour = glm::vec4(0.f, 0.f, 0.f, 1.0);
+		}
+	}
+
+	return true;
+}
+
+/**
+ @brief Write the tile values of every level, and the current level, to a snapshot.
+		The values are stored as 16-bit numbers, as the tile values are far below 65536
+ @param cSnapshot The snapshot to write to
+ */
+void CMapGrid::WriteSnapshot(CSnapshotBuffer& cSnapshot) const
+{
+	cSnapshot.Write(uiNumLevels);
+	cSnapshot.Write(uiNumRows);
+	cSnapshot.Write(uiNumCols);
+	cSnapshot.Write(uiCurLevel);
+
+	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
+	{
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+		{
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+			{
+				cSnapshot.Write((unsigned short)arrMapInfo[uiLevel][uiRow][uiCol].value);
+			}
+		}
+	}
+}
+
+/**
+ @brief Read the tile values of every level, and the current level, from a snapshot.
+		Nothing is changed if the snapshot is for a map of another size
+ @param cSnapshot The snapshot to read from
+ @return false if the snapshot does not match this map
+ */
+bool CMapGrid::ReadSnapshot(CSnapshotBuffer& cSnapshot)
+{
+	unsigned int uiSnapshotLevels = 0, uiSnapshotRows = 0, uiSnapshotCols = 0, uiSnapshotCurLevel = 0;
+	cSnapshot.Read(uiSnapshotLevels);
+	cSnapshot.Read(uiSnapshotRows);
+	cSnapshot.Read(uiSnapshotCols);
+	cSnapshot.Read(uiSnapshotCurLevel);
+
+	if ((cSnapshot.HasReadError() == true) ||
+		(uiSnapshotLevels != uiNumLevels) || (uiSnapshotRows != uiNumRows) || (uiSnapshotCols != uiNumCols) ||
+		(uiSnapshotCurLevel >= uiNumLevels) ||
+		(cSnapshot.GetRemaining() < uiNumLevels * uiNumRows * uiNumCols * sizeof(unsigned short)))
+	{
+		cout << "CMapGrid::ReadSnapshot - The snapshot does not match the sizes of the map" << endl;
+		return false;
+	}
+
+	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
+	{
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+		{
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+			{
+				unsigned short usValue = 0;
+				cSnapshot.Read(usValue);
+				arrMapInfo[uiLevel][uiRow][uiCol].value = usValue;
+				arrMapInfo[uiLevel][uiRow][uiCol].runtimeColour = glm::vec4(0.f, 0.f, 0.f, 1.0);
+			}
+		}
+	}
+	uiCurLevel = uiSnapshotCurLevel;
+
+	return true;
+}
+
+/**
+ @brief Delete the levels of tiles
+ */
+void CMapGrid::DeleteGrid(void)
+{
+	if (arrMapInfo == NULL)
+		return;
+
+	// Dynamically deallocate the 3D array used to store the map information
+	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
+	{
+		for (unsigned int iRow = 0; iRow < uiNumRows; iRow++)
+		{
+			delete[] arrMapInfo[uiLevel][iRow];
+		}
+		delete [] arrMapInfo[uiLevel];
+	}
+	delete[] arrMapInfo;
+	arrMapInfo = NULL;
+}
+
+/**
+ @brief Set the value at certain indices in the arrMapInfo
+ @param iRow A const int variable containing the row index of the element to set to
+ @param iCol A const int variable containing the column index of the element to set to
+ @param iValue A const int variable containing the value to assign to this arrMapInfo
+ */
+void CMapGrid::SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert)
+{
+	if (bInvert)
+	{
+		arrMapInfo[uiCurLevel][uiNumRows - uiRow - 1][uiCol].value = iValue;
+	}
+	else
+	{
+		arrMapInfo[uiCurLevel][uiRow][uiCol].value = iValue;
+	}
+}
+
+/**
+ @brief Set the runtime colour at certain indices in the arrMapInfo, used for lighting
+ @param iRow A const int variable containing the row index of the element to set to
+ @param iCol A const int variable containing the column index of the element to set to
+ @param runtimeColour The colour to set the tile at this position to
+ */
+void CMapGrid::SetMapColour(const unsigned int uiRow, const unsigned int uiCol, const glm::vec4 runtimeColour, const bool bInvert)
+{
+	if (bInvert)
+	{
+		arrMapInfo[uiCurLevel][uiNumRows - uiRow - 1][uiCol].runtimeColour = runtimeColour;
+	}
+	else
+	{
+		arrMapInfo[uiCurLevel][uiRow][uiCol].runtimeColour = runtimeColour;
+	}
+}
+
+/**
+ @brief Get the value at certain indices in the arrMapInfo
+ @param iRow A const int variable containing the row index of the element to get from
+ @param iCol A const int variable containing the column index of the element to get from
+ @param bInvert A const bool variable which indicates if the row information is inverted
+ */
+int CMapGrid::GetMapInfo(const unsigned int uiRow, const int unsigned uiCol, const bool bInvert) const
+{
+	if (bInvert)
+		return arrMapInfo[uiCurLevel][uiNumRows - uiRow - 1][uiCol].value;
+	else
+		return arrMapInfo[uiCurLevel][uiRow][uiCol].value;
+}
+
+glm::vec4 CMapGrid::GetMapColour(const unsigned int uiRow, const int unsigned uiCol, const bool bInvert) const
+{
+	if (bInvert)
+		return arrMapInfo[uiCurLevel][uiNumRows - uiRow - 1][uiCol].runtimeColour;
+	else
+		return arrMapInfo[uiCurLevel][uiRow][uiCol].runtimeColour;
+}
+
+/**
+@brief Find the indices of a certain value in arrMapInfo
+@param iValue A const int variable containing the row index of the found element
+@param iRow A const int variable containing the row index of the found element
+@param iCol A const int variable containing the column index of the found element
+@param bInvert A const bool variable which indicates if the row information is inverted
+*/
+bool CMapGrid::FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert)
+{
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			if (arrMapInfo[uiCurLevel][uiRow][uiCol].value == static_cast<unsigned int>(iValue))
+			{
+				if (bInvert)
+					uirRow = uiNumRows - uiRow - 1;
+				else
+					uirRow = uiRow;
+				uirCol = uiCol;
+				return true;	// Return true immediately if the value has been found
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ @brief Set current level
+ */
+void CMapGrid::SetCurrentLevel(unsigned int uiCurLevel)
+{
+	if (uiCurLevel < uiNumLevels)
+	{
+		this->uiCurLevel = uiCurLevel;
+	}
+}
+
+/**
+ @brief Get current level
+ */
+unsigned int CMapGrid::GetCurrentLevel(void) const
+{
+	return uiCurLevel;
+}
+
+/**
+ @brief Shorten a ray so that it ends at the first collidable tile within 10 tiles of the enemy
+ @param enemy_index The tile indices of the enemy
+ @param enemy_UVpos The UV coordinates of the enemy, which is the origin of the ray
+ @param ray_direction The direction of the ray
+ @param ray_length The length of the ray, which is shortened if it hits a collidable tile
+ */
+void CMapGrid::CheckIntersect(glm::vec2 enemy_index, glm::vec2 enemy_UVpos, glm::vec3 ray_direction, float& ray_length )
+{
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			if (uiRow <= enemy_index.y + 10 && uiRow >= enemy_index.y - 10 &&
+				uiCol <= enemy_index.x + 10 && uiCol >= enemy_index.x - 10)
+			{
+				glm::mat4 tileTransform;
+				tileTransform = glm::mat4(1.f);
+				// Top left corner is half a tile in from (-1, 1), e.g. (-0.9875, 0.977778) for 80 x 45 tiles.
+				// Each tile is +fTileWidth to X and -fTileHeight to Y
+				float xTranslate = -1.0f + fTileWidth * 0.5f + (uiCol * fTileWidth);
+				float yTranslate = 1.0f - fTileHeight * 0.5f - ((uiNumRows - uiRow) * fTileHeight);
+				tileTransform = glm::translate(tileTransform, glm::vec3(xTranslate, yTranslate, 0));
+
+				float intersectionDist = 9999;
+				if (CCollisionManager::RayOBBCollision(
+					glm::vec3(enemy_UVpos.x, enemy_UVpos.y, 0.f),
+					ray_direction,
+					glm::vec3(-fTileWidth, -fTileHeight * 0.5, -1.f),
+					glm::vec3(fTileWidth, fTileHeight, 1.f),
+					tileTransform,
+					intersectionDist))
+				{
+					// Cut off ray when hit a wall, only highlight tiles that are within the distance
+					if (intersectionDist <= ray_length)
+					{
+						if (GetMapInfo(uiRow, uiCol) >= 100)
+						{
+							ray_length = intersectionDist;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ @brief Find a path
+ @param startPos The indices of the start tile
+ @param targetPos The indices of the target tile
+ @param heuristicFunc The heuristic function
+ @param weight The weight of the heuristic
+ @return The path, allocated from the frame arena of the calling thread. It must not be kept after the frame
+ */
+FrameVector<glm::vec2> CMapGrid::PathFind(const glm::vec2& startPos, const glm::vec2& targetPos, const HeuristicFunction& heuristicFunc, int weight)
+{
+	PROFILE_SCOPE("CMapGrid::PathFind");
+
+	// Check if the startPos and targetPost are blocked
+	if (isBlocked(startPos.y, startPos.x) ||
+		(isBlocked(targetPos.y, targetPos.x)))
+	{
+		//cout << "Invalid start or target position." << endl;
+		// Return an empty path
+		return FrameVector<glm::vec2>();
+	}
+
+	// Set up the variables and lists
+	m_startPos = startPos;
+	m_targetPos = targetPos;
+	m_weight = weight;
+	m_heuristic = heuristicFunc;
+
+	// Reset AStar lists
+	ResetAStarLists();
+
+	// Add the start pos to 2 lists
+	m_cameFromList[ConvertTo1D(m_startPos)].parent = m_startPos;
+	m_openList.push(Grid(m_startPos, 0));
+
+	unsigned int fNew, gNew, hNew;
+	glm::vec2 currentPos;
+
+	// Start the path finding...
+	while (!m_openList.empty())
+	{
+		// Get the node with the least f value
+		currentPos = m_openList.top().pos;
+		//cout << endl << "*** New position to check: " << currentPos.x << ", " << currentPos.y << endl;
+		//cout << "*** targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
+
+		// If the targetPos was reached, then quit this loop
+		if (currentPos == m_targetPos)
+		{
+			//cout << "=== Found the targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
+			while (m_openList.size() != 0)
+				m_openList.pop();
+			break;
+		}
+
+		m_openList.pop();
+		m_closedList[ConvertTo1D(currentPos)] = true;
+
+		// Check the neighbors of the current node
+		for (unsigned int i = 0; i < m_nrOfDirections; ++i)
+		{
+			const auto neighborPos = currentPos + m_directions[i];
+			const auto neighborIndex = ConvertTo1D(neighborPos);
+
+			//cout << "\t#" << i << ": Check this: " << neighborPos.x << ", " << neighborPos.y << ":\t";
+			if (!isValid(neighborPos) ||
+				isBlocked(neighborPos.y, neighborPos.x) ||
+				m_closedList[neighborIndex] == true)
+			{
+				//cout << "This position is not valid. Going to next neighbour." << endl;
+				continue;
+			}
+
+			gNew = m_cameFromList[ConvertTo1D(currentPos)].g + 1; //NOTE: This restricts enemy movement to only linear, no diagonal. If want diagonal jumping, need algorithm to calculate whether + 1 or + 1.414
+			hNew = m_heuristic(neighborPos, m_targetPos, m_weight);
+			fNew = gNew + hNew;
+
+			if (m_cameFromList[neighborIndex].f == 0 || fNew < m_cameFromList[neighborIndex].f)
+			{
+				//cout << "Adding to Open List: " << neighborPos.x << ", " << neighborPos.y;
+				//cout << ". [ f : " << fNew << ", g : " << gNew << ", h : " << hNew << "]" << endl;
+				m_openList.push(Grid(neighborPos, fNew));
+				m_cameFromList[neighborIndex] = { neighborPos, currentPos, fNew, gNew, hNew };
+			}
+			else
+			{
+				//cout << "Not adding this" << endl;
+			}
+		}
+		//system("pause");
+	}
+
+	return BuildPath();
+}
+
+/**
+ @brief Build a path from m_cameFromList. The path is counted first, so that it is allocated once
+		and filled from the back instead of being grown and reversed.
+ @return The path, allocated from the frame arena of the calling thread
+ */
+FrameVector<glm::vec2> CMapGrid::BuildPath() const
+{
+	FrameVector<glm::vec2> path;
+
+	// Count the number of steps from the target back to the start
+	unsigned int uiNumSteps = 0;
+	auto currentPos = m_targetPos;
+	auto currentIndex = ConvertTo1D(currentPos);
+	while (!(m_cameFromList[currentIndex].parent == currentPos))
+	{
+		uiNumSteps++;
+		currentPos = m_cameFromList[currentIndex].parent;
+		currentIndex = ConvertTo1D(currentPos);
+	}
+
+	// If the path has only 1 entry, then it is the the target position
+	if (uiNumSteps == 1)
+	{
+		// if m_startPos is next to m_targetPos, then having 1 path point is OK
+		if (m_nrOfDirections == 4)
+		{
+			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
+				return path;
+		}
+		else //check for 8 directions (including diagonals)
+		{
+			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 2)
+				return path;
+			else if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
+				return path;
+		}
+	}
+
+	// Fill the path from the back, so that it goes from the start to the target
+	path.resize(uiNumSteps);
+	currentPos = m_targetPos;
+	currentIndex = ConvertTo1D(currentPos);
+	for (unsigned int i = uiNumSteps; i > 0; i--)
+	{
+		path[i - 1] = currentPos;
+		currentPos = m_cameFromList[currentIndex].parent;
+		currentIndex = ConvertTo1D(currentPos);
+	}
+
+	return path;
+}
+
+/**
+ @brief Toggle the checks for diagonal movements
+ */
+void CMapGrid::SetDiagonalMovement(const bool bEnable)
+{
+	m_nrOfDirections = (bEnable) ? 8 : 4;
+}
+
+/**
+ @brief Check if a position is valid
+ */
+bool CMapGrid::isValid(const glm::vec2& pos) const
+{
+	//return (pos.x >= 0) && (pos.x < m_dimensions.x) &&
+	//	(pos.y >= 0) && (pos.y < m_dimensions.y);
+	return (pos.x >= 0) && (pos.x < uiNumCols) &&
+		(pos.y >= 0) && (pos.y < uiNumRows);
+}
+
+/**
+ @brief Check if a grid is blocked
+ */
+bool CMapGrid::isBlocked(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert) const
+{
+	if (bInvert == true)
+	{
+		if ((arrMapInfo[uiCurLevel][uiNumRows - uiRow - 1][uiCol].value >= 100) &&
+			(arrMapInfo[uiCurLevel][uiNumRows - uiRow - 1][uiCol].value < 200))
+			return true;
+		else
+			return false;
+	}
+	else
+	{
+		if ((arrMapInfo[uiCurLevel][uiRow][uiCol].value >= 100) &&
+			(arrMapInfo[uiCurLevel][uiRow][uiCol].value < 200))
+			return true;
+		else
+			return false;
+	}
+}
+
+/**
+ @brief Returns a 1D index based on a 2D coordinate using row-major layout
+ */
+int CMapGrid::ConvertTo1D(const glm::vec2& pos) const
+{
+	//return (pos.y * m_dimensions.x) + pos.x;
+	return (pos.y * uiNumCols) + pos.x;
+}
+
+/**
+ @brief Delete AStar lists
+ */
+bool CMapGrid::DeleteAStarLists(void)
+{
+	// Delete m_openList
+	while (m_openList.size() != 0)
+		m_openList.pop();
+	// Delete m_cameFromList
+	m_cameFromList.clear();
+	// Delete m_closedList
+	m_closedList.clear();
+
+	return true;
+}
+
+/**
+ @brief Reset AStar lists
+ */
+bool CMapGrid::ResetAStarLists(void)
+{
+	// Delete m_openList
+	while (m_openList.size() != 0)
+		m_openList.pop();
+	// Reset m_cameFromList
+	for (size_t i = 0; i < m_cameFromList.size(); i++)
+	{
+		m_cameFromList[i].pos = glm::vec2(0, 0);
+		m_cameFromList[i].parent = glm::vec2(0, 0);
+		m_cameFromList[i].f = 0;
+		m_cameFromList[i].g = 0;
+		m_cameFromList[i].h = 0;
+	}
+	// Reset m_closedList
+	for (size_t i = 0; i < m_closedList.size(); i++)
+	{
+		m_closedList[i] = false;
+	}
+
+	return true;
+}
+
+/**
+ @brief manhattan calculation method for calculation of h
+ */
+unsigned int heuristic::manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight)
+{
+	glm::vec2 delta = v2 - v1;
+	return static_cast<unsigned int>(weight * (delta.x + delta.y));
+}
+
+/**
+ @brief euclidean calculation method for calculation of h
+ */
+unsigned int heuristic::euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight)
+{
+	glm::vec2 delta = v2 - v1;
+	return static_cast<unsigned int>(weight * sqrt((delta.x * delta.x) + (delta.y * delta.y)));
+}
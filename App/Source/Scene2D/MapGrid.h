@@ -0,0 +1,193 @@
+/**
+ CMapGrid
+ @brief A class which stores the tile values of the map levels, loads them from CSV files and
+		runs the A* path finding and ray checks on them. It does not use OpenGL or the window,
+		so it can also be used by tools and benchmarks.
+ */
+#pragma once
+#include <queue>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Include GLM
+#include <includes/glm.hpp>
+#include <includes/gtc/matrix_transform.hpp>
+#include <includes/gtc/type_ptr.hpp>
+
+// Include the RapidCSV
+#include "System/rapidcsv.h"
+
+// Include CFrameArena for the paths, which only live for a frame
+#include "System/FrameArena.h"
+// Include CSnapshotBuffer for the save games
+#include "System/SnapshotBuffer.h"
+
+// A structure storing information about Map Sizes
+struct MapSize {
+	unsigned int uiRowSize;
+	unsigned int uiColSize;
+};
+
+// A structure storing information about a map grid
+// It includes data to be used for A* Path Finding
+struct Grid {
+	unsigned int value;
+	glm::vec4 runtimeColour;
+
+	Grid()
+		: value(0), runtimeColour(0, 0, 0, 1), pos(0, 0), parent(-1, -1), f(0), g(0), h(0) {}
+	Grid(	const glm::vec2& pos, unsigned int f) 
+		: value(0), runtimeColour(0, 0, 0, 1), pos(pos), parent(-1, 1), f(f), g(0), h(0) {}
+	Grid(	const glm::vec2& pos, const glm::vec2& parent, 
+			unsigned int f, unsigned int g, unsigned int h) 
+		: value(0), runtimeColour(0, 0, 0, 1), pos(pos), parent(parent), f(f), g(g), h(h) {}
+
+	glm::vec2 pos;
+	glm::vec2 parent;
+	unsigned int f;
+	unsigned int g;
+	unsigned int h;
+};
+
+using HeuristicFunction = std::function<unsigned int(const glm::vec2&, const glm::vec2&, int)>;
+// Reverse std::priority_queue to get the smallest element on top
+inline bool operator< (const Grid& a, const Grid& b) { return b.f < a.f; }
+
+namespace heuristic
+{
+	unsigned int manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight);
+	unsigned int euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight);
+}
+
+class CMapGrid
+{
+public:
+	// Constructor
+	CMapGrid(void);
+
+	// Destructor
+	virtual ~CMapGrid(void);
+
+	// Create the levels of tiles, and set up the A* lists for this size
+	void InitGrid(	const unsigned int uiNumLevels,
+					const unsigned int uiNumRows,
+					const unsigned int uiNumCols);
+
+	// Set the size of a tile in UV space, used by CheckIntersect
+	void SetTileSize(const float fTileWidth, const float fTileHeight);
+
+	// Get the number of rows and columns of the levels
+	unsigned int GetNumRows(void) const;
+	unsigned int GetNumCols(void) const;
+
+	// Set the value at certain indices in the arrMapInfo
+	void SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert = true);
+
+	// Set the runtime colour at certain indices in the arrMapInfo
+	void SetMapColour(const unsigned int uiRow, const unsigned int uiCol, const glm::vec4 runtimeColour, const bool bInvert = true);
+
+	// Get the value at certain indices in the arrMapInfo
+	int GetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const;
+
+	// Get the runtime colour at certain indices, used for enemies
+	glm::vec4 GetMapColour(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const;
+
+	// Load a level from a CSV file at this path
+	bool LoadCSV(const std::string& sFilePath, const unsigned int uiLevel = 0);
+
+	// Save a level to a CSV file at this path
+	bool SaveCSV(const std::string& sFilePath, const unsigned int uiLevel = 0);
+
+	// Set the values of a level, row by row as in its CSV file, e.g. from a level prepared on another thread
+	bool SetLevelValues(const unsigned int uiLevel, const std::vector<unsigned int>& vValues);
+
+	// Read a CSV file into the cache, so that LoadCSV copies it from memory instead of reading the file
+	static bool CacheCSV(const std::string& sFilePath);
+	// Remove all the CSV files from the cache
+	static void ClearCSVCache(void);
+	// Get a copy of a CSV file from the cache
+	static bool GetCachedCSV(const std::string& sFilePath, rapidcsv::Document& doc);
+
+	// Write the tile values of every level, and the current level, to a snapshot
+	virtual void WriteSnapshot(CSnapshotBuffer& cSnapshot) const;
+	// Read the tile values of every level, and the current level, from a snapshot
+	virtual bool ReadSnapshot(CSnapshotBuffer& cSnapshot);
+
+	// Find the indices of a certain value in arrMapInfo
+	bool FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert = true);
+
+	// Set current level
+	void SetCurrentLevel(unsigned int uiCurLevel);
+	// Get current level
+	unsigned int GetCurrentLevel(void) const;
+
+	// For AStar PathFinding. The path is allocated from the frame arena of the calling thread
+	FrameVector<glm::vec2> PathFind(const glm::vec2& startPos, const glm::vec2& targetPos, const HeuristicFunction& heuristicFunc, int weight = 1);
+	// Set if AStar PathFinding will consider diagonal movements
+	void SetDiagonalMovement(const bool bEnable);
+
+	// Essentially TestOBBIntersection but to be used for Enemy class, simply pass in the ray direction
+	// Changes the ray length such that it ends when hit a collidable block
+	void CheckIntersect(
+		glm::vec2 enemy_index,
+		glm::vec2 enemy_UVpos,
+		glm::vec3 ray_direction,
+		float& ray_length
+	);
+
+protected:
+	// For A-Star PathFinding
+	// Build a path from m_cameFromList after calling PathFind()
+	FrameVector<glm::vec2> BuildPath() const;
+	// Check if a grid is valid
+	bool isValid(const glm::vec2& pos) const;
+	// Check if a grid is blocked
+	bool isBlocked(const unsigned int uiRow,
+		const unsigned int uiCol,
+		const bool bInvert = true) const;
+	// Convert a position to a 1D position in the array
+	int ConvertTo1D(const glm::vec2& pos) const;
+
+	// Delete AStar lists
+	bool DeleteAStarLists(void);
+
+	// Reset AStar lists
+	bool ResetAStarLists(void);
+
+	// Delete the levels of tiles
+	void DeleteGrid(void);
+
+	int m_weight;
+	unsigned int m_nrOfDirections;
+	glm::vec2 m_startPos;
+	glm::vec2 m_targetPos;
+
+	std::priority_queue<Grid> m_openList;
+	std::vector<bool> m_closedList;
+	std::vector<Grid> m_cameFromList;
+	std::vector<glm::vec2> m_directions;
+	HeuristicFunction m_heuristic;
+
+	// The variable containing the rapidcsv::Document
+	// We will load the CSV file's content into this Document
+	rapidcsv::Document doc;
+
+	// The CSV files which were read by CacheCSV, by their paths. They are shared by every CMapGrid
+	static std::map<std::string, rapidcsv::Document> mapCSVCache;
+
+	// A 3-D array which stores the values of the tile map
+	Grid*** arrMapInfo;
+
+	// The current level
+	unsigned int uiCurLevel;
+	// The number of levels
+	unsigned int uiNumLevels;
+	// The number of rows and columns in each level
+	unsigned int uiNumRows;
+	unsigned int uiNumCols;
+	// The size of a tile in UV space
+	float fTileWidth;
+	float fTileHeight;
+};
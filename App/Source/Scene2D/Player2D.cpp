@@ -6,14 +6,23 @@
  */
 #include "Player2D.h"
 
+// Include CMemoryTracker to count the OpenGL objects
+#include "System\MemoryTracker.h"
+
 #include <iostream>
 using namespace std;
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "RenderControl\GLStateCache.h"
+// Include CSpriteBatch
+#include "RenderControl\SpriteBatch.h"
 
 // Include ImageLoader
 #include "System\ImageLoader.h"
+// Include CSnapshotBuffer for the save games
+#include "System\SnapshotBuffer.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
@@ -76,7 +85,8 @@ CPlayer2D::~CPlayer2D(void)
 	camera = NULL;
 
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
+	CGLStateCache::GetInstance()->DeleteVertexArrays(1, &VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, -1);
 }
 
 /**
@@ -113,7 +123,8 @@ bool CPlayer2D::Init(void)
 	vec2NumMicroSteps = glm::i32vec2(0, 0);
 
 	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
 	
 	// Load the player texture 
 	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/scene2d_player2.png", true);
@@ -126,17 +137,19 @@ bool CPlayer2D::Init(void)
 	//CS: Create the animated sprite and setup the animation
 	//NOTE, TODO: FOR DOUBLE SPRITE HEIGHT JUST DO CSETTINGS->TILE_HEIGHT * 2
 	animatedSprites = CMeshBuilder::GenerateSpriteAnimation(8, 20, cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-	animatedSprites->AddAnimation("right", 0, 19);
-	animatedSprites->AddAnimation("left", 20, 39);
-	animatedSprites->AddAnimation("up", 40, 59);
-	animatedSprites->AddAnimation("down", 60, 79);
-	animatedSprites->AddAnimation("idleRight", 80, 99);
-	animatedSprites->AddAnimation("idleLeft", 100, 119);
-	animatedSprites->AddAnimation("idleDown", 120, 139);
-	animatedSprites->AddAnimation("idleUp", 140, 159);
+	arrAnimationIDs[ANIM_RIGHT] = animatedSprites->AddAnimation("right", 0, 19);
+	arrAnimationIDs[ANIM_LEFT] = animatedSprites->AddAnimation("left", 20, 39);
+	arrAnimationIDs[ANIM_UP] = animatedSprites->AddAnimation("up", 40, 59);
+	arrAnimationIDs[ANIM_DOWN] = animatedSprites->AddAnimation("down", 60, 79);
+	arrAnimationIDs[ANIM_IDLE_RIGHT] = animatedSprites->AddAnimation("idleRight", 80, 99);
+	arrAnimationIDs[ANIM_IDLE_LEFT] = animatedSprites->AddAnimation("idleLeft", 100, 119);
+	arrAnimationIDs[ANIM_IDLE_DOWN] = animatedSprites->AddAnimation("idleDown", 120, 139);
+	arrAnimationIDs[ANIM_IDLE_UP] = animatedSprites->AddAnimation("idleUp", 140, 159);
+	// The sprite sheet has no death animation yet, so this is INVALID_ANIMATION, which is not played
+	arrAnimationIDs[ANIM_DEATH] = animatedSprites->GetAnimationID("death");
 	//CS: Play the "idle" animation as default
 	// PlayAnimation(animName, loopCount, every ? seconds). Eg, "down", 5, 1.0f means loop anim 5 times every 1s. -1 loops infinitely/
-	animatedSprites->PlayAnimation("idleUp", -1, 0.8f);
+	animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_IDLE_UP], -1, 0.8f);
 
 
 	//CS: Init the color to white
@@ -144,7 +157,8 @@ bool CPlayer2D::Init(void)
 
 	// Create the quad mesh for the player
 	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
 	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
 
 	// Set the physics to fall status by default
@@ -286,7 +300,7 @@ bool CPlayer2D::Reset()
 
 	//CS: Play the "down" animation as default
 	// PlayAnimation(animName, loopCount, every ? seconds). Eg, "down", 5, 1.0f means loop anim 5 times every 1s. -1 loops infinitely/
-	animatedSprites->PlayAnimation("idleRight", -1, 1.f);
+	animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_IDLE_RIGHT], -1, 1.f);
 
 	//Reset attack
 	iAttackCount = 0;
@@ -359,8 +373,8 @@ void CPlayer2D::Update(const double dElapsedTime)
 		}
 
 		//CS: Play the "left" animation
-		animatedSprites->PlayAnimation("left", -1, 0.2f);
-		cSoundController->PlaySoundByID(10);
+		animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_LEFT], -1, 0.2f);
+		cSoundController->PlaySoundByID(SOUND_STEP);
 			
 	}
 	else if (cKeyboardController->IsKeyDown(GLFW_KEY_D))
@@ -389,8 +403,8 @@ void CPlayer2D::Update(const double dElapsedTime)
 		}
 
 		//CS: Play the "right" animation
-		animatedSprites->PlayAnimation("right", -1, 0.2f);
-		cSoundController->PlaySoundByID(10);
+		animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_RIGHT], -1, 0.2f);
+		cSoundController->PlaySoundByID(SOUND_STEP);
 	}
 
 	if (cKeyboardController->IsKeyDown(GLFW_KEY_W))
@@ -420,8 +434,8 @@ void CPlayer2D::Update(const double dElapsedTime)
 		}
 
 		//CS: Play the "left" animation
-		animatedSprites->PlayAnimation("up", -1, 0.2f);
-		cSoundController->PlaySoundByID(10);
+		animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_UP], -1, 0.2f);
+		cSoundController->PlaySoundByID(SOUND_STEP);
 	}
 	else if (cKeyboardController->IsKeyDown(GLFW_KEY_S))
 	{
@@ -448,8 +462,8 @@ void CPlayer2D::Update(const double dElapsedTime)
 		}
 
 		//CS: Play the "right" animation
-		animatedSprites->PlayAnimation("down", -1, 0.2f);
-		cSoundController->PlaySoundByID(10);
+		animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_DOWN], -1, 0.2f);
+		cSoundController->PlaySoundByID(SOUND_STEP);
 	}
 
 	
@@ -457,13 +471,13 @@ void CPlayer2D::Update(const double dElapsedTime)
 	{
 		//CS: Play the "idle" animation by default, if not jumping/falling as well
 		if (dir == DIRECTION::LEFT)
-			animatedSprites->PlayAnimation("idleLeft", -1, 1.f);
+			animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_IDLE_LEFT], -1, 1.f);
 		else if (dir == DIRECTION::RIGHT)
-			animatedSprites->PlayAnimation("idleRight", -1, 1.f);
+			animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_IDLE_RIGHT], -1, 1.f);
 		else if (dir == DIRECTION::UP)
-			animatedSprites->PlayAnimation("idleUp", -1, 1.f);
+			animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_IDLE_UP], -1, 1.f);
 		else if (dir == DIRECTION::DOWN)
-			animatedSprites->PlayAnimation("idleDown", -1, 1.f);
+			animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_IDLE_DOWN], -1, 1.f);
 	}
 	
 	//Flashlight 
@@ -573,7 +587,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 			cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 2) == 2)
 		{
 			//cout << "player push box left" << endl;
-			cSoundController->PlaySoundByID(6);
+			cSoundController->PlaySoundByID(SOUND_BOX_MOVE);
 			setEBox(true);
 			//Set box into new position
 			cMap2D->SetMapInfo(vec2Index.y, vec2Index.x - 2, 110);
@@ -586,7 +600,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 			cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x - 2) == 2)
 		{
 			//cout << "player push box left" << endl;
-			cSoundController->PlaySoundByID(6);
+			cSoundController->PlaySoundByID(SOUND_BOX_MOVE);
 			setEBox(true);
 			//Set box into new position
 			cMap2D->SetMapInfo(vec2Index.y + 1, vec2Index.x - 2, 110);
@@ -601,7 +615,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 			cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 2) == 2)
 		{
 		//	cout << "player push box right" << endl;
-			cSoundController->PlaySoundByID(6);
+			cSoundController->PlaySoundByID(SOUND_BOX_MOVE);
 			setEBox(true);
 			//Set box into new position
 			cMap2D->SetMapInfo(vec2Index.y, vec2Index.x + 2, 110);
@@ -614,7 +628,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 			cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 2) == 2)
 		{
 		//	cout << "player push box right" << endl;
-			cSoundController->PlaySoundByID(6);
+			cSoundController->PlaySoundByID(SOUND_BOX_MOVE);
 			setEBox(true);
 			//Set box into new position
 			cMap2D->SetMapInfo(vec2Index.y + 1, vec2Index.x + 2, 110);
@@ -629,7 +643,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 			cMap2D->GetMapInfo(vec2Index.y - 2, vec2Index.x) == 2)
 		{
 		//	cout << "player push box down" << endl;
-			cSoundController->PlaySoundByID(6);
+			cSoundController->PlaySoundByID(SOUND_BOX_MOVE);
 			setEBox(true);
 			//Set box into new position
 			cMap2D->SetMapInfo(vec2Index.y - 2, vec2Index.x, 110);
@@ -642,7 +656,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 			cMap2D->GetMapInfo(vec2Index.y - 2, vec2Index.x + 1) == 2)
 		{
 			//	cout << "player push box down" << endl;
-			cSoundController->PlaySoundByID(6);
+			cSoundController->PlaySoundByID(SOUND_BOX_MOVE);
 			setEBox(true);
 			//Set box into new position
 			cMap2D->SetMapInfo(vec2Index.y - 2, vec2Index.x + 1, 110);
@@ -664,7 +678,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 			//Remove box from original position
 			cMap2D->SetMapInfo(vec2Index.y + 1, vec2Index.x, 2);
 			boxElapsed = 0;
-			cSoundController->PlaySoundByID(6);
+			cSoundController->PlaySoundByID(SOUND_BOX_MOVE);
 		}
 		else if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) == 110 &&			//if player is on bottom left of the box
 			vec2NumMicroSteps.x >= offsetX &&
@@ -677,7 +691,7 @@ void CPlayer2D::Update(const double dElapsedTime)
 			//Remove box from original position
 			cMap2D->SetMapInfo(vec2Index.y + 1, vec2Index.x + 1, 2);
 			boxElapsed = 0;
-			cSoundController->PlaySoundByID(6);
+			cSoundController->PlaySoundByID(SOUND_BOX_MOVE);
 		}
 
 	}
@@ -706,12 +720,7 @@ void CPlayer2D::Update(const double dElapsedTime)
  */
 void CPlayer2D::PreRender(void)
 {
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	// The sprite batch sets the blending mode and shader when it is flushed
 }
 
 /**
@@ -719,69 +728,22 @@ void CPlayer2D::PreRender(void)
  */
 void CPlayer2D::Render(void)
 {
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	//unsigned int MVLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "MV");
-	//unsigned int inverseLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "MV_inverse_transpose");
-	//unsigned int ambientLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "material.kAmbient");
-	//unsigned int diffuseLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "material.kDiffuse");
-	//unsigned int specularLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "material.kSpecular");
-	//unsigned int shininessLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "material.kShininess");
-
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-	glm::mat4 MVP = camera->GetMVP();
-	glm::mat4 transformMVP;
-	//transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	//transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-	//												vec2UVCoordinate.y,
-	//												0.0f));
-	// 
-	transformMVP = MVP; // make sure to initialize matrix to identity matrix first
-	transformMVP = glm::translate(transformMVP, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
+	// Render between the last two simulation ticks
+	glm::vec2 vec2RenderUVCoordinate = GetInterpolatedUVCoordinate();
+	glm::mat4 transformMVP = camera->GetMVP();
+	transformMVP = glm::translate(transformMVP, glm::vec3(vec2RenderUVCoordinate.x,
+		vec2RenderUVCoordinate.y,
 		0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transformMVP));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
-
-	//glm::mat4 MV = camera->GetMV();
-	//glm::mat4 transformMV = MV; // init to original matrix
-	//transformMV = glm::translate(transformMV, glm::vec3(vec2UVCoordinate.x,
-	//	vec2UVCoordinate.y,
-	//	0.0f));
-	//glUniformMatrix4fv(MVLoc, 1, GL_FALSE, &transformMV[0][0]);
-
-	//glm::mat4 MV_inverse_transpose = glm::transpose(glm::inverse(transformMVP));
-	//glUniformMatrix4fv(inverseLoc, 1, GL_FALSE, &MV_inverse_transpose[0][0]);
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-	//glUniform3fv(ambientLoc, 1, &quadMesh->material.kAmbient.r);
-	//glUniform3fv(diffuseLoc, 1, &quadMesh->material.kDiffuse.r);
-	//glUniform3fv(specularLoc, 1, &quadMesh->material.kSpecular.r);
-	//glUniform1f(shininessLoc, quadMesh->material.kShininess);
-
-	//CS: Render the animated sprite
-	glBindVertexArray(VAO);
-	animatedSprites->Render();
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
-
-	//// bind textures on corresponding texture units
-	//glActiveTexture(GL_TEXTURE0);
-	//// Get the texture to be rendered
-	//glBindTexture(GL_TEXTURE_2D, iTextureID);
-	//	//Render the Player sprite
-	//	glBindVertexArray(VAO);
-	//	quadMesh->Render();
-	//	glBindVertexArray(0);
-	//glBindTexture(GL_TEXTURE_2D, 0);
+
+	//CS: Add the current frame of the animated sprite to the sprite batch
+	CSpriteBatch::GetInstance()->DrawFrame(SPRITE_LAYER_PLAYER,
+										   iTextureID,
+										   transformMVP,
+										   glm::vec2(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT),
+										   animatedSprites->GetCurrentFrame(),
+										   animatedSprites->GetSpriteSheet().GetNumRows(),
+										   animatedSprites->GetSpriteSheet().GetNumCols(),
+										   runtimeColour);
 }
 
 /**
@@ -789,8 +751,6 @@ void CPlayer2D::Render(void)
  */
 void CPlayer2D::PostRender(void)
 {
-	// Disable blending
-	glDisable(GL_BLEND);
 }
 
 /**
@@ -971,14 +931,14 @@ void CPlayer2D::InteractWithMap(void)
 		cInventoryItem = cInventoryManager->GetItem("Paper");
 		oldpapercount = cInventoryItem->GetCount();
 		cInventoryItem->Add(1);
-		cSoundController->PlaySoundByID(13);
+		cSoundController->PlaySoundByID(SOUND_PAPER_PICKUP);
 		collected = true;
 		break;
 	case 80:
 		cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 2);
 		cInventoryItem = cInventoryManager->GetItem("Flashlight");
 		cInventoryItem->Add(cInventoryItem->GetMaxCount() - cInventoryItem->GetCount());
-		cSoundController->PlaySoundByID(28);
+		cSoundController->PlaySoundByID(SOUND_BATTERY_PICKUP);
 		break;
 	case 91:
 		CGameManager::GetInstance()->bPlayerWon = true;
@@ -1011,7 +971,7 @@ void CPlayer2D::InteractWithMap(void)
 		cInventoryItem = cInventoryManager->GetItem("Paper");
 		oldpapercount = cInventoryItem->GetCount();
 		cInventoryItem->Add(1);
-		cSoundController->PlaySoundByID(13);
+		cSoundController->PlaySoundByID(SOUND_PAPER_PICKUP);
 		collected = true;
 	}
 	if ((cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) == 75 ||
@@ -1026,7 +986,7 @@ void CPlayer2D::InteractWithMap(void)
 		cInventoryItem = cInventoryManager->GetItem("Paper");
 		oldpapercount = cInventoryItem->GetCount();
 		cInventoryItem->Add(1);
-		cSoundController->PlaySoundByID(13);
+		cSoundController->PlaySoundByID(SOUND_PAPER_PICKUP);
 		collected = true;
 	}
 
@@ -1036,14 +996,14 @@ void CPlayer2D::InteractWithMap(void)
 		cMap2D->SetMapInfo(vec2Index.y, vec2Index.x + 1, 2);
 		cInventoryItem = cInventoryManager->GetItem("Flashlight");
 		cInventoryItem->Add(cInventoryItem->GetMaxCount() - cInventoryItem->GetCount());
-		cSoundController->PlaySoundByID(28);
+		cSoundController->PlaySoundByID(SOUND_BATTERY_PICKUP);
 	}
 	if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) == 80 && vec2NumMicroSteps.y > 10)
 	{
 		cMap2D->SetMapInfo(vec2Index.y+1, vec2Index.x, 2);
 		cInventoryItem = cInventoryManager->GetItem("Flashlight");
 		cInventoryItem->Add(cInventoryItem->GetMaxCount() - cInventoryItem->GetCount());
-		cSoundController->PlaySoundByID(28);
+		cSoundController->PlaySoundByID(SOUND_BATTERY_PICKUP);
 	}
 }
 
@@ -1058,7 +1018,7 @@ void CPlayer2D::UpdateHealthLives(void)
 	if (cInventoryItem->GetCount() == 0)
 	{
 		CGameManager::GetInstance()->bPlayerLost = true;
-		animatedSprites->PlayAnimation("death", 1, 3.0f);
+		animatedSprites->PlayAnimation(arrAnimationIDs[ANIM_DEATH], 1, 3.0f);
 		runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
 		iframeElapsed = 0;
 		deadElapsed += 0.01;
@@ -1075,7 +1035,7 @@ void CPlayer2D::DamagePlayer(int eDirection)
 		cInventoryItem = cInventoryManager->GetItem("Health");
 		cInventoryItem->Remove(1);
 		iframeElapsed = 0;
-		cSoundController->PlaySoundByID(9);
+		cSoundController->PlaySoundByID(SOUND_PLAYER_DAMAGED);
 
 		////Knockback player a bit depending on direction
 		//if (eDirection == DIRECTION::LEFT)
@@ -1189,3 +1149,86 @@ int CPlayer2D::getitemTracked()
 {
 	return itemTracked;
 }
+
+/**
+ @brief Write the position, timers and radar of the player to a snapshot
+ @param cSnapshot The snapshot to write to
+ */
+void CPlayer2D::WriteSnapshot(CSnapshotBuffer& cSnapshot) const
+{
+	cSnapshot.Write(vec2Index);
+	cSnapshot.Write(vec2NumMicroSteps);
+	cSnapshot.Write(vec2UVCoordinate);
+	cSnapshot.Write(vec2OldIndex);
+	cSnapshot.Write(tempOldVec);
+	cSnapshot.Write(runtimeColour);
+	cSnapshot.Write(cPhysics2D.GetStatus());
+	cSnapshot.Write(dir);
+
+	cSnapshot.Write(iJumpCount);
+	cSnapshot.Write(lastAttackElapsed);
+	cSnapshot.Write(iAttackCount);
+	cSnapshot.Write(iframeElapsed);
+	cSnapshot.Write(deadElapsed);
+	cSnapshot.Write(focusElapsed);
+	cSnapshot.Write(boxElapsed);
+	cSnapshot.Write(flashlightElapsed);
+	cSnapshot.Write(eBox);
+
+	cSnapshot.Write(AllNumbersCollected);
+	cSnapshot.Write(closestCollectable);
+	cSnapshot.Write(distCount);
+	cSnapshot.Write(distanceHolder);
+	cSnapshot.Write(noOfCollectibles);
+	cSnapshot.Write(noOfBattery);
+	cSnapshot.Write(blCycle);
+	cSnapshot.Write(itemTracked);
+	cSnapshot.Write(collected);
+	cSnapshot.Write(oldpapercount);
+}
+
+/**
+ @brief Read the position, timers and radar of the player from a snapshot
+ @param cSnapshot The snapshot to read from
+ @return false if the snapshot ended too early
+ */
+bool CPlayer2D::ReadSnapshot(CSnapshotBuffer& cSnapshot)
+{
+	CPhysics2D::STATUS sStatus = CPhysics2D::STATUS::IDLE;
+
+	cSnapshot.Read(vec2Index);
+	cSnapshot.Read(vec2NumMicroSteps);
+	cSnapshot.Read(vec2UVCoordinate);
+	cSnapshot.Read(vec2OldIndex);
+	cSnapshot.Read(tempOldVec);
+	cSnapshot.Read(runtimeColour);
+	cSnapshot.Read(sStatus);
+	cSnapshot.Read(dir);
+
+	cSnapshot.Read(iJumpCount);
+	cSnapshot.Read(lastAttackElapsed);
+	cSnapshot.Read(iAttackCount);
+	cSnapshot.Read(iframeElapsed);
+	cSnapshot.Read(deadElapsed);
+	cSnapshot.Read(focusElapsed);
+	cSnapshot.Read(boxElapsed);
+	cSnapshot.Read(flashlightElapsed);
+	cSnapshot.Read(eBox);
+
+	cSnapshot.Read(AllNumbersCollected);
+	cSnapshot.Read(closestCollectable);
+	cSnapshot.Read(distCount);
+	cSnapshot.Read(distanceHolder);
+	cSnapshot.Read(noOfCollectibles);
+	cSnapshot.Read(noOfBattery);
+	cSnapshot.Read(blCycle);
+	cSnapshot.Read(itemTracked);
+	cSnapshot.Read(collected);
+	cSnapshot.Read(oldpapercount);
+
+	cPhysics2D.SetStatus(sStatus);
+	// Do not blend the restored position with the position before the load
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
+	return (cSnapshot.HasReadError() == false);
+}
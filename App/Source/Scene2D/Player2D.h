@@ -25,6 +25,8 @@
 
 // Include the Map2D as we will use it to check the player's movements and actions
 class CMap2D;
+// Include CSnapshotBuffer for the save games
+class CSnapshotBuffer;
 
 // Include Keyboard controller
 #include "Inputs\KeyboardController.h"
@@ -89,6 +91,11 @@ public:
 
 	int getitemTracked();
 
+	// Write the position, timers and radar of the player to a snapshot
+	void WriteSnapshot(CSnapshotBuffer& cSnapshot) const;
+	// Read the position, timers and radar of the player from a snapshot
+	bool ReadSnapshot(CSnapshotBuffer& cSnapshot);
+
 protected:
 	enum DIRECTION
 	{
@@ -99,6 +106,21 @@ protected:
 		NUM_DIRECTIONS
 	};
 
+	// The animations of the sprite
+	enum ANIMATION
+	{
+		ANIM_RIGHT = 0,
+		ANIM_LEFT,
+		ANIM_UP,
+		ANIM_DOWN,
+		ANIM_IDLE_RIGHT,
+		ANIM_IDLE_LEFT,
+		ANIM_IDLE_DOWN,
+		ANIM_IDLE_UP,
+		ANIM_DEATH,
+		NUM_ANIMATIONS
+	};
+
 	glm::vec2 vec2OldIndex;
 
 	// Handler to the CMap2D instance
@@ -112,6 +134,8 @@ protected:
 
 	//CS: Animated Sprite
 	CSpriteAnimation* animatedSprites;
+	// The indices of the animations in animatedSprites, so they are played without looking up their names
+	int arrAnimationIDs[NUM_ANIMATIONS];
 
 	// Handler to the CSoundController
 	CSoundController* cSoundController;
@@ -4,11 +4,18 @@
  */
 #include "Rays.h"
 
+// Include CMemoryTracker to count the allocations and OpenGL objects
+#include "System\MemoryTracker.h"
+
 #include <iostream>
 using namespace std;
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "RenderControl\GLStateCache.h"
+// Include CSpriteBatch
+#include "RenderControl\SpriteBatch.h"
 
 // Include ImageLoader
 #include "System\ImageLoader.h"
@@ -46,7 +53,8 @@ Rays::~Rays(void)
 	cSoundController = NULL;
 
 	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
+	CGLStateCache::GetInstance()->DeleteVertexArrays(1, &VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, -1);
 }
 
 /**
@@ -69,7 +77,8 @@ bool Rays::Init(void)
 	cSoundController = CSoundController::GetInstance();
 
 	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
 
 	// Load the player texture 
 	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/flashlight.png", true);
@@ -81,7 +90,8 @@ bool Rays::Init(void)
 
 	// Create the quad mesh for the rays
 	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
 
 	raysNo = sizeof(rays) / sizeof(rays[0]);
 
@@ -150,8 +160,8 @@ void Rays::Update(const double dElapsedTime)
 		double diff = elapsedTime - flickerElapsed;
 		if (diff >= 0.3)
 		{
-			cSoundController->StopSoundByID(14);
-			cSoundController->PlaySoundByID(14);
+			cSoundController->StopSoundByID(SOUND_LIGHT_FLICKER);
+			cSoundController->PlaySoundByID(SOUND_LIGHT_FLICKER);
 			flashlightOn = !flashlightOn;
 			flickerElapsed = elapsedTime;
 		}
@@ -164,7 +174,7 @@ void Rays::Update(const double dElapsedTime)
 			double onDiff = elapsedTime - onElapsed;
 			if (onDiff >= 0.3 && flickerNo < 4)
 			{
-				cSoundController->PlaySoundByID(14);
+				cSoundController->PlaySoundByID(SOUND_LIGHT_FLICKER);
 				flashlightOn = !flashlightOn;
 				flickerNo++;
 				onElapsed = elapsedTime;
@@ -185,7 +195,7 @@ void Rays::Update(const double dElapsedTime)
 			double onDiff = elapsedTime - onElapsed;
 			if (onDiff >= 0.1 && flickerNo < 5)
 			{
-				cSoundController->PlaySoundByID(14);
+				cSoundController->PlaySoundByID(SOUND_LIGHT_FLICKER);
 				flashlightOn = !flashlightOn;
 				flickerNo++;
 				onElapsed = elapsedTime;
@@ -209,12 +219,7 @@ void Rays::Update(const double dElapsedTime)
  */
 void Rays::PreRender(void)
 {
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Activate the shader
-	CShaderManager::GetInstance()->Use("Shader2D");
+	// The sprite batch sets the blending mode and shader when it is flushed
 }
 
 /**
@@ -222,28 +227,23 @@ void Rays::PreRender(void)
  */
 void Rays::Render(void)
 {
+	MEMORY_TAG("Rays::Render");
+
 	// Do not render rays if flashlight is off
 	if (!flashlightOn)
 		return;
 
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
 	//CS: Render the rays
 	for (int i = 0; i < (sizeof(renderRays) / sizeof(renderRays[0])); i++)
 	{
-		quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), 0.0025f, renderRays[i].length);
-
 		glm::mat4 MVP = camera->GetMVP();
 		glm::mat4 transformMVP;
 		transformMVP = MVP; // make sure to initialize matrix to identity matrix first
 
-		float xTranslate = CPlayer2D::GetInstance()->vec2UVCoordinate.x;
-		float yTranslate = CPlayer2D::GetInstance()->vec2UVCoordinate.y;
+		// Follow the player's rendered position, which is between the last two simulation ticks
+		glm::vec2 vec2PlayerUVCoordinate = CPlayer2D::GetInstance()->GetInterpolatedUVCoordinate();
+		float xTranslate = vec2PlayerUVCoordinate.x;
+		float yTranslate = vec2PlayerUVCoordinate.y;
 
 		float dy = CMouseController::GetInstance()->GetMousePositionY() - cSettings->iWindowHeight * 0.5;
 		float dx = CMouseController::GetInstance()->GetMousePositionX() - cSettings->iWindowWidth * 0.5;
@@ -305,23 +305,18 @@ void Rays::Render(void)
 			break;
 		}
 
-		// Update the shaders with the latest transform
 		transformMVP = glm::translate(transformMVP, glm::vec3(xTranslate,
 			yTranslate,
 			0.0f));
 		transformMVP = glm::rotate(transformMVP, overallRotate, glm::vec3(0, 0, 1));
-		glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transformMVP));
-		glUniform4fv(colorLoc, 1, glm::value_ptr(glm::vec4(1.f, 1.f, 1.f, 1.f)));
-
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0);
-		// Get the texture to be rendered
-		glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-		glBindVertexArray(VAO);
-		quadMesh->Render();
-		glBindVertexArray(0);
-		glBindTexture(GL_TEXTURE_2D, 0);
+
+		// Add the ray to the sprite batch, instead of building a new quad mesh for it
+		CSpriteBatch::GetInstance()->Draw(SPRITE_LAYER_EFFECTS,
+										  iTextureID,
+										  transformMVP,
+										  glm::vec2(0.0025f, renderRays[i].length),
+										  glm::vec4(0.f, 0.f, 1.f, 1.f),
+										  glm::vec4(1.f, 1.f, 1.f, 1.f));
 	}
 
 	//Reset length
@@ -335,8 +330,6 @@ void Rays::Render(void)
  */
 void Rays::PostRender(void)
 {
-	// Disable blending
-	glDisable(GL_BLEND);
 }
 
 void Rays::SetRayLength(int index, float length)
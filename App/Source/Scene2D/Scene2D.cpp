@@ -10,10 +10,64 @@ using namespace std;
 
 // Include Shader Manager
 #include "RenderControl\ShaderManager.h"
+// Include CSpriteBatch to draw the sprites of the scene
+#include "RenderControl\SpriteBatch.h"
 
 #include "System\filesystem.h"
 #include "../GameStateManagement/GameStateManager.h"
 
+// Include CFixedTimeStep to interpolate between simulation ticks
+#include "TimeControl\FixedTimeStep.h"
+// Include CProfiler to measure the scene
+#include "TimeControl\Profiler.h"
+// Include CMemoryTracker to count the allocations of the scene
+#include "System\MemoryTracker.h"
+// Include CUIRuntime to draw the transition screen into the shared UI frame
+#include "RenderControl\UIRuntime.h"
+// Include CAsyncFileWriter to write the save games in the background
+#include "System\AsyncFileWriter.h"
+// Include CRandom to save the state of the random number generator
+#include "System\Random.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+// The map files of the levels
+static const char* const LEVEL_MAP_FILES[] = { "Maps/Maze_Level_01.csv", "Maps/DM2213_Map_Level_02.csv" };
+static const unsigned int NUM_LEVELS = sizeof(LEVEL_MAP_FILES) / sizeof(LEVEL_MAP_FILES[0]);
+// The number of times in a row which a level is prepared before the game gives up on it
+static const unsigned int MAX_LEVEL_TRIES = 3;
+
+// The save game file.
+// File format (little-endian):
+//	Header: "MZSG", version, size of the snapshot, FNV-1a checksum of the snapshot (4 bytes each)
+//	Then the snapshot: the map, the random number generator, the inventory, the player,
+//	the number of enemies and every enemy, as written by their WriteSnapshot methods
+static const char* const SAVE_GAME_FILE = "SaveGame.sav";
+// Identifies a save game file
+static const char SAVE_GAME_MAGIC[4] = { 'M', 'Z', 'S', 'G' };
+// Increase this whenever the layout of a snapshot changes
+static const unsigned int SAVE_GAME_VERSION = 1;
+// The number of bytes to reserve for a snapshot, so that capturing it does not grow the buffer
+static const size_t SAVE_GAME_RESERVE_BYTES = 32 * 1024;
+
+/**
+ @brief Calculate the FNV-1a checksum of some bytes, to detect a damaged save game file
+ @param pData The bytes
+ @param uiNumBytes The number of bytes
+ */
+static unsigned int CalculateChecksum(const unsigned char* pData, const size_t uiNumBytes)
+{
+	unsigned int uiHash = 2166136261u;
+	for (size_t i = 0; i < uiNumBytes; i++)
+	{
+		uiHash ^= pData[i];
+		uiHash *= 16777619u;
+	}
+	return uiHash;
+}
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -26,6 +80,11 @@ CScene2D::CScene2D(void)
 	, cSoundController(NULL)
 	, camera(NULL)
 	, cRays(NULL)
+	, cLevelStreamer(NULL)
+	, bLevelTransition(false)
+	, uiLevelTries(0)
+	, vec2CameraTranslate(glm::vec2(0.0f))
+	, vec2PrevCameraTranslate(glm::vec2(0.0f))
 {
 }
 
@@ -87,6 +146,77 @@ CScene2D::~CScene2D(void)
 	{
 		cRays = NULL;
 	}
+
+	// Delete the level streamer, which waits for the level it is preparing
+	if (cLevelStreamer)
+	{
+		delete cLevelStreamer;
+		cLevelStreamer = NULL;
+	}
+}
+
+/**
+ @brief Load the resources which are kept between games, so that restarting the game does not load them again.
+		The sounds are kept by CSoundController, and the maps are kept in the cache of CMapGrid
+ */
+bool CScene2D::LoadResources(void)
+{
+	PROFILE_SCOPE("CScene2D::LoadResources");
+	MEMORY_TAG("CScene2D::LoadResources");
+
+	// Read the maps into the cache
+	for (unsigned int uiLevel = 0; uiLevel < NUM_LEVELS; uiLevel++)
+	{
+		if (CMap2D::CacheMap(LEVEL_MAP_FILES[uiLevel]) == false)
+		{
+			cout << "CScene2D::LoadResources - Unable to read the maps" << endl;
+			return false;
+		}
+	}
+
+	// Load sounds into CSoundController
+	CSoundController* cSoundController = CSoundController::GetInstance();
+	//Game BGM
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\GameBGM2.ogg"), SOUND_GAME_BGM, true, true);
+	
+	//Box sound effect
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\BoxMove.wav"), SOUND_BOX_MOVE, true);
+
+	//Player sound
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\Step.wav"), SOUND_STEP, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\PlayerHurt.wav"), SOUND_PLAYER_HURT, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\Paperpickup.wav"), SOUND_PAPER_PICKUP, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\LightFlicker.wav"), SOUND_LIGHT_FLICKER, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\PlayerFound.wav"), SOUND_PLAYER_FOUND, true);
+
+	//Enemy Sound
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\EnemyStun.wav"), SOUND_ENEMY_STUN, true);
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\CreepyLaugh.wav"), SOUND_CREEPY_LAUGH, true, false, CSoundInfo::SOUNDTYPE::_3D, glm::vec3(0, 0, 0));
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\Jumpscare.wav"), SOUND_JUMPSCARE, true);
+
+	cSoundController->LoadSound(FileSystem::getPath("Sounds\\BatteryPickup.ogg"), SOUND_BATTERY_PICKUP, true);
+
+	// The music, the jumpscare and the sounds of the player are mixed before the sounds of the enemies.
+	// Each enemy has its own laugh, but only the 4 nearest are mixed, and none which are more than 12 tiles away
+	cSoundController->SetSoundPriority(SOUND_GAME_BGM, 3, 1);
+	cSoundController->SetSoundPriority(SOUND_JUMPSCARE, 3, 1);
+	cSoundController->SetSoundPriority(SOUND_STEP, 2, 1);
+	cSoundController->SetSoundPriority(SOUND_PLAYER_HURT, 2, 1);
+	cSoundController->SetSoundPriority(SOUND_PAPER_PICKUP, 2, 1);
+	cSoundController->SetSoundPriority(SOUND_BATTERY_PICKUP, 2, 1);
+	cSoundController->SetSoundPriority(SOUND_PLAYER_FOUND, 1, 1);
+	cSoundController->SetSoundPriority(SOUND_ENEMY_STUN, 1, 1);
+	cSoundController->SetSoundPriority(SOUND_CREEPY_LAUGH, 0, 4, 12.0f);
+
+	return true;
+}
+
+/**
+ @brief Release the resources of LoadResources. The sounds stay in CSoundController, which owns them
+ */
+void CScene2D::UnloadResources(void)
+{
+	CMapGrid::ClearCSVCache();
 }
 
 /**
@@ -163,21 +293,16 @@ bool CScene2D::Init(void)
 	// Set a shader to this class
 	cMap2D->SetShader("Shader2D");
 	// Initialise the instance
-	if (cMap2D->Init(2, CSettings::GetInstance()->NUM_TILES_YAXIS,
+	if (cMap2D->Init(NUM_LEVELS, CSettings::GetInstance()->NUM_TILES_YAXIS,
 						CSettings::GetInstance()->NUM_TILES_XAXIS) == false)
 	{
 		cout << "Failed to load CMap2D" << endl;
 		return false;
 	}
 
-	// Load the map into an array
-	if (cMap2D->LoadMap("Maps/Maze_Level_01.csv") == false)
-	{
-		// The loading of a map has failed. Return false
-		return false;
-	}
-
-	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_02.csv", 1) == false)
+	// Load the first map into an array. It is copied from the cache of LoadResources.
+	// The other levels are prepared by the level streamer while the game is played
+	if (cMap2D->LoadMap(LEVEL_MAP_FILES[0]) == false)
 	{
 		// The loading of a map has failed. Return false
 		return false;
@@ -238,34 +363,26 @@ bool CScene2D::Init(void)
 		return false;
 	}
 
-	// Load sounds into CSoundController
+	// The sounds were loaded into CSoundController by LoadResources
 	cSoundController = CSoundController::GetInstance();
-	//Game BGM
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\GameBGM.ogg"), 5, true, true);
-	
-	//Box sound effect
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\BoxMove.wav"), 6, true);
-
-	//Player sound
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\Step.wav"), 10, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\PlayerHurt.wav"), 12, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\Paperpickup.wav"), 13, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\LightFlicker.wav"), 14, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\PlayerFound.wav"), 15, true);
 
-	//Enemy Sound
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\EnemyStun.wav"), 25, true);
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\CreepyLaugh.wav"), 26, true, false, CSoundInfo::SOUNDTYPE::_3D, vec3df(0, 0, 0));
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\Jumpscare.wav"), 27, true);
+	//Set BGM and SFX volume to be same as menu state's, since they haven't been set since they haven't been loaded yet
+	cSoundController->SetBGMVolume(cSoundController->getCurrentVolume(SOUND_MENU_BGM));
+	cSoundController->SetSFXVolume(cSoundController->getCurrentVolume(SOUND_UI_CONFIRM));
 
-	cSoundController->LoadSound(FileSystem::getPath("Sounds\\BatteryPickup.ogg"), 28, true);
+	cSoundController->StopSoundByID(SOUND_MENU_BGM);
+	cSoundController->PlaySoundByID(SOUND_GAME_BGM);
 
-	//Set BGM and SFX volume to be same as menu state's, since they haven't been set since they haven't been loaded yet
-	cSoundController->SetBGMVolume(cSoundController->getCurrentVolume(1));
-	cSoundController->SetSFXVolume(cSoundController->getCurrentVolume(2));
+	// Start the camera on the player, without interpolating from the previous level
+	vec2CameraTranslate = CalculateCameraTranslate();
+	vec2PrevCameraTranslate = vec2CameraTranslate;
 
-	cSoundController->StopSoundByID(1);
-	cSoundController->PlaySoundByID(5);
+	// Start preparing the next level
+	if (cLevelStreamer == NULL)
+		cLevelStreamer = new CLevelStreamer();
+	bLevelTransition = false;
+	uiLevelTries = 0;
+	RequestLevel(1);
 
 	return true;
 }
@@ -275,34 +392,61 @@ bool CScene2D::Init(void)
 */
 bool CScene2D::Update(const double dElapsedTime)
 {
+	PROFILE_SCOPE("CScene2D::Update");
+	MEMORY_TAG("CScene2D::Update");
+
+	// Keep showing the transition screen until the next level has been prepared, then swap it in
+	if (bLevelTransition == true)
+	{
+		if (cLevelStreamer->IsReady() == false)
+		{
+			UpdateTransition();
+			return true;
+		}
+		if (SwapLevel() == false)
+		{
+			RetryLevel(cMap2D->GetCurrentLevel() + 1);
+			return true;
+		}
+		uiLevelTries = 0;
+	}
+
+	// Store the state of the previous tick, so that Render can interpolate between ticks
+	cPlayer2D->StorePreviousState();
+	for (int i = 0; i < enemyVector.size(); i++)
+	{
+		enemyVector[i]->StorePreviousState();
+	}
+	vec2PrevCameraTranslate = vec2CameraTranslate;
+
 	cRays->Update(dElapsedTime);
 	// Call the cPlayer2D's update method before Map2D
 	// as we want to capture the inputs before map2D update
 	cPlayer2D->Update(dElapsedTime);
 
+	// Centre the camera on the player's new position
+	vec2CameraTranslate = CalculateCameraTranslate();
+
 	//Call all of the cEnemyCrawlid's update method before Map2D as we want to capture the updates before map2D update
 	for (int i = 0; i < enemyVector.size(); i++)
 	{
+		PROFILE_SCOPE("CEnemySawCon::Update");
+		MEMORY_TAG("CEnemySawCon::Update");
 		enemyVector[i]->Update(dElapsedTime);
 	}
 	cPlayer2D->setCollected(false);
 	// Call the Map2D's update method
 	cMap2D->Update(dElapsedTime);
 
-	if (cKeyboardController->IsKeyDown(GLFW_KEY_F6))
+	if (cKeyboardController->IsKeyPressed(GLFW_KEY_F6))
 	{
 		//Save the current game to a save file
-		try {
-			if (cMap2D->SaveMap("Maps/DM2213_Map_Level_01_SAVEGAMEtest.csv") == false)
-			{
-				throw runtime_error("Unable to save the current game to a file");
-			}
-		}
-		catch (runtime_error e)
-		{
-			cout << "Runtime error: " << e.what();
-			return true;
-		}
+		SaveGame();
+	}
+	else if (cKeyboardController->IsKeyPressed(GLFW_KEY_F7))
+	{
+		//Load the current game from the save file
+		LoadGame();
 	}
 	// Call the cGUI_Scene2D's update method
 	cGUI_Scene2D->Update(dElapsedTime);
@@ -310,37 +454,19 @@ bool CScene2D::Update(const double dElapsedTime)
 	// Move light with player
 	light[0].position = glm::vec3(cPlayer2D->vec2Index.x, cPlayer2D->vec2Index.y, 0.0f);
 
-	// Check if the game should go to the next level
+	// Check if the game should go to the next level. It is swapped in at the next Update,
+	// or after the transition screen if the level streamer has not prepared it yet.
+	// The player wins when the last level is completed
 	if (cGameManager->bLevelCompleted == true)
 	{
-		cMap2D->SetCurrentLevel(cMap2D->GetCurrentLevel() + 1);
-		//Reset enemies
-		//Destroy the enemies
-		for (int i = 0; i < enemyVector.size(); i++)
-		{
-			delete enemyVector[i];
-			enemyVector[i] = NULL;
-		}
-		enemyVector.clear();
-
-
-		while (true)
-		{
-			CEnemySawCon* cEnemySawCon = new CEnemySawCon();
-			//Pass shader to cEnemyWarrior
-			cEnemySawCon->SetShader("Shader2D_Colour");
-			//Initalise the instance
-			if (cEnemySawCon->Init() == true)
-			{
-				cEnemySawCon->SetPlayer2D(cPlayer2D);
-				enemyVector.push_back(cEnemySawCon);
-			}
-			else
-			{
-				//Break out of this loop if the enemy has all been loaded
-				break;
-			}
-		}
+		cGameManager->bLevelCompleted = false;
+		const unsigned int uiNextLevel = cMap2D->GetCurrentLevel() + 1;
+		if (uiNextLevel >= NUM_LEVELS)
+			cGameManager->bPlayerWon = true;
+		else if ((cLevelStreamer->IsPending() == true) || (RequestLevel(uiNextLevel) == true))
+			bLevelTransition = true;
+		else
+			cout << "CScene2D::Update - Unable to prepare level " << uiNextLevel << endl;
 	}
 
 	// Check if the game has been won by the player
@@ -365,6 +491,8 @@ bool CScene2D::Update(const double dElapsedTime)
 		cout << "Loading LoseState" << endl;
 		CGameStateManager::GetInstance()->SetActiveGameState("LoseState");
 	}
+
+	return true;
 }
 
 /**
@@ -388,15 +516,16 @@ void CScene2D::PreRender(void)
  */
 void CScene2D::Render(void)
 {
-	// Hacky, but it works `\("/)/`
-	// Would be better to target camera to middle of player, but due to time contraints decided to go to roundabout way of reverse engineering. Sorry D:
+	PROFILE_SCOPE("CScene2D::Render");
+	MEMORY_TAG("CScene2D::Render");
 
-	// Min. player coords are (2, 4), Max. player coords are (77, 43).
-	// After some trial and error, to center player in camera in both Min. and Max.,
-	// the translation required is Min. (-0.93, -0.8), Max. (0.93, 0.95).
-	// The calculations is working backwards to arrive at the required translation values, given the player coords.
-	float xTranslate = (cPlayer2D->vec2Index.x + (cPlayer2D->vec2NumMicroSteps.x / 15) - 2) * 0.0248 - 0.93;
-	float yTranslate = (cPlayer2D->vec2Index.y + (cPlayer2D->vec2NumMicroSteps.y / 15) - 4) * 0.045 - 0.8;
+	// Interpolate the camera between the last two simulation ticks, unless it jumped (e.g. player respawned)
+	glm::vec2 vec2Translate = vec2CameraTranslate;
+	glm::vec2 vec2Delta = vec2CameraTranslate - vec2PrevCameraTranslate;
+	if ((fabs(vec2Delta.x) < 0.0248f) && (fabs(vec2Delta.y) < 0.045f))
+		vec2Translate = vec2PrevCameraTranslate + vec2Delta * CFixedTimeStep::GetInstance()->GetAlpha();
+	float xTranslate = vec2Translate.x;
+	float yTranslate = vec2Translate.y;
 
 	camera->Update(glm::vec3(xTranslate, yTranslate, 0.5f),
 		glm::vec3(xTranslate, yTranslate, 0.f),
@@ -440,6 +569,9 @@ void CScene2D::Render(void)
 	cPlayer2D->Render();
 	cPlayer2D->PostRender();
 
+	// Draw the sprites of the enemies, rays and player, which were added to the sprite batch
+	CSpriteBatch::GetInstance()->Flush();
+
 	// Call the cGUI_Scene2D's PreRender()
 	cGUI_Scene2D->PreRender();
 	// Call the cGUI_Scene2D's Render()
@@ -453,4 +585,285 @@ void CScene2D::Render(void)
  */
 void CScene2D::PostRender(void)
 {
-}
\ No newline at end of file
+}
+
+/**
+ @brief Calculate the camera translation which centres the camera on the player
+ @return A glm::vec2 containing the translation of the camera
+ */
+glm::vec2 CScene2D::CalculateCameraTranslate(void) const
+{
+	// Hacky, but it works `\("/)/`
+	// Would be better to target camera to middle of player, but due to time contraints decided to go to roundabout way of reverse engineering. Sorry D:
+
+	// Min. player coords are (2, 4), Max. player coords are (77, 43).
+	// After some trial and error, to center player in camera in both Min. and Max.,
+	// the translation required is Min. (-0.93, -0.8), Max. (0.93, 0.95).
+	// The calculations is working backwards to arrive at the required translation values, given the player coords.
+	float xTranslate = (cPlayer2D->vec2Index.x + (cPlayer2D->vec2NumMicroSteps.x / 15) - 2) * 0.0248 - 0.93;
+	float yTranslate = (cPlayer2D->vec2Index.y + (cPlayer2D->vec2NumMicroSteps.y / 15) - 4) * 0.045 - 0.8;
+
+	return glm::vec2(xTranslate, yTranslate);
+}
+
+/**
+ @brief Start preparing a level on the worker thread of the level streamer, if the level exists
+ @param uiLevel The level to prepare
+ */
+bool CScene2D::RequestLevel(const unsigned int uiLevel)
+{
+	if (uiLevel >= NUM_LEVELS)
+		return false;
+
+	return cLevelStreamer->RequestLevel(uiLevel, FileSystem::getPath(LEVEL_MAP_FILES[uiLevel]),
+										cMap2D->GetNumRows(), cMap2D->GetNumCols());
+}
+
+/**
+ @brief Swap in the level which the level streamer prepared. The tiles, player and enemies are all
+		changed within one Update, so no frame shows a mix of the two levels
+ */
+bool CScene2D::SwapLevel(void)
+{
+	PROFILE_SCOPE("CScene2D::SwapLevel");
+	MEMORY_TAG("CScene2D::SwapLevel");
+
+	bLevelTransition = false;
+
+	CLevelStreamer::LevelData levelData;
+	if ((cLevelStreamer->TakeLevel(levelData) == false) || (levelData.bValid == false))
+	{
+		cout << "CScene2D::SwapLevel - The next level could not be prepared" << endl;
+		return false;
+	}
+
+	// Copy the tiles of the new level, and make it the current level
+	if (cMap2D->SetLevelValues(levelData.uiLevel, levelData.vValues) == false)
+		return false;
+	cMap2D->SetCurrentLevel(levelData.uiLevel);
+
+	// Move the player to the start of the new level
+	cPlayer2D->Reset();
+
+	// Move the enemies to the spawn positions of the new level
+	SpawnEnemies(levelData.vEnemySpawns);
+
+	// Start the camera on the player, without interpolating from the previous level
+	vec2CameraTranslate = CalculateCameraTranslate();
+	vec2PrevCameraTranslate = vec2CameraTranslate;
+
+	// Start preparing the level after this one
+	RequestLevel(levelData.uiLevel + 1);
+
+	return true;
+}
+
+/**
+ @brief Handle a level which could not be swapped in. It is prepared again, up to MAX_LEVEL_TRIES times in a row,
+		then the game goes back to the menu, so that a bad level file cannot keep the game trying it forever
+ @param uiLevel The level which could not be swapped in
+ */
+void CScene2D::RetryLevel(const unsigned int uiLevel)
+{
+	uiLevelTries++;
+	if ((uiLevelTries < MAX_LEVEL_TRIES) && (RequestLevel(uiLevel) == true))
+	{
+		bLevelTransition = true;
+		return;
+	}
+
+	cout << "CScene2D::RetryLevel - Level " << uiLevel << " could not be loaded after " << uiLevelTries
+		 << " tries, so the game goes back to the menu" << endl;
+	uiLevelTries = 0;
+	bLevelTransition = false;
+
+	// Reset the CKeyboardController
+	CKeyboardController::GetInstance()->Reset();
+
+	// Load the menu state
+	cout << "Loading MenuState" << endl;
+	CGameStateManager::GetInstance()->SetActiveGameState("MenuState");
+}
+
+/**
+ @brief Move the enemies to the spawn positions of a level. The existing enemies are reused,
+		so that their textures and sprite sheet are not looked up again
+ @param vEnemySpawns The indices (column, row) which the enemies spawn at
+ */
+void CScene2D::SpawnEnemies(const std::vector<glm::i32vec2>& vEnemySpawns)
+{
+	for (unsigned int i = 0; i < vEnemySpawns.size(); i++)
+	{
+		if (i < enemyVector.size())
+		{
+			enemyVector[i]->Spawn(vEnemySpawns[i]);
+			continue;
+		}
+
+		// Create an enemy if the new level has more enemies than the previous level
+		CEnemySawCon* cEnemySawCon = new CEnemySawCon();
+		//Pass shader to cEnemyWarrior
+		cEnemySawCon->SetShader("Shader2D_Colour");
+		//Initalise the instance
+		if (cEnemySawCon->Init(vEnemySpawns[i]) == false)
+		{
+			delete cEnemySawCon;
+			break;
+		}
+		cEnemySawCon->SetPlayer2D(cPlayer2D);
+		enemyVector.push_back(cEnemySawCon);
+	}
+
+	// Delete the enemies which the new level does not have
+	while (enemyVector.size() > vEnemySpawns.size())
+	{
+		delete enemyVector.back();
+		enemyVector.pop_back();
+	}
+}
+
+/**
+ @brief Show the transition screen while the next level is being prepared. The game is not updated,
+		but the scene and the transition screen keep being rendered
+ */
+void CScene2D::UpdateTransition(void)
+{
+	// Start the shared UI frame
+	CUIRuntime::GetInstance()->BeginFrame();
+
+	ImGuiWindowFlags window_flags = 0;
+	window_flags |= ImGuiWindowFlags_NoTitleBar;
+	window_flags |= ImGuiWindowFlags_NoScrollbar;
+	window_flags |= ImGuiWindowFlags_NoMove;
+	window_flags |= ImGuiWindowFlags_NoResize;
+	window_flags |= ImGuiWindowFlags_NoCollapse;
+	window_flags |= ImGuiWindowFlags_NoNav;
+	window_flags |= ImGuiWindowFlags_AlwaysAutoResize;
+
+	// Show the window at the centre of the screen
+	ImGui::SetNextWindowPos(ImVec2(CSettings::GetInstance()->iWindowWidth / 2.0f, CSettings::GetInstance()->iWindowHeight / 2.0f),
+							ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+	ImGui::Begin("Level Transition", NULL, window_flags);
+	ImGui::SetWindowFontScale(2.0f);
+	ImGui::TextColored(ImVec4(1, 1, 1, 1), "Loading the next level...");
+	ImGui::End();
+}
+
+/**
+ @brief Capture the state of the game, and write it to the save game file in the background.
+		Only the capture is done here, which copies the values into a buffer, so that saving does
+		not stall the game. The file is written by CAsyncFileWriter, which replaces the file in one rename
+ */
+bool CScene2D::SaveGame(void)
+{
+	PROFILE_SCOPE("CScene2D::SaveGame");
+
+	// Capture the state of the game
+	cSaveSnapshot.Clear(SAVE_GAME_RESERVE_BYTES);
+	cMap2D->WriteSnapshot(cSaveSnapshot);
+	CRandom::GetInstance()->WriteSnapshot(cSaveSnapshot);
+	CInventoryManager::GetInstance()->WriteSnapshot(cSaveSnapshot);
+	cPlayer2D->WriteSnapshot(cSaveSnapshot);
+	cSaveSnapshot.Write((unsigned int)enemyVector.size());
+	for (unsigned int i = 0; i < enemyVector.size(); i++)
+	{
+		enemyVector[i]->WriteSnapshot(cSaveSnapshot);
+	}
+
+	// Add the header in front of the snapshot
+	const std::vector<unsigned char>& vSnapshotData = cSaveSnapshot.GetData();
+	CSnapshotBuffer cSaveFile;
+	cSaveFile.Clear(sizeof(SAVE_GAME_MAGIC) + 3 * sizeof(unsigned int) + vSnapshotData.size());
+	cSaveFile.WriteBytes(SAVE_GAME_MAGIC, sizeof(SAVE_GAME_MAGIC));
+	cSaveFile.Write(SAVE_GAME_VERSION);
+	cSaveFile.Write((unsigned int)vSnapshotData.size());
+	cSaveFile.Write(CalculateChecksum(vSnapshotData.data(), vSnapshotData.size()));
+	cSaveFile.WriteBytes(vSnapshotData.data(), vSnapshotData.size());
+
+	// Hand the file over to the background writer
+	CAsyncFileWriter::GetInstance()->Write(FileSystem::getPath(SAVE_GAME_FILE), cSaveFile.TakeData());
+
+	cout << "CScene2D::SaveGame - Saved the game (" << vSnapshotData.size() << " bytes)" << endl;
+	return true;
+}
+
+/**
+ @brief Restore the state of the game from the save game file. The file is checked before
+		anything is changed, so a damaged or outdated file leaves the current game as it is
+ */
+bool CScene2D::LoadGame(void)
+{
+	PROFILE_SCOPE("CScene2D::LoadGame");
+	MEMORY_TAG("CScene2D::LoadGame");
+
+	// Wait for a save which is still being written, so that the latest save is loaded
+	CAsyncFileWriter::GetInstance()->Flush();
+
+	const std::string sFilePath = FileSystem::getPath(SAVE_GAME_FILE);
+	ifstream saveFile(sFilePath, ios::binary);
+	if (!saveFile.is_open())
+	{
+		cout << "CScene2D::LoadGame - Unable to open " << sFilePath << endl;
+		return false;
+	}
+	std::vector<unsigned char> vFileData((std::istreambuf_iterator<char>(saveFile)), std::istreambuf_iterator<char>());
+	saveFile.close();
+
+	// Check the header and the checksum
+	CSnapshotBuffer cSnapshot;
+	cSnapshot.SetData(std::move(vFileData));
+
+	char magic[sizeof(SAVE_GAME_MAGIC)] = { 0 };
+	unsigned int uiVersion = 0, uiSnapshotSize = 0, uiChecksum = 0;
+	cSnapshot.ReadBytes(magic, sizeof(magic));
+	cSnapshot.Read(uiVersion);
+	cSnapshot.Read(uiSnapshotSize);
+	cSnapshot.Read(uiChecksum);
+	if ((cSnapshot.HasReadError() == true) ||
+		(memcmp(magic, SAVE_GAME_MAGIC, sizeof(magic)) != 0) ||
+		(uiVersion != SAVE_GAME_VERSION) ||
+		(uiSnapshotSize != cSnapshot.GetRemaining()) ||
+		(uiChecksum != CalculateChecksum(cSnapshot.GetData().data() + (cSnapshot.GetSize() - uiSnapshotSize), uiSnapshotSize)))
+	{
+		cout << "CScene2D::LoadGame - " << sFilePath << " is not a valid save game" << endl;
+		return false;
+	}
+
+	// Stop preparing the next level, as the saved game may be on another level
+	cLevelStreamer->Cancel();
+	bLevelTransition = false;
+	uiLevelTries = 0;
+
+	// Restore the state of the game
+	if (cMap2D->ReadSnapshot(cSnapshot) == false)
+	{
+		RequestLevel(cMap2D->GetCurrentLevel() + 1);
+		return false;
+	}
+	CRandom::GetInstance()->ReadSnapshot(cSnapshot);
+	CInventoryManager::GetInstance()->ReadSnapshot(cSnapshot);
+	cPlayer2D->ReadSnapshot(cSnapshot);
+
+	// Create or delete enemies to match the saved game, then restore each of them
+	unsigned int uiNumEnemies = 0;
+	cSnapshot.Read(uiNumEnemies);
+	if (uiNumEnemies > cSnapshot.GetRemaining())
+		uiNumEnemies = 0;
+	SpawnEnemies(std::vector<glm::i32vec2>(uiNumEnemies, glm::i32vec2(0, 0)));
+	for (unsigned int i = 0; i < enemyVector.size(); i++)
+	{
+		enemyVector[i]->ReadSnapshot(cSnapshot);
+	}
+
+	if (cSnapshot.HasReadError())
+		cout << "CScene2D::LoadGame - " << sFilePath << " ended too early" << endl;
+
+	// Start the camera on the player, without interpolating from the position before the load
+	vec2CameraTranslate = CalculateCameraTranslate();
+	vec2PrevCameraTranslate = vec2CameraTranslate;
+
+	// Start preparing the level after the saved level
+	RequestLevel(cMap2D->GetCurrentLevel() + 1);
+
+	return (cSnapshot.HasReadError() == false);
+}
@@ -44,6 +44,12 @@
 
 #include "EnemySawCon.h"
 
+// Include CLevelStreamer to prepare the next level in the background
+#include "LevelStreamer.h"
+
+// Include CSnapshotBuffer to capture the state of the game for the save games
+#include "System\SnapshotBuffer.h"
+
 #include "..\SoundController\SoundController.h"
 
 #include "Camera.h"
@@ -58,6 +64,11 @@ class CScene2D : public CSingletonTemplate<CScene2D>
 {
 	friend CSingletonTemplate<CScene2D>;
 public:
+	// Load the resources which are kept between games, i.e. the sounds and the maps
+	static bool LoadResources(void);
+	// Release the resources of LoadResources
+	static void UnloadResources(void);
+
 	// Init
 	bool Init(void);
 
@@ -114,7 +125,17 @@ protected:
 	Rays* cRays;
 
 	// A vector containing the instance of CEnemyCrawlids
-	vector<CEntity2D*> enemyVector;
+	vector<CEnemySawCon*> enemyVector;
+
+	// The level streamer, which prepares the next level while the current level is played
+	CLevelStreamer* cLevelStreamer;
+	// true while the scene waits for the next level to be prepared, and shows the transition screen
+	bool bLevelTransition;
+	// The number of times in a row which the next level could not be swapped in
+	unsigned int uiLevelTries;
+
+	// The snapshot which the state of the game is captured into when saving. It is kept, so that its memory is reused
+	CSnapshotBuffer cSaveSnapshot;
 
 	// A transformation matrix for controlling where to render the entities
 	glm::mat4 transform;
@@ -122,6 +143,29 @@ protected:
 	// Add your variables and methods here.
 	Camera* camera;
 
+	// The camera translation at the current and previous simulation tick, to interpolate between ticks when rendering
+	glm::vec2 vec2CameraTranslate;
+	glm::vec2 vec2PrevCameraTranslate;
+
+	// Calculate the camera translation which centres the camera on the player
+	glm::vec2 CalculateCameraTranslate(void) const;
+
+	// Start preparing a level in the background, if it exists
+	bool RequestLevel(const unsigned int uiLevel);
+	// Swap in the level which the level streamer prepared
+	bool SwapLevel(void);
+	// Prepare a level again which could not be swapped in, or go back to the menu after too many tries
+	void RetryLevel(const unsigned int uiLevel);
+	// Move the enemies to the spawn positions of a level, reusing the existing enemies
+	void SpawnEnemies(const std::vector<glm::i32vec2>& vEnemySpawns);
+	// Show the transition screen while the next level is being prepared
+	void UpdateTransition(void);
+
+	// Capture the state of the game, and write it to the save game file in the background
+	bool SaveGame(void);
+	// Restore the state of the game from the save game file
+	bool LoadGame(void);
+
 	// Constructor
 	CScene2D(void);
 	// Destructor
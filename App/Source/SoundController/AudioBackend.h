@@ -0,0 +1,74 @@
+/**
+ CAudioBackend
+ @brief An interface to the library which decodes and plays the sounds. CSoundController only talks
+		to this interface, so the game can use irrKlang on Windows, or the built-in software mixer
+		to run and measure the audio anywhere, e.g. on a headless Linux machine.
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include string
+#include <string>
+
+class CAudioBackend
+{
+public:
+	// The handle of a source which could not be loaded
+	static const unsigned int INVALID_SOURCE = 0xFFFFFFFF;
+	// The handle of a voice which could not be started
+	static const unsigned int INVALID_VOICE = 0xFFFFFFFF;
+
+	// Constructor
+	CAudioBackend(void) {}
+
+	// Destructor
+	virtual ~CAudioBackend(void) {}
+
+	// Initialise the backend
+	virtual bool Init(void) = 0;
+
+	// Advance the audio by the duration of a simulation tick. Only backends which are driven
+	// by the simulation time, e.g. the software mixer in headless mode, need to do anything here
+	virtual void Update(const double dElapsedTime) {}
+
+	// Load a sound source from a file. A streamed source is decoded a chunk at a time while it plays,
+	// instead of all at once. It returns INVALID_SOURCE if the file could not be loaded
+	virtual unsigned int LoadSource(const std::string& sFilePath, const bool bPreload, const bool bStream) = 0;
+	// Release a sound source, and stop its voices
+	virtual void ReleaseSource(const unsigned int uiSource) = 0;
+
+	// Get the duration of a sound source in seconds
+	virtual float GetSourceLength(const unsigned int uiSource) = 0;
+	// Get the number of bytes of decoded audio which a sound source keeps in memory
+	virtual size_t GetSourceMemory(const unsigned int uiSource) = 0;
+
+	// Start a voice of a sound source, from a time in seconds. A 3D voice is played at a position,
+	// and a 2D voice is not. It returns INVALID_VOICE if the voice could not be started
+	virtual unsigned int PlayVoice(const unsigned int uiSource,
+		const bool b3D,
+		const glm::vec3& vec3Position,
+		const float fVolume,
+		const bool bLooped,
+		const float fStartTime) = 0;
+	// Stop a voice, and release its handle. It must also be called for a voice which has ended by itself
+	virtual void StopVoice(const unsigned int uiVoice) = 0;
+	// Check if a voice is still playing
+	virtual bool IsVoicePlaying(const unsigned int uiVoice) = 0;
+	// Move a 3D voice, and set the volume of a voice, while it is playing
+	virtual void SetVoice(const unsigned int uiVoice, const glm::vec3& vec3Position, const float fVolume) = 0;
+
+	// Set the volume of a sound source, which is used by its next voices
+	virtual void SetSourceVolume(const unsigned int uiSource, const float fVolume) = 0;
+	// Get the volume of a sound source
+	virtual float GetSourceVolume(const unsigned int uiSource) = 0;
+
+	// Set the master volume
+	virtual void SetMasterVolume(const float fVolume) = 0;
+	// Get the master volume
+	virtual float GetMasterVolume(void) = 0;
+
+	// Set the position and view direction of the listener, used by the next 3D voices
+	virtual void SetListener(const glm::vec3& vec3Position, const glm::vec3& vec3Direction) = 0;
+};
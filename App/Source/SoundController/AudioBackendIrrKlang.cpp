@@ -0,0 +1,343 @@
+/**
+ CAudioBackendIrrKlang
+ @brief An audio backend which plays the sounds with the irrKlang sound engine
+ */
+#include "AudioBackendIrrKlang.h"
+
+#pragma comment(lib, "irrKlang.lib") // link with irrKlang.dll
+
+#include <iostream>
+using namespace std;
+using namespace irrklang;
+
+/**
+ @brief Constructor
+ */
+CAudioBackendIrrKlang::CAudioBackendIrrKlang(void)
+	: cSoundEngine(NULL)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CAudioBackendIrrKlang::~CAudioBackendIrrKlang(void)
+{
+	// Release the voices which are still playing
+	for (unsigned int i = 0; i < vVoices.size(); i++)
+	{
+		if (vVoices[i].pSound)
+		{
+			vVoices[i].pSound->drop();
+			vVoices[i].pSound = NULL;
+		}
+	}
+	vVoices.clear();
+
+	// The sound sources belong to the sound engine, so they are removed with it
+	vSources.clear();
+
+	if (cSoundEngine)
+	{
+		cSoundEngine->removeAllSoundSources();
+		cSoundEngine->drop();
+		cSoundEngine = NULL;
+	}
+}
+
+/**
+ @brief Initialise the irrKlang sound engine
+ @return true if the sound engine was created, otherwise false
+ */
+bool CAudioBackendIrrKlang::Init(void)
+{
+	// Initialise the sound engine with default parameters
+	cSoundEngine = createIrrKlangDevice(ESOD_WIN_MM, ESEO_MULTI_THREADED);
+	if (cSoundEngine == NULL)
+	{
+		cout << "Unable to initialise the IrrKlang sound engine" << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief Load a sound source from a file
+ @param sFilePath The path of the file
+ @param bPreload true to decode the file into memory now. It is not used for a streamed source
+ @param bStream true to let irrKlang decode the file while it plays, instead of all at once
+ @return The handle of the sound source, or INVALID_SOURCE if the file could not be loaded
+ */
+unsigned int CAudioBackendIrrKlang::LoadSource(const std::string& sFilePath, const bool bPreload, const bool bStream)
+{
+	ISoundSource* pSoundSource = cSoundEngine->addSoundSourceFromFile(sFilePath.c_str(),
+		(bStream ? E_STREAM_MODE::ESM_STREAMING : E_STREAM_MODE::ESM_NO_STREAMING),
+		(bStream ? false : bPreload));
+
+	// Trivial Rejection : Invalid pointer provided
+	if (pSoundSource == nullptr)
+		return INVALID_SOURCE;
+
+	// Force the sound source to be streamed, or not to have any streaming
+	pSoundSource->setForcedStreamingThreshold(bStream ? 0 : -1);
+
+	// Reuse the handle of a released sound source
+	for (unsigned int i = 0; i < vSources.size(); i++)
+	{
+		if (vSources[i] == NULL)
+		{
+			vSources[i] = pSoundSource;
+			return i;
+		}
+	}
+	vSources.push_back(pSoundSource);
+	return (unsigned int)vSources.size() - 1;
+}
+
+/**
+ @brief Release a sound source, and stop its voices
+ @param uiSource The handle of the sound source
+ */
+void CAudioBackendIrrKlang::ReleaseSource(const unsigned int uiSource)
+{
+	ISoundSource* pSoundSource = GetSource(uiSource);
+	if (pSoundSource == NULL)
+		return;
+
+	cSoundEngine->removeSoundSource(pSoundSource);
+	vSources[uiSource] = NULL;
+}
+
+/**
+ @brief Get the duration of a sound source in seconds
+ @param uiSource The handle of the sound source
+ @return The duration, or 0 if it is not known
+ */
+float CAudioBackendIrrKlang::GetSourceLength(const unsigned int uiSource)
+{
+	ISoundSource* pSoundSource = GetSource(uiSource);
+	if (pSoundSource == NULL)
+		return 0.0f;
+
+	// irrKlang returns -1 if the length is not known
+	const ik_u32 uiPlayLength = pSoundSource->getPlayLength();
+	if (uiPlayLength == (ik_u32)-1)
+		return 0.0f;
+	return uiPlayLength / 1000.0f;
+}
+
+/**
+ @brief Get the number of bytes of decoded audio which a sound source keeps in memory.
+		irrKlang keeps all the samples of a sound source which is not streamed once it is decoded.
+		The small buffers of a streamed source are kept by irrKlang, and are not counted
+ @param uiSource The handle of the sound source
+ @return The size of its samples, or 0 if the handle is not valid, the source is streamed or the sound is not decoded yet
+ */
+size_t CAudioBackendIrrKlang::GetSourceMemory(const unsigned int uiSource)
+{
+	ISoundSource* pSoundSource = GetSource(uiSource);
+	if ((pSoundSource == NULL) || (pSoundSource->getStreamMode() == E_STREAM_MODE::ESM_STREAMING))
+		return 0;
+
+	const ik_s32 iSampleDataSize = pSoundSource->getAudioFormat().getSampleDataSize();
+	if (iSampleDataSize < 0)
+		return 0;
+	return (size_t)iSampleDataSize;
+}
+
+/**
+ @brief Start a voice of a sound source, from a time in seconds. The sound is started paused,
+		so that its volume and play position are set before it is heard
+ @param uiSource The handle of the sound source
+ @param b3D true to play the voice at its position
+ @param vec3Position The position of the voice
+ @param fVolume The volume of the voice, which is multiplied by the volume of the sound source
+ @param bLooped true to loop the sound
+ @param fStartTime The time to start from. A looped voice wraps it around the duration of the sound
+ @return The handle of the voice, or INVALID_VOICE if it could not be started
+ */
+unsigned int CAudioBackendIrrKlang::PlayVoice(const unsigned int uiSource,
+	const bool b3D,
+	const glm::vec3& vec3Position,
+	const float fVolume,
+	const bool bLooped,
+	const float fStartTime)
+{
+	ISoundSource* pSoundSource = GetSource(uiSource);
+	if (pSoundSource == NULL)
+		return INVALID_VOICE;
+
+	ik_u32 uiStartTime = (ik_u32)(fStartTime * 1000.0f);
+	const ik_u32 uiPlayLength = pSoundSource->getPlayLength();
+	if ((uiPlayLength > 0) && (uiPlayLength != (ik_u32)-1))
+	{
+		if (bLooped)
+			uiStartTime %= uiPlayLength;
+		else if (uiStartTime >= uiPlayLength)
+			return INVALID_VOICE;
+	}
+
+	ISound* pSound = NULL;
+	if (b3D)
+		pSound = cSoundEngine->play3D(pSoundSource, vec3df(vec3Position.x, vec3Position.y, vec3Position.z), bLooped, true, true);
+	else
+		pSound = cSoundEngine->play2D(pSoundSource, bLooped, true, true);
+	if (pSound == NULL)
+		return INVALID_VOICE;
+
+	pSound->setVolume(pSoundSource->getDefaultVolume() * fVolume);
+	if (uiStartTime > 0)
+		pSound->setPlayPosition(uiStartTime);
+	pSound->setIsPaused(false);
+
+	// Reuse the index of a released voice
+	unsigned int uiIndex = 0;
+	while ((uiIndex < vVoices.size()) && (vVoices[uiIndex].pSound != NULL))
+		uiIndex++;
+	if (uiIndex == vVoices.size())
+	{
+		Voice voice;
+		voice.pSound = NULL;
+		voice.fVolume = 1.0f;
+		voice.uiGeneration = 0;
+		vVoices.push_back(voice);
+	}
+
+	Voice& voice = vVoices[uiIndex];
+	voice.pSound = pSound;
+	voice.fVolume = fVolume;
+	voice.uiGeneration++;
+	return ((voice.uiGeneration & 0xFFFF) << 16) | uiIndex;
+}
+
+/**
+ @brief Stop a voice, and release its handle
+ @param uiVoice The handle of the voice
+ */
+void CAudioBackendIrrKlang::StopVoice(const unsigned int uiVoice)
+{
+	Voice* pVoice = GetVoice(uiVoice);
+	if (pVoice == NULL)
+		return;
+
+	pVoice->pSound->stop();
+	pVoice->pSound->drop();
+	pVoice->pSound = NULL;
+}
+
+/**
+ @brief Check if a voice is still playing
+ @param uiVoice The handle of the voice
+ */
+bool CAudioBackendIrrKlang::IsVoicePlaying(const unsigned int uiVoice)
+{
+	Voice* pVoice = GetVoice(uiVoice);
+	if (pVoice == NULL)
+		return false;
+
+	return (pVoice->pSound->isFinished() == false);
+}
+
+/**
+ @brief Move a 3D voice, and set the volume of a voice, while it is playing
+ @param uiVoice The handle of the voice
+ @param vec3Position The position of the voice
+ @param fVolume The volume of the voice
+ */
+void CAudioBackendIrrKlang::SetVoice(const unsigned int uiVoice, const glm::vec3& vec3Position, const float fVolume)
+{
+	Voice* pVoice = GetVoice(uiVoice);
+	if (pVoice == NULL)
+		return;
+
+	pVoice->pSound->setPosition(vec3df(vec3Position.x, vec3Position.y, vec3Position.z));
+	if (pVoice->fVolume != fVolume)
+	{
+		pVoice->fVolume = fVolume;
+		pVoice->pSound->setVolume(pVoice->pSound->getSoundSource()->getDefaultVolume() * fVolume);
+	}
+}
+
+/**
+ @brief Set the volume of a sound source, which is used by its next voices
+ @param uiSource The handle of the sound source
+ @param fVolume The volume, from 0 to 1
+ */
+void CAudioBackendIrrKlang::SetSourceVolume(const unsigned int uiSource, const float fVolume)
+{
+	ISoundSource* pSoundSource = GetSource(uiSource);
+	if (pSoundSource)
+		pSoundSource->setDefaultVolume(fVolume);
+}
+
+/**
+ @brief Get the volume of a sound source
+ @param uiSource The handle of the sound source
+ @return The volume, or 1 if the handle is not valid
+ */
+float CAudioBackendIrrKlang::GetSourceVolume(const unsigned int uiSource)
+{
+	ISoundSource* pSoundSource = GetSource(uiSource);
+	if (pSoundSource == NULL)
+		return 1.0f;
+
+	return pSoundSource->getDefaultVolume();
+}
+
+/**
+ @brief Set the master volume
+ @param fVolume The volume, from 0 to 1
+ */
+void CAudioBackendIrrKlang::SetMasterVolume(const float fVolume)
+{
+	cSoundEngine->setSoundVolume(fVolume);
+}
+
+/**
+ @brief Get the master volume
+ */
+float CAudioBackendIrrKlang::GetMasterVolume(void)
+{
+	return cSoundEngine->getSoundVolume();
+}
+
+/**
+ @brief Set the position and view direction of the listener, used by the next 3D voices
+ @param vec3Position The position of the listener
+ @param vec3Direction The view direction of the listener
+ */
+void CAudioBackendIrrKlang::SetListener(const glm::vec3& vec3Position, const glm::vec3& vec3Direction)
+{
+	cSoundEngine->setListenerPosition(vec3df(vec3Position.x, vec3Position.y, vec3Position.z),
+									  vec3df(vec3Direction.x, vec3Direction.y, vec3Direction.z));
+}
+
+/**
+ @brief Get a sound source by its handle
+ @param uiSource The handle of the sound source
+ @return The sound source, or NULL if the handle is not valid
+ */
+ISoundSource* CAudioBackendIrrKlang::GetSource(const unsigned int uiSource) const
+{
+	if (uiSource >= vSources.size())
+		return NULL;
+
+	return vSources[uiSource];
+}
+
+/**
+ @brief Get a voice by its handle
+ @param uiVoice The handle of the voice. Its lowest 16 bits are the index of the voice, and the rest its generation
+ @return The voice, or NULL if the handle is not valid
+ */
+CAudioBackendIrrKlang::Voice* CAudioBackendIrrKlang::GetVoice(const unsigned int uiVoice)
+{
+	const unsigned int uiIndex = uiVoice & 0xFFFF;
+	if ((uiVoice == INVALID_VOICE) || (uiIndex >= vVoices.size()))
+		return NULL;
+
+	Voice& voice = vVoices[uiIndex];
+	if ((voice.pSound == NULL) || ((voice.uiGeneration & 0xFFFF) != (uiVoice >> 16)))
+		return NULL;
+	return &voice;
+}
@@ -0,0 +1,87 @@
+/**
+ CAudioBackendIrrKlang
+ @brief An audio backend which plays the sounds with the irrKlang sound engine
+ */
+#pragma once
+
+// Include CAudioBackend
+#include "AudioBackend.h"
+
+// Include IrrKlang
+#include <includes/irrKlang.h>
+
+// Include vector
+#include <vector>
+
+class CAudioBackendIrrKlang : public CAudioBackend
+{
+public:
+	// Constructor
+	CAudioBackendIrrKlang(void);
+
+	// Destructor
+	virtual ~CAudioBackendIrrKlang(void);
+
+	// Initialise the irrKlang sound engine
+	virtual bool Init(void);
+
+	// Load a sound source from a file
+	virtual unsigned int LoadSource(const std::string& sFilePath, const bool bPreload, const bool bStream);
+	// Release a sound source, and stop its voices
+	virtual void ReleaseSource(const unsigned int uiSource);
+
+	// Get the duration of a sound source in seconds
+	virtual float GetSourceLength(const unsigned int uiSource);
+	// Get the number of bytes of decoded audio which a sound source keeps in memory
+	virtual size_t GetSourceMemory(const unsigned int uiSource);
+
+	// Start a voice of a sound source, from a time in seconds
+	virtual unsigned int PlayVoice(const unsigned int uiSource,
+		const bool b3D,
+		const glm::vec3& vec3Position,
+		const float fVolume,
+		const bool bLooped,
+		const float fStartTime);
+	// Stop a voice, and release its handle
+	virtual void StopVoice(const unsigned int uiVoice);
+	// Check if a voice is still playing
+	virtual bool IsVoicePlaying(const unsigned int uiVoice);
+	// Move a 3D voice, and set the volume of a voice, while it is playing
+	virtual void SetVoice(const unsigned int uiVoice, const glm::vec3& vec3Position, const float fVolume);
+
+	// Set the volume of a sound source
+	virtual void SetSourceVolume(const unsigned int uiSource, const float fVolume);
+	// Get the volume of a sound source
+	virtual float GetSourceVolume(const unsigned int uiSource);
+
+	// Set the master volume
+	virtual void SetMasterVolume(const float fVolume);
+	// Get the master volume
+	virtual float GetMasterVolume(void);
+
+	// Set the position and view direction of the listener
+	virtual void SetListener(const glm::vec3& vec3Position, const glm::vec3& vec3Direction);
+
+protected:
+	// The handler to the irrklang Sound Engine
+	irrklang::ISoundEngine* cSoundEngine;
+
+	// The sound sources, by their handles. Released handles are NULL until they are reused
+	std::vector<irrklang::ISoundSource*> vSources;
+
+	// A sound which is being played, and the volume it was given, which is multiplied by the volume of its source
+	struct Voice
+	{
+		irrklang::ISound* pSound;
+		float fVolume;
+		// Counted up each time the voice is started, so that the handles of its earlier sounds are not valid anymore
+		unsigned int uiGeneration;
+	};
+	// The voices, by the indices in their handles. Released voices have a NULL sound until they are reused
+	std::vector<Voice> vVoices;
+
+	// Get a sound source by its handle. NULL if the handle is not valid
+	irrklang::ISoundSource* GetSource(const unsigned int uiSource) const;
+	// Get a voice by its handle. NULL if the handle is not valid
+	Voice* GetVoice(const unsigned int uiVoice);
+};
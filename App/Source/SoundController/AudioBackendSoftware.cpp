@@ -0,0 +1,1134 @@
+/**
+ CAudioBackendSoftware
+ @brief An audio backend which decodes and mixes the sounds itself, and passes the mixed audio to a
+		CAudioSink. It needs no sound device, so the audio can be run and measured anywhere.
+		The voices are mixed in blocks into a ring buffer, which is drained into the sink.
+		In real time mode a mixer thread mixes a block every block period. Otherwise the audio
+		is mixed by Update, for the duration of each simulation tick, e.g. in headless mode.
+		A streamed sound is not decoded when it is loaded. While it plays, Update decodes it a chunk
+		at a time into a small ring of frames, which the mixer reads, so a long music track only
+		keeps STREAM_FRAMES frames in memory. WAV and OGG files are streamed in the same way.
+ */
+#include "AudioBackendSoftware.h"
+
+// Include CProfiler to measure the cost of mixing
+#include "TimeControl/Profiler.h"
+
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+// The distance within which a 3D sound is played at its full volume, as in irrKlang
+static const float MIN_DISTANCE = 1.0f;
+
+/**
+ @brief Read a little-endian unsigned int from some bytes
+ */
+static unsigned int ReadUInt(const unsigned char* pBytes)
+{
+	return (unsigned int)pBytes[0] | ((unsigned int)pBytes[1] << 8) |
+		((unsigned int)pBytes[2] << 16) | ((unsigned int)pBytes[3] << 24);
+}
+
+/**
+ @brief Read a little-endian unsigned short from some bytes
+ */
+static unsigned short ReadUShort(const unsigned char* pBytes)
+{
+	return (unsigned short)(pBytes[0] | (pBytes[1] << 8));
+}
+
+/**
+ @brief Constructor
+ @param cAudioSink The output of the mixed audio. The backend deletes it
+ @param bRealTime true to mix in real time on the mixer thread, false to mix in Update
+ */
+CAudioBackendSoftware::CAudioBackendSoftware(CAudioSink* cAudioSink, const bool bRealTime)
+	: cAudioSink(cAudioSink)
+	, bRealTime(bRealTime)
+	, fMasterVolume(1.0f)
+	, vec3ListenerPos(0.0f, 0.0f, 0.0f)
+	, vec3ListenerDir(0.0f, 0.0f, 1.0f)
+	, uiRingWrite(0)
+	, uiRingRead(0)
+	, ullNumFramesMixed(0)
+	, dFramesOwed(0.0)
+	, bStop(false)
+{
+	memset(arrVoices, 0, sizeof(arrVoices));
+}
+
+/**
+ @brief Destructor
+ */
+CAudioBackendSoftware::~CAudioBackendSoftware(void)
+{
+	// Stop the mixer thread
+	{
+		std::lock_guard<std::mutex> lock(mutexMixer);
+		bStop = true;
+	}
+	conditionStop.notify_one();
+	if (threadMixer.joinable())
+		threadMixer.join();
+
+	if (cAudioSink)
+	{
+		cAudioSink->Close();
+		delete cAudioSink;
+		cAudioSink = NULL;
+	}
+}
+
+/**
+ @brief Open the sink, and start the mixer thread in real time mode
+ @return false if the sink could not be opened
+ */
+bool CAudioBackendSoftware::Init(void)
+{
+	if ((cAudioSink == NULL) || (cAudioSink->Open(SAMPLE_RATE, NUM_CHANNELS) == false))
+	{
+		cout << "CAudioBackendSoftware::Init - Unable to open the audio sink" << endl;
+		return false;
+	}
+
+	vRingBuffer.assign(RING_BLOCKS * BLOCK_FRAMES * NUM_CHANNELS, 0.0f);
+
+	if (bRealTime)
+		threadMixer = std::thread(&CAudioBackendSoftware::Run, this);
+
+	return true;
+}
+
+/**
+ @brief Decode the streamed sounds which are playing, and mix the audio for the duration of a simulation tick,
+		if not in real time mode. In real time mode, each stream keeps STREAM_FRAMES frames decoded ahead of
+		the mixer thread, so a tick can be late by that much before the stream runs dry
+ @param dElapsedTime The duration of the tick in seconds
+ */
+void CAudioBackendSoftware::Update(const double dElapsedTime)
+{
+	if (bRealTime)
+	{
+		RefillStreams();
+		return;
+	}
+
+	// Carry the part of a frame over to the next tick, so that the output keeps in step with the simulation
+	dFramesOwed += dElapsedTime * SAMPLE_RATE;
+	const unsigned int uiNumFrames = (unsigned int)dFramesOwed;
+	dFramesOwed -= uiNumFrames;
+
+	Render(uiNumFrames);
+}
+
+/**
+ @brief Load a sound source from a file. The file is decoded now, whether bPreload is set or not,
+		unless it is streamed. WAV and OGG files can be decoded. Other files are loaded as silent sources,
+		so that the game still runs with the same sound IDs
+ @param sFilePath The path of the file
+ @param bPreload Not used, as the sounds which are not streamed are always decoded when they are loaded
+ @param bStream true to only read the format of the file now, and decode it while it plays
+ @return The handle of the sound source, or INVALID_SOURCE if the file could not be read
+ */
+unsigned int CAudioBackendSoftware::LoadSource(const std::string& sFilePath, const bool bPreload, const bool bStream)
+{
+	PROFILE_SCOPE("CAudioBackendSoftware::LoadSource");
+
+	// Decode the file before locking the mixer, so that the mixer is not held up
+	Source source;
+	source.sFilePath = sFilePath;
+	source.uiNumFrames = 0;
+	source.fVolume = 1.0f;
+	source.bLoaded = true;
+
+	const size_t uiDot = sFilePath.find_last_of('.');
+	std::string sExtension = (uiDot == std::string::npos ? "" : sFilePath.substr(uiDot + 1));
+	for (size_t i = 0; i < sExtension.size(); i++)
+		sExtension[i] = (char)tolower(sExtension[i]);
+
+	if (sExtension == "wav")
+	{
+		if (bStream)
+		{
+			source.pStream.reset(new Stream());
+			if (OpenStream(sFilePath, *source.pStream, source.uiNumFrames) == false)
+				return INVALID_SOURCE;
+		}
+		else if (DecodeWave(sFilePath, source.vSamples, source.uiNumFrames) == false)
+			return INVALID_SOURCE;
+	}
+	else if (sExtension == "ogg")
+	{
+		if (bStream)
+		{
+			source.pStream.reset(new Stream());
+			if (OpenVorbisStream(sFilePath, *source.pStream, source.uiNumFrames) == false)
+				return INVALID_SOURCE;
+		}
+		else if (DecodeVorbis(sFilePath, source.vSamples, source.uiNumFrames) == false)
+			return INVALID_SOURCE;
+	}
+	else
+	{
+		std::ifstream file(sFilePath, ios::binary);
+		if (!file.is_open())
+			return INVALID_SOURCE;
+		cout << "CAudioBackendSoftware::LoadSource - " << sFilePath
+			<< " cannot be decoded by the software mixer, so it will be silent" << endl;
+	}
+
+	std::lock_guard<std::mutex> lock(mutexMixer);
+
+	// Reuse the handle of a released sound source
+	for (unsigned int i = 0; i < vSources.size(); i++)
+	{
+		if (vSources[i].bLoaded == false)
+		{
+			vSources[i] = std::move(source);
+			return i;
+		}
+	}
+	vSources.push_back(std::move(source));
+	return (unsigned int)vSources.size() - 1;
+}
+
+/**
+ @brief Release a sound source, and stop its voices
+ @param uiSource The handle of the sound source
+ */
+void CAudioBackendSoftware::ReleaseSource(const unsigned int uiSource)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	if (IsValidSource(uiSource) == false)
+		return;
+
+	for (unsigned int i = 0; i < MAX_VOICES; i++)
+	{
+		if (arrVoices[i].bActive && (arrVoices[i].uiSource == uiSource))
+			arrVoices[i].bActive = false;
+	}
+
+	vSources[uiSource].bLoaded = false;
+	vSources[uiSource].vSamples.clear();
+	vSources[uiSource].vSamples.shrink_to_fit();
+	vSources[uiSource].pStream.reset();
+	vSources[uiSource].uiNumFrames = 0;
+}
+
+/**
+ @brief Get the duration of a sound source in seconds
+ @param uiSource The handle of the sound source
+ @return The duration, or 0 if the handle is not valid
+ */
+float CAudioBackendSoftware::GetSourceLength(const unsigned int uiSource)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	if (IsValidSource(uiSource) == false)
+		return 0.0f;
+
+	return (float)vSources[uiSource].uiNumFrames / SAMPLE_RATE;
+}
+
+/**
+ @brief Get the number of bytes of decoded audio which a sound source keeps in memory
+ @param uiSource The handle of the sound source
+ @return The size of its samples, or of the buffers of its stream, or 0 if the handle is not valid
+ */
+size_t CAudioBackendSoftware::GetSourceMemory(const unsigned int uiSource)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	if (IsValidSource(uiSource) == false)
+		return 0;
+
+	const Source& source = vSources[uiSource];
+	size_t uiMemorySize = source.vSamples.size() * sizeof(float);
+	if (source.pStream)
+	{
+		uiMemorySize += (source.pStream->vRing.size() + source.pStream->vDecoded.size()) * sizeof(float) +
+			source.pStream->vFileBytes.size();
+		if (source.pStream->pVorbisDecoder)
+		{
+			uiMemorySize += (source.pStream->vVorbisRead.size() + source.pStream->vVorbisFrames.size()) * sizeof(float) +
+				source.pStream->pVorbisDecoder->GetMemorySize();
+		}
+	}
+	return uiMemorySize;
+}
+
+/**
+ @brief Start a voice of a sound source, from a time in seconds. Nothing is played if every voice is in use.
+		A streamed sound has one voice at a time, so its earlier voice is stopped. Its frames are decoded
+		by the next Update, and the voice waits for them
+ @param uiSource The handle of the sound source
+ @param b3D true to play the voice at its position
+ @param vec3Position The position of the voice
+ @param fVolume The volume of the voice, which is multiplied by the volume of the sound source
+ @param bLooped true to loop the sound
+ @param fStartTime The time to start from. A looped voice wraps it around the duration of the sound
+ @return The handle of the voice, or INVALID_VOICE if it could not be started
+ */
+unsigned int CAudioBackendSoftware::PlayVoice(const unsigned int uiSource,
+	const bool b3D,
+	const glm::vec3& vec3Position,
+	const float fVolume,
+	const bool bLooped,
+	const float fStartTime)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	if (IsValidSource(uiSource) == false)
+		return INVALID_VOICE;
+
+	unsigned int uiStartFrame = (unsigned int)(fStartTime * SAMPLE_RATE);
+	const unsigned int uiNumFrames = vSources[uiSource].uiNumFrames;
+	if ((bLooped) && (uiNumFrames > 0))
+		uiStartFrame %= uiNumFrames;
+	else if (uiStartFrame >= uiNumFrames)
+		return INVALID_VOICE;
+
+	Stream* pStream = vSources[uiSource].pStream.get();
+	if (pStream)
+	{
+		for (unsigned int i = 0; i < MAX_VOICES; i++)
+		{
+			if (arrVoices[i].bActive && (arrVoices[i].uiSource == uiSource))
+				arrVoices[i].bActive = false;
+		}
+	}
+
+	for (unsigned int i = 0; i < MAX_VOICES; i++)
+	{
+		Voice& voice = arrVoices[i];
+		if (voice.bActive)
+			continue;
+
+		if (pStream)
+		{
+			// Drop the frames which were decoded for the earlier voice, and decode from the start time
+			pStream->uiRingRead = pStream->uiRingWrite;
+			pStream->uiDecodeFrame = uiStartFrame;
+			pStream->bLooped = bLooped;
+			pStream->bDecoding = true;
+		}
+
+		voice.uiSource = uiSource;
+		voice.uiFrame = uiStartFrame;
+		voice.uiGeneration++;
+		voice.b3D = b3D;
+		voice.vec3Position = vec3Position;
+		voice.fVolume = fVolume;
+		voice.bLooped = bLooped;
+		voice.bActive = true;
+		return ((voice.uiGeneration & 0xFFFFFF) << 8) | i;
+	}
+	return INVALID_VOICE;
+}
+
+/**
+ @brief Stop a voice, and release its handle. The stream of a streamed sound stops decoding
+ @param uiVoice The handle of the voice
+ */
+void CAudioBackendSoftware::StopVoice(const unsigned int uiVoice)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	Voice* pVoice = GetVoice(uiVoice);
+	if (pVoice)
+	{
+		pVoice->bActive = false;
+
+		Stream* pStream = vSources[pVoice->uiSource].pStream.get();
+		if (pStream)
+		{
+			pStream->bDecoding = false;
+			pStream->uiRingRead = pStream->uiRingWrite;
+		}
+	}
+}
+
+/**
+ @brief Check if a voice is still playing
+ @param uiVoice The handle of the voice
+ */
+bool CAudioBackendSoftware::IsVoicePlaying(const unsigned int uiVoice)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	return (GetVoice(uiVoice) != NULL);
+}
+
+/**
+ @brief Move a 3D voice, and set the volume of a voice, while it is playing
+ @param uiVoice The handle of the voice
+ @param vec3Position The position of the voice
+ @param fVolume The volume of the voice
+ */
+void CAudioBackendSoftware::SetVoice(const unsigned int uiVoice, const glm::vec3& vec3Position, const float fVolume)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	Voice* pVoice = GetVoice(uiVoice);
+	if (pVoice)
+	{
+		pVoice->vec3Position = vec3Position;
+		pVoice->fVolume = fVolume;
+	}
+}
+
+/**
+ @brief Set the volume of a sound source, which is also applied to the voices which are playing
+ @param uiSource The handle of the sound source
+ @param fVolume The volume, from 0 to 1
+ */
+void CAudioBackendSoftware::SetSourceVolume(const unsigned int uiSource, const float fVolume)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	if (IsValidSource(uiSource))
+		vSources[uiSource].fVolume = fVolume;
+}
+
+/**
+ @brief Get the volume of a sound source
+ @param uiSource The handle of the sound source
+ @return The volume, or 1 if the handle is not valid
+ */
+float CAudioBackendSoftware::GetSourceVolume(const unsigned int uiSource)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	if (IsValidSource(uiSource) == false)
+		return 1.0f;
+
+	return vSources[uiSource].fVolume;
+}
+
+/**
+ @brief Set the master volume, which is applied to every voice, including those which are playing
+ @param fVolume The volume, from 0 to 1
+ */
+void CAudioBackendSoftware::SetMasterVolume(const float fVolume)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	fMasterVolume = fVolume;
+}
+
+/**
+ @brief Get the master volume
+ */
+float CAudioBackendSoftware::GetMasterVolume(void)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	return fMasterVolume;
+}
+
+/**
+ @brief Set the position and view direction of the listener, which is also applied to the voices which are playing
+ @param vec3Position The position of the listener
+ @param vec3Direction The view direction of the listener
+ */
+void CAudioBackendSoftware::SetListener(const glm::vec3& vec3Position, const glm::vec3& vec3Direction)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	vec3ListenerPos = vec3Position;
+	vec3ListenerDir = vec3Direction;
+}
+
+/**
+ @brief Mix a number of frames and pass them to the sink, e.g. to render a session offline.
+		The streams are decoded before each block, so they keep up however many frames are mixed.
+		Only use it if not in real time mode, as the mixer thread would mix the same ring buffer
+ @param uiNumFrames The number of frames to mix
+ */
+void CAudioBackendSoftware::Render(const unsigned int uiNumFrames)
+{
+	unsigned int uiFramesLeft = uiNumFrames;
+	while (uiFramesLeft > 0)
+	{
+		const unsigned int uiBlockFrames = (uiFramesLeft < BLOCK_FRAMES ? uiFramesLeft : BLOCK_FRAMES);
+		RefillStreams();
+		{
+			std::lock_guard<std::mutex> lock(mutexMixer);
+			MixBlock(uiBlockFrames);
+		}
+		DrainRingBuffer();
+		uiFramesLeft -= uiBlockFrames;
+	}
+}
+
+/**
+ @brief Get the number of frames which have been mixed
+ */
+unsigned long long CAudioBackendSoftware::GetNumFramesMixed(void)
+{
+	std::lock_guard<std::mutex> lock(mutexMixer);
+	return ullNumFramesMixed;
+}
+
+/**
+ @brief The loop of the mixer thread. It mixes a block every block period, so that the sink
+		receives the audio at the rate it would be played
+ */
+void CAudioBackendSoftware::Run(void)
+{
+	PROFILE_THREAD("Audio Mixer");
+
+	const std::chrono::microseconds blockPeriod((long long)BLOCK_FRAMES * 1000000 / SAMPLE_RATE);
+	std::chrono::steady_clock::time_point nextBlockTime = std::chrono::steady_clock::now();
+
+	std::unique_lock<std::mutex> lock(mutexMixer);
+	while (bStop == false)
+	{
+		MixBlock(BLOCK_FRAMES);
+
+		lock.unlock();
+		DrainRingBuffer();
+		lock.lock();
+
+		nextBlockTime += blockPeriod;
+		conditionStop.wait_until(lock, nextBlockTime, [this] { return bStop; });
+	}
+}
+
+/**
+ @brief Mix a number of frames into the ring buffer. mutexMixer must be locked
+ @param uiNumFrames The number of frames to mix, up to BLOCK_FRAMES
+ */
+void CAudioBackendSoftware::MixBlock(const unsigned int uiNumFrames)
+{
+	PROFILE_SCOPE("CAudioBackendSoftware::MixBlock");
+
+	const unsigned int uiRingFrames = RING_BLOCKS * BLOCK_FRAMES;
+
+	// Clear the frames of the block. They may wrap around the end of the ring buffer
+	for (unsigned int i = 0; i < uiNumFrames; i++)
+	{
+		const unsigned int uiRingFrame = (uiRingWrite + i) % uiRingFrames;
+		vRingBuffer[uiRingFrame * NUM_CHANNELS] = 0.0f;
+		vRingBuffer[uiRingFrame * NUM_CHANNELS + 1] = 0.0f;
+	}
+
+	// Add every voice to the block
+	for (unsigned int uiVoice = 0; uiVoice < MAX_VOICES; uiVoice++)
+	{
+		Voice& voice = arrVoices[uiVoice];
+		if (voice.bActive == false)
+			continue;
+
+		const Source& source = vSources[voice.uiSource];
+		if (source.uiNumFrames == 0)
+		{
+			// A silent source ends at once, even if it is looped
+			voice.bActive = false;
+			continue;
+		}
+		Stream* pStream = source.pStream.get();
+
+		// The gains are calculated once per block, so that moving voices are followed
+		float fGainLeft = 0.0f, fGainRight = 0.0f;
+		CalculateGains(voice, fGainLeft, fGainRight);
+		fGainLeft *= fMasterVolume;
+		fGainRight *= fMasterVolume;
+		for (unsigned int i = 0; i < uiNumFrames; i++)
+		{
+			// A streamed voice takes its frames from the ring of its stream. It waits if they are not decoded yet
+			const float* pFrame = NULL;
+			if (pStream)
+			{
+				if (pStream->uiRingRead == pStream->uiRingWrite)
+					break;
+				pFrame = &pStream->vRing[(pStream->uiRingRead % STREAM_FRAMES) * NUM_CHANNELS];
+				pStream->uiRingRead++;
+			}
+			else
+				pFrame = &source.vSamples[voice.uiFrame * NUM_CHANNELS];
+
+			const unsigned int uiRingFrame = (uiRingWrite + i) % uiRingFrames;
+			vRingBuffer[uiRingFrame * NUM_CHANNELS] += pFrame[0] * fGainLeft;
+			vRingBuffer[uiRingFrame * NUM_CHANNELS + 1] += pFrame[1] * fGainRight;
+
+			voice.uiFrame++;
+			if (voice.uiFrame >= source.uiNumFrames)
+			{
+				if (voice.bLooped == false)
+				{
+					voice.bActive = false;
+					break;
+				}
+				voice.uiFrame = 0;
+			}
+		}
+	}
+
+	uiRingWrite = (uiRingWrite + uiNumFrames) % uiRingFrames;
+	ullNumFramesMixed += uiNumFrames;
+}
+
+/**
+ @brief Pass the frames in the ring buffer to the sink. The frames are passed in at most two parts,
+		as they may wrap around the end of the ring buffer
+ */
+void CAudioBackendSoftware::DrainRingBuffer(void)
+{
+	const unsigned int uiRingFrames = RING_BLOCKS * BLOCK_FRAMES;
+
+	unsigned int uiRingWritten = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutexMixer);
+		uiRingWritten = uiRingWrite;
+	}
+
+	while (uiRingRead != uiRingWritten)
+	{
+		const unsigned int uiEnd = (uiRingWritten > uiRingRead ? uiRingWritten : uiRingFrames);
+		cAudioSink->Write(&vRingBuffer[uiRingRead * NUM_CHANNELS], uiEnd - uiRingRead);
+		uiRingRead = uiEnd % uiRingFrames;
+	}
+}
+
+/**
+ @brief Get the voice of a handle. mutexMixer must be locked
+ @param uiVoice The handle of the voice. Its lowest 8 bits are the index of the voice, and the rest its generation
+ @return The voice, or NULL if the handle is not valid or its voice has ended
+ */
+CAudioBackendSoftware::Voice* CAudioBackendSoftware::GetVoice(const unsigned int uiVoice)
+{
+	const unsigned int uiIndex = uiVoice & 0xFF;
+	if ((uiVoice == INVALID_VOICE) || (uiIndex >= MAX_VOICES))
+		return NULL;
+
+	Voice& voice = arrVoices[uiIndex];
+	if ((voice.bActive == false) || ((voice.uiGeneration & 0xFFFFFF) != (uiVoice >> 8)))
+		return NULL;
+	return &voice;
+}
+
+/**
+ @brief Calculate the gains of the left and right channels of a voice. The volume of a 3D voice drops with
+		its distance from the listener, and it is panned to the side of the listener which it is on. mutexMixer must be locked
+ @param voice The voice
+ @param fGainLeft The gain of the left channel
+ @param fGainRight The gain of the right channel
+ */
+void CAudioBackendSoftware::CalculateGains(const Voice& voice, float& fGainLeft, float& fGainRight) const
+{
+	const float fVolume = vSources[voice.uiSource].fVolume * voice.fVolume;
+	if (voice.b3D == false)
+	{
+		fGainLeft = fVolume;
+		fGainRight = fVolume;
+		return;
+	}
+
+	const glm::vec3 vec3Offset = voice.vec3Position - vec3ListenerPos;
+	const float fDistance = glm::length(vec3Offset);
+
+	// Inverse distance attenuation, as in irrKlang
+	float fAttenuation = 1.0f;
+	if (fDistance > MIN_DISTANCE)
+		fAttenuation = MIN_DISTANCE / fDistance;
+
+	// Pan the sound with an equal power pan law, using the right of the listener
+	float fPan = 0.0f;
+	if (fDistance > 0.0f)
+	{
+		glm::vec3 vec3Right = glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), vec3ListenerDir);
+		if (glm::length(vec3Right) > 0.0f)
+			fPan = glm::dot(vec3Offset / fDistance, glm::normalize(vec3Right));
+	}
+	const float fAngle = (fPan + 1.0f) * 0.25f * 3.14159265f;
+
+	fGainLeft = fVolume * fAttenuation * cosf(fAngle);
+	fGainRight = fVolume * fAttenuation * sinf(fAngle);
+}
+
+/**
+ @brief Check if a handle is a loaded sound source. mutexMixer must be locked
+ @param uiSource The handle of the sound source
+ */
+bool CAudioBackendSoftware::IsValidSource(const unsigned int uiSource) const
+{
+	return ((uiSource < vSources.size()) && (vSources[uiSource].bLoaded == true));
+}
+
+/**
+ @brief Decode the next chunks of the streamed sounds which are playing, until their rings are full.
+		The files are read without locking the mixer, so it is not held up. Only call it from the
+		thread which calls the other methods, as it uses the streams without mutexMixer
+ */
+void CAudioBackendSoftware::RefillStreams(void)
+{
+	PROFILE_SCOPE("CAudioBackendSoftware::RefillStreams");
+
+	for (unsigned int uiSource = 0; uiSource < vSources.size(); uiSource++)
+	{
+		Stream* pStream = vSources[uiSource].pStream.get();
+		if (pStream == NULL)
+			continue;
+
+		while (pStream->bDecoding)
+		{
+			unsigned int uiFreeFrames = 0;
+			{
+				std::lock_guard<std::mutex> lock(mutexMixer);
+				uiFreeFrames = STREAM_FRAMES - (pStream->uiRingWrite - pStream->uiRingRead);
+			}
+			if (uiFreeFrames < STREAM_CHUNK_FRAMES)
+				break;
+
+			const unsigned int uiNumFrames = DecodeStream(*pStream, vSources[uiSource].uiNumFrames);
+			if (uiNumFrames == 0)
+				break;
+
+			// The ring may wrap around in the middle of the chunk
+			std::lock_guard<std::mutex> lock(mutexMixer);
+			for (unsigned int i = 0; i < uiNumFrames; i++)
+			{
+				const unsigned int uiRingFrame = (pStream->uiRingWrite + i) % STREAM_FRAMES;
+				pStream->vRing[uiRingFrame * NUM_CHANNELS] = pStream->vDecoded[i * NUM_CHANNELS];
+				pStream->vRing[uiRingFrame * NUM_CHANNELS + 1] = pStream->vDecoded[i * NUM_CHANNELS + 1];
+			}
+			pStream->uiRingWrite += uiNumFrames;
+		}
+	}
+}
+
+/**
+ @brief Decode the next frames of a stream into its vDecoded, up to STREAM_CHUNK_FRAMES, and convert them
+		to the format of the mixed audio. A looped stream goes back to the start at the end of the sound,
+		and a stream which is not looped stops decoding
+ @param stream The stream
+ @param uiNumSourceFrames The number of frames of the sound in the format of the mixed audio
+ @return The number of frames which were decoded
+ */
+unsigned int CAudioBackendSoftware::DecodeStream(Stream& stream, const unsigned int uiNumSourceFrames)
+{
+	const WaveFormat& format = stream.format;
+
+	if (stream.uiDecodeFrame >= uiNumSourceFrames)
+	{
+		if (stream.bLooped == false)
+		{
+			stream.bDecoding = false;
+			return 0;
+		}
+		stream.uiDecodeFrame = 0;
+	}
+
+	const unsigned int uiFramesLeft = uiNumSourceFrames - stream.uiDecodeFrame;
+	const unsigned int uiNumFrames = (uiFramesLeft < STREAM_CHUNK_FRAMES ? uiFramesLeft : STREAM_CHUNK_FRAMES);
+
+	// Read the frames of the file which the decoded frames are interpolated from
+	const double dStep = (double)format.uiSampleRate / SAMPLE_RATE;
+	const unsigned int uiFirstFileFrame = (unsigned int)(stream.uiDecodeFrame * dStep);
+	unsigned int uiLastFileFrame = (unsigned int)((stream.uiDecodeFrame + uiNumFrames - 1) * dStep) + 1;
+	if (uiLastFileFrame >= format.uiNumFrames)
+		uiLastFileFrame = format.uiNumFrames - 1;
+
+	if (stream.pVorbisDecoder)
+	{
+		if (ReadVorbisFrames(stream, uiFirstFileFrame, uiLastFileFrame) == false)
+		{
+			cout << "CAudioBackendSoftware::DecodeStream - Unable to decode a file, so its stream is stopped" << endl;
+			stream.bDecoding = false;
+			return 0;
+		}
+
+		// Convert to the sample rate of the mixed audio with a linear interpolation, as in Resample
+		for (unsigned int i = 0; i < uiNumFrames; i++)
+		{
+			const double dPosition = (stream.uiDecodeFrame + i) * dStep;
+			const unsigned int uiFileFrame = (unsigned int)dPosition;
+			const unsigned int uiNextFileFrame = (uiFileFrame + 1 < format.uiNumFrames ? uiFileFrame + 1 : uiFileFrame);
+			const float fWeight = (float)(dPosition - uiFileFrame);
+			const float* pFrame0 = &stream.vVorbisFrames[(uiFileFrame - stream.uiVorbisFirstFrame) * NUM_CHANNELS];
+			const float* pFrame1 = &stream.vVorbisFrames[(uiNextFileFrame - stream.uiVorbisFirstFrame) * NUM_CHANNELS];
+			for (unsigned int uiChannel = 0; uiChannel < NUM_CHANNELS; uiChannel++)
+				stream.vDecoded[i * NUM_CHANNELS + uiChannel] = pFrame0[uiChannel] + (pFrame1[uiChannel] - pFrame0[uiChannel]) * fWeight;
+		}
+
+		stream.uiDecodeFrame += uiNumFrames;
+		return uiNumFrames;
+	}
+
+	const unsigned int uiBytesPerFrame = format.usBitsPerSample / 8 * format.usChannels;
+	const unsigned int uiNumBytes = (uiLastFileFrame - uiFirstFileFrame + 1) * uiBytesPerFrame;
+	stream.file.clear();
+	stream.file.seekg((std::streamoff)format.uiDataOffset + (std::streamoff)uiFirstFileFrame * uiBytesPerFrame);
+	stream.file.read((char*)&stream.vFileBytes[0], uiNumBytes);
+	if (stream.file.gcount() != (std::streamsize)uiNumBytes)
+	{
+		cout << "CAudioBackendSoftware::DecodeStream - Unable to read a file, so its stream is stopped" << endl;
+		stream.bDecoding = false;
+		return 0;
+	}
+
+	// Convert to the sample rate of the mixed audio with a linear interpolation, as in Resample
+	for (unsigned int i = 0; i < uiNumFrames; i++)
+	{
+		const double dPosition = (stream.uiDecodeFrame + i) * dStep;
+		const unsigned int uiFileFrame = (unsigned int)dPosition;
+		const unsigned int uiNextFileFrame = (uiFileFrame + 1 < format.uiNumFrames ? uiFileFrame + 1 : uiFileFrame);
+		const float fWeight = (float)(dPosition - uiFileFrame);
+		const unsigned char* pFrame0 = &stream.vFileBytes[(uiFileFrame - uiFirstFileFrame) * uiBytesPerFrame];
+		const unsigned char* pFrame1 = &stream.vFileBytes[(uiNextFileFrame - uiFirstFileFrame) * uiBytesPerFrame];
+		for (unsigned int uiChannel = 0; uiChannel < NUM_CHANNELS; uiChannel++)
+		{
+			const float fSample0 = ReadWaveSample(pFrame0, format, uiChannel);
+			const float fSample1 = ReadWaveSample(pFrame1, format, uiChannel);
+			stream.vDecoded[i * NUM_CHANNELS + uiChannel] = fSample0 + (fSample1 - fSample0) * fWeight;
+		}
+	}
+
+	stream.uiDecodeFrame += uiNumFrames;
+	return uiNumFrames;
+}
+
+/**
+ @brief Read the format of a WAV file with 8-bit, 16-bit or 32-bit float samples, and find its samples.
+		Only the headers of the chunks are read
+ @param file The file, opened in binary mode
+ @param sFilePath The path of the file, for the error messages
+ @param format The format of the file
+ @return false if the file could not be read, or its format is not supported
+ */
+bool CAudioBackendSoftware::ReadWaveFormat(std::ifstream& file, const std::string& sFilePath, WaveFormat& format)
+{
+	memset(&format, 0, sizeof(format));
+
+	file.seekg(0, ios::end);
+	const size_t uiFileSize = (size_t)file.tellg();
+	file.seekg(0, ios::beg);
+
+	unsigned char arrHeader[16];
+	if ((uiFileSize < 12) || (!file.read((char*)arrHeader, 12)) ||
+		(memcmp(&arrHeader[0], "RIFF", 4) != 0) || (memcmp(&arrHeader[8], "WAVE", 4) != 0))
+	{
+		cout << "CAudioBackendSoftware::ReadWaveFormat - " << sFilePath << " is not a WAV file" << endl;
+		return false;
+	}
+
+	// Find the "fmt " and "data" chunks
+	bool bHasData = false;
+	size_t uiOffset = 12;
+	while (uiOffset + 8 <= uiFileSize)
+	{
+		file.seekg((std::streamoff)uiOffset);
+		if (!file.read((char*)arrHeader, 8))
+			break;
+		const unsigned int uiChunkSize = ReadUInt(&arrHeader[4]);
+		const size_t uiChunkData = uiOffset + 8;
+		if (uiChunkData + uiChunkSize > uiFileSize)
+			break;
+
+		if ((memcmp(&arrHeader[0], "fmt ", 4) == 0) && (uiChunkSize >= 16))
+		{
+			if (!file.read((char*)arrHeader, 16))
+				break;
+			format.usFormat = ReadUShort(&arrHeader[0]);
+			format.usChannels = ReadUShort(&arrHeader[2]);
+			format.uiSampleRate = ReadUInt(&arrHeader[4]);
+			format.usBitsPerSample = ReadUShort(&arrHeader[14]);
+		}
+		else if (memcmp(&arrHeader[0], "data", 4) == 0)
+		{
+			format.uiDataOffset = (unsigned int)uiChunkData;
+			format.uiDataBytes = uiChunkSize;
+			bHasData = true;
+		}
+
+		// Chunks are padded to an even size
+		uiOffset = uiChunkData + uiChunkSize + (uiChunkSize & 1);
+	}
+
+	const bool bPCM = ((format.usFormat == 1) && ((format.usBitsPerSample == 8) || (format.usBitsPerSample == 16)));
+	const bool bFloat = ((format.usFormat == 3) && (format.usBitsPerSample == 32));
+	if ((bHasData == false) || ((bPCM == false) && (bFloat == false)) ||
+		(format.usChannels == 0) || (format.usChannels > 2) || (format.uiSampleRate == 0))
+	{
+		cout << "CAudioBackendSoftware::ReadWaveFormat - The format of " << sFilePath << " is not supported" << endl;
+		return false;
+	}
+
+	format.uiNumFrames = format.uiDataBytes / (format.usBitsPerSample / 8 * format.usChannels);
+	return true;
+}
+
+/**
+ @brief Convert a sample of a frame of a WAV file to a float. A mono sound is played on both channels
+ @param pFrame The bytes of the frame
+ @param format The format of the file
+ @param uiChannel The channel of the mixed audio
+ @return The sample, from -1 to 1
+ */
+float CAudioBackendSoftware::ReadWaveSample(const unsigned char* pFrame, const WaveFormat& format, const unsigned int uiChannel)
+{
+	const unsigned int uiFileChannel = (uiChannel < format.usChannels ? uiChannel : 0);
+	const unsigned char* pSample = pFrame + uiFileChannel * (format.usBitsPerSample / 8);
+
+	if (format.usFormat == 3)
+	{
+		float fSample = 0.0f;
+		const unsigned int uiBits = ReadUInt(pSample);
+		memcpy(&fSample, &uiBits, sizeof(fSample));
+		return fSample;
+	}
+	else if (format.usBitsPerSample == 16)
+		return (short)ReadUShort(pSample) / 32768.0f;
+	else
+		return (pSample[0] - 128) / 128.0f;
+}
+
+/**
+ @brief Decode a WAV file with 8-bit, 16-bit or 32-bit float samples, and convert it to
+		the sample rate and number of channels of the mixed audio
+ @param sFilePath The path of the file
+ @param vSamples The interleaved samples
+ @param uiNumFrames The number of frames
+ @return false if the file could not be read, or its format is not supported
+ */
+bool CAudioBackendSoftware::DecodeWave(const std::string& sFilePath, std::vector<float>& vSamples, unsigned int& uiNumFrames)
+{
+	std::ifstream file(sFilePath, ios::binary);
+	if (!file.is_open())
+		return false;
+
+	WaveFormat format;
+	if (ReadWaveFormat(file, sFilePath, format) == false)
+		return false;
+
+	std::vector<unsigned char> vData(format.uiDataBytes);
+	file.clear();
+	file.seekg((std::streamoff)format.uiDataOffset);
+	if ((format.uiDataBytes > 0) && (!file.read((char*)&vData[0], format.uiDataBytes)))
+	{
+		cout << "CAudioBackendSoftware::DecodeWave - Unable to read the samples of " << sFilePath << endl;
+		return false;
+	}
+
+	// Convert the samples to floats
+	const unsigned int uiBytesPerFrame = format.usBitsPerSample / 8 * format.usChannels;
+	const unsigned int uiFileFrames = format.uiNumFrames;
+	std::vector<float> vFileSamples(uiFileFrames * NUM_CHANNELS);
+	for (unsigned int uiFrame = 0; uiFrame < uiFileFrames; uiFrame++)
+	{
+		for (unsigned int uiChannel = 0; uiChannel < NUM_CHANNELS; uiChannel++)
+			vFileSamples[uiFrame * NUM_CHANNELS + uiChannel] = ReadWaveSample(&vData[uiFrame * uiBytesPerFrame], format, uiChannel);
+	}
+
+	Resample(vFileSamples, uiFileFrames, format.uiSampleRate, vSamples, uiNumFrames);
+	return true;
+}
+
+/**
+ @brief Decode an OGG Vorbis file, and convert it to the sample rate and number of channels of the mixed audio.
+		A mono sound is played on both channels, and only the front left and right channels of a sound
+		with more than 2 channels are played
+ @param sFilePath The path of the file
+ @param vSamples The interleaved samples
+ @param uiNumFrames The number of frames
+ @return false if the file could not be read, or it is not a Vorbis file which can be decoded
+ */
+bool CAudioBackendSoftware::DecodeVorbis(const std::string& sFilePath, std::vector<float>& vSamples, unsigned int& uiNumFrames)
+{
+	CVorbisDecoder cVorbisDecoder;
+	if (cVorbisDecoder.Open(sFilePath) == false)
+		return false;
+
+	const unsigned int uiFileChannels = cVorbisDecoder.GetNumChannels();
+	const unsigned int uiFileFrames = cVorbisDecoder.GetNumFrames();
+	std::vector<float> vFileSamples(uiFileFrames * NUM_CHANNELS);
+	std::vector<float> vChunk(STREAM_CHUNK_FRAMES * uiFileChannels);
+	unsigned int uiFramesDecoded = 0;
+	while (uiFramesDecoded < uiFileFrames)
+	{
+		const unsigned int uiChunkFrames = cVorbisDecoder.Read(&vChunk[0], STREAM_CHUNK_FRAMES);
+		if (uiChunkFrames == 0)
+			break;
+		ConvertVorbisChannels(&vChunk[0], uiChunkFrames, uiFileChannels, &vFileSamples[uiFramesDecoded * NUM_CHANNELS]);
+		uiFramesDecoded += uiChunkFrames;
+	}
+	if (uiFramesDecoded < uiFileFrames)
+	{
+		cout << "CAudioBackendSoftware::DecodeVorbis - " << sFilePath << " ends before its last frame" << endl;
+		vFileSamples.resize(uiFramesDecoded * NUM_CHANNELS);
+	}
+
+	Resample(vFileSamples, uiFramesDecoded, cVorbisDecoder.GetSampleRate(), vSamples, uiNumFrames);
+	return true;
+}
+
+/**
+ @brief Convert the interleaved frames of a Vorbis stream to the channels of the mixed audio.
+		In the channel order of Vorbis, the front right channel is the second channel of a stream with
+		2 or 4 channels, and the third channel of a stream with 3 or 5 to 8 channels, after the centre channel
+ @param pFileSamples The frames of the stream
+ @param uiNumFrames The number of frames
+ @param uiFileChannels The number of channels of the stream
+ @param pSamples The frames in the format of the mixed audio
+ */
+void CAudioBackendSoftware::ConvertVorbisChannels(const float* pFileSamples, const unsigned int uiNumFrames,
+												  const unsigned int uiFileChannels, float* pSamples)
+{
+	unsigned int uiRightChannel = 2;
+	if (uiFileChannels == 1)
+		uiRightChannel = 0;
+	else if ((uiFileChannels == 2) || (uiFileChannels == 4))
+		uiRightChannel = 1;
+	for (unsigned int uiFrame = 0; uiFrame < uiNumFrames; uiFrame++)
+	{
+		pSamples[uiFrame * NUM_CHANNELS] = pFileSamples[uiFrame * uiFileChannels];
+		pSamples[uiFrame * NUM_CHANNELS + 1] = pFileSamples[uiFrame * uiFileChannels + uiRightChannel];
+	}
+}
+
+/**
+ @brief Convert the frames of a sound to the sample rate of the mixed audio with a linear interpolation
+ @param vFileSamples The interleaved frames of the sound, with the channels of the mixed audio.
+		They are moved into vSamples if the sample rate is already the same
+ @param uiFileFrames The number of frames of the sound
+ @param uiSampleRate The sample rate of the sound
+ @param vSamples The interleaved frames in the format of the mixed audio
+ @param uiNumFrames The number of frames in the format of the mixed audio
+ */
+void CAudioBackendSoftware::Resample(std::vector<float>& vFileSamples, const unsigned int uiFileFrames, const unsigned int uiSampleRate,
+									 std::vector<float>& vSamples, unsigned int& uiNumFrames)
+{
+	if ((uiSampleRate == SAMPLE_RATE) || (uiFileFrames == 0))
+	{
+		vSamples.swap(vFileSamples);
+		uiNumFrames = uiFileFrames;
+		return;
+	}
+
+	uiNumFrames = (unsigned int)((unsigned long long)uiFileFrames * SAMPLE_RATE / uiSampleRate);
+	vSamples.resize(uiNumFrames * NUM_CHANNELS);
+	const double dStep = (double)uiSampleRate / SAMPLE_RATE;
+	for (unsigned int uiFrame = 0; uiFrame < uiNumFrames; uiFrame++)
+	{
+		const double dPosition = uiFrame * dStep;
+		const unsigned int uiFileFrame = (unsigned int)dPosition;
+		const unsigned int uiNextFileFrame = (uiFileFrame + 1 < uiFileFrames ? uiFileFrame + 1 : uiFileFrame);
+		const float fWeight = (float)(dPosition - uiFileFrame);
+		for (unsigned int uiChannel = 0; uiChannel < NUM_CHANNELS; uiChannel++)
+		{
+			const float fSample0 = vFileSamples[uiFileFrame * NUM_CHANNELS + uiChannel];
+			const float fSample1 = vFileSamples[uiNextFileFrame * NUM_CHANNELS + uiChannel];
+			vSamples[uiFrame * NUM_CHANNELS + uiChannel] = fSample0 + (fSample1 - fSample0) * fWeight;
+		}
+	}
+}
+
+/**
+ @brief Open a WAV file to stream it. Only its format is read now. The buffers of the stream are
+		allocated here, so decoding it while it plays does not allocate
+ @param sFilePath The path of the file
+ @param stream The stream
+ @param uiNumFrames The number of frames of the sound in the format of the mixed audio
+ @return false if the file could not be read, or its format is not supported
+ */
+bool CAudioBackendSoftware::OpenStream(const std::string& sFilePath, Stream& stream, unsigned int& uiNumFrames)
+{
+	stream.file.open(sFilePath, ios::binary);
+	if (!stream.file.is_open())
+		return false;
+
+	if (ReadWaveFormat(stream.file, sFilePath, stream.format) == false)
+		return false;
+
+	const WaveFormat& format = stream.format;
+	uiNumFrames = (unsigned int)((unsigned long long)format.uiNumFrames * SAMPLE_RATE / format.uiSampleRate);
+
+	// A chunk is interpolated from up to 3 more frames of the file than it covers, and 1 more is kept for rounding
+	const unsigned int uiBytesPerFrame = format.usBitsPerSample / 8 * format.usChannels;
+	const unsigned int uiMaxFileFrames = (unsigned int)((unsigned long long)STREAM_CHUNK_FRAMES * format.uiSampleRate / SAMPLE_RATE) + 4;
+	stream.vFileBytes.assign(uiMaxFileFrames * uiBytesPerFrame, 0);
+	stream.vDecoded.assign(STREAM_CHUNK_FRAMES * NUM_CHANNELS, 0.0f);
+	stream.vRing.assign(STREAM_FRAMES * NUM_CHANNELS, 0.0f);
+	stream.uiRingWrite = 0;
+	stream.uiRingRead = 0;
+	stream.uiDecodeFrame = 0;
+	stream.bLooped = false;
+	stream.bDecoding = false;
+	return true;
+}
+
+/**
+ @brief Open an OGG Vorbis file to stream it. Only its headers are read now. The buffers of the stream are
+		allocated here, so decoding it while it plays does not allocate, except when a packet of the file is
+		larger than the ones before it
+ @param sFilePath The path of the file
+ @param stream The stream
+ @param uiNumFrames The number of frames of the sound in the format of the mixed audio
+ @return false if the file could not be read, or it is not a Vorbis file which can be decoded
+ */
+bool CAudioBackendSoftware::OpenVorbisStream(const std::string& sFilePath, Stream& stream, unsigned int& uiNumFrames)
+{
+	stream.pVorbisDecoder.reset(new CVorbisDecoder());
+	if (stream.pVorbisDecoder->Open(sFilePath) == false)
+		return false;
+
+	// Only the sample rate and the number of frames of the format are used by DecodeStream
+	WaveFormat& format = stream.format;
+	memset(&format, 0, sizeof(format));
+	format.uiSampleRate = stream.pVorbisDecoder->GetSampleRate();
+	format.uiNumFrames = stream.pVorbisDecoder->GetNumFrames();
+	uiNumFrames = (unsigned int)((unsigned long long)format.uiNumFrames * SAMPLE_RATE / format.uiSampleRate);
+
+	// A chunk is interpolated from up to 3 more frames of the file than it covers, and 1 more is kept for rounding
+	const unsigned int uiMaxFileFrames = (unsigned int)((unsigned long long)STREAM_CHUNK_FRAMES * format.uiSampleRate / SAMPLE_RATE) + 4;
+	stream.vVorbisRead.assign(uiMaxFileFrames * stream.pVorbisDecoder->GetNumChannels(), 0.0f);
+	stream.vVorbisFrames.assign(uiMaxFileFrames * NUM_CHANNELS, 0.0f);
+	stream.uiVorbisFirstFrame = 0;
+	stream.uiVorbisNumFrames = 0;
+	stream.vDecoded.assign(STREAM_CHUNK_FRAMES * NUM_CHANNELS, 0.0f);
+	stream.vRing.assign(STREAM_FRAMES * NUM_CHANNELS, 0.0f);
+	stream.uiRingWrite = 0;
+	stream.uiRingRead = 0;
+	stream.uiDecodeFrame = 0;
+	stream.bLooped = false;
+	stream.bDecoding = false;
+	return true;
+}
+
+/**
+ @brief Decode the frames of an OGG file from uiFirstFileFrame to uiLastFileFrame into the vVorbisFrames of its stream.
+		The frames which the previous chunk decoded and this chunk still needs are kept. The decoder only goes
+		back, or skips ahead, when a voice starts from another time, or the sound loops
+ @param stream The stream
+ @param uiFirstFileFrame The first frame of the file
+ @param uiLastFileFrame The last frame of the file, which is also decoded
+ @return false if the file ends before uiLastFileFrame
+ */
+bool CAudioBackendSoftware::ReadVorbisFrames(Stream& stream, const unsigned int uiFirstFileFrame, const unsigned int uiLastFileFrame)
+{
+	CVorbisDecoder& cVorbisDecoder = *stream.pVorbisDecoder;
+
+	if ((uiFirstFileFrame < stream.uiVorbisFirstFrame) ||
+		(uiFirstFileFrame > stream.uiVorbisFirstFrame + stream.uiVorbisNumFrames))
+	{
+		if (cVorbisDecoder.Seek(uiFirstFileFrame) == false)
+			return false;
+		stream.uiVorbisFirstFrame = uiFirstFileFrame;
+		stream.uiVorbisNumFrames = 0;
+	}
+	else if (uiFirstFileFrame > stream.uiVorbisFirstFrame)
+	{
+		// Move the frames which are still needed to the front
+		const unsigned int uiDropFrames = uiFirstFileFrame - stream.uiVorbisFirstFrame;
+		stream.uiVorbisNumFrames -= uiDropFrames;
+		memmove(&stream.vVorbisFrames[0], &stream.vVorbisFrames[uiDropFrames * NUM_CHANNELS],
+				stream.uiVorbisNumFrames * NUM_CHANNELS * sizeof(float));
+		stream.uiVorbisFirstFrame = uiFirstFileFrame;
+	}
+
+	const unsigned int uiMaxFrames = (unsigned int)(stream.vVorbisFrames.size() / NUM_CHANNELS);
+	while (stream.uiVorbisFirstFrame + stream.uiVorbisNumFrames <= uiLastFileFrame)
+	{
+		const unsigned int uiNumFrames = cVorbisDecoder.Read(&stream.vVorbisRead[0], uiMaxFrames - stream.uiVorbisNumFrames);
+		if (uiNumFrames == 0)
+			return false;
+		ConvertVorbisChannels(&stream.vVorbisRead[0], uiNumFrames, cVorbisDecoder.GetNumChannels(),
+							  &stream.vVorbisFrames[stream.uiVorbisNumFrames * NUM_CHANNELS]);
+		stream.uiVorbisNumFrames += uiNumFrames;
+	}
+	return true;
+}
@@ -0,0 +1,257 @@
+/**
+ CAudioBackendSoftware
+ @brief An audio backend which decodes and mixes the sounds itself, and passes the mixed audio to a
+		CAudioSink. It needs no sound device, so the audio can be run and measured anywhere.
+		The voices are mixed in blocks into a ring buffer, which is drained into the sink.
+		In real time mode a mixer thread mixes a block every block period. Otherwise the audio
+		is mixed by Update, for the duration of each simulation tick, e.g. in headless mode.
+		A streamed sound is not decoded when it is loaded. While it plays, Update decodes it a chunk
+		at a time into a small ring of frames, which the mixer reads, so a long music track only
+		keeps STREAM_FRAMES frames in memory. WAV and OGG files are streamed in the same way.
+ */
+#pragma once
+
+// Include CAudioBackend
+#include "AudioBackend.h"
+// Include CAudioSink
+#include "AudioSink.h"
+// Include CVorbisDecoder, which decodes the OGG files
+#include "VorbisDecoder.h"
+
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class CAudioBackendSoftware : public CAudioBackend
+{
+public:
+	// The format of the mixed audio
+	static const unsigned int SAMPLE_RATE = 44100;
+	static const unsigned int NUM_CHANNELS = 2;
+	// The number of frames which are mixed at a time
+	static const unsigned int BLOCK_FRAMES = 512;
+	// The number of blocks in the ring buffer
+	static const unsigned int RING_BLOCKS = 4;
+	// The maximum number of voices which are mixed at the same time
+	static const unsigned int MAX_VOICES = 32;
+	// The number of frames which a streamed sound keeps decoded ahead of its voice
+	static const unsigned int STREAM_FRAMES = 32768;
+	// The number of frames of a streamed sound which are decoded at a time
+	static const unsigned int STREAM_CHUNK_FRAMES = 8192;
+
+	// Constructor. The backend deletes the sink
+	CAudioBackendSoftware(CAudioSink* cAudioSink, const bool bRealTime);
+
+	// Destructor
+	virtual ~CAudioBackendSoftware(void);
+
+	// Open the sink, and start the mixer thread in real time mode
+	virtual bool Init(void);
+
+	// Decode the streamed sounds which are playing, and mix the audio for the duration of a simulation tick,
+	// if not in real time mode
+	virtual void Update(const double dElapsedTime);
+
+	// Load a sound source from a file. WAV and OGG files can be decoded and streamed
+	virtual unsigned int LoadSource(const std::string& sFilePath, const bool bPreload, const bool bStream);
+	// Release a sound source, and stop its voices
+	virtual void ReleaseSource(const unsigned int uiSource);
+
+	// Get the duration of a sound source in seconds
+	virtual float GetSourceLength(const unsigned int uiSource);
+	// Get the number of bytes of decoded audio which a sound source keeps in memory
+	virtual size_t GetSourceMemory(const unsigned int uiSource);
+
+	// Start a voice of a sound source, from a time in seconds
+	virtual unsigned int PlayVoice(const unsigned int uiSource,
+		const bool b3D,
+		const glm::vec3& vec3Position,
+		const float fVolume,
+		const bool bLooped,
+		const float fStartTime);
+	// Stop a voice, and release its handle
+	virtual void StopVoice(const unsigned int uiVoice);
+	// Check if a voice is still playing
+	virtual bool IsVoicePlaying(const unsigned int uiVoice);
+	// Move a 3D voice, and set the volume of a voice, while it is playing
+	virtual void SetVoice(const unsigned int uiVoice, const glm::vec3& vec3Position, const float fVolume);
+
+	// Set the volume of a sound source
+	virtual void SetSourceVolume(const unsigned int uiSource, const float fVolume);
+	// Get the volume of a sound source
+	virtual float GetSourceVolume(const unsigned int uiSource);
+
+	// Set the master volume
+	virtual void SetMasterVolume(const float fVolume);
+	// Get the master volume
+	virtual float GetMasterVolume(void);
+
+	// Set the position and view direction of the listener
+	virtual void SetListener(const glm::vec3& vec3Position, const glm::vec3& vec3Direction);
+
+	// Mix a number of frames and pass them to the sink. Only use it if not in real time mode
+	void Render(const unsigned int uiNumFrames);
+
+	// Get the number of frames which have been mixed
+	unsigned long long GetNumFramesMixed(void);
+
+protected:
+	// The format of a WAV file, and where its samples are in the file
+	struct WaveFormat
+	{
+		// 1 for integer samples, 3 for float samples
+		unsigned short usFormat;
+		unsigned short usChannels;
+		unsigned short usBitsPerSample;
+		unsigned int uiSampleRate;
+		// The offset and size in bytes of the samples
+		unsigned int uiDataOffset;
+		unsigned int uiDataBytes;
+		// The number of frames in the file
+		unsigned int uiNumFrames;
+	};
+
+	// A sound which is decoded from its file while it plays
+	struct Stream
+	{
+		// The file, which stays open while the sound is loaded
+		std::ifstream file;
+		WaveFormat format;
+		// The decoded frames which have not been mixed yet, in the order they are played
+		std::vector<float> vRing;
+		// The numbers of frames which were put into and taken from the ring. Guarded by mutexMixer
+		unsigned int uiRingWrite;
+		unsigned int uiRingRead;
+		// The next frame of the sound to decode
+		unsigned int uiDecodeFrame;
+		// true if the decoding goes back to the start at the end of the sound
+		bool bLooped;
+		// true while the sound has a voice, until the end of the sound is decoded if it is not looped
+		bool bDecoding;
+		// The bytes which are read from the file, and the frames which are decoded from them, before they are put into the ring
+		std::vector<unsigned char> vFileBytes;
+		std::vector<float> vDecoded;
+		// The decoder of an OGG file, otherwise NULL. It decodes the file in order, so its frames are kept from
+		// uiVorbisFirstFrame, in the channels of the mixed audio, until a chunk no longer needs them
+		std::unique_ptr<CVorbisDecoder> pVorbisDecoder;
+		std::vector<float> vVorbisRead;
+		std::vector<float> vVorbisFrames;
+		unsigned int uiVorbisFirstFrame;
+		unsigned int uiVorbisNumFrames;
+	};
+
+	// A sound, converted to the format of the mixed audio
+	struct Source
+	{
+		// The path of the file
+		std::string sFilePath;
+		// The interleaved samples. Empty if the sound is streamed
+		std::vector<float> vSamples;
+		// The stream of a streamed sound, otherwise NULL
+		std::unique_ptr<Stream> pStream;
+		// The number of frames
+		unsigned int uiNumFrames;
+		// The volume of the next voices
+		float fVolume;
+		// false if the handle was released
+		bool bLoaded;
+	};
+
+	// A sound source which is being played
+	struct Voice
+	{
+		// The handle of the sound source
+		unsigned int uiSource;
+		// The next frame to mix
+		unsigned int uiFrame;
+		// Counted up each time the voice is started, so that the handles of its earlier sounds are not valid anymore
+		unsigned int uiGeneration;
+		// true if the voice is played at its position
+		bool b3D;
+		glm::vec3 vec3Position;
+		// The volume of the voice, which is multiplied by the volume of its sound source
+		float fVolume;
+		// true if the voice starts again at its end
+		bool bLooped;
+		// false if the voice is free
+		bool bActive;
+	};
+
+	// The output of the mixed audio
+	CAudioSink* cAudioSink;
+	// true to mix in real time on the mixer thread, false to mix in Update
+	bool bRealTime;
+
+	// The sound sources, by their handles
+	std::vector<Source> vSources;
+	// The voices
+	Voice arrVoices[MAX_VOICES];
+	// The master volume
+	float fMasterVolume;
+	// The position and view direction of the listener
+	glm::vec3 vec3ListenerPos;
+	glm::vec3 vec3ListenerDir;
+
+	// The ring buffer of mixed frames, and the positions (in frames) where the next frame is written and read
+	std::vector<float> vRingBuffer;
+	unsigned int uiRingWrite;
+	unsigned int uiRingRead;
+	// The number of frames which have been mixed
+	unsigned long long ullNumFramesMixed;
+	// The part of a frame which Update could not mix yet
+	double dFramesOwed;
+
+	// The mutex which guards the sources, voices and mixer settings
+	std::mutex mutexMixer;
+	// Signalled when the mixer thread must stop
+	std::condition_variable conditionStop;
+	// true when the mixer thread must stop
+	bool bStop;
+	// The mixer thread
+	std::thread threadMixer;
+
+	// The loop of the mixer thread
+	void Run(void);
+
+	// Mix a number of frames, up to BLOCK_FRAMES, into the ring buffer. mutexMixer must be locked
+	void MixBlock(const unsigned int uiNumFrames);
+	// Pass the frames in the ring buffer to the sink
+	void DrainRingBuffer(void);
+
+	// Get the voice of a handle. NULL if the handle is not valid, or its voice has ended. mutexMixer must be locked
+	Voice* GetVoice(const unsigned int uiVoice);
+	// Calculate the gains of the left and right channels of a voice. mutexMixer must be locked
+	void CalculateGains(const Voice& voice, float& fGainLeft, float& fGainRight) const;
+
+	// Check if a handle is a loaded sound source. mutexMixer must be locked
+	bool IsValidSource(const unsigned int uiSource) const;
+
+	// Decode the next chunks of the streamed sounds which are playing, until their rings are full
+	void RefillStreams(void);
+	// Decode the next frames of a stream into its vDecoded. It returns the number of frames which were decoded
+	static unsigned int DecodeStream(Stream& stream, const unsigned int uiNumSourceFrames);
+
+	// Read the format of a WAV file, and find its samples
+	static bool ReadWaveFormat(std::ifstream& file, const std::string& sFilePath, WaveFormat& format);
+	// Convert a sample of a frame of a WAV file to a float. A mono sound is played on both channels
+	static float ReadWaveSample(const unsigned char* pFrame, const WaveFormat& format, const unsigned int uiChannel);
+	// Decode a WAV file, and convert it to the format of the mixed audio
+	static bool DecodeWave(const std::string& sFilePath, std::vector<float>& vSamples, unsigned int& uiNumFrames);
+	// Decode an OGG Vorbis file, and convert it to the format of the mixed audio
+	static bool DecodeVorbis(const std::string& sFilePath, std::vector<float>& vSamples, unsigned int& uiNumFrames);
+	// Convert the interleaved frames of a Vorbis stream to the channels of the mixed audio
+	static void ConvertVorbisChannels(const float* pFileSamples, const unsigned int uiNumFrames,
+		const unsigned int uiFileChannels, float* pSamples);
+	// Convert the frames of a sound to the sample rate of the mixed audio
+	static void Resample(std::vector<float>& vFileSamples, const unsigned int uiFileFrames, const unsigned int uiSampleRate,
+		std::vector<float>& vSamples, unsigned int& uiNumFrames);
+	// Open a WAV file to stream it. It returns the number of frames of the sound in the format of the mixed audio
+	static bool OpenStream(const std::string& sFilePath, Stream& stream, unsigned int& uiNumFrames);
+	// Open an OGG Vorbis file to stream it. It returns the number of frames of the sound in the format of the mixed audio
+	static bool OpenVorbisStream(const std::string& sFilePath, Stream& stream, unsigned int& uiNumFrames);
+	// Decode the frames of an OGG file from uiFirstFileFrame to uiLastFileFrame into the vVorbisFrames of its stream
+	static bool ReadVorbisFrames(Stream& stream, const unsigned int uiFirstFileFrame, const unsigned int uiLastFileFrame);
+};
@@ -0,0 +1,181 @@
+/**
+ CAudioSink
+ @brief The output of the software mixer. CAudioSinkNull discards the mixed audio, e.g. to measure
+		the cost of mixing on a machine without a sound device, and CAudioSinkWaveFile writes it to
+		a 16-bit WAV file, to check what the mixer produced.
+ */
+#include "AudioSink.h"
+
+#include <iostream>
+using namespace std;
+
+// The size of the header of a WAV file with one "fmt " and one "data" chunk
+static const unsigned int WAVE_HEADER_SIZE = 44;
+
+/**
+ @brief Write a little-endian unsigned int to a stream
+ */
+static void WriteUInt(std::ostream& stream, const unsigned int uiValue)
+{
+	const unsigned char bytes[4] = {	(unsigned char)(uiValue & 0xFF), (unsigned char)((uiValue >> 8) & 0xFF),
+										(unsigned char)((uiValue >> 16) & 0xFF), (unsigned char)((uiValue >> 24) & 0xFF) };
+	stream.write((const char*)bytes, sizeof(bytes));
+}
+
+/**
+ @brief Write a little-endian unsigned short to a stream
+ */
+static void WriteUShort(std::ostream& stream, const unsigned short usValue)
+{
+	const unsigned char bytes[2] = { (unsigned char)(usValue & 0xFF), (unsigned char)((usValue >> 8) & 0xFF) };
+	stream.write((const char*)bytes, sizeof(bytes));
+}
+
+/**
+ @brief Constructor
+ */
+CAudioSinkNull::CAudioSinkNull(void)
+	: ullNumFrames(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CAudioSinkNull::~CAudioSinkNull(void)
+{
+}
+
+/**
+ @brief Open the sink
+ @param uiSampleRate The number of frames per second
+ @param uiNumChannels The number of samples in a frame
+ */
+bool CAudioSinkNull::Open(const unsigned int uiSampleRate, const unsigned int uiNumChannels)
+{
+	ullNumFrames = 0;
+	return true;
+}
+
+/**
+ @brief Count the frames, and discard them
+ @param pSamples The interleaved samples
+ @param uiNumFrames The number of frames
+ */
+void CAudioSinkNull::Write(const float* pSamples, const unsigned int uiNumFrames)
+{
+	ullNumFrames += uiNumFrames;
+}
+
+/**
+ @brief Close the sink
+ */
+void CAudioSinkNull::Close(void)
+{
+}
+
+/**
+ @brief Get the number of frames which were written
+ */
+unsigned long long CAudioSinkNull::GetNumFrames(void) const
+{
+	return ullNumFrames;
+}
+
+/**
+ @brief Constructor
+ @param sFilePath The path of the WAV file to write
+ */
+CAudioSinkWaveFile::CAudioSinkWaveFile(const std::string& sFilePath)
+	: sFilePath(sFilePath)
+	, uiNumChannels(0)
+	, uiDataBytes(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CAudioSinkWaveFile::~CAudioSinkWaveFile(void)
+{
+	Close();
+}
+
+/**
+ @brief Create the WAV file, with a header which is completed by Close
+ @param uiSampleRate The number of frames per second
+ @param uiNumChannels The number of samples in a frame
+ @return false if the file could not be created
+ */
+bool CAudioSinkWaveFile::Open(const unsigned int uiSampleRate, const unsigned int uiNumChannels)
+{
+	waveFile.open(sFilePath, ios::binary | ios::trunc);
+	if (!waveFile.is_open())
+	{
+		cout << "CAudioSinkWaveFile::Open - Unable to create " << sFilePath << endl;
+		return false;
+	}
+
+	this->uiNumChannels = uiNumChannels;
+	uiDataBytes = 0;
+
+	// The sizes of the RIFF and data chunks are written by Close
+	waveFile.write("RIFF", 4);
+	WriteUInt(waveFile, 0);
+	waveFile.write("WAVE", 4);
+	waveFile.write("fmt ", 4);
+	WriteUInt(waveFile, 16);
+	WriteUShort(waveFile, 1);	// PCM
+	WriteUShort(waveFile, (unsigned short)uiNumChannels);
+	WriteUInt(waveFile, uiSampleRate);
+	WriteUInt(waveFile, uiSampleRate * uiNumChannels * sizeof(short));
+	WriteUShort(waveFile, (unsigned short)(uiNumChannels * sizeof(short)));
+	WriteUShort(waveFile, 16);
+	waveFile.write("data", 4);
+	WriteUInt(waveFile, 0);
+
+	return true;
+}
+
+/**
+ @brief Convert the frames to 16-bit samples, and write them to the file
+ @param pSamples The interleaved samples, in [-1, 1]
+ @param uiNumFrames The number of frames
+ */
+void CAudioSinkWaveFile::Write(const float* pSamples, const unsigned int uiNumFrames)
+{
+	if (!waveFile.is_open())
+		return;
+
+	// Convert the whole block first, so that the file is written once per block
+	const unsigned int uiNumSamples = uiNumFrames * uiNumChannels;
+	vBytes.resize(uiNumSamples * sizeof(short));
+	for (unsigned int i = 0; i < uiNumSamples; i++)
+	{
+		float fSample = pSamples[i];
+		if (fSample > 1.0f)
+			fSample = 1.0f;
+		else if (fSample < -1.0f)
+			fSample = -1.0f;
+		const unsigned short usSample = (unsigned short)(short)(fSample * 32767.0f);
+		vBytes[i * 2] = (unsigned char)(usSample & 0xFF);
+		vBytes[i * 2 + 1] = (unsigned char)((usSample >> 8) & 0xFF);
+	}
+	waveFile.write((const char*)vBytes.data(), vBytes.size());
+	uiDataBytes += uiNumSamples * sizeof(short);
+}
+
+/**
+ @brief Write the sizes into the header, and close the file
+ */
+void CAudioSinkWaveFile::Close(void)
+{
+	if (!waveFile.is_open())
+		return;
+
+	waveFile.seekp(4);
+	WriteUInt(waveFile, WAVE_HEADER_SIZE - 8 + uiDataBytes);
+	waveFile.seekp(WAVE_HEADER_SIZE - 4);
+	WriteUInt(waveFile, uiDataBytes);
+	waveFile.close();
+}
@@ -0,0 +1,90 @@
+/**
+ CAudioSink
+ @brief The output of the software mixer. CAudioSinkNull discards the mixed audio, e.g. to measure
+		the cost of mixing on a machine without a sound device, and CAudioSinkWaveFile writes it to
+		a 16-bit WAV file, to check what the mixer produced.
+ */
+#pragma once
+
+// Include fstream
+#include <fstream>
+// Include string
+#include <string>
+// Include vector
+#include <vector>
+
+class CAudioSink
+{
+public:
+	// Constructor
+	CAudioSink(void) {}
+
+	// Destructor
+	virtual ~CAudioSink(void) {}
+
+	// Open the sink for a sample rate and number of channels
+	virtual bool Open(const unsigned int uiSampleRate, const unsigned int uiNumChannels) = 0;
+
+	// Write a number of frames of interleaved samples, in [-1, 1]
+	virtual void Write(const float* pSamples, const unsigned int uiNumFrames) = 0;
+
+	// Close the sink
+	virtual void Close(void) = 0;
+};
+
+class CAudioSinkNull : public CAudioSink
+{
+public:
+	// Constructor
+	CAudioSinkNull(void);
+
+	// Destructor
+	virtual ~CAudioSinkNull(void);
+
+	// Open the sink
+	virtual bool Open(const unsigned int uiSampleRate, const unsigned int uiNumChannels);
+
+	// Count the frames, and discard them
+	virtual void Write(const float* pSamples, const unsigned int uiNumFrames);
+
+	// Close the sink
+	virtual void Close(void);
+
+	// Get the number of frames which were written
+	unsigned long long GetNumFrames(void) const;
+
+protected:
+	// The number of frames which were written
+	unsigned long long ullNumFrames;
+};
+
+class CAudioSinkWaveFile : public CAudioSink
+{
+public:
+	// Constructor
+	CAudioSinkWaveFile(const std::string& sFilePath);
+
+	// Destructor
+	virtual ~CAudioSinkWaveFile(void);
+
+	// Create the WAV file, with a header which is completed by Close
+	virtual bool Open(const unsigned int uiSampleRate, const unsigned int uiNumChannels);
+
+	// Convert the frames to 16-bit samples, and write them to the file
+	virtual void Write(const float* pSamples, const unsigned int uiNumFrames);
+
+	// Write the sizes into the header, and close the file
+	virtual void Close(void);
+
+protected:
+	// The path of the WAV file
+	std::string sFilePath;
+	// The WAV file
+	std::ofstream waveFile;
+	// The number of channels
+	unsigned int uiNumChannels;
+	// The number of bytes of samples which were written
+	unsigned int uiDataBytes;
+	// The 16-bit samples of the block which is being written
+	std::vector<unsigned char> vBytes;
+};
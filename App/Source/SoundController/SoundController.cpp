@@ -1,11 +1,23 @@
 /**
  CSoundController
- @brief A class which manages the sound objects
+ @brief A class which manages the sound objects. The sounds are kept in an array indexed by their IDs,
+		so finding a sound is an array access, and the decoded audio which they keep in memory is
+		counted, and can be limited by a budget. The sounds in large files, e.g. the music, are streamed:
+		they are decoded while they play, so they only keep a small buffer in memory.
+		The game thread does not call the audio backend while playing. Each call is turned into a small
+		command in a lock-free queue, which the audio thread reads. At the end of each tick, the audio thread
+		merges the commands of that tick, e.g. a sound which was asked to play many times is played once
+		and only its last volume is set, and then passes the result to the CVoiceManager, which chooses
+		the sound instances which are mixed by the audio backend.
  By: Toh Da Jun
  Date: Mar 2020
  */
 #include "SoundController.h"
 
+// Include CProfiler to measure the loading of sounds and the audio thread
+#include "TimeControl/Profiler.h"
+
+#include <fstream>
 #include <iostream>
 using namespace std;
 
@@ -13,10 +25,25 @@ using namespace std;
  @brief Constructor
  */
 CSoundController::CSoundController(void)
-	: cSoundEngine(NULL)
-	, vec3dfListenerPos(vec3df(0, 0, 0))
-	, vec3dfListenerDir(vec3df(0, 0, 1))
+	: cAudioBackend(NULL)
+	, bPendingMasterVolume(false)
+	, fPendingMasterVolume(1.0f)
+	, bPendingListener(false)
+	, vec3PendingListenerPos(glm::vec3(0, 0, 0))
+	, vec3PendingListenerDir(glm::vec3(0, 0, 1))
+	, bWake(false)
+	, bStop(false)
+	, fMasterVolume(1.0f)
+	, uiNextInstance(CVoiceManager::INVALID_INSTANCE + 1)
+	, uiAudioMemory(0)
+	, uiPeakAudioMemory(0)
+	, iAudioMemoryBudget(-1)
+	, iAudioStreamThreshold(-1)
+	, vec3ListenerPos(glm::vec3(0, 0, 0))
+	, vec3ListenerDir(glm::vec3(0, 0, 1))
 {
+	// Make space for the sounds of the game, so that loading them does not move the array
+	vSounds.resize(NUM_SOUND_ID);
 }
 
 /**
@@ -24,96 +51,166 @@ CSoundController::CSoundController(void)
  */
 CSoundController::~CSoundController(void)
 {
-	// Iterate through the entityMap
-	for (std::map<int, CSoundInfo*>::iterator it = soundMap.begin(); it != soundMap.end(); ++it)
+	// Stop the audio thread, after it applies the commands of the ticks which have ended
+	if (threadAudio.joinable())
 	{
-		// If the value/second was not deleted elsewhere, then delete it here
-		if (it->second != NULL)
 		{
-			delete it->second;
-			it->second = NULL;
+			std::lock_guard<std::mutex> lock(mutexWake);
+			bStop = true;
 		}
+		conditionWake.notify_one();
+		threadAudio.join();
 	}
 
-	// Remove all elements in entityMap
-	soundMap.clear();
+	// Release the sound sources which are still loaded
+	for (unsigned int i = 0; i < vSounds.size(); i++)
+	{
+		if ((cAudioBackend) && (vSounds[i].GetSource() != CAudioBackend::INVALID_SOURCE))
+			cAudioBackend->ReleaseSource(vSounds[i].GetSource());
+	}
+	vSounds.clear();
 
-	// Since we have already dropped the ISoundSource, then we don't need to delete the cSoundEngine
-	//// Clear the sound engine
-	//if (cSoundEngine)
-	//{
-	//	cSoundEngine->drop();
-	//	cSoundEngine = NULL;
-	//}
+	// Clear the audio backend
+	if (cAudioBackend)
+	{
+		delete cAudioBackend;
+		cAudioBackend = NULL;
+	}
 }
 
 /**
- @brief Initialise this class instance
+ @brief Initialise this class instance with an audio backend, and start the audio thread.
+		The caller chooses the backend, e.g. the Application from CSettings, so that this class
+		does not depend on the game's settings, and can be run on its own, e.g. by the audio benchmark
+ @param cAudioBackend The audio backend, which this class deletes
  @return A bool value. true is this class instance was initialised, else false
  */
-bool CSoundController::Init(void)
+bool CSoundController::Init(CAudioBackend* cAudioBackend)
 {
-	// Initialise the sound engine with default parameters
-	cSoundEngine = createIrrKlangDevice(ESOD_WIN_MM, ESEO_MULTI_THREADED);
-	if (cSoundEngine == NULL)
+	this->cAudioBackend = cAudioBackend;
+
+	if ((cAudioBackend == NULL) || (cAudioBackend->Init() == false))
 	{
-		cout << "Unable to initialise the IrrKlang sound engine" << endl;
+		cout << "Unable to initialise the audio backend" << endl;
+		delete cAudioBackend;
+		this->cAudioBackend = NULL;
 		return false;
 	}
+
+	cVoiceManager.Init(cAudioBackend);
+
+	// Start the audio thread
+	threadAudio = std::thread(&CSoundController::Run, this);
+
 	return true;
 }
 
 /**
- @brief Load a sound
+ @brief End the commands of a simulation tick, and let the audio thread apply them.
+		The audio backend is advanced by the tick on the audio thread, e.g. the software mixer in headless mode
+ @param dElapsedTime The duration of the tick in seconds
+ */
+void CSoundController::Update(const double dElapsedTime)
+{
+	AudioCommand command = {};
+	command.eType = END_TICK;
+	command.fValue = (float)dElapsedTime;
+	PushCommand(command);
+
+	WakeAudioThread();
+}
+
+/**
+ @brief Load a sound. It is streamed if its file is at least as large as the stream threshold.
+		It is not kept if its decoded audio would go over the audio memory budget
  @param filename A string variable storing the name of the file to read from
- @param ID A const int variable which will be the ID of the iSoundSource in the map
+ @param ID A const int variable which will be the ID of the sound, e.g. a SOUND_ID
  @param bPreload A const bool variable which indicates if this iSoundSource will be pre-loaded into memory now.
  @param bIsLooped A const bool variable which indicates if this iSoundSource will have loop playback.
  @param eSoundType A SOUNDTYPE enum variable which states the type of sound
- @param vec3dfSoundPos A vec3df variable which contains the 3D position of the soundS
+ @param vec3SoundPos A glm::vec3 variable which contains the 3D position of the soundS
  */
 bool CSoundController::LoadSound(string filename,
 	const int ID,
 	const bool bPreload,
 	const bool bIsLooped,
 	CSoundInfo::SOUNDTYPE eSoundType,
-	vec3df vec3dfSoundPos)
-{	
-	// Load the sound from the file
-	ISoundSource* pSoundSource = cSoundEngine->addSoundSourceFromFile(filename.c_str(),
-		E_STREAM_MODE::ESM_NO_STREAMING,
-		bPreload);
+	glm::vec3 vec3SoundPos)
+{
+	PROFILE_SCOPE("CSoundController::LoadSound");
+
+	if (ID < 0)
+	{
+		cout << "CSoundController::LoadSound - " << ID << " is not a valid sound ID" << endl;
+		return false;
+	}
+
+	// Keep the sound if it was loaded from this file before, e.g. when a game state is entered again
+	CSoundInfo* pExistingSoundInfo = GetSound(ID);
+	if ((pExistingSoundInfo) && (filename == pExistingSoundInfo->GetFilePath()))
+		return true;
 
-	// Trivial Rejection : Invalid pointer provided
-	if (pSoundSource == nullptr)
+	// Stream the sounds in large files, e.g. the music, so that they are not decoded into memory at once
+	bool bStream = false;
+	if (iAudioStreamThreshold >= 0)
+	{
+		std::ifstream file(filename, ios::binary | ios::ate);
+		bStream = ((file.is_open()) && ((long long)file.tellg() >= (long long)iAudioStreamThreshold * 1024));
+	}
+
+	// Load the sound from the file. Loading only happens between game states, so waiting for the audio thread is fine
+	unsigned int uiSource = CAudioBackend::INVALID_SOURCE;
+	size_t uiMemorySize = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutexBackend);
+		uiSource = cAudioBackend->LoadSource(filename, bPreload, bStream);
+		if (uiSource != CAudioBackend::INVALID_SOURCE)
+			uiMemorySize = cAudioBackend->GetSourceMemory(uiSource);
+	}
+
+	// Trivial Rejection : Invalid sound source
+	if (uiSource == CAudioBackend::INVALID_SOURCE)
 	{
 		//cout << "Unable to load sound " << filename.c_str() << endl;
 		return false;
 	}
 
-	// Force the sound source not to have any streaming
-	pSoundSource->setForcedStreamingThreshold(-1);
+	// Reject the sound if it would go over the budget. The sound which it replaces does not count
+	const size_t uiReplacedMemorySize = (pExistingSoundInfo ? pExistingSoundInfo->GetMemorySize() : 0);
+	if ((iAudioMemoryBudget >= 0) &&
+		(uiAudioMemory - uiReplacedMemorySize + uiMemorySize > (size_t)iAudioMemoryBudget * 1024))
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutexBackend);
+			cAudioBackend->ReleaseSource(uiSource);
+		}
+		cout << "CSoundController::LoadSound - " << filename << " needs " << uiMemorySize / 1024
+			<< "KB, which goes over the audio memory budget of " << iAudioMemoryBudget << "KB" << endl;
+		return false;
+	}
 
-	// Clean up first if there is an existing Entity with the same name
+	// Clean up first if there is an existing sound with the same ID
 	RemoveSound(ID);
 
-	cout << vec3dfSoundPos.X << endl;
-
-	// Add the entity now
-	CSoundInfo* cSoundInfo = new CSoundInfo();
+	// Add the sound now
+	if ((unsigned int)ID >= vSounds.size())
+		vSounds.resize(ID + 1);
+	CSoundInfo& cSoundInfo = vSounds[ID];
 	if (eSoundType == CSoundInfo::SOUNDTYPE::_2D)
-		cSoundInfo->Init(ID, pSoundSource, bIsLooped);
+		cSoundInfo.Init(ID, uiSource, filename, bIsLooped);
 	else
-		cSoundInfo->Init(ID, pSoundSource, bIsLooped, eSoundType, vec3dfSoundPos);
+		cSoundInfo.Init(ID, uiSource, filename, bIsLooped, eSoundType, vec3SoundPos);
+	cSoundInfo.SetMemorySize(uiMemorySize);
 
-	// Set to soundMap
-	soundMap[ID] = cSoundInfo;
+	uiAudioMemory += uiMemorySize;
+	if (uiAudioMemory > uiPeakAudioMemory)
+		uiPeakAudioMemory = uiAudioMemory;
 
 	return true;
 }
 
 /**
- @brief Play a sound by its ID
+ @brief Play a sound by its ID. It is not played again if it is playing already, even if it is not mixed
  @param ID A const int variable which will be the ID of the iSoundSource in the map
  */
 void CSoundController::PlaySoundByID(const int ID)
@@ -124,24 +221,14 @@ void CSoundController::PlaySoundByID(const int ID)
 		cout << "Sound #" << ID << " is not playable." << endl;
 		return;
 	}
-	else if (cSoundEngine->isCurrentlyPlaying(pSoundInfo->GetSound()))
-	{
-		//cout << "Sound #" << ID << " is currently being played." << endl;
-		return;
-	}
 
-	if (pSoundInfo->GetSoundType() == CSoundInfo::SOUNDTYPE::_2D)
-	{
-		cSoundEngine->play2D(pSoundInfo->GetSound(),
-			pSoundInfo->GetLoopStatus());
-	}
-	else if (pSoundInfo->GetSoundType() == CSoundInfo::SOUNDTYPE::_3D)
-	{
-		cSoundEngine->setListenerPosition(vec3dfListenerPos, vec3dfListenerDir);
-		cSoundEngine->play3D(pSoundInfo->GetSound(),
-			pSoundInfo->GetPosition(),
-			pSoundInfo->GetLoopStatus());
-	}
+	AudioCommand command = {};
+	command.eType = PLAY;
+	command.uiSource = pSoundInfo->GetSource();
+	command.b3D = (pSoundInfo->GetSoundType() == CSoundInfo::SOUNDTYPE::_3D);
+	command.bLooped = pSoundInfo->GetLoopStatus();
+	command.vec3Position = pSoundInfo->GetPosition();
+	PushCommand(command);
 }
 
 /**
@@ -157,11 +244,11 @@ void CSoundController::StopSoundByID(const int ID)
 		cout << "Sound #" << ID << " is not playing now." << endl;
 		return;
 	}
-	else if (cSoundEngine->isCurrentlyPlaying(pSoundInfo->GetSound()))
-	{
-		cout << "Sound #" << ID << " has been stopped." << endl;
-		cSoundEngine->stopAllSoundsOfSoundSource(pSoundInfo->GetSound());
-	}
+
+	AudioCommand command = {};
+	command.eType = STOP;
+	command.uiSource = pSoundInfo->GetSource();
+	PushCommand(command);
 }
 
 /**
@@ -171,13 +258,13 @@ void CSoundController::StopSoundByID(const int ID)
 bool CSoundController::MasterVolumeIncrease(void)
 {
 	// Get the current volume
-	float fCurrentVolume = cSoundEngine->getSoundVolume() + 0.1f;
+	float fCurrentVolume = fMasterVolume + 0.1f;
 	// Check if the maximum volume has been reached
 	if (fCurrentVolume > 1.0f)
 		fCurrentVolume = 1.0f;
 
 	// Update the Mastervolume
-	cSoundEngine->setSoundVolume(fCurrentVolume);
+	SetMasterVolume(fCurrentVolume);
 	//cout << "MasterVolumeIncrease: fCurrentVolume = " << fCurrentVolume << endl;
 
 	return true;
@@ -190,13 +277,13 @@ bool CSoundController::MasterVolumeIncrease(void)
 bool CSoundController::MasterVolumeDecrease(void)
 {
 	// Get the current volume
-	float fCurrentVolume = cSoundEngine->getSoundVolume() - 0.1f;
+	float fCurrentVolume = fMasterVolume - 0.1f;
 	// Check if the minimum volume has been reached
 	if (fCurrentVolume < 0.0f)
 		fCurrentVolume = 0.0f;
 
 	// Update the Mastervolume
-	cSoundEngine->setSoundVolume(fCurrentVolume);
+	SetMasterVolume(fCurrentVolume);
 	cout << "MasterVolumeDecrease: fCurrentVolume = " << fCurrentVolume << endl;
 
 	return true;
@@ -204,129 +291,132 @@ bool CSoundController::MasterVolumeDecrease(void)
 
 
 /**
- @brief Increase volume of a ISoundSource
- @param ID A const int variable which contains the ID of the iSoundSource in the map
+ @brief Increase volume of a sound source
+ @param ID A const int variable which contains the ID of the sound in the map
  @return true if successfully decreased volume, else false
  */
 bool CSoundController::VolumeIncrease(const int ID)
 {
-	// Get the ISoundSource
-	ISoundSource* pISoundSource = GetSound(ID)->GetSound();
-	if (pISoundSource == nullptr)
+	// Get the sound
+	CSoundInfo* pSoundInfo = GetSound(ID);
+	if (pSoundInfo == nullptr)
 	{
 		return false;
 	}
 
 	// Get the current volume
-	float fCurrentVolume = pISoundSource->getDefaultVolume();
+	float fCurrentVolume = pSoundInfo->GetVolume();
 
 	// Check if the maximum volume has been reached
 	if (fCurrentVolume >= 1.0f)
 	{
-		pISoundSource->setDefaultVolume(1.0f);
+		SetVolume(ID, 1.0f);
 		return false;
 	}
 
 	// Increase the volume by 10%
-	pISoundSource->setDefaultVolume(fCurrentVolume + 0.1f);
+	SetVolume(ID, fCurrentVolume + 0.1f);
 
 	return true;
 }
 
 /**
- @brief Decrease volume of a ISoundSource
- @param ID A const int variable which contains the ID of the iSoundSource in the map
+ @brief Decrease volume of a sound source
+ @param ID A const int variable which contains the ID of the sound in the map
  @return true if successfully decreased volume, else false
  */
 bool CSoundController::VolumeDecrease(const int ID)
 {
-	// Get the ISoundSource
-	ISoundSource* pISoundSource = GetSound(ID)->GetSound();
-	if (pISoundSource == nullptr)
+	// Get the sound
+	CSoundInfo* pSoundInfo = GetSound(ID);
+	if (pSoundInfo == nullptr)
 	{
 		return false;
 	}
 
 	// Get the current volume
-	float fCurrentVolume = pISoundSource->getDefaultVolume();
+	float fCurrentVolume = pSoundInfo->GetVolume();
 
 	// Check if the minimum volume has been reached
 	if (fCurrentVolume <= 0.0f)
 	{
-		pISoundSource->setDefaultVolume(0.0f);
+		SetVolume(ID, 0.0f);
 		return false;
 	}
 
 	// Decrease the volume by 10%
-	pISoundSource->setDefaultVolume(fCurrentVolume - 0.1f);
+	SetVolume(ID, fCurrentVolume - 0.1f);
 
 	return true;
 }
 
+/**
+ @brief Set the volume of a sound source. Nothing is sent to the audio thread if the volume is not changed,
+		e.g. when an enemy sets the same volume every frame
+ @param ID A const int variable which contains the ID of the sound in the map
+ @param volume The volume
+ @return false if the sound does not exist
+ */
 bool CSoundController::SetVolume(const int ID, const float volume)
 {
-	// Get the ISoundSource
+	// Get the sound
 	CSoundInfo* SoundSource = GetSound(ID);
 	if (SoundSource == nullptr)
 	{
 		return false;
 	}
-	ISoundSource* pISoundSource = SoundSource->GetSound();
-	if (pISoundSource == nullptr)
-	{
-		return false;
-	}
-
-	// Get the current volume
-	float fCurrentVolume = pISoundSource->getDefaultVolume();
 
-	//// Check if the minimum volume has been reached
-	//if (fCurrentVolume <= 0.0f)
-	//{
-	//	pISoundSource->setDefaultVolume(0.0f);
-	//	return false;
-	//}
+	if (SoundSource->GetVolume() != volume)
+	{
+		SoundSource->SetVolume(volume);
 
-	pISoundSource->setDefaultVolume(volume);
+		AudioCommand command = {};
+		command.eType = SET_VOLUME;
+		command.uiSource = SoundSource->GetSource();
+		command.fValue = volume;
+		PushCommand(command);
+	}
 
 	return true;
 }
 
 bool CSoundController::SetMasterVolume(const float volume)
 {
-	// Get the current volume
-	float fCurrentVolume = cSoundEngine->getSoundVolume();
-	// Check if the minimum volume has been reached
-	if (fCurrentVolume < 0.0f)
-		fCurrentVolume = 0.0f;
-
 	// Update the Mastervolume
-	cSoundEngine->setSoundVolume(volume);
+	if (fMasterVolume != volume)
+	{
+		fMasterVolume = volume;
+
+		AudioCommand command = {};
+		command.eType = SET_MASTER_VOLUME;
+		command.fValue = volume;
+		PushCommand(command);
+	}
 
 	return true;
 }
 
 bool CSoundController::SetBGMVolume(const float volume)
 {
-	SetVolume(1, volume);
-	SetVolume(3, volume);
-	SetVolume(4, volume);
-	SetVolume(5, volume);
+	SetVolume(SOUND_MENU_BGM, volume);
+	SetVolume(SOUND_LOSE_BGM, volume);
+	SetVolume(SOUND_WIN_BGM, volume);
+	SetVolume(SOUND_GAME_BGM, volume);
 	
 	return true;
 }
 
 bool CSoundController::SetSFXVolume(const float volume)
 {
-	SetVolume(6, 0.5 * volume);
+	SetVolume(SOUND_BOX_MOVE, 0.5 * volume);
 	//Player
-	SetVolume(10, 0.1 * volume);
-	SetVolume(12, volume);
-	SetVolume(13, 0.25 * volume);
+	SetVolume(SOUND_STEP, 0.1 * volume);
+	SetVolume(SOUND_PLAYER_HURT, volume);
+	SetVolume(SOUND_PAPER_PICKUP, 0.25 * volume);
 	//Enemy
-	SetVolume(25, volume);
-	SetVolume(26, volume);
-	SetVolume(27, volume);
+	SetVolume(SOUND_ENEMY_STUN, volume);
+	SetVolume(SOUND_CREEPY_LAUGH, volume);
+	SetVolume(SOUND_JUMPSCARE, volume);
 
 	return true;
 }
@@ -334,26 +424,26 @@ bool CSoundController::SetSFXVolume(const float volume)
 float CSoundController::getCurrentVolume(const int ID)
 {
 	//Master
-	if (ID == 0)
-		return cSoundEngine->getSoundVolume();
+	if (ID == SOUND_MASTER)
+		return fMasterVolume;
 
-	// Get the ISoundSource, if not exists, return 1.0 by default.
+	// Get the sound, if not exists, return 1.0 by default.
 	CSoundInfo* SoundSource = GetSound(ID);
 	if (SoundSource == nullptr)
 	{
 		return 1.0;
 	}
-	ISoundSource* pISoundSource = SoundSource->GetSound();
-	if (pISoundSource == nullptr)
-	{
-		return 1.0;
-	}
 
 	// Get the current volume
-	return pISoundSource->getDefaultVolume();
+	return SoundSource->GetVolume();
 }
 
 
+/**
+ @brief Check if a sound is playing, whether it is mixed or not. It asks the voice manager, so a sound which
+		was played in this tick is not playing yet. It waits for the audio thread, so do not call it every frame
+ @param ID A const int variable which contains the ID of the sound in the map
+ */
 bool CSoundController::isPlaying(const int ID)
 {
 	CSoundInfo* pSoundInfo = GetSound(ID);
@@ -362,7 +452,8 @@ bool CSoundController::isPlaying(const int ID)
 		return false;
 	}
 	
-	return cSoundEngine->isCurrentlyPlaying(pSoundInfo->GetSound());
+	std::lock_guard<std::mutex> lock(mutexBackend);
+	return cVoiceManager.IsSourcePlaying(pSoundInfo->GetSource());
 }
 
 // For 3D sounds only
@@ -374,7 +465,17 @@ bool CSoundController::isPlaying(const int ID)
  */
 void CSoundController::SetListenerPosition(const float x, const float y, const float z)
 {
-	vec3dfListenerPos.set(x, y, z);
+	const glm::vec3 vec3NewListenerPos = glm::vec3(x, y, z);
+	if (vec3NewListenerPos == vec3ListenerPos)
+		return;
+
+	vec3ListenerPos = vec3NewListenerPos;
+
+	AudioCommand command = {};
+	command.eType = SET_LISTENER;
+	command.vec3Position = vec3ListenerPos;
+	command.vec3Direction = vec3ListenerDir;
+	PushCommand(command);
 }
 
 /**
@@ -385,7 +486,17 @@ void CSoundController::SetListenerPosition(const float x, const float y, const f
  */
 void CSoundController::SetListenerDirection(const float x, const float y, const float z)
 {
-	vec3dfListenerDir.set(x, y, z);
+	const glm::vec3 vec3NewListenerDir = glm::vec3(x, y, z);
+	if (vec3NewListenerDir == vec3ListenerDir)
+		return;
+
+	vec3ListenerDir = vec3NewListenerDir;
+
+	AudioCommand command = {};
+	command.eType = SET_LISTENER;
+	command.vec3Position = vec3ListenerPos;
+	command.vec3Direction = vec3ListenerDir;
+	PushCommand(command);
 }
 
 void CSoundController::SetSoundPosition(const float x, const float y, const float z, const int ID)
@@ -415,21 +526,184 @@ void CSoundController::SetSoundType(const int ID, int type)
 }
 
 /**
- @brief Get an sound from this map
- @param ID A const int variable which will be the ID of the iSoundSource in the map
- @return A CSoundInfo* variable
+ @brief Set the priority of a sound, the number of its instances which are mixed at the same time,
+		and the distance from the listener beyond which they are kept in time but not mixed
+ @param ID A const int variable which contains the ID of the sound in the map
+ @param iPriority The instances of sounds with a higher priority are mixed first
+ @param uiMaxVoices The number of instances which are mixed at the same time
+ @param fMaxDistance The distance beyond which the 3D instances are not mixed. 0 for any distance
+ */
+void CSoundController::SetSoundPriority(const int ID, const int iPriority, const unsigned int uiMaxVoices, const float fMaxDistance)
+{
+	CSoundInfo* pSoundInfo = GetSound(ID);
+	if (pSoundInfo == nullptr)
+		return;
+
+	AudioCommand command = {};
+	command.eType = SET_PRIORITY;
+	command.uiSource = pSoundInfo->GetSource();
+	command.iPriority = iPriority;
+	command.uiMaxVoices = uiMaxVoices;
+	command.fValue = fMaxDistance;
+	PushCommand(command);
+}
+
+/**
+ @brief Create an instance of a 3D sound, which is played and moved on its own, e.g. one for each enemy
+ @param ID A const int variable which contains the ID of the sound in the map
+ @return The handle of the instance, or CVoiceManager::INVALID_INSTANCE if the sound does not exist
+ */
+unsigned int CSoundController::CreateSoundInstance(const int ID)
+{
+	CSoundInfo* pSoundInfo = GetSound(ID);
+	if (pSoundInfo == nullptr)
+		return CVoiceManager::INVALID_INSTANCE;
+
+	AudioCommand command = {};
+	command.eType = CREATE_INSTANCE;
+	command.uiSource = pSoundInfo->GetSource();
+	command.uiInstance = uiNextInstance++;
+	command.bLooped = pSoundInfo->GetLoopStatus();
+	PushCommand(command);
+
+	// Skip the invalid handle when the handles wrap around
+	if (uiNextInstance == CVoiceManager::INVALID_INSTANCE)
+		uiNextInstance++;
+
+	return command.uiInstance;
+}
+
+/**
+ @brief Play an instance at a position, unless it is playing already. Its position and volume are updated either way
+ @param uiInstance The handle of the instance
+ @param x A const float variable containing the x-component of a position
+ @param y A const float variable containing the y-component of a position
+ @param z A const float variable containing the z-component of a position
+ @param fVolume The volume of the instance, which is multiplied by the volume of the sound
+ */
+void CSoundController::PlaySoundInstance(const unsigned int uiInstance, const float x, const float y, const float z, const float fVolume)
+{
+	if (uiInstance == CVoiceManager::INVALID_INSTANCE)
+		return;
+
+	AudioCommand command = {};
+	command.eType = PLAY_INSTANCE;
+	command.uiInstance = uiInstance;
+	command.vec3Position = glm::vec3(x, y, z);
+	command.fValue = fVolume;
+	PushCommand(command);
+}
+
+/**
+ @brief Stop an instance, and release its handle
+ @param uiInstance The handle of the instance
+ */
+void CSoundController::DestroySoundInstance(const unsigned int uiInstance)
+{
+	if (uiInstance == CVoiceManager::INVALID_INSTANCE)
+		return;
+
+	AudioCommand command = {};
+	command.eType = DESTROY_INSTANCE;
+	command.uiInstance = uiInstance;
+	PushCommand(command);
+}
+
+/**
+ @brief Set the max kilobytes of decoded audio which the sounds keep in memory.
+		It only applies to the sounds which are loaded after it is set
+ @param iBudget The number of kilobytes, or -1 for no budget
+ */
+void CSoundController::SetAudioMemoryBudget(const int iBudget)
+{
+	iAudioMemoryBudget = iBudget;
+}
+
+/**
+ @brief Get the max kilobytes of decoded audio which the sounds keep in memory
+ @return The number of kilobytes, or -1 for no budget
+ */
+int CSoundController::GetAudioMemoryBudget(void) const
+{
+	return iAudioMemoryBudget;
+}
+
+/**
+ @brief Get the number of bytes of decoded audio which the sounds keep in memory
+ @return The number of bytes
+ */
+size_t CSoundController::GetAudioMemory(void) const
+{
+	return uiAudioMemory;
+}
+
+/**
+ @brief Get the highest number of bytes of decoded audio which the sounds kept in memory
+ @return The number of bytes
+ */
+size_t CSoundController::GetPeakAudioMemory(void) const
+{
+	return uiPeakAudioMemory;
+}
+
+/**
+ @brief Print the decoded audio which each sound keeps in memory, and the total
+ */
+void CSoundController::PrintMemoryReport(void) const
+{
+	cout << "Audio memory: " << uiAudioMemory / 1024 << "KB in " << GetNumOfSounds() << " sounds, peak "
+		<< uiPeakAudioMemory / 1024 << "KB";
+	if (iAudioMemoryBudget >= 0)
+		cout << ", budget " << iAudioMemoryBudget << "KB";
+	cout << endl;
+
+	for (unsigned int i = 0; i < vSounds.size(); i++)
+	{
+		if (vSounds[i].GetSource() == CAudioBackend::INVALID_SOURCE)
+			continue;
+		cout << "  Sound #" << i << ": " << vSounds[i].GetMemorySize() / 1024 << "KB, "
+			<< vSounds[i].GetFilePath() << endl;
+	}
+}
+
+/**
+ @brief Set the size in kilobytes from which the files of the sounds are streamed.
+		It only applies to the sounds which are loaded after it is set
+ @param iThreshold The number of kilobytes, or -1 to stream none of the sounds
+ */
+void CSoundController::SetAudioStreamThreshold(const int iThreshold)
+{
+	iAudioStreamThreshold = iThreshold;
+}
+
+/**
+ @brief Get the size in kilobytes from which the files of the sounds are streamed
+ @return The number of kilobytes, or -1 if none of the sounds are streamed
+ */
+int CSoundController::GetAudioStreamThreshold(void) const
+{
+	return iAudioStreamThreshold;
+}
+
+/**
+ @brief Get a sound by its ID
+ @param ID A const int variable which contains the ID of the sound
+ @return The sound, or nullptr if it is not loaded
  */
 CSoundInfo* CSoundController::GetSound(const int ID)
 {
-	if (soundMap.count(ID) != 0)
-		return soundMap[ID];
+	if ((ID < 0) || ((unsigned int)ID >= vSounds.size()))
+		return nullptr;
 
-	return nullptr;
+	CSoundInfo* pSoundInfo = &vSounds[ID];
+	if (pSoundInfo->GetSource() == CAudioBackend::INVALID_SOURCE)
+		return nullptr;
+	return pSoundInfo;
 }
 
 /**
- @brief Remove an sound from this map
- @param ID A const int variable which will be the ID of the iSoundSource in the map
+ @brief Remove a sound by its ID
+ @param ID A const int variable which contains the ID of the sound
  @return true if the sound was successfully removed, else false
  */
 bool CSoundController::RemoveSound(const int ID)
@@ -437,18 +711,225 @@ bool CSoundController::RemoveSound(const int ID)
 	CSoundInfo* pSoundInfo = GetSound(ID);
 	if (pSoundInfo != nullptr)
 	{
-		delete pSoundInfo;
-		soundMap.erase(ID);
+		// The audio thread releases the sound source after the commands which were queued before
+		AudioCommand command = {};
+		command.eType = RELEASE_SOURCE;
+		command.uiSource = pSoundInfo->GetSource();
+		PushCommand(command);
+
+		uiAudioMemory -= pSoundInfo->GetMemorySize();
+		*pSoundInfo = CSoundInfo();
 		return true;
 	}
 	return false;
 }
 
 /**
-@brief Get the number of sounds in this map
-@return The number of sounds currently stored in the Map
-*/
+ @brief Get the number of sounds which are loaded
+ @return The number of sounds
+ */
 int CSoundController::GetNumOfSounds(void) const
 {
-	return soundMap.size();
-}
\ No newline at end of file
+	int iNumOfSounds = 0;
+	for (unsigned int i = 0; i < vSounds.size(); i++)
+	{
+		if (vSounds[i].GetSource() != CAudioBackend::INVALID_SOURCE)
+			iNumOfSounds++;
+	}
+	return iNumOfSounds;
+}
+
+/**
+ @brief Add a command to the queue. Only the game thread may call it.
+		If the queue is full, the audio thread is woken up and the game thread waits until there is space
+ @param command The command
+ */
+void CSoundController::PushCommand(const AudioCommand& command)
+{
+	while (queueCommands.Push(command) == false)
+	{
+		// Drop the command if there is no audio thread to make space, e.g. if the audio backend failed
+		if (threadAudio.joinable() == false)
+			return;
+
+		WakeAudioThread();
+		std::this_thread::yield();
+	}
+}
+
+/**
+ @brief Wake up the audio thread
+ */
+void CSoundController::WakeAudioThread(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutexWake);
+		bWake = true;
+	}
+	conditionWake.notify_one();
+}
+
+/**
+ @brief The loop of the audio thread. It sleeps until the game thread ends a tick
+ */
+void CSoundController::Run(void)
+{
+	PROFILE_THREAD("Audio");
+
+	while (true)
+	{
+		bool bStopping = false;
+		{
+			std::unique_lock<std::mutex> lock(mutexWake);
+			conditionWake.wait(lock, [this] { return (bWake == true) || (bStop == true); });
+			bStopping = bStop;
+			bWake = false;
+		}
+
+		// The last commands are applied before stopping, e.g. so that a recording has every tick
+		ProcessCommands();
+		if (bStopping)
+			return;
+	}
+}
+
+/**
+ @brief Read the commands in the queue, and apply them at the end of each tick. Only the audio thread may call it.
+		The commands of a tick which has not ended yet stay merged until its END_TICK command arrives
+ */
+void CSoundController::ProcessCommands(void)
+{
+	PROFILE_SCOPE("CSoundController::ProcessCommands");
+
+	std::lock_guard<std::mutex> lock(mutexBackend);
+
+	AudioCommand command;
+	while (queueCommands.Pop(command) == true)
+	{
+		if (command.eType == END_TICK)
+		{
+			ApplyPendingCommands();
+			cVoiceManager.Update(command.fValue);
+			cAudioBackend->Update(command.fValue);
+		}
+		else
+		{
+			MergeCommand(command);
+		}
+	}
+}
+
+/**
+ @brief Merge a command into the commands of the current tick. Only the latest volume and listener are kept,
+		and a sound source is played at most once. A stop cancels the plays before it, but not the plays after it
+ @param command The command
+ */
+void CSoundController::MergeCommand(const AudioCommand& command)
+{
+	if (command.eType == SET_MASTER_VOLUME)
+	{
+		bPendingMasterVolume = true;
+		fPendingMasterVolume = command.fValue;
+		return;
+	}
+	else if (command.eType == SET_LISTENER)
+	{
+		bPendingListener = true;
+		vec3PendingListenerPos = command.vec3Position;
+		vec3PendingListenerDir = command.vec3Direction;
+		return;
+	}
+	else if (command.eType == SET_PRIORITY)
+	{
+		cVoiceManager.SetSourceSettings(command.uiSource, command.iPriority, command.uiMaxVoices, command.fValue);
+		return;
+	}
+	else if (command.eType == CREATE_INSTANCE)
+	{
+		cVoiceManager.CreateInstance(command.uiInstance, command.uiSource, command.bLooped);
+		return;
+	}
+	else if (command.eType == PLAY_INSTANCE)
+	{
+		cVoiceManager.PlayInstance(command.uiInstance, command.vec3Position, command.fValue);
+		return;
+	}
+	else if (command.eType == DESTROY_INSTANCE)
+	{
+		cVoiceManager.DestroyInstance(command.uiInstance);
+		return;
+	}
+
+	// The remaining commands are for a sound source
+	if (command.uiSource >= vPendingSources.size())
+		vPendingSources.resize(command.uiSource + 1, PendingSource());
+
+	PendingSource& pendingSource = vPendingSources[command.uiSource];
+	if (pendingSource.bTouched == false)
+	{
+		pendingSource.bTouched = true;
+		vTouchedSources.push_back(command.uiSource);
+	}
+
+	switch (command.eType)
+	{
+	case PLAY:
+		pendingSource.bPlay = true;
+		pendingSource.b3D = command.b3D;
+		pendingSource.bLooped = command.bLooped;
+		pendingSource.vec3Position = command.vec3Position;
+		break;
+	case STOP:
+		pendingSource.bStop = true;
+		pendingSource.bPlay = false;
+		break;
+	case SET_VOLUME:
+		pendingSource.bSetVolume = true;
+		pendingSource.fVolume = command.fValue;
+		break;
+	case RELEASE_SOURCE:
+		pendingSource.bRelease = true;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ @brief Pass the merged commands of the current tick to the voice manager and the audio backend. mutexBackend must be locked
+ */
+void CSoundController::ApplyPendingCommands(void)
+{
+	if (bPendingMasterVolume)
+	{
+		cAudioBackend->SetMasterVolume(fPendingMasterVolume);
+		bPendingMasterVolume = false;
+	}
+	if (bPendingListener)
+	{
+		cAudioBackend->SetListener(vec3PendingListenerPos, vec3PendingListenerDir);
+		cVoiceManager.SetListener(vec3PendingListenerPos);
+		bPendingListener = false;
+	}
+
+	for (unsigned int i = 0; i < vTouchedSources.size(); i++)
+	{
+		const unsigned int uiSource = vTouchedSources[i];
+		PendingSource& pendingSource = vPendingSources[uiSource];
+
+		if (pendingSource.bStop)
+			cVoiceManager.StopSource(uiSource);
+		if (pendingSource.bSetVolume)
+			cAudioBackend->SetSourceVolume(uiSource, pendingSource.fVolume);
+		if (pendingSource.bPlay)
+			cVoiceManager.PlaySource(uiSource, pendingSource.b3D, pendingSource.vec3Position, pendingSource.bLooped);
+		if (pendingSource.bRelease)
+		{
+			cVoiceManager.ReleaseSource(uiSource);
+			cAudioBackend->ReleaseSource(uiSource);
+		}
+
+		pendingSource = PendingSource();
+	}
+	vTouchedSources.clear();
+}
@@ -1,34 +1,52 @@
 /**
  CSoundController
- @brief A class which manages the sound objects
+ @brief A class which manages the sound objects. The sounds are kept in an array indexed by their IDs,
+		so finding a sound is an array access, and the decoded audio which they keep in memory is
+		counted, and can be limited by a budget. The sounds in large files, e.g. the music, are streamed:
+		they are decoded while they play, so they only keep a small buffer in memory.
+		The game thread does not call the audio backend while playing. Each call is turned into a small
+		command in a lock-free queue, which the audio thread reads. At the end of each tick, the audio thread
+		merges the commands of that tick, e.g. a sound which was asked to play many times is played once
+		and only its last volume is set, and then passes the result to the CVoiceManager, which chooses
+		the sound instances which are mixed by the audio backend.
  By: Toh Da Jun
  Date: Mar 2020
  */
 #pragma once
 
  // Include SingletonTemplate
-#include <DesignPatterns\SingletonTemplate.h>
+#include <DesignPatterns/SingletonTemplate.h>
 
-// Include GLEW
-#include <includes/irrKlang.h>
-using namespace irrklang;
-#pragma comment(lib, "irrKlang.lib") // link with irrKlang.dll
+// Include CAudioBackend, which plays the sounds
+#include "AudioBackend.h"
+// Include CVoiceManager, which chooses the sound instances which are mixed
+#include "VoiceManager.h"
+// Include CSPSCQueue to pass the commands to the audio thread
+#include <System/SPSCQueue.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // Include string
 #include <string>
-// Include map storage
-#include <map>
 using namespace std;
 
 // Include SoundInfo class; it stores the sound and other information
 #include "SoundInfo.h"
+// Include the IDs of the sounds
+#include "SoundIDs.h"
 
 class CSoundController : public CSingletonTemplate<CSoundController>
 {
 	friend CSingletonTemplate<CSoundController>;
 public:
-	// Initialise this class instance
-	bool Init(void);
+	// Initialise this class instance with an audio backend, and start the audio thread
+	bool Init(CAudioBackend* cAudioBackend);
+
+	// End the commands of a simulation tick, and let the audio thread apply them
+	void Update(const double dElapsedTime);
 
 	// Load a sound
 	bool LoadSound(string filename,
@@ -36,7 +54,7 @@ public:
 		const bool bPreload = true,
 		const bool bIsLooped = false,
 		CSoundInfo::SOUNDTYPE eSoundType = CSoundInfo::SOUNDTYPE::_2D,
-		vec3df vec3dfSoundPos = vec3df(0.0f, 0.0f, 0.0f));
+		glm::vec3 vec3SoundPos = glm::vec3(0.0f, 0.0f, 0.0f));
 
 	// Play a sound by its ID
 	void PlaySoundByID(const int ID);
@@ -49,9 +67,9 @@ public:
 	// Decrease Master volume
 	bool MasterVolumeDecrease(void);
 
-	// Increase volume of a ISoundSource
+	// Increase volume of a sound source
 	bool VolumeIncrease(const int ID);
-	// Decrease volume of a ISoundSource
+	// Decrease volume of a sound source
 	bool VolumeDecrease(const int ID);
 	bool SetVolume(const int ID, const float volume);
 
@@ -74,30 +92,182 @@ public:
 	int GetSoundType(const int ID);
 	void SetSoundType(const int ID, int type);
 
+	// Set the priority of a sound, the number of its instances which are mixed at the same time,
+	// and the distance from the listener beyond which they are kept in time but not mixed. 0 for any distance
+	void SetSoundPriority(const int ID, const int iPriority, const unsigned int uiMaxVoices, const float fMaxDistance = 0.0f);
+
+	// Create an instance of a 3D sound, which is played and moved on its own, e.g. one for each enemy.
+	// It returns CVoiceManager::INVALID_INSTANCE if the sound does not exist
+	unsigned int CreateSoundInstance(const int ID);
+	// Play an instance at a position, unless it is playing already. Its position and volume are updated either way
+	void PlaySoundInstance(const unsigned int uiInstance, const float x, const float y, const float z, const float fVolume = 1.0f);
+	// Stop an instance, and release its handle
+	void DestroySoundInstance(const unsigned int uiInstance);
+
+	// Set the max kilobytes of decoded audio which the sounds keep in memory. -1 for no budget
+	void SetAudioMemoryBudget(const int iBudget);
+	// Get the max kilobytes of decoded audio which the sounds keep in memory. -1 for no budget
+	int GetAudioMemoryBudget(void) const;
+	// Get the number of bytes of decoded audio which the sounds keep in memory
+	size_t GetAudioMemory(void) const;
+	// Get the highest number of bytes of decoded audio which the sounds kept in memory
+	size_t GetPeakAudioMemory(void) const;
+	// Print the decoded audio which each sound keeps in memory
+	void PrintMemoryReport(void) const;
+
+	// Set the size in kilobytes from which the files of the sounds are streamed. -1 to stream none of them
+	void SetAudioStreamThreshold(const int iThreshold);
+	// Get the size in kilobytes from which the files of the sounds are streamed. -1 to stream none of them
+	int GetAudioStreamThreshold(void) const;
+
 protected:
+	// The types of the commands for the audio thread
+	enum AUDIOCOMMAND
+	{
+		PLAY = 0,
+		STOP,
+		SET_VOLUME,
+		SET_MASTER_VOLUME,
+		SET_LISTENER,
+		RELEASE_SOURCE,
+		SET_PRIORITY,
+		CREATE_INSTANCE,
+		PLAY_INSTANCE,
+		DESTROY_INSTANCE,
+		END_TICK,
+		NUM_AUDIOCOMMAND
+	};
+
+	// A command for the audio thread
+	struct AudioCommand
+	{
+		// The type of the command
+		AUDIOCOMMAND eType;
+		// The handle of the sound source
+		unsigned int uiSource;
+		// CREATE_INSTANCE, PLAY_INSTANCE, DESTROY_INSTANCE: the handle of the instance
+		unsigned int uiInstance;
+		// PLAY: true if the sound is played at its position
+		bool b3D;
+		// PLAY, CREATE_INSTANCE: true if the sound is looped
+		bool bLooped;
+		// SET_PRIORITY: the priority and the number of voices of the sound
+		int iPriority;
+		unsigned int uiMaxVoices;
+		// SET_VOLUME, SET_MASTER_VOLUME, PLAY_INSTANCE: the volume. SET_PRIORITY: the maximum distance.
+		// END_TICK: the duration of the tick
+		float fValue;
+		// PLAY, PLAY_INSTANCE: the position of the sound. SET_LISTENER: the position of the listener
+		glm::vec3 vec3Position;
+		// SET_LISTENER: the view direction of the listener
+		glm::vec3 vec3Direction;
+	};
+
+	// The commands of a sound source in the current tick, merged into the latest request of each kind
+	struct PendingSource
+	{
+		// true if the sound source is in vTouchedSources
+		bool bTouched;
+		// true if the voices of the sound source are stopped, before it is played again
+		bool bStop;
+		// true if the sound source is played, unless it is playing already
+		bool bPlay;
+		bool b3D;
+		bool bLooped;
+		glm::vec3 vec3Position;
+		// true if the volume is set
+		bool bSetVolume;
+		float fVolume;
+		// true if the sound source is released, after all its other commands
+		bool bRelease;
+	};
+
+	// The number of commands which the queue can hold. If it is full, the game thread waits for the audio thread
+	static const unsigned int COMMAND_QUEUE_SIZE = 4096;
+
 	// Constructor
 	CSoundController(void);
 
 	// Destructor
 	virtual ~CSoundController(void);
 
-	// Get an sound from this map
+	// Get a sound by its ID. nullptr if it is not loaded
 	CSoundInfo* GetSound(const int ID);
-	// Remove an sound from this map
+	// Remove a sound by its ID
 	bool RemoveSound(const int ID);
-	// Get the number of sounds in this map
+	// Get the number of sounds which are loaded
 	int GetNumOfSounds(void) const;
 
-	// The handler to the irrklang Sound Engine
-	ISoundEngine* cSoundEngine;
+	// Add a command to the queue. Only the game thread may call it
+	void PushCommand(const AudioCommand& command);
+	// Wake up the audio thread
+	void WakeAudioThread(void);
+
+	// The loop of the audio thread
+	void Run(void);
+	// Read the commands in the queue, and apply them at the end of each tick. Only the audio thread may call it
+	void ProcessCommands(void);
+	// Merge a command into the commands of the current tick. The commands of the instances are passed
+	// to the voice manager at once, as it only calls the audio backend in its Update
+	void MergeCommand(const AudioCommand& command);
+	// Pass the merged commands of the current tick to the audio backend
+	void ApplyPendingCommands(void);
+
+	// The audio backend which plays the sounds
+	CAudioBackend* cAudioBackend;
+	// The voice manager which chooses the sound instances which are mixed by the audio backend
+	CVoiceManager cVoiceManager;
+	// The mutex which guards the audio backend and the voice manager.
+	// The game thread only takes it to load a sound or to ask if one is playing
+	std::mutex mutexBackend;
+
+	// The commands from the game thread to the audio thread
+	CSPSCQueue<AudioCommand, COMMAND_QUEUE_SIZE> queueCommands;
+
+	// The merged commands of the current tick, by the handles of the sound sources. Only the audio thread uses them
+	std::vector<PendingSource> vPendingSources;
+	// The handles of the sound sources which have commands in the current tick
+	std::vector<unsigned int> vTouchedSources;
+	// The latest master volume and listener of the current tick
+	bool bPendingMasterVolume;
+	float fPendingMasterVolume;
+	bool bPendingListener;
+	glm::vec3 vec3PendingListenerPos;
+	glm::vec3 vec3PendingListenerDir;
+
+	// The mutex which guards the wake up flags
+	std::mutex mutexWake;
+	// Signalled when the audio thread has commands to apply, or must stop
+	std::condition_variable conditionWake;
+	// true when the audio thread has commands to apply
+	bool bWake;
+	// true when the audio thread must stop
+	bool bStop;
+	// The audio thread
+	std::thread threadAudio;
+
+	// The master volume which was last sent to the audio backend
+	float fMasterVolume;
+
+	// The handle of the next instance which is created. The handles are chosen by the game thread,
+	// so that an instance can be used at once, without waiting for the audio thread
+	unsigned int uiNextInstance;
+
+	// The sounds, by their IDs. A sound which is not loaded has the handle CAudioBackend::INVALID_SOURCE
+	std::vector<CSoundInfo> vSounds;
 
-	// The map of all the entity created
-	std::map<int, CSoundInfo*> soundMap;
+	// The number of bytes of decoded audio which the sounds keep in memory, and the highest number so far
+	size_t uiAudioMemory;
+	size_t uiPeakAudioMemory;
+	// The max kilobytes of decoded audio which the sounds keep in memory. -1 for no budget
+	int iAudioMemoryBudget;
+	// The size in kilobytes from which the files of the sounds are streamed. -1 to stream none of them
+	int iAudioStreamThreshold;
 
 	// For 3D sound only: Listener position
-	vec3df vec3dfListenerPos;
+	glm::vec3 vec3ListenerPos;
 	// For 3D sound only: Listender view direction
-	vec3df vec3dfListenerDir;
+	glm::vec3 vec3ListenerDir;
 
 };
 
@@ -0,0 +1,39 @@
+/**
+ SoundIDs
+ @brief The IDs of the sounds of the game. CSoundController keeps its sounds in an array which is
+		indexed by these IDs, so they must stay small and close together.
+ */
+#pragma once
+
+enum SOUND_ID
+{
+	// Not a sound. CSoundController::getCurrentVolume returns the master volume for it
+	SOUND_MASTER = 0,
+
+	// Loaded by CIntroState
+	SOUND_MENU_BGM = 1,
+	SOUND_UI_CONFIRM = 2,
+	SOUND_LOSE_BGM = 3,
+	SOUND_WIN_BGM = 4,
+
+	// Loaded by CScene2D
+	SOUND_GAME_BGM = 5,
+	SOUND_BOX_MOVE = 6,
+	SOUND_STEP = 10,
+	SOUND_PLAYER_HURT = 12,
+	SOUND_PAPER_PICKUP = 13,
+	SOUND_LIGHT_FLICKER = 14,
+	SOUND_PLAYER_FOUND = 15,
+	SOUND_ENEMY_STUN = 25,
+	SOUND_CREEPY_LAUGH = 26,
+	SOUND_JUMPSCARE = 27,
+	SOUND_BATTERY_PICKUP = 28,
+
+	// Played, but not loaded by any game state yet
+	SOUND_PLAYER_DAMAGED = 9,
+	SOUND_ENEMY_ATTACK = 19,
+	SOUND_ENEMY_HURT = 21,
+
+	// The number of IDs which the sound array holds
+	NUM_SOUND_ID = 29
+};
@@ -6,6 +6,9 @@
  */
 #include "SoundInfo.h"
 
+// Include CAudioBackend for the handle of an invalid sound source
+#include "AudioBackend.h"
+
 #include <iostream>
 using namespace std;
 
@@ -14,57 +17,64 @@ using namespace std;
  */
 CSoundInfo::CSoundInfo(void)
 	: ID(-1)
-	, pSoundSource(NULL)
+	, uiSource(CAudioBackend::INVALID_SOURCE)
 	, bIsLooped(false)
 	, eSoundType(_2D)
-	, vec3dfSoundPos(vec3df(0.0, 0.0, 0.0))
+	, vec3SoundPos(glm::vec3(0.0, 0.0, 0.0))
+	, fVolume(1.0f)
+	, uiMemorySize(0)
 {
 }
 
 /**
- @brief Destructor
+ @brief Destructor. The sound source is released by CSoundController, which owns the audio backend
  */
 CSoundInfo::~CSoundInfo(void)
 {
-	// Clear the memory before destroying this class instance
-	if (pSoundSource != NULL)
-	{
-		pSoundSource->drop();
-		pSoundSource = NULL;
-	}
 }
 
 /**
  @brief Initialise this class instance
- @param ID A const int variable which will be the ID of the iSoundSource in the map
- @param pSoundSource A ISoundSource* variable which contains the iSoundSource
- @param bIsLooped A const bool variable which indicates if this iSoundSource will have loop playback.
+ @param ID A const int variable which will be the ID of the sound in the map
+ @param uiSource The handle of the sound source in the audio backend
+ @param sFilePath The path of the file which the sound was loaded from
+ @param bIsLooped A const bool variable which indicates if this sound will have loop playback.
  @param eSoundType A SOUNDTYPE enum variable which states the type of sound
- @param vec3dfSoundPos A vec3df variable which contains the 3D position of the sound
+ @param vec3SoundPos A glm::vec3 variable which contains the 3D position of the sound
  @return A bool value. true is this class instance was initialised, else false
  */
 bool CSoundInfo::Init(const int ID,
-	ISoundSource* pSoundSource,
+	const unsigned int uiSource,
+	const std::string& sFilePath,
 	const bool bIsLooped,
 	SOUNDTYPE eSoundType,
-	vec3df vec3dfSoundPos)
+	glm::vec3 vec3SoundPos)
 {
 	this->ID = ID;
-	this->pSoundSource = pSoundSource;
+	this->uiSource = uiSource;
+	this->sFilePath = sFilePath;
 	this->bIsLooped = bIsLooped;
 	this->eSoundType = eSoundType;
-	this->vec3dfSoundPos = vec3dfSoundPos;
+	this->vec3SoundPos = vec3SoundPos;
 
 	return true;
 }
 
 /**
- @brief Get an sound from this class
- @return The iSoundSource stored in this class instance
+ @brief Get the handle of the sound source in the audio backend
+ @return The handle of the sound source
+ */
+unsigned int CSoundInfo::GetSource(void) const
+{
+	return uiSource;
+}
+
+/**
+ @brief Get the path of the file which the sound was loaded from
  */
-ISoundSource* CSoundInfo::GetSound(void) const
+const std::string& CSoundInfo::GetFilePath(void) const
 {
-	return pSoundSource;
+	return sFilePath;
 }
 
 /**
@@ -90,65 +100,59 @@ void CSoundInfo::SetSoundType(SOUNDTYPE eSoundtype)
 	eSoundType = eSoundtype;
 }
 
+// For 3D sounds only
 /**
- @brief Increase volume of a ISoundSource
- @return true if successfully decreased volume, else false
+ @brief Set Listener position
+ @param x A const float variable containing the x-component of a position
+ @param y A const float variable containing the y-component of a position
+ @param z A const float variable containing the z-component of a position
  */
-bool CSoundInfo::VolumeIncrease(void)
+void CSoundInfo::SetPosition(const float x, const float y, const float z)
 {
-	// Get the current volume
-	float fCurrentVolume = pSoundSource->getDefaultVolume();
-
-	// Increase the volume by 10%
-	pSoundSource->setDefaultVolume(fCurrentVolume + 0.1f);
-
-	// Check if the maximum volume has been reached
-	if (fCurrentVolume >= 1.0f)
-	{
-		pSoundSource->setDefaultVolume(1.0f);
-	}
-
-	return true;
+	vec3SoundPos = glm::vec3(x, y, z);
 }
 
 /**
- @brief Decrease volume of a ISoundSource
- @return true if successfully decreased volume, else false
+ @brief Get position of the 3D sound
+ @return The position of the 3D sound
  */
-bool CSoundInfo::VolumeDecrease(void)
+glm::vec3 CSoundInfo::GetPosition(void) const
 {
-	// Get the current volume
-	float fCurrentVolume = pSoundSource->getDefaultVolume();
-
-	// Decrease the volume by 10%
-	pSoundSource->setDefaultVolume(fCurrentVolume - 0.1f);
+	return vec3SoundPos;
+}
 
-	// Check if the minimum volume has been reached
-	if (fCurrentVolume <= 0.0f)
-	{
-		pSoundSource->setDefaultVolume(0.0f);
-	}
+/**
+ @brief Set the volume which was last sent to the audio backend
+ @param fVolume The volume
+ */
+void CSoundInfo::SetVolume(const float fVolume)
+{
+	this->fVolume = fVolume;
+}
 
-	return true;
+/**
+ @brief Get the volume which was last sent to the audio backend
+ @return The volume
+ */
+float CSoundInfo::GetVolume(void) const
+{
+	return fVolume;
 }
 
-// For 3D sounds only
 /**
- @brief Set Listener position
- @param x A const float variable containing the x-component of a position
- @param y A const float variable containing the y-component of a position
- @param z A const float variable containing the z-component of a position
+ @brief Set the number of bytes of decoded audio which the sound keeps in memory
+ @param uiMemorySize The number of bytes
  */
-void CSoundInfo::SetPosition(const float x, const float y, const float z)
+void CSoundInfo::SetMemorySize(const size_t uiMemorySize)
 {
-	vec3dfSoundPos.set(x, y, z);
+	this->uiMemorySize = uiMemorySize;
 }
 
 /**
- @brief Get position of the 3D sound
- @return The position of the 3D sound
+ @brief Get the number of bytes of decoded audio which the sound keeps in memory
+ @return The number of bytes
  */
-vec3df CSoundInfo::GetPosition(void) const
+size_t CSoundInfo::GetMemorySize(void) const
 {
-	return vec3dfSoundPos;
-}
\ No newline at end of file
+	return uiMemorySize;
+}
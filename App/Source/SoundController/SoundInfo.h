@@ -6,10 +6,11 @@
  */
 #pragma once
 
- // Include IrrKlang
-#include <includes/irrKlang.h>
-using namespace irrklang;
-#pragma comment(lib, "irrKlang.lib") // link with irrKlang.dll
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include string
+#include <string>
 
 class CSoundInfo
 {
@@ -29,13 +30,17 @@ public:
 
 	// Initialise this class instance
 	bool Init(const int ID,
-		ISoundSource* pSoundSource,
+		const unsigned int uiSource,
+		const std::string& sFilePath,
 		const bool bIsLooped = false,
 		SOUNDTYPE eSoundType = _2D,
-		vec3df vec3dfSoundPos = vec3df(0.0f, 0.0f, 0.0f));
+		glm::vec3 vec3SoundPos = glm::vec3(0.0f, 0.0f, 0.0f));
+
+	// Get the handle of the sound source in the audio backend
+	unsigned int GetSource(void) const;
 
-	// Get an sound from this map
-	ISoundSource* GetSound(void) const;
+	// Get the path of the file which the sound was loaded from
+	const std::string& GetFilePath(void) const;
 
 	// Get loop status
 	bool GetLoopStatus(void) const;
@@ -44,24 +49,32 @@ public:
 	SOUNDTYPE GetSoundType(void) const;
 	void SetSoundType(SOUNDTYPE eSoundtype);
 
-	// Increase volume of a ISoundSource
-	bool VolumeIncrease(void);
-	// Decrease volume of a ISoundSource
-	bool VolumeDecrease(void);
-
 	// For 3D sounds only
 	// Set position
 	void SetPosition(const float x, const float y, const float z);
 
 	// Get position
-	vec3df GetPosition(void) const;
+	glm::vec3 GetPosition(void) const;
+
+	// Set the volume which was last sent to the audio backend
+	void SetVolume(const float fVolume);
+	// Get the volume which was last sent to the audio backend
+	float GetVolume(void) const;
+
+	// Set the number of bytes of decoded audio which the sound keeps in memory
+	void SetMemorySize(const size_t uiMemorySize);
+	// Get the number of bytes of decoded audio which the sound keeps in memory
+	size_t GetMemorySize(void) const;
 
 protected:
 	// ID for this sound
 	int ID;
 
-	// The handler to the irrklang Sound Engine
-	ISoundSource* pSoundSource;
+	// The handle of the sound source in the audio backend
+	unsigned int uiSource;
+
+	// The path of the file which the sound was loaded from
+	std::string sFilePath;
 
 	// Indicate if this sound will be looped during playback
 	bool bIsLooped;
@@ -70,6 +83,11 @@ protected:
 	SOUNDTYPE eSoundType;
 
 	// For 3D sound only: Sound position
-	vec3df vec3dfSoundPos;
-};
+	glm::vec3 vec3SoundPos;
 
+	// The volume which was last sent to the audio backend. The backend is only asked on the audio thread
+	float fVolume;
+
+	// The number of bytes of decoded audio which the sound keeps in memory
+	size_t uiMemorySize;
+};
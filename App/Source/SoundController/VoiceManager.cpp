@@ -0,0 +1,472 @@
+/**
+ CVoiceManager
+ @brief A class which decides which sound instances are mixed. Every sound which is played is an instance in
+		a fixed pool. Each tick, the instances which can be heard are ranked by the priority of their sound and
+		by how loud they are at the listener. Only the first MAX_REAL_VOICES of them, and at most the number of
+		voices of each sound, are played by the audio backend. The other instances are virtual: they keep their
+		time, but are not mixed, and they are played again from that time when they become important enough.
+		So the cost of mixing does not grow with the number of enemies. It is only used on the audio thread.
+ */
+#include "VoiceManager.h"
+
+// Include CProfiler to measure the cost of choosing the voices
+#include "TimeControl/Profiler.h"
+
+#include <algorithm>
+#include <climits>
+
+// The distance within which a 3D sound is heard at its full volume, as in the audio backends
+static const float MIN_DISTANCE = 1.0f;
+
+/**
+ @brief Constructor
+ */
+CVoiceManager::CVoiceManager(void)
+	: cAudioBackend(NULL)
+	, vec3ListenerPos(glm::vec3(0.0f, 0.0f, 0.0f))
+	, uiNumRealVoices(0)
+{
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		arrInstances[i].bInUse = false;
+		arrInstances[i].bPlaying = false;
+		arrInstances[i].uiVoice = CAudioBackend::INVALID_VOICE;
+	}
+}
+
+/**
+ @brief Destructor. The voices are stopped by the audio backend when it is deleted
+ */
+CVoiceManager::~CVoiceManager(void)
+{
+	cAudioBackend = NULL;
+}
+
+/**
+ @brief Set the audio backend which plays the real voices
+ @param cAudioBackend The audio backend
+ */
+void CVoiceManager::Init(CAudioBackend* cAudioBackend)
+{
+	this->cAudioBackend = cAudioBackend;
+}
+
+/**
+ @brief Set the priority of a sound source, the number of its instances which are mixed at the same time,
+		and the distance from the listener beyond which its 3D instances are not mixed
+ @param uiSource The handle of the sound source
+ @param iPriority The instances of sounds with a higher priority are mixed first
+ @param uiMaxVoices The number of instances which are mixed at the same time
+ @param fMaxDistance The distance beyond which 3D instances are not mixed. 0 for any distance
+ */
+void CVoiceManager::SetSourceSettings(const unsigned int uiSource, const int iPriority, const unsigned int uiMaxVoices, const float fMaxDistance)
+{
+	SourceSettings& settings = GetSourceSettings(uiSource);
+	settings.iPriority = iPriority;
+	settings.uiMaxVoices = uiMaxVoices;
+	settings.fMaxDistance = fMaxDistance;
+}
+
+/**
+ @brief Play a sound source, unless it was played by this method and is still playing.
+		The instance is removed when it ends
+ @param uiSource The handle of the sound source
+ @param b3D true to play the sound at its position
+ @param vec3Position The position of the sound
+ @param bLooped true to loop the sound
+ */
+void CVoiceManager::PlaySource(const unsigned int uiSource, const bool b3D, const glm::vec3& vec3Position, const bool bLooped)
+{
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		const Instance& instance = arrInstances[i];
+		if ((instance.bInUse) && (instance.uiHandle == INVALID_INSTANCE) && (instance.uiSource == uiSource))
+			return;
+	}
+
+	Instance* pInstance = AllocateInstance(GetSourceSettings(uiSource).iPriority);
+	if (pInstance == NULL)
+		return;
+
+	pInstance->uiHandle = INVALID_INSTANCE;
+	pInstance->uiSource = uiSource;
+	pInstance->b3D = b3D;
+	pInstance->vec3Position = vec3Position;
+	pInstance->fVolume = 1.0f;
+	pInstance->bLooped = bLooped;
+	pInstance->bPlaying = true;
+	pInstance->dTime = 0.0;
+}
+
+/**
+ @brief Stop all the instances of a sound source
+ @param uiSource The handle of the sound source
+ */
+void CVoiceManager::StopSource(const unsigned int uiSource)
+{
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		Instance& instance = arrInstances[i];
+		if ((instance.bInUse) && (instance.bPlaying) && (instance.uiSource == uiSource))
+			EndInstance(instance);
+	}
+}
+
+/**
+ @brief Remove all the instances and the settings of a sound source, before it is released.
+		The instances which were created by the game thread are removed too, so their handles are not known anymore
+ @param uiSource The handle of the sound source
+ */
+void CVoiceManager::ReleaseSource(const unsigned int uiSource)
+{
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		Instance& instance = arrInstances[i];
+		if ((instance.bInUse == false) || (instance.uiSource != uiSource))
+			continue;
+
+		StopVoice(instance);
+		if (instance.uiHandle != INVALID_INSTANCE)
+			mapInstances.erase(instance.uiHandle);
+		instance.bInUse = false;
+		instance.bPlaying = false;
+	}
+
+	// A new sound source may get this handle, so it starts with the default settings
+	SourceSettings& settings = GetSourceSettings(uiSource);
+	settings.iPriority = 0;
+	settings.uiMaxVoices = MAX_REAL_VOICES;
+	settings.fMaxDistance = 0.0f;
+	settings.fLength = -1.0f;
+}
+
+/**
+ @brief Check if an instance of a sound source is playing, whether it is mixed or not
+ @param uiSource The handle of the sound source
+ */
+bool CVoiceManager::IsSourcePlaying(const unsigned int uiSource) const
+{
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		const Instance& instance = arrInstances[i];
+		if ((instance.bInUse) && (instance.bPlaying) && (instance.uiSource == uiSource))
+			return true;
+	}
+	return false;
+}
+
+/**
+ @brief Create a 3D instance of a sound source, with a handle chosen by the game thread.
+		It is not played until PlayInstance is called. Nothing is created if MAX_CREATED_INSTANCES are in use
+ @param uiInstance The handle of the instance
+ @param uiSource The handle of the sound source
+ @param bLooped true to loop the sound
+ */
+void CVoiceManager::CreateInstance(const unsigned int uiInstance, const unsigned int uiSource, const bool bLooped)
+{
+	if ((uiInstance == INVALID_INSTANCE) || (FindInstance(uiInstance) != NULL) || (mapInstances.size() >= MAX_CREATED_INSTANCES))
+		return;
+
+	// The instances of the game are kept until they are destroyed, so they may take an instance of PlaySource
+	// if every instance is in use
+	Instance* pInstance = AllocateInstance(INT_MAX);
+	if (pInstance == NULL)
+		return;
+
+	pInstance->uiHandle = uiInstance;
+	pInstance->uiSource = uiSource;
+	pInstance->b3D = true;
+	pInstance->vec3Position = glm::vec3(0.0f, 0.0f, 0.0f);
+	pInstance->fVolume = 1.0f;
+	pInstance->bLooped = bLooped;
+	pInstance->bPlaying = false;
+	pInstance->dTime = 0.0;
+	mapInstances[uiInstance] = (unsigned int)(pInstance - arrInstances);
+}
+
+/**
+ @brief Play an instance at a position, unless it is playing already. Its position and volume are updated either way
+ @param uiInstance The handle of the instance
+ @param vec3Position The position of the instance
+ @param fVolume The volume of the instance, which is multiplied by the volume of its sound source
+ */
+void CVoiceManager::PlayInstance(const unsigned int uiInstance, const glm::vec3& vec3Position, const float fVolume)
+{
+	Instance* pInstance = FindInstance(uiInstance);
+	if (pInstance == NULL)
+		return;
+
+	pInstance->vec3Position = vec3Position;
+	pInstance->fVolume = fVolume;
+	if (pInstance->bPlaying == false)
+	{
+		pInstance->bPlaying = true;
+		pInstance->dTime = 0.0;
+	}
+}
+
+/**
+ @brief Stop an instance, and remove it
+ @param uiInstance The handle of the instance
+ */
+void CVoiceManager::DestroyInstance(const unsigned int uiInstance)
+{
+	Instance* pInstance = FindInstance(uiInstance);
+	if (pInstance == NULL)
+		return;
+
+	StopVoice(*pInstance);
+	pInstance->bInUse = false;
+	pInstance->bPlaying = false;
+	mapInstances.erase(uiInstance);
+}
+
+/**
+ @brief Set the position of the listener
+ @param vec3Position The position of the listener
+ */
+void CVoiceManager::SetListener(const glm::vec3& vec3Position)
+{
+	vec3ListenerPos = vec3Position;
+}
+
+/**
+ @brief Advance the instances by the duration of a tick, and choose which of them are mixed
+ @param dElapsedTime The duration of the tick in seconds
+ */
+void CVoiceManager::Update(const double dElapsedTime)
+{
+	PROFILE_SCOPE("CVoiceManager::Update");
+
+	// Advance the instances which are playing, and end those which have reached their end
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		Instance& instance = arrInstances[i];
+		if ((instance.bInUse == false) || (instance.bPlaying == false))
+			continue;
+
+		instance.dTime += dElapsedTime;
+		if (instance.uiVoice != CAudioBackend::INVALID_VOICE)
+		{
+			if (cAudioBackend->IsVoicePlaying(instance.uiVoice) == false)
+				EndInstance(instance);
+		}
+		else if (instance.bLooped == false)
+		{
+			SourceSettings& settings = GetSourceSettings(instance.uiSource);
+			if (settings.fLength < 0.0f)
+				settings.fLength = cAudioBackend->GetSourceLength(instance.uiSource);
+			if (instance.dTime >= settings.fLength)
+				EndInstance(instance);
+		}
+	}
+
+	// Rank the instances which can be heard by the priority of their sounds, and then by how loud they are
+	vRanking.clear();
+	vLoudness.resize(MAX_INSTANCES);
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		const Instance& instance = arrInstances[i];
+		if ((instance.bInUse == false) || (instance.bPlaying == false))
+			continue;
+
+		GetSourceSettings(instance.uiSource);
+		vLoudness[i] = GetLoudness(instance);
+		if (vLoudness[i] >= 0.0f)
+			vRanking.push_back(i);
+	}
+	std::sort(vRanking.begin(), vRanking.end(), [this](const unsigned int a, const unsigned int b)
+	{
+		const int iPriorityA = vSourceSettings[arrInstances[a].uiSource].iPriority;
+		const int iPriorityB = vSourceSettings[arrInstances[b].uiSource].iPriority;
+		if (iPriorityA != iPriorityB)
+			return iPriorityA > iPriorityB;
+		return vLoudness[a] > vLoudness[b];
+	});
+
+	// Choose the real voices. The rest of the instances are virtual
+	bool arrReal[MAX_INSTANCES] = { false };
+	vSourceVoices.assign(vSourceSettings.size(), 0);
+	unsigned int uiNumChosen = 0;
+	for (unsigned int i = 0; (i < vRanking.size()) && (uiNumChosen < MAX_REAL_VOICES); i++)
+	{
+		const unsigned int uiSource = arrInstances[vRanking[i]].uiSource;
+		if (vSourceVoices[uiSource] >= vSourceSettings[uiSource].uiMaxVoices)
+			continue;
+
+		vSourceVoices[uiSource]++;
+		arrReal[vRanking[i]] = true;
+		uiNumChosen++;
+	}
+
+	// Stop the voices which are not chosen anymore first, so that the audio backend has free voices for the new ones
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		if ((arrInstances[i].bInUse) && (arrReal[i] == false))
+			StopVoice(arrInstances[i]);
+	}
+
+	// Update the real voices, and play the chosen virtual instances from their time
+	uiNumRealVoices = 0;
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		if (arrReal[i] == false)
+			continue;
+
+		Instance& instance = arrInstances[i];
+		if (instance.uiVoice != CAudioBackend::INVALID_VOICE)
+		{
+			cAudioBackend->SetVoice(instance.uiVoice, instance.vec3Position, instance.fVolume);
+		}
+		else
+		{
+			instance.uiVoice = cAudioBackend->PlayVoice(instance.uiSource,
+				instance.b3D,
+				instance.vec3Position,
+				instance.fVolume,
+				instance.bLooped,
+				(float)instance.dTime);
+		}
+
+		if (instance.uiVoice != CAudioBackend::INVALID_VOICE)
+			uiNumRealVoices++;
+	}
+}
+
+/**
+ @brief Get the number of instances which are mixed
+ */
+unsigned int CVoiceManager::GetNumRealVoices(void) const
+{
+	return uiNumRealVoices;
+}
+
+/**
+ @brief Get the number of instances which are playing, whether they are mixed or not
+ */
+unsigned int CVoiceManager::GetNumPlaying(void) const
+{
+	unsigned int uiNumPlaying = 0;
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		if ((arrInstances[i].bInUse) && (arrInstances[i].bPlaying))
+			uiNumPlaying++;
+	}
+	return uiNumPlaying;
+}
+
+/**
+ @brief Get the settings of a sound source, adding the default settings if it has none.
+		By default, a sound has the lowest priority, may use every real voice, and is mixed at any distance
+ @param uiSource The handle of the sound source
+ */
+CVoiceManager::SourceSettings& CVoiceManager::GetSourceSettings(const unsigned int uiSource)
+{
+	if (uiSource >= vSourceSettings.size())
+	{
+		SourceSettings settings;
+		settings.iPriority = 0;
+		settings.uiMaxVoices = MAX_REAL_VOICES;
+		settings.fMaxDistance = 0.0f;
+		settings.fLength = -1.0f;
+		vSourceSettings.resize(uiSource + 1, settings);
+	}
+	return vSourceSettings[uiSource];
+}
+
+/**
+ @brief Get an instance which was created by the game thread
+ @param uiInstance The handle of the instance
+ @return The instance, or NULL if the handle is not known
+ */
+CVoiceManager::Instance* CVoiceManager::FindInstance(const unsigned int uiInstance)
+{
+	std::unordered_map<unsigned int, unsigned int>::iterator it = mapInstances.find(uiInstance);
+	if (it == mapInstances.end())
+		return NULL;
+	return &arrInstances[it->second];
+}
+
+/**
+ @brief Find a free instance. If there is none, the least important instance of PlaySource is taken,
+		if its sound has a lower priority
+ @param iPriority The priority of the sound which needs the instance
+ @return The instance, or NULL if every instance is in use by a more important sound
+ */
+CVoiceManager::Instance* CVoiceManager::AllocateInstance(const int iPriority)
+{
+	Instance* pLeastImportant = NULL;
+	int iLeastPriority = iPriority;
+	for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+	{
+		Instance& instance = arrInstances[i];
+		if (instance.bInUse == false)
+		{
+			instance.bInUse = true;
+			instance.uiVoice = CAudioBackend::INVALID_VOICE;
+			return &instance;
+		}
+
+		if (instance.uiHandle == INVALID_INSTANCE)
+		{
+			const int iInstancePriority = GetSourceSettings(instance.uiSource).iPriority;
+			if (iInstancePriority < iLeastPriority)
+			{
+				pLeastImportant = &instance;
+				iLeastPriority = iInstancePriority;
+			}
+		}
+	}
+
+	if (pLeastImportant)
+	{
+		StopVoice(*pLeastImportant);
+		pLeastImportant->bPlaying = false;
+	}
+	return pLeastImportant;
+}
+
+/**
+ @brief Stop the voice of an instance, if it is mixed. The instance keeps its time
+ @param instance The instance
+ */
+void CVoiceManager::StopVoice(Instance& instance)
+{
+	if (instance.uiVoice == CAudioBackend::INVALID_VOICE)
+		return;
+
+	cAudioBackend->StopVoice(instance.uiVoice);
+	instance.uiVoice = CAudioBackend::INVALID_VOICE;
+}
+
+/**
+ @brief Stop an instance. It is removed if it was played by PlaySource
+ @param instance The instance
+ */
+void CVoiceManager::EndInstance(Instance& instance)
+{
+	StopVoice(instance);
+	instance.bPlaying = false;
+	if (instance.uiHandle == INVALID_INSTANCE)
+		instance.bInUse = false;
+}
+
+/**
+ @brief Get how loud an instance is at the listener, with the same inverse distance attenuation as the audio backends
+ @param instance The instance
+ @return The loudness, or less than 0 if the instance is too far from the listener to be mixed
+ */
+float CVoiceManager::GetLoudness(const Instance& instance)
+{
+	if (instance.b3D == false)
+		return instance.fVolume;
+
+	const float fDistance = glm::length(instance.vec3Position - vec3ListenerPos);
+	const SourceSettings& settings = GetSourceSettings(instance.uiSource);
+	if ((settings.fMaxDistance > 0.0f) && (fDistance > settings.fMaxDistance))
+		return -1.0f;
+
+	if (fDistance > MIN_DISTANCE)
+		return instance.fVolume * MIN_DISTANCE / fDistance;
+	return instance.fVolume;
+}
@@ -0,0 +1,143 @@
+/**
+ CVoiceManager
+ @brief A class which decides which sound instances are mixed. Every sound which is played is an instance in
+		a fixed pool. Each tick, the instances which can be heard are ranked by the priority of their sound and
+		by how loud they are at the listener. Only the first MAX_REAL_VOICES of them, and at most the number of
+		voices of each sound, are played by the audio backend. The other instances are virtual: they keep their
+		time, but are not mixed, and they are played again from that time when they become important enough.
+		So the cost of mixing does not grow with the number of enemies. It is only used on the audio thread.
+ */
+#pragma once
+
+// Include CAudioBackend, which plays the real voices
+#include "AudioBackend.h"
+
+#include <unordered_map>
+#include <vector>
+
+class CVoiceManager
+{
+public:
+	// The number of instances which can be playing, whether they are mixed or not. An instance which is not mixed
+	// only costs a few bytes and a distance check per tick
+	static const unsigned int MAX_INSTANCES = 1024;
+	// The number of instances which are mixed at the same time
+	static const unsigned int MAX_REAL_VOICES = 16;
+	// The number of instances which the game thread can create. The rest are kept for the sounds of PlaySource
+	static const unsigned int MAX_CREATED_INSTANCES = MAX_INSTANCES - 64;
+	// The handle of an instance which was not created by the game, e.g. one played by CSoundController::PlaySoundByID
+	static const unsigned int INVALID_INSTANCE = 0;
+
+	// Constructor
+	CVoiceManager(void);
+
+	// Destructor
+	virtual ~CVoiceManager(void);
+
+	// Set the audio backend which plays the real voices
+	void Init(CAudioBackend* cAudioBackend);
+
+	// Set the priority of a sound source, the number of its instances which are mixed at the same time,
+	// and the distance from the listener beyond which its 3D instances are not mixed
+	void SetSourceSettings(const unsigned int uiSource, const int iPriority, const unsigned int uiMaxVoices, const float fMaxDistance);
+
+	// Play a sound source, unless it was played by this method and is still playing
+	void PlaySource(const unsigned int uiSource, const bool b3D, const glm::vec3& vec3Position, const bool bLooped);
+	// Stop all the instances of a sound source
+	void StopSource(const unsigned int uiSource);
+	// Remove all the instances and the settings of a sound source, before it is released
+	void ReleaseSource(const unsigned int uiSource);
+	// Check if an instance of a sound source is playing, whether it is mixed or not
+	bool IsSourcePlaying(const unsigned int uiSource) const;
+
+	// Create a 3D instance of a sound source, with a handle chosen by the game thread
+	void CreateInstance(const unsigned int uiInstance, const unsigned int uiSource, const bool bLooped);
+	// Play an instance at a position, unless it is playing already. Its position and volume are updated either way
+	void PlayInstance(const unsigned int uiInstance, const glm::vec3& vec3Position, const float fVolume);
+	// Stop an instance, and remove it
+	void DestroyInstance(const unsigned int uiInstance);
+
+	// Set the position of the listener
+	void SetListener(const glm::vec3& vec3Position);
+
+	// Advance the instances by the duration of a tick, and choose which of them are mixed
+	void Update(const double dElapsedTime);
+
+	// Get the number of instances which are mixed
+	unsigned int GetNumRealVoices(void) const;
+	// Get the number of instances which are playing, whether they are mixed or not
+	unsigned int GetNumPlaying(void) const;
+
+protected:
+	// The settings of a sound source
+	struct SourceSettings
+	{
+		// The instances of sounds with a higher priority are mixed first
+		int iPriority;
+		// The number of instances of the sound which are mixed at the same time
+		unsigned int uiMaxVoices;
+		// The distance from the listener beyond which 3D instances are not mixed. 0 for any distance
+		float fMaxDistance;
+		// The duration of the sound in seconds, or less than 0 if it was not asked from the audio backend yet
+		float fLength;
+	};
+
+	// A sound instance
+	struct Instance
+	{
+		// false if the instance is free
+		bool bInUse;
+		// The handle which the game thread chose, or INVALID_INSTANCE if the instance is removed when it ends
+		unsigned int uiHandle;
+		// The handle of the sound source
+		unsigned int uiSource;
+		// true if the instance is played at its position
+		bool b3D;
+		glm::vec3 vec3Position;
+		// The volume of the instance, which is multiplied by the volume of its sound source
+		float fVolume;
+		// true if the instance starts again at its end
+		bool bLooped;
+		// true if the instance is playing, whether it is mixed or not
+		bool bPlaying;
+		// The time since the instance was started, in seconds
+		double dTime;
+		// The voice in the audio backend, or INVALID_VOICE if the instance is virtual
+		unsigned int uiVoice;
+	};
+
+	// The audio backend which plays the real voices
+	CAudioBackend* cAudioBackend;
+
+	// The instances
+	Instance arrInstances[MAX_INSTANCES];
+	// The indices of the instances which were created by the game thread, by their handles
+	std::unordered_map<unsigned int, unsigned int> mapInstances;
+	// The settings of the sound sources, by their handles
+	std::vector<SourceSettings> vSourceSettings;
+
+	// The position of the listener
+	glm::vec3 vec3ListenerPos;
+
+	// The number of instances which are mixed
+	unsigned int uiNumRealVoices;
+
+	// The instances which can be heard, ordered by how important they are, and how loud each instance is. Used by Update
+	std::vector<unsigned int> vRanking;
+	std::vector<float> vLoudness;
+	// The number of real voices of each sound source. Used by Update
+	std::vector<unsigned int> vSourceVoices;
+
+	// Get the settings of a sound source, adding the default settings if it has none
+	SourceSettings& GetSourceSettings(const unsigned int uiSource);
+	// Get an instance which was created by the game thread. NULL if the handle is not known
+	Instance* FindInstance(const unsigned int uiInstance);
+	// Find a free instance. If there is none, the least important instance of PlaySource is taken, if it is less important
+	Instance* AllocateInstance(const int iPriority);
+	// Stop the voice of an instance, if it is mixed
+	void StopVoice(Instance& instance);
+	// Stop an instance. It is removed if it was played by PlaySource
+	void EndInstance(Instance& instance);
+	// Get how loud an instance is at the listener. It is less than 0 if the instance cannot be heard
+	float GetLoudness(const Instance& instance);
+};
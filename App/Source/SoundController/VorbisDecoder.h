@@ -0,0 +1,159 @@
+/**
+ CVorbisDecoder
+ @brief A decoder of Ogg Vorbis files, for the software mixer. It wraps stb_vorbis, whose single file goes in
+		SOIL/includes/stb_vorbis.c next to stb_image.h, and is compiled as its own translation unit.
+		The file is read a page at a time while it is decoded, so a long music track can be streamed.
+		If stb_vorbis.c is not in the tree, the decoder is still built, but it opens no files
+ */
+#pragma once
+
+#include <iostream>
+#include <string>
+
+#if defined(__has_include)
+	#if __has_include(<includes/stb_vorbis.c>)
+		#define VORBIS_DECODER_ENABLED
+	#endif
+#endif
+
+#ifdef VORBIS_DECODER_ENABLED
+	// Only the declarations of stb_vorbis; its implementation is compiled from stb_vorbis.c
+	#define STB_VORBIS_HEADER_ONLY
+	#include <includes/stb_vorbis.c>
+	#undef STB_VORBIS_HEADER_ONLY
+#endif
+
+class CVorbisDecoder
+{
+public:
+	// Constructor
+	CVorbisDecoder(void)
+		: pVorbis(NULL)
+		, uiNumChannels(0)
+		, uiSampleRate(0)
+		, uiNumFrames(0)
+		, uiMemorySize(0)
+	{
+	}
+
+	// Destructor
+	virtual ~CVorbisDecoder(void)
+	{
+		Close();
+	}
+
+	// Open a file, and read the headers of its stream. It returns false if the file could not be read,
+	// or it is not a Vorbis file
+	bool Open(const std::string& sFilePath)
+	{
+		Close();
+
+#ifdef VORBIS_DECODER_ENABLED
+		int iError = 0;
+		pVorbis = stb_vorbis_open_filename(sFilePath.c_str(), &iError, NULL);
+		if (pVorbis == NULL)
+		{
+			std::cout << "CVorbisDecoder::Open - " << sFilePath << " is not a Vorbis file which can be decoded (error "
+				<< iError << ")" << std::endl;
+			return false;
+		}
+
+		const stb_vorbis_info info = stb_vorbis_get_info(pVorbis);
+		uiNumChannels = (unsigned int)info.channels;
+		uiSampleRate = info.sample_rate;
+		uiNumFrames = stb_vorbis_stream_length_in_samples(pVorbis);
+		uiMemorySize = (size_t)info.setup_memory_required + info.temp_memory_required;
+		if ((uiNumChannels == 0) || (uiSampleRate == 0) || (uiNumFrames == 0))
+		{
+			std::cout << "CVorbisDecoder::Open - " << sFilePath << " has no audio which can be read" << std::endl;
+			Close();
+			return false;
+		}
+		return true;
+#else
+		std::cout << "CVorbisDecoder::Open - " << sFilePath << " cannot be decoded, as SOIL/includes/stb_vorbis.c"
+			<< " is not in the tree" << std::endl;
+		return false;
+#endif
+	}
+
+	// Close the file
+	void Close(void)
+	{
+#ifdef VORBIS_DECODER_ENABLED
+		if (pVorbis)
+			stb_vorbis_close(pVorbis);
+#endif
+		pVorbis = NULL;
+		uiNumChannels = 0;
+		uiSampleRate = 0;
+		uiNumFrames = 0;
+		uiMemorySize = 0;
+	}
+
+	// Get the number of channels of the stream
+	unsigned int GetNumChannels(void) const
+	{
+		return uiNumChannels;
+	}
+
+	// Get the sample rate of the stream
+	unsigned int GetSampleRate(void) const
+	{
+		return uiSampleRate;
+	}
+
+	// Get the number of frames of the stream
+	unsigned int GetNumFrames(void) const
+	{
+		return uiNumFrames;
+	}
+
+	// Decode the next frames into interleaved samples, with the channels of the stream.
+	// It returns the number of frames which were decoded, which is less than uiMaxFrames at the end of the stream
+	unsigned int Read(float* pSamples, const unsigned int uiMaxFrames)
+	{
+#ifdef VORBIS_DECODER_ENABLED
+		if (pVorbis == NULL)
+			return 0;
+		return (unsigned int)stb_vorbis_get_samples_float_interleaved(pVorbis, (int)uiNumChannels, pSamples,
+																	  (int)(uiMaxFrames * uiNumChannels));
+#else
+		(void)pSamples;
+		(void)uiMaxFrames;
+		return 0;
+#endif
+	}
+
+	// Go to a frame of the stream, so that the next Read starts from it
+	bool Seek(const unsigned int uiFrame)
+	{
+#ifdef VORBIS_DECODER_ENABLED
+		if (pVorbis == NULL)
+			return false;
+		if (uiFrame == 0)
+			return stb_vorbis_seek_start(pVorbis) != 0;
+		return stb_vorbis_seek(pVorbis, uiFrame) != 0;
+#else
+		(void)uiFrame;
+		return false;
+#endif
+	}
+
+	// Get the number of bytes which the decoder keeps in memory
+	size_t GetMemorySize(void) const
+	{
+		return uiMemorySize;
+	}
+
+protected:
+	// The stream of stb_vorbis, or NULL if no file is open
+	struct stb_vorbis* pVorbis;
+
+	// The format of the stream
+	unsigned int uiNumChannels;
+	unsigned int uiSampleRate;
+	unsigned int uiNumFrames;
+	// The memory which stb_vorbis allocated for the setup and the decoding of the stream
+	size_t uiMemorySize;
+};
@@ -6,12 +6,81 @@
  */
 #include "Application.h"
 
+// Include CSettings to pass the command line options to the Application
+#include "GameControl\Settings.h"
+
+#include <string.h>
+#include <stdlib.h>
+
 /**
  @brief This function is the main function which is called by the operating system when you run the executables
+ @param argc The number of command line arguments
+ @param argv The command line arguments. Use "-headless <ticks>" to run the simulation without rendering,
+			 "-uncapped" to not limit the frame rate, "-profile <file>" to write a Chrome trace on exit,
+			 "-allocbudget <number>" to warn about frames with more heap allocations (needs ENABLE_MEMORY_TRACKER),
+			 "-seed <number>" to seed the random number generator, "-record <file>" to record the input,
+			 "-replay <file>" to replay a recorded input, "-timings <file>" to write the frame timings of a replay,
+			 "-audio <irrklang|software>" to choose the audio backend, "-audiowav <file>" to write the
+			 output of the software mixer to a WAV file, "-audiobudget <KB>" to limit the decoded audio in memory
+			 and "-earlyinput" to poll the input right after the buffers are swapped
  @return This function returns the error codes
  */
-int main(void)
+int main(int argc, char* argv[])
 {
+	// Parse the command line options
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "-headless") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->bHeadless = true;
+			CSettings::GetInstance()->iHeadlessTicks = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-uncapped") == 0)
+		{
+			CSettings::GetInstance()->bLimitFrameRate = false;
+		}
+		else if ((strcmp(argv[i], "-profile") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->sProfileTraceFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "-allocbudget") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->iFrameAllocBudget = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "-seed") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->iRandomSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+		}
+		else if ((strcmp(argv[i], "-record") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->sRecordInputFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "-replay") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->sReplayInputFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "-timings") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->sReplayTimingsFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "-audio") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->sAudioBackend = argv[++i];
+		}
+		else if ((strcmp(argv[i], "-audiowav") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->sAudioOutputFile = argv[++i];
+		}
+		else if ((strcmp(argv[i], "-audiobudget") == 0) && (i + 1 < argc))
+		{
+			CSettings::GetInstance()->iAudioMemoryBudget = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-earlyinput") == 0)
+		{
+			CSettings::GetInstance()->bLateInputPolling = false;
+		}
+	}
+
 	Application* pApp = Application::GetInstance();
 	// if the application is initialised properly, then run it
 	if (pApp->Init() == true)
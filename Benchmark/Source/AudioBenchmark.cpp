@@ -0,0 +1,288 @@
+/**
+ AudioBenchmark.cpp
+ @brief This file contains the main function of the benchmarks for the audio. They run the sounds in
+		App/Sounds through the software mixer, so they need no sound device, and print the time,
+		allocations and throughput per operation as JSON lines (default) or CSV.
+		The session benchmark plays a minute of the game through CSoundController, CVoiceManager and
+		CAudioBackendSoftware in headless mode, and writes it to a WAV file, which is checked at the end.
+
+		Options:
+			--sounds <dir>		The directory with the sounds (default: App/Sounds of this source tree)
+			--output <file>		The WAV file of the session (default: AudioSession.wav in the temp directory)
+			--seconds <secs>	The length of the session (default: 60)
+			--filter <text>		Only run the benchmarks whose names contain this text
+			--min-time <secs>	The minimum time to run each benchmark for (default: 0.25)
+			--format json|csv	The output format
+ */
+#include "BenchmarkRunner.h"
+
+#include "AudioBackendSoftware.h"
+#include "AudioSink.h"
+#include "SoundController.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+#ifndef AUDIO_SOUNDS_DIR
+	#define AUDIO_SOUNDS_DIR "App/Sounds"
+#endif
+
+// The tick rate of the session, as in the game
+static const unsigned int TICKS_PER_SECOND = 60;
+// The number of enemies whose laughs are played in the session
+static const unsigned int NUM_ENEMIES = 6;
+
+/**
+ @brief Load and release the sounds, which decodes them all
+ */
+static void RunLoadBenchmarks(CBenchmarkRunner& cRunner, const std::string& sSoundsDir)
+{
+	const char* apSounds[] = { "BatteryPickup.ogg", "Paperpickup.wav", "CreepyLaugh.wav", "WinBGM.wav" };
+	for (const char* pSound : apSounds)
+	{
+		const std::string sFilePath = sSoundsDir + "/" + pSound;
+
+		// The sink is not opened, as nothing is mixed
+		CAudioBackendSoftware cAudioBackend(new CAudioSinkNull(), false);
+		const unsigned int uiSource = cAudioBackend.LoadSource(sFilePath, true, false);
+		if (uiSource == CAudioBackend::INVALID_SOURCE)
+		{
+			cerr << "Unable to load " << sFilePath << endl;
+			continue;
+		}
+		const double dNumFrames = cAudioBackend.GetSourceLength(uiSource) * CAudioBackendSoftware::SAMPLE_RATE;
+		cAudioBackend.ReleaseSource(uiSource);
+
+		cRunner.Run(std::string("CAudioBackendSoftware::LoadSource/") + pSound, [&](const unsigned long long ullIterations)
+		{
+			for (unsigned long long i = 0; i < ullIterations; i++)
+			{
+				const unsigned int uiLoaded = cAudioBackend.LoadSource(sFilePath, true, false);
+				DoNotOptimise(uiLoaded);
+				cAudioBackend.ReleaseSource(uiLoaded);
+			}
+		}, dNumFrames, "frames");
+	}
+}
+
+/**
+ @brief Mix a number of looped voices, without the cost of a sink
+ */
+static void RunMixBenchmarks(CBenchmarkRunner& cRunner, const std::string& sSoundsDir)
+{
+	const char* apSounds[] = { "Step.wav", "Paperpickup.wav", "CreepyLaugh.wav", "BatteryPickup.ogg" };
+	const unsigned int auiNumVoices[] = { 4, CAudioBackendSoftware::MAX_VOICES };
+	for (unsigned int uiNumVoices : auiNumVoices)
+	{
+		std::ostringstream name;
+		name << "CAudioBackendSoftware::Render/" << uiNumVoices << "voices";
+		if (cRunner.IsSelected(name.str()) == false)
+			continue;
+
+		CAudioBackendSoftware cAudioBackend(new CAudioSinkNull(), false);
+		if (cAudioBackend.Init() == false)
+			return;
+		std::vector<unsigned int> vSources;
+		for (const char* pSound : apSounds)
+		{
+			const unsigned int uiSource = cAudioBackend.LoadSource(sSoundsDir + "/" + pSound, true, false);
+			if (uiSource != CAudioBackend::INVALID_SOURCE)
+				vSources.push_back(uiSource);
+		}
+		if (vSources.empty())
+			return;
+
+		// Half of the voices are 3D, around the listener
+		for (unsigned int i = 0; i < uiNumVoices; i++)
+		{
+			const glm::vec3 vec3Position((float)(i % 8) - 4.0f, (float)(i / 8), 0.0f);
+			cAudioBackend.PlayVoice(vSources[i % vSources.size()], (i % 2) == 1, vec3Position, 0.5f, true, 0.0f);
+		}
+
+		cRunner.Run(name.str(), [&](const unsigned long long ullIterations)
+		{
+			for (unsigned long long i = 0; i < ullIterations; i++)
+				cAudioBackend.Render(CAudioBackendSoftware::BLOCK_FRAMES);
+			DoNotOptimise(cAudioBackend.GetNumFramesMixed());
+		}, CAudioBackendSoftware::BLOCK_FRAMES, "frames");
+	}
+}
+
+/**
+ @brief Play a session of the game through CSoundController, and write it to a WAV file.
+		The sounds are loaded as CScene2D loads them, the music is streamed, the player's sounds are played
+		every few ticks, and the laughs of the enemies move around the listener, so that the voice manager
+		has more of them than it mixes
+ @return false if CSoundController could not be initialised
+ */
+static bool RenderSession(const std::string& sSoundsDir, const std::string& sOutputFile, const unsigned int uiNumTicks)
+{
+	CSoundController* cSoundController = CSoundController::GetInstance();
+	cSoundController->SetAudioStreamThreshold(1024);
+	if (cSoundController->Init(new CAudioBackendSoftware(new CAudioSinkWaveFile(sOutputFile), false)) == false)
+	{
+		CSoundController::Destroy();
+		return false;
+	}
+
+	cSoundController->LoadSound(sSoundsDir + "/GameBGM2.ogg", SOUND_GAME_BGM, true, true);
+	cSoundController->LoadSound(sSoundsDir + "/Step.wav", SOUND_STEP, true);
+	cSoundController->LoadSound(sSoundsDir + "/Paperpickup.wav", SOUND_PAPER_PICKUP, true);
+	cSoundController->LoadSound(sSoundsDir + "/EnemyStun.wav", SOUND_ENEMY_STUN, true);
+	cSoundController->LoadSound(sSoundsDir + "/CreepyLaugh.wav", SOUND_CREEPY_LAUGH, true, false, CSoundInfo::SOUNDTYPE::_3D, glm::vec3(0, 0, 0));
+	cSoundController->LoadSound(sSoundsDir + "/BatteryPickup.ogg", SOUND_BATTERY_PICKUP, true);
+	cSoundController->SetSoundPriority(SOUND_GAME_BGM, 3, 1);
+	cSoundController->SetSoundPriority(SOUND_STEP, 2, 1);
+	cSoundController->SetSoundPriority(SOUND_PAPER_PICKUP, 2, 1);
+	cSoundController->SetSoundPriority(SOUND_BATTERY_PICKUP, 2, 1);
+	cSoundController->SetSoundPriority(SOUND_ENEMY_STUN, 1, 1);
+	cSoundController->SetSoundPriority(SOUND_CREEPY_LAUGH, 0, 4, 12.0f);
+
+	std::vector<unsigned int> vLaughs;
+	for (unsigned int i = 0; i < NUM_ENEMIES; i++)
+		vLaughs.push_back(cSoundController->CreateSoundInstance(SOUND_CREEPY_LAUGH));
+
+	cSoundController->PlaySoundByID(SOUND_GAME_BGM);
+	const double dTickTime = 1.0 / TICKS_PER_SECOND;
+	for (unsigned int uiTick = 0; uiTick < uiNumTicks; uiTick++)
+	{
+		// The player walks to and fro along a corridor
+		const float fPlayerX = (float)((uiTick / 4) % 40);
+		cSoundController->SetListenerPosition(fPlayerX, 5.0f, 0.0f);
+		if (uiTick % 20 == 0)
+			cSoundController->PlaySoundByID(SOUND_STEP);
+		if (uiTick % 150 == 75)
+			cSoundController->PlaySoundByID(SOUND_PAPER_PICKUP);
+		if (uiTick % 210 == 105)
+			cSoundController->PlaySoundByID(SOUND_BATTERY_PICKUP);
+		if (uiTick % 300 == 200)
+			cSoundController->PlaySoundByID(SOUND_ENEMY_STUN);
+
+		// The enemies are spread along the corridor, and drift up and down
+		for (unsigned int i = 0; i < NUM_ENEMIES; i++)
+		{
+			const float fEnemyX = (float)(i * 8);
+			const float fEnemyY = (float)((uiTick / 10 + i * 7) % 16);
+			cSoundController->PlaySoundInstance(vLaughs[i], fEnemyX, fEnemyY, 0.0f, 1.0f);
+		}
+
+		cSoundController->Update(dTickTime);
+	}
+
+	// The audio thread applies the last ticks before it stops, and the sink completes the WAV file
+	CSoundController::Destroy();
+	return true;
+}
+
+/**
+ @brief Check that a WAV file of the session has all of its frames, and that they are not silent
+ @return true if the file is complete and has sound in it
+ */
+static bool CheckSession(const std::string& sOutputFile, const unsigned int uiNumTicks)
+{
+	std::ifstream file(sOutputFile, ios::binary);
+	std::vector<unsigned char> vBytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	const size_t uiHeaderSize = 44;
+	if ((vBytes.size() < uiHeaderSize) || (memcmp(&vBytes[0], "RIFF", 4) != 0))
+	{
+		cerr << sOutputFile << " is not a WAV file" << endl;
+		return false;
+	}
+
+	const unsigned int uiBytesPerFrame = CAudioBackendSoftware::NUM_CHANNELS * sizeof(short);
+	const unsigned long long ullNumFrames = (vBytes.size() - uiHeaderSize) / uiBytesPerFrame;
+	const unsigned long long ullExpectedFrames = (unsigned long long)uiNumTicks * CAudioBackendSoftware::SAMPLE_RATE / TICKS_PER_SECOND;
+	int iPeak = 0;
+	for (size_t i = uiHeaderSize; i + 1 < vBytes.size(); i += 2)
+	{
+		const int iSample = abs((int)(short)(vBytes[i] | (vBytes[i + 1] << 8)));
+		if (iSample > iPeak)
+			iPeak = iSample;
+	}
+
+	cerr << "Wrote " << ullNumFrames << " frames to " << sOutputFile << ", with a peak of " << iPeak << endl;
+	// Each tick mixes the whole frames of its duration, and carries the part of a frame over
+	if ((ullNumFrames + 1 < ullExpectedFrames) || (ullNumFrames > ullExpectedFrames))
+	{
+		cerr << "The session should have " << ullExpectedFrames << " frames" << endl;
+		return false;
+	}
+	if (iPeak == 0)
+	{
+		cerr << "The session is silent" << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ @brief The main function of the audio benchmarks
+ @param argc The number of command line arguments
+ @param argv The command line arguments
+ @return 0 if the benchmarks ran, and the session was written, otherwise 1
+ */
+int main(int argc, char* argv[])
+{
+	CBenchmarkRunner cRunner;
+	std::string sSoundsDir = AUDIO_SOUNDS_DIR;
+	std::string sOutputFile = (std::filesystem::temp_directory_path() / "AudioSession.wav").string();
+	unsigned int uiNumSeconds = 60;
+
+	// Parse the command line options
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--sounds") == 0) && (i + 1 < argc))
+			sSoundsDir = argv[++i];
+		else if ((strcmp(argv[i], "--output") == 0) && (i + 1 < argc))
+			sOutputFile = argv[++i];
+		else if ((strcmp(argv[i], "--seconds") == 0) && (i + 1 < argc))
+			uiNumSeconds = (unsigned int)strtoul(argv[++i], NULL, 10);
+		else if ((strcmp(argv[i], "--filter") == 0) && (i + 1 < argc))
+			cRunner.SetFilter(argv[++i]);
+		else if ((strcmp(argv[i], "--min-time") == 0) && (i + 1 < argc))
+			cRunner.SetMinTime(atof(argv[++i]));
+		else if ((strcmp(argv[i], "--format") == 0) && (i + 1 < argc))
+		{
+			i++;
+			cRunner.SetFormat(strcmp(argv[i], "csv") == 0 ? CBenchmarkRunner::FORMAT_CSV : CBenchmarkRunner::FORMAT_JSON);
+		}
+		else
+		{
+			cerr << "Unknown option: " << argv[i] << endl;
+			return 1;
+		}
+	}
+
+	RunLoadBenchmarks(cRunner, sSoundsDir);
+	RunMixBenchmarks(cRunner, sSoundsDir);
+
+	// Each operation is a whole session, so the WAV file has the last one
+	const unsigned int uiNumTicks = uiNumSeconds * TICKS_PER_SECOND;
+	std::ostringstream name;
+	name << "CSoundController::Session/" << uiNumSeconds << "s";
+	bool bSessionRun = false;
+	bool bSessionFailed = false;
+	cRunner.Run(name.str(), [&](const unsigned long long ullIterations)
+	{
+		for (unsigned long long i = 0; i < ullIterations; i++)
+			bSessionFailed = bSessionFailed || (RenderSession(sSoundsDir, sOutputFile, uiNumTicks) == false);
+		bSessionRun = true;
+	}, uiNumTicks, "ticks");
+
+	if (cRunner.GetNumRun() == 0)
+	{
+		cerr << "No benchmarks were run" << endl;
+		return 1;
+	}
+	if ((bSessionRun) && ((bSessionFailed) || (CheckSession(sOutputFile, uiNumTicks) == false)))
+		return 1;
+	return 0;
+}
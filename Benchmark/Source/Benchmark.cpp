@@ -0,0 +1,721 @@
+/**
+ Benchmark.cpp
+ @brief This file contains the main function of the microbenchmarks for the map loading, path finding,
+		ray casting and broadphase hot paths. It runs them on the real levels in App/Maps and on generated mazes,
+		and prints the time, allocations and throughput per operation as JSON lines (default) or CSV.
+
+		Options:
+			--maps <dir>		The directory with the levels (default: App/Maps of this source tree)
+			--filter <text>		Only run the benchmarks whose names contain this text
+			--min-time <secs>	The minimum time to run each benchmark for (default: 0.25)
+			--format json|csv	The output format
+			--seed <number>		The seed for the generated mazes and queries (default: 1)
+			--no-synthetic		Do not run the benchmarks on generated mazes
+ */
+#include "BenchmarkRunner.h"
+#include "MazeGenerator.h"
+
+#include "MapGrid.h"
+#include "Primitives/Broadphase.h"
+#include "Primitives/CollisionManager.h"
+#include "System/Random.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+#ifndef MAZE_MAPS_DIR
+	#define MAZE_MAPS_DIR "App/Maps"
+#endif
+
+// The number of start and target pairs in one operation of the path finding benchmarks.
+// Every operation runs all of them, so that runs with different iteration counts measure the same work
+static const unsigned int NUM_PATH_QUERIES = 64;
+// The number of rays in one operation of CheckIntersect, and which the collision benchmarks cycle through
+static const unsigned int NUM_RAYS = 256;
+
+// A level to run the map benchmarks on
+struct MapCase
+{
+	std::string sName;
+	std::string sFilePath;
+	unsigned int uiNumRows;
+	unsigned int uiNumCols;
+};
+
+/**
+ @brief Get the number of rows and columns of a level, in the same way as CMapGrid::LoadCSV reads it
+ @return true if the file could be read
+ */
+static bool GetMapSize(const std::string& sFilePath, unsigned int& uiNumRows, unsigned int& uiNumCols)
+{
+	try
+	{
+		rapidcsv::Document doc(sFilePath);
+		uiNumRows = (unsigned int)doc.GetRowCount();
+		uiNumCols = (unsigned int)doc.GetColumnCount();
+	}
+	catch (const std::exception& e)
+	{
+		cerr << "Unable to read " << sFilePath << ": " << e.what() << endl;
+		return false;
+	}
+	return (uiNumRows > 0) && (uiNumCols > 0);
+}
+
+/**
+ @brief Get the positions of all the tiles which are not blocked, as (column, row) like the enemies use
+ */
+static std::vector<glm::vec2> GetWalkableTiles(const CMapGrid& cMapGrid)
+{
+	std::vector<glm::vec2> vWalkable;
+	for (unsigned int uiRow = 0; uiRow < cMapGrid.GetNumRows(); uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < cMapGrid.GetNumCols(); uiCol++)
+		{
+			const int iValue = cMapGrid.GetMapInfo(uiRow, uiCol);
+			if ((iValue < 100) || (iValue >= 200))
+				vWalkable.push_back(glm::vec2((float)uiCol, (float)uiRow));
+		}
+	}
+	return vWalkable;
+}
+
+/**
+ @brief Run the benchmarks on one level
+ */
+static void RunMapBenchmarks(CBenchmarkRunner& cRunner, const MapCase& mapCase, const unsigned int uiSeed)
+{
+	const double dNumTiles = (double)mapCase.uiNumRows * mapCase.uiNumCols;
+
+	// CMapGrid keeps a rapidcsv::Document, so create it on the heap
+	std::unique_ptr<CMapGrid> cMapGrid(new CMapGrid());
+	cMapGrid->InitGrid(1, mapCase.uiNumRows, mapCase.uiNumCols);
+	cMapGrid->SetTileSize(2.0f / mapCase.uiNumCols, 2.0f / mapCase.uiNumRows);
+	if (cMapGrid->LoadCSV(mapCase.sFilePath, 0) == false)
+	{
+		cerr << "Unable to load " << mapCase.sFilePath << endl;
+		return;
+	}
+
+	// CMap2D::LoadMap
+	cRunner.Run("LoadMap/" + mapCase.sName, [&](const unsigned long long ullIterations)
+	{
+		for (unsigned long long i = 0; i < ullIterations; i++)
+			DoNotOptimise(cMapGrid->LoadCSV(mapCase.sFilePath, 0));
+	}, dNumTiles, "tiles");
+
+	// CMap2D::FindValue for the player start, and for a value which is not in the map
+	cRunner.Run("FindValue/hit/" + mapCase.sName, [&](const unsigned long long ullIterations)
+	{
+		unsigned int uiRow = 0, uiCol = 0;
+		for (unsigned long long i = 0; i < ullIterations; i++)
+			DoNotOptimise(cMapGrid->FindValue(303, uiRow, uiCol) ? uiRow + uiCol : 0);
+	}, dNumTiles, "tiles");
+	cRunner.Run("FindValue/miss/" + mapCase.sName, [&](const unsigned long long ullIterations)
+	{
+		unsigned int uiRow = 0, uiCol = 0;
+		for (unsigned long long i = 0; i < ullIterations; i++)
+			DoNotOptimise(cMapGrid->FindValue(-1, uiRow, uiCol) ? 1 : 0);
+	}, dNumTiles, "tiles");
+
+	// Pick the same start and target pairs in every run
+	const std::vector<glm::vec2> vWalkable = GetWalkableTiles(*cMapGrid);
+	if (vWalkable.size() < 2)
+		return;
+	CRandom cRandom;
+	cRandom.Seed(uiSeed);
+	std::vector<glm::vec2> vStarts, vTargets;
+	for (unsigned int i = 0; i < NUM_PATH_QUERIES; i++)
+	{
+		vStarts.push_back(vWalkable[cRandom.Range(0, (int)vWalkable.size() - 1)]);
+		vTargets.push_back(vWalkable[cRandom.Range(0, (int)vWalkable.size() - 1)]);
+	}
+
+	// CMap2D::PathFind with each number of directions, heuristic and weight
+	const unsigned int auiDirections[] = { 4, 8 };
+	const int aiWeights[] = { 1, 2, 5 };
+	struct { const char* pName; HeuristicFunction function; } heuristics[] = {
+		{ "manhattan", heuristic::manhattan },
+		{ "euclidean", heuristic::euclidean } };
+	for (unsigned int uiDirections : auiDirections)
+	{
+		for (const auto& heuristicCase : heuristics)
+		{
+			for (int iWeight : aiWeights)
+			{
+				std::ostringstream name;
+				name << "PathFind/" << uiDirections << "dir/" << heuristicCase.pName << "/w" << iWeight << "/" << mapCase.sName;
+				if (cRunner.IsSelected(name.str()) == false)
+					continue;
+
+				cMapGrid->SetDiagonalMovement(uiDirections == 8);
+				cRunner.Run(name.str(), [&](const unsigned long long ullIterations)
+				{
+					for (unsigned long long i = 0; i < ullIterations; i++)
+					{
+						for (unsigned int uiQuery = 0; uiQuery < NUM_PATH_QUERIES; uiQuery++)
+						{
+							FrameVector<glm::vec2> path = cMapGrid->PathFind(vStarts[uiQuery], vTargets[uiQuery],
+																			 heuristicCase.function, iWeight);
+							DoNotOptimise(path.size());
+						}
+						// One operation is a frame of path queries, like the game resets the arena every frame
+						CFrameArena::GetThreadArena()->Reset();
+					}
+				}, NUM_PATH_QUERIES, "paths");
+			}
+		}
+	}
+	cMapGrid->SetDiagonalMovement(false);
+
+	// CMap2D::CheckIntersect, casting the enemy's rays from walkable tiles in 8 directions
+	const float fTileWidth = 2.0f / mapCase.uiNumCols;
+	const float fTileHeight = 2.0f / mapCase.uiNumRows;
+	// The rays are about 10 tiles long, as CheckIntersect only tests the tiles within 10 tiles of the enemy
+	const float fRayLength = 10.0f * std::min(fTileWidth, fTileHeight);
+	std::vector<glm::vec2> vRayTiles;
+	std::vector<glm::vec2> vRayOrigins;
+	std::vector<glm::vec3> vRayDirections;
+	for (unsigned int i = 0; i < NUM_RAYS; i++)
+	{
+		const glm::vec2 tile = vWalkable[cRandom.Range(0, (int)vWalkable.size() - 1)];
+		const float fAngle = glm::radians(45.0f * (i % 8));
+		vRayTiles.push_back(tile);
+		vRayOrigins.push_back(glm::vec2(-1.0f + (tile.x + 0.5f) * fTileWidth, -1.0f + (tile.y + 0.5f) * fTileHeight));
+		vRayDirections.push_back(glm::vec3(cos(fAngle), sin(fAngle), 0.0f));
+	}
+	cRunner.Run("CheckIntersect/" + mapCase.sName, [&](const unsigned long long ullIterations)
+	{
+		for (unsigned long long i = 0; i < ullIterations; i++)
+		{
+			for (unsigned int uiRay = 0; uiRay < NUM_RAYS; uiRay++)
+			{
+				float fLength = fRayLength;
+				cMapGrid->CheckIntersect(vRayTiles[uiRay], vRayOrigins[uiRay], vRayDirections[uiRay], fLength);
+				DoNotOptimise((unsigned long long)(fLength * 1000.0f));
+			}
+		}
+	}, NUM_RAYS, "rays");
+}
+
+/**
+ @brief Run the benchmarks of the collision tests
+ */
+static void RunCollisionBenchmarks(CBenchmarkRunner& cRunner, const unsigned int uiSeed)
+{
+	CRandom cRandom;
+	cRandom.Seed(uiSeed);
+
+	// Random rays and boxes in the same range as the map's UV space
+	std::vector<glm::vec3> vOrigins, vDirections, vCentres, vBoxMins, vBoxMaxs;
+	std::vector<glm::mat4> vModelMatrices;
+	for (unsigned int i = 0; i < NUM_RAYS; i++)
+	{
+		const float fAngle = cRandom.Uniform() * 6.2831853f;
+		vOrigins.push_back(glm::vec3(cRandom.Uniform() * 2.0f - 1.0f, cRandom.Uniform() * 2.0f - 1.0f, 0.0f));
+		vDirections.push_back(glm::vec3(cos(fAngle), sin(fAngle), 0.0f));
+		const glm::vec3 centre(cRandom.Uniform() * 2.0f - 1.0f, cRandom.Uniform() * 2.0f - 1.0f, 0.0f);
+		vCentres.push_back(centre);
+		vBoxMins.push_back(centre - glm::vec3(0.025f, 0.045f, 1.0f));
+		vBoxMaxs.push_back(centre + glm::vec3(0.025f, 0.045f, 1.0f));
+		vModelMatrices.push_back(glm::translate(glm::mat4(1.0f), centre));
+	}
+
+	// Flashlight::TestRayOBBIntersection
+	cRunner.Run("CCollisionManager::RayOBBCollision", [&](const unsigned long long ullIterations)
+	{
+		unsigned long long ullHits = 0;
+		for (unsigned long long i = 0; i < ullIterations; i++)
+		{
+			const unsigned int uiRay = (unsigned int)(i % NUM_RAYS);
+			const unsigned int uiBox = (unsigned int)((i / NUM_RAYS + i) % NUM_RAYS);
+			float t = 0.0f;
+			if (CCollisionManager::RayOBBCollision(vOrigins[uiRay], vDirections[uiRay],
+				glm::vec3(-0.025f, -0.045f, -1.0f), glm::vec3(0.025f, 0.045f, 1.0f), vModelMatrices[uiBox], t))
+				ullHits++;
+		}
+		DoNotOptimise(ullHits);
+	}, 1.0, "tests");
+
+	cRunner.Run("CCollisionManager::SphereSphereCollision", [&](const unsigned long long ullIterations)
+	{
+		unsigned long long ullHits = 0;
+		for (unsigned long long i = 0; i < ullIterations; i++)
+		{
+			if (CCollisionManager::SphereSphereCollision(vCentres[i % NUM_RAYS], 0.05f, vOrigins[(i + 1) % NUM_RAYS], 0.05f))
+				ullHits++;
+		}
+		DoNotOptimise(ullHits);
+	}, 1.0, "tests");
+
+	cRunner.Run("CCollisionManager::BoxBoxCollision", [&](const unsigned long long ullIterations)
+	{
+		unsigned long long ullHits = 0;
+		for (unsigned long long i = 0; i < ullIterations; i++)
+		{
+			const unsigned int uiA = (unsigned int)(i % NUM_RAYS);
+			const unsigned int uiB = (unsigned int)((i + 7) % NUM_RAYS);
+			if (CCollisionManager::BoxBoxCollision(vBoxMins[uiA], vBoxMaxs[uiA], vBoxMins[uiB], vBoxMaxs[uiB]))
+				ullHits++;
+		}
+		DoNotOptimise(ullHits);
+	}, 1.0, "tests");
+
+	cRunner.Run("CCollisionManager::RaySphereCollision", [&](const unsigned long long ullIterations)
+	{
+		unsigned long long ullHits = 0;
+		for (unsigned long long i = 0; i < ullIterations; i++)
+		{
+			const unsigned int uiRay = (unsigned int)(i % NUM_RAYS);
+			float t = 0.0f;
+			if (CCollisionManager::RaySphereCollision(vCentres[(i + 3) % NUM_RAYS], 0.05f, vOrigins[uiRay], vDirections[uiRay], t))
+				ullHits++;
+		}
+		DoNotOptimise(ullHits);
+	}, 1.0, "tests");
+
+	cRunner.Run("CCollisionManager::RayBoxCollision", [&](const unsigned long long ullIterations)
+	{
+		unsigned long long ullHits = 0;
+		for (unsigned long long i = 0; i < ullIterations; i++)
+		{
+			const unsigned int uiRay = (unsigned int)(i % NUM_RAYS);
+			const unsigned int uiBox = (unsigned int)((i + 5) % NUM_RAYS);
+			float t = 0.0f;
+			if (CCollisionManager::RayBoxCollision(vBoxMins[uiBox], vBoxMaxs[uiBox], vOrigins[uiRay], vDirections[uiRay], t))
+				ullHits++;
+		}
+		DoNotOptimise(ullHits);
+	}, 1.0, "tests");
+
+	cRunner.Run("CCollisionManager::RayBoxCollision/segment", [&](const unsigned long long ullIterations)
+	{
+		unsigned long long ullHits = 0;
+		for (unsigned long long i = 0; i < ullIterations; i++)
+		{
+			const unsigned int uiRay = (unsigned int)(i % NUM_RAYS);
+			const unsigned int uiBox = (unsigned int)((i + 5) % NUM_RAYS);
+			if (CCollisionManager::RayBoxCollision(vBoxMins[uiBox], vBoxMaxs[uiBox], vOrigins[uiRay],
+				vOrigins[uiRay] + vDirections[uiRay] * 0.5f))
+				ullHits++;
+		}
+		DoNotOptimise(ullHits);
+	}, 1.0, "tests");
+}
+
+/**
+ @brief Check if 2 boxes overlap, counting the boxes which only touch, as CBroadphase does
+ */
+static bool BoxesOverlap(const glm::vec2& aMin, const glm::vec2& aMax, const glm::vec2& bMin, const glm::vec2& bMax)
+{
+	return (aMin.x <= bMax.x) && (aMax.x >= bMin.x) && (aMin.y <= bMax.y) && (aMax.y >= bMin.y);
+}
+
+/**
+ @brief Check if a line segment passes through a box in the x-y plane, for the brute force queries.
+		CCollisionManager::RayBoxCollision is not used, as it also finds the boxes behind the start of the segment
+ */
+static bool SegmentHitsBox(const glm::vec2& vec2Start, const glm::vec2& vec2End, const glm::vec2& vec2Min, const glm::vec2& vec2Max)
+{
+	const glm::vec2 vec2Direction = vec2End - vec2Start;
+	float tEnter = 0.0f, tExit = 1.0f;
+	for (int i = 0; i < 2; i++)
+	{
+		if (vec2Direction[i] == 0.0f)
+		{
+			if ((vec2Start[i] < vec2Min[i]) || (vec2Start[i] > vec2Max[i]))
+				return false;
+			continue;
+		}
+		float t1 = (vec2Min[i] - vec2Start[i]) / vec2Direction[i];
+		float t2 = (vec2Max[i] - vec2Start[i]) / vec2Direction[i];
+		if (t1 > t2)
+			std::swap(t1, t2);
+		tEnter = std::max(tEnter, t1);
+		tExit = std::min(tExit, t2);
+		if (tEnter > tExit)
+			return false;
+	}
+	return true;
+}
+
+/**
+ @brief Check the pairs, region queries and ray queries of a broadphase against testing every box
+ @param cBroadphase The broadphase
+ @param vMins The bottom left corners of the boxes, by their proxies
+ @param vMaxs The top right corners of the boxes, by their proxies
+ @param vDynamic true for the dynamic boxes, by their proxies
+ @param vRegionMins The bottom left corners of the regions to query
+ @param vRegionMaxs The top right corners of the regions to query
+ @param vRayStarts The starts of the line segments to query
+ @param vRayEnds The ends of the line segments to query
+ @return false if the broadphase found different boxes from testing every box
+ */
+static bool CheckBroadphase(CBroadphase& cBroadphase,
+							const std::vector<glm::vec2>& vMins, const std::vector<glm::vec2>& vMaxs, const std::vector<bool>& vDynamic,
+							const std::vector<glm::vec2>& vRegionMins, const std::vector<glm::vec2>& vRegionMaxs,
+							const std::vector<glm::vec2>& vRayStarts, const std::vector<glm::vec2>& vRayEnds)
+{
+	const unsigned int uiNumBoxes = (unsigned int)vMins.size();
+
+	// The pairs of overlapping boxes in which at least one box is dynamic
+	std::vector<std::pair<unsigned int, unsigned int>> vExpectedPairs, vFoundPairs;
+	for (unsigned int uiA = 0; uiA < uiNumBoxes; uiA++)
+	{
+		for (unsigned int uiB = uiA + 1; uiB < uiNumBoxes; uiB++)
+		{
+			if ((vDynamic[uiA] || vDynamic[uiB]) && BoxesOverlap(vMins[uiA], vMaxs[uiA], vMins[uiB], vMaxs[uiB]))
+				vExpectedPairs.push_back(std::make_pair(uiA, uiB));
+		}
+	}
+	std::vector<BroadphasePair> vPairs;
+	cBroadphase.FindOverlappingPairs(vPairs);
+	for (const BroadphasePair& pair : vPairs)
+		vFoundPairs.push_back(std::make_pair(std::min(pair.uiProxyA, pair.uiProxyB), std::max(pair.uiProxyA, pair.uiProxyB)));
+	std::sort(vFoundPairs.begin(), vFoundPairs.end());
+	if (vFoundPairs != vExpectedPairs)
+	{
+		cerr << "CBroadphase::FindOverlappingPairs found " << vFoundPairs.size() << " pairs, but testing every pair found "
+			 << vExpectedPairs.size() << " pairs, or different ones" << endl;
+		return false;
+	}
+
+	std::vector<unsigned int> vExpected, vFound;
+	for (unsigned int uiQuery = 0; uiQuery < vRegionMins.size(); uiQuery++)
+	{
+		vExpected.clear();
+		for (unsigned int uiBox = 0; uiBox < uiNumBoxes; uiBox++)
+		{
+			if (BoxesOverlap(vRegionMins[uiQuery], vRegionMaxs[uiQuery], vMins[uiBox], vMaxs[uiBox]))
+				vExpected.push_back(uiBox);
+		}
+		cBroadphase.QueryRegion(vRegionMins[uiQuery], vRegionMaxs[uiQuery], vFound);
+		std::sort(vFound.begin(), vFound.end());
+		if (vFound != vExpected)
+		{
+			cerr << "CBroadphase::QueryRegion found " << vFound.size() << " boxes in region " << uiQuery
+				 << ", but testing every box found " << vExpected.size() << " boxes, or different ones" << endl;
+			return false;
+		}
+	}
+
+	for (unsigned int uiQuery = 0; uiQuery < vRayStarts.size(); uiQuery++)
+	{
+		vExpected.clear();
+		for (unsigned int uiBox = 0; uiBox < uiNumBoxes; uiBox++)
+		{
+			if (SegmentHitsBox(vRayStarts[uiQuery], vRayEnds[uiQuery], vMins[uiBox], vMaxs[uiBox]))
+				vExpected.push_back(uiBox);
+		}
+		cBroadphase.QueryRay(vRayStarts[uiQuery], vRayEnds[uiQuery], vFound);
+		std::sort(vFound.begin(), vFound.end());
+		if (vFound != vExpected)
+		{
+			cerr << "CBroadphase::QueryRay found " << vFound.size() << " boxes on ray " << uiQuery
+				 << ", but testing every box found " << vExpected.size() << " boxes, or different ones" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ @brief Run the benchmarks of CBroadphase against testing every pair of boxes.
+		Each case has as many tile sized entities as static tiles, at the same density in a larger map,
+		and the entities move a little in every operation, as they would in every tick.
+		Before they are timed, the results of CBroadphase are checked against testing every box
+ @return false if CBroadphase found different boxes from testing every box
+ */
+static bool RunBroadphaseBenchmarks(CBenchmarkRunner& cRunner, const unsigned int uiSeed)
+{
+	const unsigned int auiNumEntities[] = { 256, 1024, 4096 };
+	for (unsigned int uiNumEntities : auiNumEntities)
+	{
+		CRandom cRandom;
+		cRandom.Seed(uiSeed);
+
+		// 1 entity and 1 static tile for every 8 tiles of the map
+		const int iMapSize = (int)ceil(sqrt(uiNumEntities * 8.0));
+		const glm::vec2 vec2HalfSize(0.4f, 0.4f);
+		std::vector<glm::vec2> vEntities, vJitters, vTileMins, vTileMaxs;
+		for (unsigned int i = 0; i < uiNumEntities; i++)
+		{
+			vEntities.push_back(glm::vec2(cRandom.Uniform(), cRandom.Uniform()) * (float)iMapSize);
+			const glm::vec2 tile((float)cRandom.Range(0, iMapSize - 1), (float)cRandom.Range(0, iMapSize - 1));
+			vTileMins.push_back(tile);
+			vTileMaxs.push_back(tile + glm::vec2(1.0f));
+		}
+		for (unsigned int i = 0; i < NUM_RAYS; i++)
+			vJitters.push_back(glm::vec2(cRandom.Uniform() - 0.5f, cRandom.Uniform() - 0.5f) * 0.1f);
+
+		CBroadphase cBroadphase;
+		cBroadphase.Init(glm::vec2(0.0f), glm::vec2(1.0f), iMapSize, iMapSize);
+		std::vector<unsigned int> vProxies;
+		std::vector<glm::vec2> vProxyMins, vProxyMaxs;
+		std::vector<bool> vProxyDynamic;
+		for (unsigned int i = 0; i < uiNumEntities; i++)
+		{
+			vProxies.push_back(cBroadphase.Insert(vEntities[i] - vec2HalfSize, vEntities[i] + vec2HalfSize, true, i));
+			const unsigned int uiTileProxy = cBroadphase.Insert(vTileMins[i], vTileMaxs[i], false, i);
+			vProxyMins.resize(std::max((unsigned int)vProxyMins.size(), std::max(vProxies.back(), uiTileProxy) + 1));
+			vProxyMaxs.resize(vProxyMins.size());
+			vProxyDynamic.resize(vProxyMins.size());
+			vProxyMins[vProxies.back()] = vEntities[i] - vec2HalfSize;
+			vProxyMaxs[vProxies.back()] = vEntities[i] + vec2HalfSize;
+			vProxyDynamic[vProxies.back()] = true;
+			vProxyMins[uiTileProxy] = vTileMins[i];
+			vProxyMaxs[uiTileProxy] = vTileMaxs[i];
+			vProxyDynamic[uiTileProxy] = false;
+		}
+
+		// Get the position of an entity in an operation, which wanders around its start by a small jitter
+		auto GetPosition = [&](const unsigned int uiEntity, const unsigned long long ullIteration)
+		{
+			return vEntities[uiEntity] + vJitters[(uiEntity + ullIteration) % NUM_RAYS];
+		};
+
+		std::ostringstream suffix;
+		suffix << "/" << uiNumEntities;
+
+		// The regions and rays of the queries, as in their benchmarks
+		std::vector<glm::vec2> vRegionMins, vRegionMaxs, vRayStarts, vRayEnds;
+		for (unsigned int i = 0; i < NUM_RAYS; i++)
+		{
+			const glm::vec2 centre = vEntities[i % uiNumEntities];
+			vRegionMins.push_back(centre - glm::vec2(2.0f));
+			vRegionMaxs.push_back(centre + glm::vec2(2.0f));
+			vRayStarts.push_back(centre);
+			vRayEnds.push_back(centre + vJitters[i] * 80.0f);
+		}
+
+		// Check the broadphase where the entities start, and after they have moved
+		if (CheckBroadphase(cBroadphase, vProxyMins, vProxyMaxs, vProxyDynamic, vRegionMins, vRegionMaxs, vRayStarts, vRayEnds) == false)
+			return false;
+		for (unsigned int uiEntity = 0; uiEntity < uiNumEntities; uiEntity++)
+		{
+			const glm::vec2 position = GetPosition(uiEntity, 1);
+			vProxyMins[vProxies[uiEntity]] = position - vec2HalfSize;
+			vProxyMaxs[vProxies[uiEntity]] = position + vec2HalfSize;
+			cBroadphase.Move(vProxies[uiEntity], position - vec2HalfSize, position + vec2HalfSize);
+		}
+		if (CheckBroadphase(cBroadphase, vProxyMins, vProxyMaxs, vProxyDynamic, vRegionMins, vRegionMaxs, vRayStarts, vRayEnds) == false)
+			return false;
+
+		std::vector<BroadphasePair> vPairs;
+		cRunner.Run("CBroadphase::FindOverlappingPairs" + suffix.str(), [&](const unsigned long long ullIterations)
+		{
+			for (unsigned long long i = 0; i < ullIterations; i++)
+			{
+				for (unsigned int uiEntity = 0; uiEntity < uiNumEntities; uiEntity++)
+				{
+					const glm::vec2 position = GetPosition(uiEntity, i);
+					cBroadphase.Move(vProxies[uiEntity], position - vec2HalfSize, position + vec2HalfSize);
+				}
+				cBroadphase.FindOverlappingPairs(vPairs);
+				DoNotOptimise(vPairs.size());
+			}
+		}, uiNumEntities, "entities");
+
+		std::vector<glm::vec2> vMins(uiNumEntities), vMaxs(uiNumEntities);
+		cRunner.Run("BruteForce::FindOverlappingPairs" + suffix.str(), [&](const unsigned long long ullIterations)
+		{
+			for (unsigned long long i = 0; i < ullIterations; i++)
+			{
+				for (unsigned int uiEntity = 0; uiEntity < uiNumEntities; uiEntity++)
+				{
+					const glm::vec2 position = GetPosition(uiEntity, i);
+					vMins[uiEntity] = position - vec2HalfSize;
+					vMaxs[uiEntity] = position + vec2HalfSize;
+				}
+				unsigned long long ullPairs = 0;
+				for (unsigned int uiA = 0; uiA < uiNumEntities; uiA++)
+				{
+					for (unsigned int uiB = uiA + 1; uiB < uiNumEntities; uiB++)
+					{
+						if ((vMins[uiA].x <= vMaxs[uiB].x) && (vMaxs[uiA].x >= vMins[uiB].x) &&
+							(vMins[uiA].y <= vMaxs[uiB].y) && (vMaxs[uiA].y >= vMins[uiB].y))
+							ullPairs++;
+					}
+					for (unsigned int uiTile = 0; uiTile < uiNumEntities; uiTile++)
+					{
+						if ((vMins[uiA].x <= vTileMaxs[uiTile].x) && (vMaxs[uiA].x >= vTileMins[uiTile].x) &&
+							(vMins[uiA].y <= vTileMaxs[uiTile].y) && (vMaxs[uiA].y >= vTileMins[uiTile].y))
+							ullPairs++;
+					}
+				}
+				DoNotOptimise(ullPairs);
+			}
+		}, uiNumEntities, "entities");
+
+		// Move the entities back to where they start, where the brute force queries test them
+		for (unsigned int uiEntity = 0; uiEntity < uiNumEntities; uiEntity++)
+			cBroadphase.Move(vProxies[uiEntity], vEntities[uiEntity] - vec2HalfSize, vEntities[uiEntity] + vec2HalfSize);
+
+		// A region of 4x4 tiles around an entity, e.g. to find the entities near the player
+		std::vector<unsigned int> vResults;
+		cRunner.Run("CBroadphase::QueryRegion" + suffix.str(), [&](const unsigned long long ullIterations)
+		{
+			for (unsigned long long i = 0; i < ullIterations; i++)
+			{
+				const glm::vec2 centre = vEntities[i % uiNumEntities];
+				cBroadphase.QueryRegion(centre - glm::vec2(2.0f), centre + glm::vec2(2.0f), vResults);
+				DoNotOptimise(vResults.size());
+			}
+		}, 1.0, "queries");
+
+		cRunner.Run("BruteForce::QueryRegion" + suffix.str(), [&](const unsigned long long ullIterations)
+		{
+			for (unsigned long long i = 0; i < ullIterations; i++)
+			{
+				const glm::vec2 centre = vEntities[i % uiNumEntities];
+				const glm::vec2 regionMin = centre - glm::vec2(2.0f), regionMax = centre + glm::vec2(2.0f);
+				unsigned long long ullFound = 0;
+				for (unsigned int uiEntity = 0; uiEntity < uiNumEntities; uiEntity++)
+				{
+					const glm::vec2 entityMin = vEntities[uiEntity] - vec2HalfSize, entityMax = vEntities[uiEntity] + vec2HalfSize;
+					if ((regionMin.x <= entityMax.x) && (regionMax.x >= entityMin.x) &&
+						(regionMin.y <= entityMax.y) && (regionMax.y >= entityMin.y))
+						ullFound++;
+					if ((regionMin.x <= vTileMaxs[uiEntity].x) && (regionMax.x >= vTileMins[uiEntity].x) &&
+						(regionMin.y <= vTileMaxs[uiEntity].y) && (regionMax.y >= vTileMins[uiEntity].y))
+						ullFound++;
+				}
+				DoNotOptimise(ullFound);
+			}
+		}, 1.0, "queries");
+
+		// A line of sight of 8 tiles from an entity
+		cRunner.Run("CBroadphase::QueryRay" + suffix.str(), [&](const unsigned long long ullIterations)
+		{
+			for (unsigned long long i = 0; i < ullIterations; i++)
+			{
+				const glm::vec2 start = vEntities[i % uiNumEntities];
+				cBroadphase.QueryRay(start, start + vJitters[i % NUM_RAYS] * 80.0f, vResults);
+				DoNotOptimise(vResults.size());
+			}
+		}, 1.0, "queries");
+
+		cRunner.Run("BruteForce::QueryRay" + suffix.str(), [&](const unsigned long long ullIterations)
+		{
+			for (unsigned long long i = 0; i < ullIterations; i++)
+			{
+				const glm::vec2 start = vEntities[i % uiNumEntities];
+				const glm::vec2 end = start + vJitters[i % NUM_RAYS] * 80.0f;
+				unsigned long long ullFound = 0;
+				for (unsigned int uiEntity = 0; uiEntity < uiNumEntities; uiEntity++)
+				{
+					if (SegmentHitsBox(start, end, vEntities[uiEntity] - vec2HalfSize, vEntities[uiEntity] + vec2HalfSize))
+						ullFound++;
+					if (SegmentHitsBox(start, end, vTileMins[uiEntity], vTileMaxs[uiEntity]))
+						ullFound++;
+				}
+				DoNotOptimise(ullFound);
+			}
+		}, 1.0, "queries");
+	}
+	return true;
+}
+
+/**
+ @brief The main function of the benchmarks
+ @param argc The number of command line arguments
+ @param argv The command line arguments
+ @return 0 if the benchmarks ran and CBroadphase matched testing every box, otherwise 1
+ */
+int main(int argc, char* argv[])
+{
+	CBenchmarkRunner cRunner;
+	std::string sMapsDir = MAZE_MAPS_DIR;
+	unsigned int uiSeed = 1;
+	bool bSynthetic = true;
+
+	// Parse the command line options
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--maps") == 0) && (i + 1 < argc))
+			sMapsDir = argv[++i];
+		else if ((strcmp(argv[i], "--filter") == 0) && (i + 1 < argc))
+			cRunner.SetFilter(argv[++i]);
+		else if ((strcmp(argv[i], "--min-time") == 0) && (i + 1 < argc))
+			cRunner.SetMinTime(atof(argv[++i]));
+		else if ((strcmp(argv[i], "--format") == 0) && (i + 1 < argc))
+		{
+			i++;
+			cRunner.SetFormat(strcmp(argv[i], "csv") == 0 ? CBenchmarkRunner::FORMAT_CSV : CBenchmarkRunner::FORMAT_JSON);
+		}
+		else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc))
+			uiSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--no-synthetic") == 0)
+			bSynthetic = false;
+		else
+		{
+			cerr << "Unknown option: " << argv[i] << endl;
+			return 1;
+		}
+	}
+
+	// The real levels of the game
+	std::vector<MapCase> vMapCases;
+	const char* apLevels[] = { "Maze_Level_01", "DM2213_Map_Level_01", "DM2213_Map_Level_02" };
+	for (const char* pLevel : apLevels)
+	{
+		MapCase mapCase;
+		mapCase.sName = pLevel;
+		mapCase.sFilePath = sMapsDir + "/" + pLevel + ".csv";
+		if (GetMapSize(mapCase.sFilePath, mapCase.uiNumRows, mapCase.uiNumCols))
+			vMapCases.push_back(mapCase);
+	}
+
+	// Generated mazes which are much larger than the real levels
+	std::vector<std::string> vGeneratedFiles;
+	if (bSynthetic)
+	{
+		const unsigned int auiSizes[] = { 127, 511 };
+		for (unsigned int uiSize : auiSizes)
+		{
+			std::ostringstream name;
+			name << "Synthetic_" << uiSize << "x" << uiSize;
+			MapCase mapCase;
+			mapCase.sName = name.str();
+			mapCase.sFilePath = (std::filesystem::temp_directory_path() / (name.str() + ".csv")).string();
+			mapCase.uiNumRows = uiSize;
+			mapCase.uiNumCols = uiSize;
+			if (CMazeGenerator::WriteCSV(mapCase.sFilePath, CMazeGenerator::Generate(uiSize, uiSize, uiSeed), uiSize, uiSize))
+			{
+				vMapCases.push_back(mapCase);
+				vGeneratedFiles.push_back(mapCase.sFilePath);
+			}
+		}
+	}
+
+	for (const MapCase& mapCase : vMapCases)
+		RunMapBenchmarks(cRunner, mapCase, uiSeed);
+	RunCollisionBenchmarks(cRunner, uiSeed);
+	const bool bBroadphaseValid = RunBroadphaseBenchmarks(cRunner, uiSeed);
+
+	for (const std::string& sFile : vGeneratedFiles)
+	{
+		std::error_code error;
+		std::filesystem::remove(sFile, error);
+	}
+
+	if (bBroadphaseValid == false)
+	{
+		cerr << "CBroadphase does not match testing every box" << endl;
+		return 1;
+	}
+	if (cRunner.GetNumRun() == 0)
+	{
+		cerr << "No benchmarks were run" << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,220 @@
+/**
+ CBenchmarkRunner
+ @brief A class to time a piece of code over many iterations and report the time, allocations and
+		throughput per operation as JSON lines or CSV, so that the results can be compared across builds
+ */
+#include "BenchmarkRunner.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+using namespace std;
+
+// Every allocation in the program is counted by the replaced operator new below
+static std::atomic<unsigned long long> g_ullAllocCount(0);
+static std::atomic<unsigned long long> g_ullAllocBytes(0);
+// Written by DoNotOptimise, so that the benchmarked results are used
+static volatile unsigned long long g_ullSink = 0;
+
+/**
+ @brief Allocate memory and count the allocation
+ */
+static void* CountedAlloc(std::size_t size)
+{
+	g_ullAllocCount.fetch_add(1, std::memory_order_relaxed);
+	g_ullAllocBytes.fetch_add(size, std::memory_order_relaxed);
+	void* p = std::malloc(size == 0 ? 1 : size);
+	if (p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	try { return CountedAlloc(size); }
+	catch (...) { return NULL; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	try { return CountedAlloc(size); }
+	catch (...) { return NULL; }
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+/**
+ @brief Keep a value alive, so that the compiler does not remove the code which computed it
+ @param ullValue The value
+ */
+void DoNotOptimise(const unsigned long long ullValue)
+{
+	g_ullSink = g_ullSink + ullValue;
+}
+
+/**
+ @brief Constructor
+ */
+CBenchmarkRunner::CBenchmarkRunner(void)
+	: dMinTime(0.25)
+	, eFormat(FORMAT_JSON)
+	, uiNumRun(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CBenchmarkRunner::~CBenchmarkRunner(void)
+{
+}
+
+/**
+ @brief Set the minimum time to run each benchmark for
+ @param dMinTime The time in seconds
+ */
+void CBenchmarkRunner::SetMinTime(const double dMinTime)
+{
+	this->dMinTime = (dMinTime > 0.0 ? dMinTime : 0.01);
+}
+
+/**
+ @brief Only run the benchmarks whose names contain this text
+ @param sFilter The text. An empty text runs all benchmarks
+ */
+void CBenchmarkRunner::SetFilter(const std::string& sFilter)
+{
+	this->sFilter = sFilter;
+}
+
+/**
+ @brief Set the output format
+ @param eFormat The format
+ */
+void CBenchmarkRunner::SetFormat(const FORMAT eFormat)
+{
+	this->eFormat = eFormat;
+}
+
+/**
+ @brief Check if a benchmark would be run with the current filter
+ @param sName The name of the benchmark
+ @return true if the benchmark would be run
+ */
+bool CBenchmarkRunner::IsSelected(const std::string& sName) const
+{
+	return sFilter.empty() || (sName.find(sFilter) != std::string::npos);
+}
+
+/**
+ @brief Run a benchmark and print its results. The number of iterations is doubled until
+		the benchmark runs for at least the minimum time, and only that last run is reported.
+ @param sName The name of the benchmark
+ @param function The benchmarked code
+ @param dItemsPerOp The number of items processed by one operation
+ @param sItemName The name of the items
+ */
+void CBenchmarkRunner::Run(const std::string& sName, const BenchmarkFunction& function,
+						   const double dItemsPerOp, const std::string& sItemName)
+{
+	if (IsSelected(sName) == false)
+		return;
+
+	// Warm up the caches and let any lazy initialisation happen outside of the measurement
+	function(1);
+
+	unsigned long long ullIterations = 1;
+	double dElapsed = 0.0;
+	unsigned long long ullAllocs = 0, ullBytes = 0;
+	while (true)
+	{
+		const unsigned long long ullAllocCountStart = GetAllocCount();
+		const unsigned long long ullAllocBytesStart = GetAllocBytes();
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		function(ullIterations);
+
+		dElapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		ullAllocs = GetAllocCount() - ullAllocCountStart;
+		ullBytes = GetAllocBytes() - ullAllocBytesStart;
+
+		if ((dElapsed >= dMinTime) || (ullIterations >= (1ULL << 40)))
+			break;
+
+		// Aim a bit past the minimum time, but never more than 10x the iterations at once
+		double dScale = (dElapsed > 0.0 ? (dMinTime * 1.2) / dElapsed : 10.0);
+		if (dScale > 10.0)
+			dScale = 10.0;
+		if (dScale < 2.0)
+			dScale = 2.0;
+		ullIterations = (unsigned long long)(ullIterations * dScale);
+	}
+
+	BenchmarkResult result;
+	result.sName = sName;
+	result.ullIterations = ullIterations;
+	result.dNsPerOp = dElapsed * 1e9 / (double)ullIterations;
+	result.dAllocsPerOp = (double)ullAllocs / (double)ullIterations;
+	result.dBytesPerOp = (double)ullBytes / (double)ullIterations;
+	result.dItemsPerSecond = (dElapsed > 0.0 ? dItemsPerOp * ullIterations / dElapsed : 0.0);
+	result.sItemName = sItemName;
+	Print(result);
+	uiNumRun++;
+}
+
+/**
+ @brief Get the number of benchmarks which were run
+ @return The number of benchmarks
+ */
+unsigned int CBenchmarkRunner::GetNumRun(void) const
+{
+	return uiNumRun;
+}
+
+/**
+ @brief Get the number of allocations since the program started
+ @return The number of allocations
+ */
+unsigned long long CBenchmarkRunner::GetAllocCount(void)
+{
+	return g_ullAllocCount.load(std::memory_order_relaxed);
+}
+
+/**
+ @brief Get the number of allocated bytes since the program started
+ @return The number of bytes
+ */
+unsigned long long CBenchmarkRunner::GetAllocBytes(void)
+{
+	return g_ullAllocBytes.load(std::memory_order_relaxed);
+}
+
+/**
+ @brief Print the results of a benchmark as one JSON object per line, or as a CSV row
+ @param result The results
+ */
+void CBenchmarkRunner::Print(const BenchmarkResult& result)
+{
+	if (eFormat == FORMAT_CSV)
+	{
+		if (uiNumRun == 0)
+			cout << "name,iterations,ns_per_op,allocs_per_op,bytes_per_op,items_per_second,item" << endl;
+		cout << result.sName << ',' << result.ullIterations << ',' << result.dNsPerOp << ','
+			<< result.dAllocsPerOp << ',' << result.dBytesPerOp << ','
+			<< result.dItemsPerSecond << ',' << result.sItemName << endl;
+	}
+	else
+	{
+		cout << "{\"name\":\"" << result.sName << "\",\"iterations\":" << result.ullIterations
+			<< ",\"ns_per_op\":" << result.dNsPerOp
+			<< ",\"allocs_per_op\":" << result.dAllocsPerOp
+			<< ",\"bytes_per_op\":" << result.dBytesPerOp
+			<< ",\"items_per_second\":" << result.dItemsPerSecond
+			<< ",\"item\":\"" << result.sItemName << "\"}" << endl;
+	}
+}
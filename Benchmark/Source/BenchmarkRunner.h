@@ -0,0 +1,75 @@
+/**
+ CBenchmarkRunner
+ @brief A class to time a piece of code over many iterations and report the time, allocations and
+		throughput per operation as JSON lines or CSV, so that the results can be compared across builds
+ */
+#pragma once
+
+#include <functional>
+#include <string>
+
+// The results of one benchmark
+struct BenchmarkResult
+{
+	std::string sName;
+	unsigned long long ullIterations;
+	double dNsPerOp;
+	double dAllocsPerOp;
+	double dBytesPerOp;
+	double dItemsPerSecond;
+	std::string sItemName;
+};
+
+class CBenchmarkRunner
+{
+public:
+	enum FORMAT
+	{
+		FORMAT_JSON = 0,
+		FORMAT_CSV,
+		NUM_FORMATS
+	};
+
+	// The benchmarked code. It must run the operation uiIterations times
+	typedef std::function<void(const unsigned long long ullIterations)> BenchmarkFunction;
+
+	// Constructor
+	CBenchmarkRunner(void);
+
+	// Destructor
+	~CBenchmarkRunner(void);
+
+	// Set the minimum time to run each benchmark for, in seconds
+	void SetMinTime(const double dMinTime);
+	// Only run the benchmarks whose names contain this text
+	void SetFilter(const std::string& sFilter);
+	// Set the output format
+	void SetFormat(const FORMAT eFormat);
+
+	// Check if a benchmark would be run with the current filter
+	bool IsSelected(const std::string& sName) const;
+
+	// Run a benchmark and print its results.
+	// dItemsPerOp is the number of items (e.g. tiles or rays) processed by one operation, for the throughput
+	void Run(const std::string& sName, const BenchmarkFunction& function,
+			 const double dItemsPerOp = 1.0, const std::string& sItemName = "ops");
+
+	// Get the number of benchmarks which were run
+	unsigned int GetNumRun(void) const;
+
+	// Get the number of allocations and allocated bytes since the program started
+	static unsigned long long GetAllocCount(void);
+	static unsigned long long GetAllocBytes(void);
+
+protected:
+	double dMinTime;
+	std::string sFilter;
+	FORMAT eFormat;
+	unsigned int uiNumRun;
+
+	// Print the results of a benchmark
+	void Print(const BenchmarkResult& result);
+};
+
+// Keep a value alive, so that the compiler does not remove the code which computed it
+void DoNotOptimise(const unsigned long long ullValue);
@@ -0,0 +1,129 @@
+/**
+ CMazeGenerator
+ @brief A class to generate mazes of any size in the same tile values and CSV layout as the
+		game's levels, to benchmark the map code on maps much larger than the real ones
+ */
+#include "MazeGenerator.h"
+
+#include "System/Random.h"
+
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Generate a maze with an iterative recursive backtracker, so that every floor tile is reachable.
+		The cells are on the odd rows and columns, with walls between them and around the border.
+ @param uiNumRows The number of rows
+ @param uiNumCols The number of columns
+ @param uiSeed The random seed. The same seed gives the same maze
+ @param fLoopChance The chance of removing each remaining inner wall, to create loops
+ @return The tile values in row-major order
+ */
+std::vector<int> CMazeGenerator::Generate(const unsigned int uiNumRows, const unsigned int uiNumCols,
+										  const unsigned int uiSeed, const float fLoopChance)
+{
+	std::vector<int> vTiles(uiNumRows * uiNumCols, TILE_WALL);
+	if ((uiNumRows < 3) || (uiNumCols < 3))
+		return vTiles;
+
+	CRandom cRandom;
+	cRandom.Seed(uiSeed);
+
+	const int iCellRows = (int)(uiNumRows - 1) / 2;
+	const int iCellCols = (int)(uiNumCols - 1) / 2;
+	std::vector<bool> vVisited(iCellRows * iCellCols, false);
+	std::vector<int> vStack;
+	vStack.reserve(iCellRows * iCellCols);
+
+	const int aiDirections[4][2] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+
+	vStack.push_back(0);
+	vVisited[0] = true;
+	vTiles[1 * uiNumCols + 1] = TILE_FLOOR;
+	while (!vStack.empty())
+	{
+		const int iCell = vStack.back();
+		const int iRow = iCell / iCellCols;
+		const int iCol = iCell % iCellCols;
+
+		// Find the neighbouring cells which have not been visited yet
+		int aiCandidates[4];
+		int iNumCandidates = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			const int iNextRow = iRow + aiDirections[i][0];
+			const int iNextCol = iCol + aiDirections[i][1];
+			if ((iNextRow >= 0) && (iNextRow < iCellRows) && (iNextCol >= 0) && (iNextCol < iCellCols) &&
+				(vVisited[iNextRow * iCellCols + iNextCol] == false))
+				aiCandidates[iNumCandidates++] = i;
+		}
+
+		if (iNumCandidates == 0)
+		{
+			vStack.pop_back();
+			continue;
+		}
+
+		// Carve a passage to a random neighbour
+		const int i = aiCandidates[cRandom.Range(0, iNumCandidates - 1)];
+		const int iNextRow = iRow + aiDirections[i][0];
+		const int iNextCol = iCol + aiDirections[i][1];
+		vTiles[(2 * iRow + 1 + aiDirections[i][0]) * uiNumCols + (2 * iCol + 1 + aiDirections[i][1])] = TILE_FLOOR;
+		vTiles[(2 * iNextRow + 1) * uiNumCols + (2 * iNextCol + 1)] = TILE_FLOOR;
+		vVisited[iNextRow * iCellCols + iNextCol] = true;
+		vStack.push_back(iNextRow * iCellCols + iNextCol);
+	}
+
+	// Remove some inner walls between two floor tiles, so that there is more than one path
+	for (unsigned int uiRow = 1; uiRow + 1 < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 1; uiCol + 1 < uiNumCols; uiCol++)
+		{
+			int& iTile = vTiles[uiRow * uiNumCols + uiCol];
+			if (iTile != TILE_WALL)
+				continue;
+			const bool bHorizontal = (vTiles[uiRow * uiNumCols + uiCol - 1] == TILE_FLOOR) &&
+									 (vTiles[uiRow * uiNumCols + uiCol + 1] == TILE_FLOOR);
+			const bool bVertical = (vTiles[(uiRow - 1) * uiNumCols + uiCol] == TILE_FLOOR) &&
+								   (vTiles[(uiRow + 1) * uiNumCols + uiCol] == TILE_FLOOR);
+			if ((bHorizontal != bVertical) && (cRandom.Uniform() < fLoopChance))
+				iTile = TILE_FLOOR;
+		}
+	}
+
+	// Put the player start in the last cell, so that searching for it scans the whole map
+	vTiles[(2 * (iCellRows - 1) + 1) * uiNumCols + (2 * (iCellCols - 1) + 1)] = TILE_PLAYER;
+
+	return vTiles;
+}
+
+/**
+ @brief Write a maze to a CSV file in the same layout as the game's levels, with a header row of column numbers
+ @param sFilePath The path of the file
+ @param vTiles The tile values in row-major order
+ @param uiNumRows The number of rows
+ @param uiNumCols The number of columns
+ @return true if the file was written, otherwise false
+ */
+bool CMazeGenerator::WriteCSV(const std::string& sFilePath, const std::vector<int>& vTiles,
+							  const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	ofstream file(sFilePath.c_str(), ios::out | ios::trunc);
+	if (!file.is_open())
+	{
+		cout << "CMazeGenerator::WriteCSV - Unable to open " << sFilePath << endl;
+		return false;
+	}
+
+	file << "//";
+	for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		file << (uiCol + 1) << (uiCol + 1 < uiNumCols ? "," : "\n");
+
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+			file << vTiles[uiRow * uiNumCols + uiCol] << (uiCol + 1 < uiNumCols ? "," : "\n");
+	}
+	return true;
+}
@@ -0,0 +1,27 @@
+/**
+ CMazeGenerator
+ @brief A class to generate mazes of any size in the same tile values and CSV layout as the
+		game's levels, to benchmark the map code on maps much larger than the real ones
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+class CMazeGenerator
+{
+public:
+	// The tile values used in the generated mazes
+	static const int TILE_FLOOR = 2;
+	static const int TILE_WALL = 102;
+	static const int TILE_PLAYER = 303;
+
+	// Generate a maze. Row 0 is the top row, as in the CSV files.
+	// fLoopChance is the chance of removing each remaining inner wall, to create loops
+	static std::vector<int> Generate(const unsigned int uiNumRows, const unsigned int uiNumCols,
+									 const unsigned int uiSeed, const float fLoopChance = 0.05f);
+
+	// Write a maze to a CSV file in the same layout as the game's levels
+	static bool WriteCSV(const std::string& sFilePath, const std::vector<int>& vTiles,
+						 const unsigned int uiNumRows, const unsigned int uiNumCols);
+};
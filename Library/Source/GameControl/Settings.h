@@ -54,6 +54,31 @@ public:
 	// Frame Rate Information
 	const unsigned char FPS = 30; // FPS of this game
 	const unsigned int frameTime = 1000 / FPS; // time for each frame
+	bool bLimitFrameRate = true; // Set to false to render as fast as possible (or at the monitor rate with V-Sync)
+	bool bUseVSync = false; // Synchronise the buffer swaps with the monitor refresh rate
+
+	// Simulation Information
+	unsigned int iTickRate = 30; // Number of fixed simulation ticks per second. Gameplay counters are tuned for 30
+	unsigned int iMaxTicksPerFrame = 5; // Max ticks to catch up in one frame, before dropping time
+	bool bHeadless = false; // Run the simulation ticks back to back without rendering or frame pacing
+	unsigned int iHeadlessTicks = 0; // Number of ticks to run in headless mode
+	bool bLateInputPolling = true; // Poll the input just before the simulation ticks. Set to false to poll it after the buffers are swapped, before the frame rate limiter waits
+
+	// Profiling Information
+	const char* sProfileTraceFile = NULL; // Write a Chrome trace of the profile zones to this file on exit, if not NULL
+	int iFrameAllocBudget = -1; // The max heap allocations per frame, checked when ENABLE_MEMORY_TRACKER is defined. -1 for no budget
+
+	// Record and Replay Information
+	unsigned int iRandomSeed = 0; // The seed for CRandom. 0 picks a seed from the time. A replay uses the seed of its recording
+	const char* sRecordInputFile = NULL; // Record the input of every tick to this file, if not NULL
+	const char* sReplayInputFile = NULL; // Replay the input from this file, one tick per frame, if not NULL
+	const char* sReplayTimingsFile = NULL; // Write the frame timings of a replay to this CSV file, if not NULL
+
+	// Audio Information
+	const char* sAudioBackend = NULL; // "irrklang" or "software". NULL uses irrKlang on Windows, and the software mixer elsewhere
+	const char* sAudioOutputFile = NULL; // Use the software mixer, and write its output to this WAV file, if not NULL
+	int iAudioMemoryBudget = -1; // The max kilobytes of decoded audio which the sounds keep in memory. -1 for no budget
+	int iAudioStreamThreshold = 1024; // Sounds in files of at least this many kilobytes are decoded while they play, one voice at a time, instead of when they are loaded. -1 to decode all the sounds when they are loaded
 
 	// Input control
 	//const bool bActivateMouseInput
@@ -0,0 +1,146 @@
+/**
+ CInputEventQueue
+ @brief A class which keeps the key and mouse events from the input callbacks, with the time they happened,
+		in a lock-free ring buffer, and applies them to the controllers in the simulation ticks.
+ */
+#include "InputEventQueue.h"
+
+#include "MouseController.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CInputEventQueue::CInputEventQueue(void)
+	: bHasHeldEvent(false)
+	, ucChangedButtons(0)
+	, uiNumEvents(0)
+	, uiDeferredEvents(0)
+	, uiDroppedEvents(0)
+	, dTotalLatency(0.0)
+	, dMaxLatency(0.0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CInputEventQueue::~CInputEventQueue(void)
+{
+}
+
+/**
+ @brief Add an event. Only the thread which polls the input may call it
+ @param eType The type of event
+ @param iCode The key or mouse button
+ @param iAction 1 if the key or button was pressed, 0 if it was released
+ @param dX The horizontal scroll offset
+ @param dY The vertical scroll offset
+ @param dTime The time of the event, in seconds
+ */
+void CInputEventQueue::Push(const EVENT_TYPE eType, const int iCode, const int iAction, const double dX, const double dY, const double dTime)
+{
+	InputEvent event;
+	event.dTime = dTime;
+	event.iType = eType;
+	event.iCode = iCode;
+	event.iAction = iAction;
+	event.dX = dX;
+	event.dY = dY;
+	if (queue.Push(event) == false)
+		uiDroppedEvents++;
+}
+
+/**
+ @brief Apply the events up to dUntilTime to the controllers, in order. An event after dUntilTime, or a change
+		of a key or button which already changed in this tick, is left for a later tick together with all
+		the events after it. Only the thread which runs the ticks may call it
+ @param dUntilTime The time which the tick stands for, in seconds
+ @param dNow The current time, in seconds, to measure how long the events waited
+ @return The number of events which were applied
+ */
+unsigned int CInputEventQueue::ApplyEvents(const double dUntilTime, const double dNow)
+{
+	changedKeys.reset();
+	ucChangedButtons = 0;
+
+	unsigned int uiApplied = 0;
+	InputEvent event;
+	while ((bHasHeldEvent == true) || (queue.Pop(event) == true))
+	{
+		if (bHasHeldEvent == true)
+		{
+			event = heldEvent;
+			bHasHeldEvent = false;
+		}
+
+		// Check if the event has to wait for a later tick
+		bool bDefer = (event.dTime > dUntilTime);
+		if ((bDefer == false) && (event.iType == KEY) && (event.iCode >= 0) && (event.iCode < CKeyboardController::MAX_KEYS))
+		{
+			bDefer = changedKeys.test(event.iCode);
+			if (bDefer)
+				uiDeferredEvents++;
+		}
+		else if ((bDefer == false) && (event.iType == MOUSE_BUTTON) && (event.iCode >= 0) && (event.iCode < 8))
+		{
+			bDefer = ((ucChangedButtons & (1 << event.iCode)) != 0);
+			if (bDefer)
+				uiDeferredEvents++;
+		}
+		if (bDefer)
+		{
+			heldEvent = event;
+			bHasHeldEvent = true;
+			break;
+		}
+
+		switch (event.iType)
+		{
+		case KEY:
+			CKeyboardController::GetInstance()->Update(event.iCode, event.iAction);
+			if ((event.iCode >= 0) && (event.iCode < CKeyboardController::MAX_KEYS))
+				changedKeys.set(event.iCode);
+			break;
+		case MOUSE_BUTTON:
+			if (event.iAction == 1)
+				CMouseController::GetInstance()->UpdateMouseButtonPressed(event.iCode);
+			else
+				CMouseController::GetInstance()->UpdateMouseButtonReleased(event.iCode);
+			if ((event.iCode >= 0) && (event.iCode < 8))
+				ucChangedButtons |= (1 << event.iCode);
+			break;
+		case MOUSE_SCROLL:
+			CMouseController::GetInstance()->UpdateMouseScroll(event.dX, event.dY);
+			break;
+		default:
+			break;
+		}
+
+		// Measure the time from the event to the tick which acts on it
+		const double dLatency = dNow - event.dTime;
+		dTotalLatency += dLatency;
+		if (dLatency > dMaxLatency)
+			dMaxLatency = dLatency;
+		uiNumEvents++;
+		uiApplied++;
+	}
+
+	return uiApplied;
+}
+
+/**
+ @brief Print the number of events, and the time from each event to the tick which applied it
+ */
+void CInputEventQueue::PrintLatencyReport(void) const
+{
+	cout << "CInputEventQueue - " << uiNumEvents << " input events";
+	if (uiNumEvents > 0)
+	{
+		cout << ", input to tick latency: mean " << dTotalLatency * 1000.0 / uiNumEvents
+			<< " ms, max " << dMaxLatency * 1000.0 << " ms";
+	}
+	cout << ", " << uiDeferredEvents << " deferred to a later tick, " << uiDroppedEvents << " dropped" << endl;
+}
@@ -0,0 +1,84 @@
+/**
+ CInputEventQueue
+ @brief A class which keeps the key and mouse events from the input callbacks, with the time they happened,
+		in a lock-free ring buffer. Each simulation tick applies the events up to the time it stands for
+		to CKeyboardController and CMouseController, in the order they happened. A key or button which
+		changes twice before a tick sees it, e.g. a press and release within one frame, has its second
+		change deferred to the next tick, so that the tick still sees the press.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CSPSCQueue to pass the events from the input callbacks to the ticks
+#include "../System/SPSCQueue.h"
+
+#include "KeyboardController.h"
+
+#include <bitset>
+
+// An event from an input device
+struct InputEvent
+{
+	// The time of the event, in seconds
+	double dTime;
+	// The type of event, from CInputEventQueue::EVENT_TYPE
+	int iType;
+	// The key or mouse button
+	int iCode;
+	// 1 if the key or button was pressed, 0 if it was released
+	int iAction;
+	// The scroll offsets
+	double dX, dY;
+};
+
+class CInputEventQueue : public CSingletonTemplate<CInputEventQueue>
+{
+	friend CSingletonTemplate<CInputEventQueue>;
+
+public:
+	enum EVENT_TYPE
+	{
+		KEY = 0,
+		MOUSE_BUTTON,
+		MOUSE_SCROLL,
+		NUM_EVENT_TYPES
+	};
+
+	// The max number of events waiting for a tick. More events are dropped
+	static const unsigned int CAPACITY = 1024;
+
+	// Add an event. Only the thread which polls the input may call it
+	void Push(const EVENT_TYPE eType, const int iCode, const int iAction, const double dX, const double dY, const double dTime);
+
+	// Apply the events up to dUntilTime to the controllers, in order. Only the thread which runs the ticks may call it
+	unsigned int ApplyEvents(const double dUntilTime, const double dNow);
+
+	// Print the number of events, and the time from each event to the tick which applied it
+	void PrintLatencyReport(void) const;
+
+protected:
+	// The events waiting for a tick
+	CSPSCQueue<InputEvent, CAPACITY> queue;
+	// An event which was taken from the queue, but is left for a later tick
+	InputEvent heldEvent;
+	bool bHasHeldEvent;
+
+	// The keys and mouse buttons which changed in the current tick
+	std::bitset<CKeyboardController::MAX_KEYS> changedKeys;
+	unsigned char ucChangedButtons;
+
+	// The statistics
+	unsigned int uiNumEvents;
+	unsigned int uiDeferredEvents;
+	unsigned int uiDroppedEvents;
+	double dTotalLatency;
+	double dMaxLatency;
+
+	// Constructor
+	CInputEventQueue(void);
+
+	// Destructor
+	virtual ~CInputEventQueue(void);
+};
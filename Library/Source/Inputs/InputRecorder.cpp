@@ -0,0 +1,384 @@
+/**
+ CInputRecorder
+ @brief A class to record the state of the keyboard and mouse at every simulation tick to a file,
+		and to replay it back through the controllers. Together with a seeded CRandom and the
+		fixed tick rate, a replay runs exactly the same session as the recording.
+
+		File format (little-endian, whatever the byte order of the machine which wrote it):
+			Header: "MZIR", version, tick rate, random seed, number of keys (4 bytes each)
+			Then for every tick: current and previous key bitsets (one bit per key),
+			current and previous button statuses (1 byte each), mouse position, mouse delta
+			and scroll offsets (6 doubles)
+ */
+#include "InputRecorder.h"
+
+#include "MouseController.h"
+
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+// Identifies an input recording file
+static const char INPUT_RECORDING_MAGIC[4] = { 'M', 'Z', 'I', 'R' };
+// Increase this whenever the layout of a frame changes
+static const unsigned int INPUT_RECORDING_VERSION = 1;
+// The number of bytes used to store one key bitset
+static const unsigned int KEY_BYTES = (CKeyboardController::MAX_KEYS + 7) / 8;
+
+/**
+ @brief Write an unsigned int to a stream as 4 little-endian bytes, whatever the byte order of the machine
+ */
+static void WriteUInt(std::ostream& stream, const unsigned int uiValue)
+{
+	unsigned char bytes[4];
+	for (int i = 0; i < 4; i++)
+		bytes[i] = (unsigned char)(uiValue >> (8 * i));
+	stream.write((const char*)bytes, sizeof(bytes));
+}
+
+/**
+ @brief Read an unsigned int from 4 little-endian bytes of a stream
+ */
+static unsigned int ReadUInt(std::istream& stream)
+{
+	unsigned char bytes[4] = { 0 };
+	stream.read((char*)bytes, sizeof(bytes));
+	unsigned int uiValue = 0;
+	for (int i = 0; i < 4; i++)
+		uiValue |= (unsigned int)bytes[i] << (8 * i);
+	return uiValue;
+}
+
+/**
+ @brief Write a double to a stream as the 8 little-endian bytes of its IEEE 754 bits
+ */
+static void WriteDouble(std::ostream& stream, const double dValue)
+{
+	unsigned long long ullBits = 0;
+	memcpy(&ullBits, &dValue, sizeof(dValue));
+	unsigned char bytes[8];
+	for (int i = 0; i < 8; i++)
+		bytes[i] = (unsigned char)(ullBits >> (8 * i));
+	stream.write((const char*)bytes, sizeof(bytes));
+}
+
+/**
+ @brief Read a double from the 8 little-endian bytes of its IEEE 754 bits in a stream
+ */
+static double ReadDouble(std::istream& stream)
+{
+	unsigned char bytes[8] = { 0 };
+	stream.read((char*)bytes, sizeof(bytes));
+	unsigned long long ullBits = 0;
+	for (int i = 0; i < 8; i++)
+		ullBits |= (unsigned long long)bytes[i] << (8 * i);
+	double dValue = 0.0;
+	memcpy(&dValue, &ullBits, sizeof(dValue));
+	return dValue;
+}
+
+/**
+ @brief Write a key bitset to a stream, one bit per key
+ */
+static void WriteKeys(std::ostream& stream, const std::bitset<CKeyboardController::MAX_KEYS>& keys)
+{
+	unsigned char bytes[KEY_BYTES] = { 0 };
+	for (int key = 0; key < CKeyboardController::MAX_KEYS; key++)
+	{
+		if (keys.test(key))
+			bytes[key / 8] |= (unsigned char)(1 << (key % 8));
+	}
+	stream.write((const char*)bytes, KEY_BYTES);
+}
+
+/**
+ @brief Read a key bitset from a stream
+ */
+static void ReadKeys(std::istream& stream, std::bitset<CKeyboardController::MAX_KEYS>& keys)
+{
+	unsigned char bytes[KEY_BYTES] = { 0 };
+	stream.read((char*)bytes, KEY_BYTES);
+	for (int key = 0; key < CKeyboardController::MAX_KEYS; key++)
+	{
+		keys.set(key, (bytes[key / 8] & (1 << (key % 8))) != 0);
+	}
+}
+
+/**
+ @brief Constructor
+ */
+CInputRecorder::CInputRecorder(void)
+	: eMode(IDLE)
+	, uiSeed(0)
+	, uiTickRate(0)
+	, uiCurrentTick(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CInputRecorder::~CInputRecorder(void)
+{
+	Stop();
+}
+
+/**
+ @brief Start writing the input of every tick to a file
+ @param sFilename The name of the file to write to
+ @param uiSeed The random seed of the session, so that a replay can use the same seed
+ @param uiTickRate The simulation tick rate of the session
+ @return true if the file was opened, otherwise false
+ */
+bool CInputRecorder::StartRecording(const std::string& sFilename, const unsigned int uiSeed, const unsigned int uiTickRate)
+{
+	Stop();
+
+	recordFile.open(sFilename.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!recordFile.is_open())
+	{
+		cout << "CInputRecorder::StartRecording - Unable to open " << sFilename << endl;
+		return false;
+	}
+
+	this->uiSeed = uiSeed;
+	this->uiTickRate = uiTickRate;
+	uiCurrentTick = 0;
+
+	recordFile.write(INPUT_RECORDING_MAGIC, sizeof(INPUT_RECORDING_MAGIC));
+	WriteUInt(recordFile, INPUT_RECORDING_VERSION);
+	WriteUInt(recordFile, uiTickRate);
+	WriteUInt(recordFile, uiSeed);
+	WriteUInt(recordFile, CKeyboardController::MAX_KEYS);
+
+	eMode = RECORDING;
+	cout << "CInputRecorder::StartRecording - Recording to " << sFilename << " with seed " << uiSeed << endl;
+	return true;
+}
+
+/**
+ @brief Load a recording and start replaying it
+ @param sFilename The name of the file to read from
+ @return true if the file was loaded, otherwise false
+ */
+bool CInputRecorder::StartReplay(const std::string& sFilename)
+{
+	Stop();
+
+	ifstream replayFile(sFilename.c_str(), ios::in | ios::binary);
+	if (!replayFile.is_open())
+	{
+		cout << "CInputRecorder::StartReplay - Unable to open " << sFilename << endl;
+		return false;
+	}
+
+	char magic[sizeof(INPUT_RECORDING_MAGIC)] = { 0 };
+	replayFile.read(magic, sizeof(magic));
+	unsigned int uiVersion = ReadUInt(replayFile);
+	unsigned int uiFileTickRate = ReadUInt(replayFile);
+	unsigned int uiFileSeed = ReadUInt(replayFile);
+	unsigned int uiNumKeys = ReadUInt(replayFile);
+	if ((!replayFile) ||
+		(memcmp(magic, INPUT_RECORDING_MAGIC, sizeof(magic)) != 0) ||
+		(uiVersion != INPUT_RECORDING_VERSION) ||
+		(uiNumKeys != CKeyboardController::MAX_KEYS))
+	{
+		cout << "CInputRecorder::StartReplay - " << sFilename << " is not a supported input recording" << endl;
+		return false;
+	}
+
+	vReplayFrames.clear();
+	InputFrame frame;
+	while (ReadFrame(replayFile, frame))
+	{
+		vReplayFrames.push_back(frame);
+	}
+
+	uiSeed = uiFileSeed;
+	uiTickRate = uiFileTickRate;
+	uiCurrentTick = 0;
+	eMode = REPLAYING;
+	cout << "CInputRecorder::StartReplay - Replaying " << vReplayFrames.size() << " ticks from " << sFilename
+		<< " with seed " << uiSeed << endl;
+	return true;
+}
+
+/**
+ @brief Stop recording or replaying
+ */
+void CInputRecorder::Stop(void)
+{
+	if (eMode == RECORDING)
+	{
+		recordFile.close();
+		cout << "CInputRecorder::Stop - Recorded " << uiCurrentTick << " ticks" << endl;
+	}
+	vReplayFrames.clear();
+	eMode = IDLE;
+}
+
+/**
+ @brief Record or replay the input of one tick. Call this before the game states are updated,
+		and CKeyboardController::PostUpdate after they are updated, as for live input.
+ @return false if a replay has run out of ticks, otherwise true
+ */
+bool CInputRecorder::ProcessTick(void)
+{
+	if (eMode == RECORDING)
+	{
+		InputFrame frame;
+		CaptureFrame(frame);
+		WriteFrame(recordFile, frame);
+		uiCurrentTick++;
+	}
+	else if (eMode == REPLAYING)
+	{
+		if (uiCurrentTick >= vReplayFrames.size())
+		{
+			Stop();
+			return false;
+		}
+		// Replace whatever the callbacks stored with the recorded input
+		ApplyFrame(vReplayFrames[uiCurrentTick]);
+		uiCurrentTick++;
+	}
+	return true;
+}
+
+/**
+ @brief Get the current mode
+ @return The current mode
+ */
+CInputRecorder::MODE CInputRecorder::GetMode(void) const
+{
+	return eMode;
+}
+
+/**
+ @brief Check if the input is being recorded
+ @return true if the input is being recorded
+ */
+bool CInputRecorder::IsRecording(void) const
+{
+	return (eMode == RECORDING);
+}
+
+/**
+ @brief Check if a recording is being replayed
+ @return true if a recording is being replayed
+ */
+bool CInputRecorder::IsReplaying(void) const
+{
+	return (eMode == REPLAYING);
+}
+
+/**
+ @brief Get the random seed of the recording
+ @return The random seed
+ */
+unsigned int CInputRecorder::GetSeed(void) const
+{
+	return uiSeed;
+}
+
+/**
+ @brief Get the simulation tick rate of the recording
+ @return The tick rate
+ */
+unsigned int CInputRecorder::GetTickRate(void) const
+{
+	return uiTickRate;
+}
+
+/**
+ @brief Get the number of ticks recorded or replayed so far
+ @return The number of ticks
+ */
+unsigned int CInputRecorder::GetCurrentTick(void) const
+{
+	return uiCurrentTick;
+}
+
+/**
+ @brief Get the number of ticks in the loaded recording
+ @return The number of ticks
+ */
+unsigned int CInputRecorder::GetNumTicks(void) const
+{
+	return (unsigned int)vReplayFrames.size();
+}
+
+/**
+ @brief Copy the state of the controllers into a frame
+ @param frame The frame to copy to
+ */
+void CInputRecorder::CaptureFrame(InputFrame& frame) const
+{
+	CKeyboardController::GetInstance()->GetStatus(frame.currKeyStatus, frame.prevKeyStatus);
+
+	CMouseController* cMouseController = CMouseController::GetInstance();
+	cMouseController->GetButtonStatus(frame.currBtnStatus, frame.prevBtnStatus);
+	frame.dMousePosX = cMouseController->GetMousePositionX();
+	frame.dMousePosY = cMouseController->GetMousePositionY();
+	frame.dMouseDeltaX = cMouseController->GetMouseDeltaX();
+	frame.dMouseDeltaY = cMouseController->GetMouseDeltaY();
+	frame.dWheelOffsetX = cMouseController->GetMouseScrollStatus(CMouseController::SCROLL_TYPE_XOFFSET);
+	frame.dWheelOffsetY = cMouseController->GetMouseScrollStatus(CMouseController::SCROLL_TYPE_YOFFSET);
+}
+
+/**
+ @brief Copy a frame into the controllers
+ @param frame The frame to copy from
+ */
+void CInputRecorder::ApplyFrame(const InputFrame& frame) const
+{
+	CKeyboardController::GetInstance()->SetStatus(frame.currKeyStatus, frame.prevKeyStatus);
+
+	CMouseController* cMouseController = CMouseController::GetInstance();
+	cMouseController->SetButtonStatus(frame.currBtnStatus, frame.prevBtnStatus);
+	cMouseController->SetMousePosition(frame.dMousePosX, frame.dMousePosY, frame.dMouseDeltaX, frame.dMouseDeltaY);
+	cMouseController->SetMouseScroll(frame.dWheelOffsetX, frame.dWheelOffsetY);
+}
+
+/**
+ @brief Write one frame to a stream
+ @param stream The stream to write to
+ @param frame The frame to write
+ */
+void CInputRecorder::WriteFrame(std::ostream& stream, const InputFrame& frame) const
+{
+	WriteKeys(stream, frame.currKeyStatus);
+	WriteKeys(stream, frame.prevKeyStatus);
+	stream.put((char)frame.currBtnStatus);
+	stream.put((char)frame.prevBtnStatus);
+	WriteDouble(stream, frame.dMousePosX);
+	WriteDouble(stream, frame.dMousePosY);
+	WriteDouble(stream, frame.dMouseDeltaX);
+	WriteDouble(stream, frame.dMouseDeltaY);
+	WriteDouble(stream, frame.dWheelOffsetX);
+	WriteDouble(stream, frame.dWheelOffsetY);
+}
+
+/**
+ @brief Read one frame from a stream
+ @param stream The stream to read from
+ @param frame The frame to read into
+ @return true if a whole frame was read, otherwise false
+ */
+bool CInputRecorder::ReadFrame(std::istream& stream, InputFrame& frame) const
+{
+	ReadKeys(stream, frame.currKeyStatus);
+	ReadKeys(stream, frame.prevKeyStatus);
+	frame.currBtnStatus = (unsigned char)stream.get();
+	frame.prevBtnStatus = (unsigned char)stream.get();
+	frame.dMousePosX = ReadDouble(stream);
+	frame.dMousePosY = ReadDouble(stream);
+	frame.dMouseDeltaX = ReadDouble(stream);
+	frame.dMouseDeltaY = ReadDouble(stream);
+	frame.dWheelOffsetX = ReadDouble(stream);
+	frame.dWheelOffsetY = ReadDouble(stream);
+	if (!stream)
+		return false;
+
+	return true;
+}
@@ -0,0 +1,95 @@
+/**
+ CInputRecorder
+ @brief A class to record the state of the keyboard and mouse at every simulation tick to a file,
+		and to replay it back through the controllers. Together with a seeded CRandom and the
+		fixed tick rate, a replay runs exactly the same session as the recording.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include "KeyboardController.h"
+
+#include <bitset>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// The state of the input devices at one simulation tick
+struct InputFrame
+{
+	std::bitset<CKeyboardController::MAX_KEYS> currKeyStatus, prevKeyStatus;
+	unsigned char currBtnStatus, prevBtnStatus;
+	double dMousePosX, dMousePosY;
+	double dMouseDeltaX, dMouseDeltaY;
+	double dWheelOffsetX, dWheelOffsetY;
+};
+
+class CInputRecorder : public CSingletonTemplate<CInputRecorder>
+{
+	friend CSingletonTemplate<CInputRecorder>;
+
+public:
+	enum MODE
+	{
+		IDLE = 0,
+		RECORDING,
+		REPLAYING,
+		NUM_MODES
+	};
+
+	// Start writing the input of every tick to a file
+	bool StartRecording(const std::string& sFilename, const unsigned int uiSeed, const unsigned int uiTickRate);
+
+	// Load a recording and start replaying it
+	bool StartReplay(const std::string& sFilename);
+
+	// Stop recording or replaying
+	void Stop(void);
+
+	// Record or replay the input of one tick. Call this before the game states are updated
+	bool ProcessTick(void);
+
+	// Get the current mode
+	MODE GetMode(void) const;
+	bool IsRecording(void) const;
+	bool IsReplaying(void) const;
+
+	// Get the random seed and tick rate of the recording
+	unsigned int GetSeed(void) const;
+	unsigned int GetTickRate(void) const;
+
+	// Get the number of ticks recorded or replayed so far
+	unsigned int GetCurrentTick(void) const;
+	// Get the number of ticks in the loaded recording
+	unsigned int GetNumTicks(void) const;
+
+protected:
+	// The current mode
+	MODE eMode;
+	// The random seed and tick rate of the recording
+	unsigned int uiSeed;
+	unsigned int uiTickRate;
+	// The number of ticks recorded or replayed so far
+	unsigned int uiCurrentTick;
+	// The file being recorded to
+	std::ofstream recordFile;
+	// The frames of the recording being replayed. The whole file is loaded so that no disk access happens during a replay
+	std::vector<InputFrame> vReplayFrames;
+
+	// Constructor
+	CInputRecorder(void);
+
+	// Destructor
+	virtual ~CInputRecorder(void);
+
+	// Copy the state of the controllers into a frame
+	void CaptureFrame(InputFrame& frame) const;
+	// Copy a frame into the controllers
+	void ApplyFrame(const InputFrame& frame) const;
+
+	// Write or read one frame
+	void WriteFrame(std::ostream& stream, const InputFrame& frame) const;
+	bool ReadFrame(std::istream& stream, InputFrame& frame) const;
+};
@@ -104,3 +104,25 @@ void CKeyboardController::Reset(void)
 		prevStatus[key] = false;
 	}
 }
+
+/**
+ @brief Get the status of all keys
+ @param currStatus A bitset to copy the current key statuses to
+ @param prevStatus A bitset to copy the previous key statuses to
+ */
+void CKeyboardController::GetStatus(std::bitset<MAX_KEYS>& currStatus, std::bitset<MAX_KEYS>& prevStatus) const
+{
+	currStatus = this->currStatus;
+	prevStatus = this->prevStatus;
+}
+
+/**
+ @brief Set the status of all keys, replacing the statuses from the keyboard callbacks
+ @param currStatus A bitset containing the current key statuses
+ @param prevStatus A bitset containing the previous key statuses
+ */
+void CKeyboardController::SetStatus(const std::bitset<MAX_KEYS>& currStatus, const std::bitset<MAX_KEYS>& prevStatus)
+{
+	this->currStatus = currStatus;
+	this->prevStatus = prevStatus;
+}
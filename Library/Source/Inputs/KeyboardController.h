@@ -36,6 +36,10 @@ public:
 	// Reset all keys
 	void Reset(void);
 
+	// Get or set the status of all keys, used to record and replay the input
+	void GetStatus(std::bitset<MAX_KEYS>& currStatus, std::bitset<MAX_KEYS>& prevStatus) const;
+	void SetStatus(const std::bitset<MAX_KEYS>& currStatus, const std::bitset<MAX_KEYS>& prevStatus);
+
 protected:
 	// Constructor
 	CKeyboardController(void);
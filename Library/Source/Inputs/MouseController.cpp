@@ -197,4 +197,55 @@ double CMouseController::GetMouseDeltaX(void) const
 double CMouseController::GetMouseDeltaY(void) const
 {
 	return delta_posY;
-}
\ No newline at end of file
+}
+
+/**
+ @brief Get the current and previous statuses of the buttons
+ @param currBtnStatus An unsigned char to copy the current button statuses to
+ @param prevBtnStatus An unsigned char to copy the previous button statuses to
+ */
+void CMouseController::GetButtonStatus(unsigned char& currBtnStatus, unsigned char& prevBtnStatus) const
+{
+	currBtnStatus = this->currBtnStatus;
+	prevBtnStatus = this->prevBtnStatus;
+}
+
+/**
+ @brief Set the current and previous statuses of the buttons, replacing the statuses from the mouse callbacks
+ @param currBtnStatus An unsigned char containing the current button statuses
+ @param prevBtnStatus An unsigned char containing the previous button statuses
+ */
+void CMouseController::SetButtonStatus(const unsigned char currBtnStatus, const unsigned char prevBtnStatus)
+{
+	this->currBtnStatus = currBtnStatus;
+	this->prevBtnStatus = prevBtnStatus;
+}
+
+/**
+ @brief Set the mouse position and delta directly, replacing the values from the cursor
+ @param _x A const double variable containing the mouse position in the x-axis
+ @param _y A const double variable containing the mouse position in the y-axis
+ @param _deltaX A const double variable containing the mouse delta in the x-axis
+ @param _deltaY A const double variable containing the mouse delta in the y-axis
+ */
+void CMouseController::SetMousePosition(const double _x, const double _y, const double _deltaX, const double _deltaY)
+{
+	curr_posX = _x;
+	curr_posY = _y;
+	prev_posX = _x - _deltaX;
+	prev_posY = _y + _deltaY;
+	delta_posX = _deltaX;
+	delta_posY = _deltaY;
+	bFirstUpdate = false;
+}
+
+/**
+ @brief Set the mouse scroll status directly, replacing the values from the scroll callbacks
+ @param WheelOffset_X A const double variable which stores the amount of offset in the x-axis
+ @param WheelOffset_Y A const double variable which stores the amount of offset in the y-axis
+ */
+void CMouseController::SetMouseScroll(const double WheelOffset_X, const double WheelOffset_Y)
+{
+	this->WheelOffset_X = WheelOffset_X;
+	this->WheelOffset_Y = WheelOffset_Y;
+}
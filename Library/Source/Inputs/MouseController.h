@@ -45,6 +45,12 @@ public:
 	double GetMouseDeltaX(void) const;
 	double GetMouseDeltaY(void) const;
 
+	// Get or set the whole mouse state, used to record and replay the input
+	void GetButtonStatus(unsigned char& currBtnStatus, unsigned char& prevBtnStatus) const;
+	void SetButtonStatus(const unsigned char currBtnStatus, const unsigned char prevBtnStatus);
+	void SetMousePosition(const double _x, const double _y, const double _deltaX, const double _deltaY);
+	void SetMouseScroll(const double WheelOffset_X, const double WheelOffset_Y);
+
 	// Get or Set status of keeping the mouse centered
 	inline bool GetKeepMouseCentered() const { return bKeepMouseCentered; };
 	inline void SetKeepMouseCentered(bool _value){ bKeepMouseCentered = _value; };
@@ -0,0 +1,548 @@
+/**
+ CBroadphase
+ @brief A class which finds the boxes which may collide, without testing every pair of them.
+ */
+#include "Broadphase.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Check if 2 boxes overlap. Boxes which only touch are counted, as in CCollisionManager::BoxBoxCollision
+ */
+static inline bool BoxBoxOverlap(	const glm::vec2& aMin, const glm::vec2& aMax,
+									const glm::vec2& bMin, const glm::vec2& bMax)
+{
+	return	(aMin.x <= bMax.x && aMax.x >= bMin.x) &&
+			(aMin.y <= bMax.y && aMax.y >= bMin.y);
+}
+
+/**
+ @brief Clip a line segment to a box, with the slab test in the x-y plane
+ @param vec2Start The start of the line segment
+ @param vec2Direction The end of the line segment minus its start
+ @param vec2Min The bottom left corner of the box
+ @param vec2Max The top right corner of the box
+ @param tEnter Returns the fraction of the line segment where it enters the box
+ @param tExit Returns the fraction of the line segment where it leaves the box
+ @return true if the line segment passes through the box, otherwise false
+ */
+static bool SegmentBoxOverlap(	const glm::vec2& vec2Start, const glm::vec2& vec2Direction,
+								const glm::vec2& vec2Min, const glm::vec2& vec2Max,
+								float& tEnter, float& tExit)
+{
+	tEnter = 0.0f;
+	tExit = 1.0f;
+	for (int i = 0; i < 2; i++)
+	{
+		if (vec2Direction[i] == 0.0f)
+		{
+			// The line segment is parallel to this slab, so it has to start inside it
+			if ((vec2Start[i] < vec2Min[i]) || (vec2Start[i] > vec2Max[i]))
+				return false;
+			continue;
+		}
+
+		const float fInvDirection = 1.0f / vec2Direction[i];
+		float t1 = (vec2Min[i] - vec2Start[i]) * fInvDirection;
+		float t2 = (vec2Max[i] - vec2Start[i]) * fInvDirection;
+		if (t1 > t2)
+			std::swap(t1, t2);
+		tEnter = std::max(tEnter, t1);
+		tExit = std::min(tExit, t2);
+		if (tEnter > tExit)
+			return false;
+	}
+	return true;
+}
+
+/**
+ @brief Constructor
+ */
+CBroadphase::CBroadphase(void)
+	: uiNumProxies(0)
+	, vec2Origin(0.0f)
+	, vec2CellSize(1.0f)
+	, iNumCols(0)
+	, iNumRows(0)
+	, fMaxDynamicWidth(0.0f)
+	, uiQueryStamp(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CBroadphase::~CBroadphase(void)
+{
+}
+
+/**
+ @brief Set up the grid for the static boxes, and remove all the boxes.
+		A static box outside of the grid is kept in the nearest cells, so region queries still find it,
+		but ray queries only walk the cells which the line segment passes through inside the grid.
+ @param vec2Origin The bottom left corner of the grid
+ @param vec2CellSize The size of each cell, e.g. the size of a tile
+ @param iNumCols The number of columns in the grid
+ @param iNumRows The number of rows in the grid
+ */
+void CBroadphase::Init(const glm::vec2& vec2Origin, const glm::vec2& vec2CellSize, const int iNumCols, const int iNumRows)
+{
+	if ((vec2CellSize.x <= 0.0f) || (vec2CellSize.y <= 0.0f) || (iNumCols <= 0) || (iNumRows <= 0))
+	{
+		cout << "CBroadphase::Init - Invalid grid of " << iNumCols << "x" << iNumRows << " cells" << endl;
+		this->iNumCols = 1;
+		this->iNumRows = 1;
+	}
+	else
+	{
+		this->iNumCols = iNumCols;
+		this->iNumRows = iNumRows;
+	}
+	this->vec2Origin = vec2Origin;
+	this->vec2CellSize = glm::max(vec2CellSize, glm::vec2(1.0e-6f));
+
+	vProxies.clear();
+	vFreeProxies.clear();
+	uiNumProxies = 0;
+	vCells.clear();
+	vCells.resize(this->iNumCols * this->iNumRows);
+	vSweepList.clear();
+	fMaxDynamicWidth = 0.0f;
+	uiQueryStamp = 0;
+}
+
+/**
+ @brief Add a box, and get its index
+ @param vec2Min The bottom left corner of the box
+ @param vec2Max The top right corner of the box
+ @param bDynamic true if the box moves often, e.g. an entity, otherwise false, e.g. a tile
+ @param uiUserData The data to keep with the box, e.g. the index of its entity
+ @return The index of the box
+ */
+unsigned int CBroadphase::Insert(const glm::vec2& vec2Min, const glm::vec2& vec2Max, const bool bDynamic, const unsigned int uiUserData)
+{
+	unsigned int uiProxy;
+	if (vFreeProxies.empty() == false)
+	{
+		uiProxy = vFreeProxies.back();
+		vFreeProxies.pop_back();
+	}
+	else
+	{
+		uiProxy = static_cast<unsigned int>(vProxies.size());
+		vProxies.push_back(Proxy());
+	}
+
+	Proxy& proxy = vProxies[uiProxy];
+	proxy.vec2Min = vec2Min;
+	proxy.vec2Max = vec2Max;
+	proxy.uiUserData = uiUserData;
+	proxy.uiQueryStamp = uiQueryStamp;
+	proxy.bDynamic = bDynamic;
+	proxy.bInUse = true;
+	uiNumProxies++;
+
+	if (bDynamic)
+	{
+		vSweepList.push_back(uiProxy);
+		fMaxDynamicWidth = std::max(fMaxDynamicWidth, vec2Max.x - vec2Min.x);
+	}
+	else
+	{
+		AddToCells(uiProxy);
+	}
+
+	return uiProxy;
+}
+
+/**
+ @brief Move a box. A dynamic box only has its corners changed. A static box is moved to other cells if it has to be
+ @param uiProxy The index of the box
+ @param vec2Min The new bottom left corner of the box
+ @param vec2Max The new top right corner of the box
+ */
+void CBroadphase::Move(const unsigned int uiProxy, const glm::vec2& vec2Min, const glm::vec2& vec2Max)
+{
+	if ((uiProxy >= vProxies.size()) || (vProxies[uiProxy].bInUse == false))
+	{
+		cout << "CBroadphase::Move - Invalid proxy " << uiProxy << endl;
+		return;
+	}
+
+	Proxy& proxy = vProxies[uiProxy];
+	if (proxy.bDynamic)
+	{
+		proxy.vec2Min = vec2Min;
+		proxy.vec2Max = vec2Max;
+		fMaxDynamicWidth = std::max(fMaxDynamicWidth, vec2Max.x - vec2Min.x);
+		return;
+	}
+
+	// Only change the cells of a static box if it has moved to other cells
+	int iOldMinCol, iOldMinRow, iOldMaxCol, iOldMaxRow;
+	int iNewMinCol, iNewMinRow, iNewMaxCol, iNewMaxRow;
+	GetCellRange(proxy.vec2Min, proxy.vec2Max, iOldMinCol, iOldMinRow, iOldMaxCol, iOldMaxRow);
+	GetCellRange(vec2Min, vec2Max, iNewMinCol, iNewMinRow, iNewMaxCol, iNewMaxRow);
+	if ((iOldMinCol == iNewMinCol) && (iOldMinRow == iNewMinRow) && (iOldMaxCol == iNewMaxCol) && (iOldMaxRow == iNewMaxRow))
+	{
+		proxy.vec2Min = vec2Min;
+		proxy.vec2Max = vec2Max;
+		return;
+	}
+
+	RemoveFromCells(uiProxy);
+	proxy.vec2Min = vec2Min;
+	proxy.vec2Max = vec2Max;
+	AddToCells(uiProxy);
+}
+
+/**
+ @brief Remove a box. Its index may be given to a box which is added later
+ @param uiProxy The index of the box
+ */
+void CBroadphase::Remove(const unsigned int uiProxy)
+{
+	if ((uiProxy >= vProxies.size()) || (vProxies[uiProxy].bInUse == false))
+	{
+		cout << "CBroadphase::Remove - Invalid proxy " << uiProxy << endl;
+		return;
+	}
+
+	Proxy& proxy = vProxies[uiProxy];
+	if (proxy.bDynamic)
+		vSweepList.erase(std::find(vSweepList.begin(), vSweepList.end(), uiProxy));
+	else
+		RemoveFromCells(uiProxy);
+
+	proxy.bInUse = false;
+	vFreeProxies.push_back(uiProxy);
+	uiNumProxies--;
+}
+
+/**
+ @brief Find the pairs of overlapping boxes in which at least one box is dynamic.
+		The dynamic boxes are tested against each other by sweep and prune, and against the static boxes
+		in the cells which they overlap. 2 static boxes are never reported, as they cannot collide.
+ @param vPairs Returns the pairs. When a pair has a static box, it is uiProxyB
+ */
+void CBroadphase::FindOverlappingPairs(std::vector<BroadphasePair>& vPairs)
+{
+	vPairs.clear();
+
+	SortSweepList();
+
+	const size_t uiNumDynamic = vSweepList.size();
+	for (size_t i = 0; i < uiNumDynamic; i++)
+	{
+		const unsigned int uiProxyA = vSweepList[i];
+		const Proxy& proxyA = vProxies[uiProxyA];
+
+		// Test the dynamic boxes which start before this box ends
+		for (size_t j = i + 1; j < uiNumDynamic; j++)
+		{
+			const unsigned int uiProxyB = vSweepList[j];
+			const Proxy& proxyB = vProxies[uiProxyB];
+			if (proxyB.vec2Min.x > proxyA.vec2Max.x)
+				break;
+			if ((proxyA.vec2Min.y <= proxyB.vec2Max.y) && (proxyA.vec2Max.y >= proxyB.vec2Min.y))
+			{
+				BroadphasePair pair = { uiProxyA, uiProxyB };
+				vPairs.push_back(pair);
+			}
+		}
+
+		// Test the static boxes in the cells which this box overlaps
+		NextQueryStamp();
+		int iMinCol, iMinRow, iMaxCol, iMaxRow;
+		GetCellRange(proxyA.vec2Min, proxyA.vec2Max, iMinCol, iMinRow, iMaxCol, iMaxRow);
+		for (int iRow = iMinRow; iRow <= iMaxRow; iRow++)
+		{
+			for (int iCol = iMinCol; iCol <= iMaxCol; iCol++)
+			{
+				const std::vector<unsigned int>& vCell = vCells[iRow * iNumCols + iCol];
+				for (size_t k = 0; k < vCell.size(); k++)
+				{
+					Proxy& proxyB = vProxies[vCell[k]];
+					if (proxyB.uiQueryStamp == uiQueryStamp)
+						continue;
+					proxyB.uiQueryStamp = uiQueryStamp;
+					if (BoxBoxOverlap(proxyA.vec2Min, proxyA.vec2Max, proxyB.vec2Min, proxyB.vec2Max))
+					{
+						BroadphasePair pair = { uiProxyA, vCell[k] };
+						vPairs.push_back(pair);
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ @brief Find the boxes which overlap a region
+ @param vec2Min The bottom left corner of the region
+ @param vec2Max The top right corner of the region
+ @param vResults Returns the indices of the boxes
+ */
+void CBroadphase::QueryRegion(const glm::vec2& vec2Min, const glm::vec2& vec2Max, std::vector<unsigned int>& vResults)
+{
+	vResults.clear();
+
+	// Find the static boxes
+	NextQueryStamp();
+	int iMinCol, iMinRow, iMaxCol, iMaxRow;
+	GetCellRange(vec2Min, vec2Max, iMinCol, iMinRow, iMaxCol, iMaxRow);
+	for (int iRow = iMinRow; iRow <= iMaxRow; iRow++)
+	{
+		for (int iCol = iMinCol; iCol <= iMaxCol; iCol++)
+			QueryCell(iCol, iRow, vec2Min, vec2Max, vResults);
+	}
+
+	// Find the dynamic boxes, starting from the first one which may be wide enough to reach the region
+	SortSweepList();
+	const float fStartX = vec2Min.x - fMaxDynamicWidth;
+	std::vector<unsigned int>::const_iterator it = std::lower_bound(vSweepList.begin(), vSweepList.end(), fStartX,
+		[this](const unsigned int uiProxy, const float fX) { return vProxies[uiProxy].vec2Min.x < fX; });
+	for (; it != vSweepList.end(); ++it)
+	{
+		const Proxy& proxy = vProxies[*it];
+		if (proxy.vec2Min.x > vec2Max.x)
+			break;
+		if (BoxBoxOverlap(vec2Min, vec2Max, proxy.vec2Min, proxy.vec2Max))
+			vResults.push_back(*it);
+	}
+}
+
+/**
+ @brief Find the boxes which a line segment passes through, e.g. for a line of sight.
+		The cells which the line segment passes through are walked in order, like a tile map raycast.
+ @param vec2Start The start of the line segment
+ @param vec2End The end of the line segment
+ @param vResults Returns the indices of the boxes
+ */
+void CBroadphase::QueryRay(const glm::vec2& vec2Start, const glm::vec2& vec2End, std::vector<unsigned int>& vResults)
+{
+	vResults.clear();
+
+	const glm::vec2 vec2Direction = vec2End - vec2Start;
+	float tEnter, tExit;
+
+	// Find the static boxes in the cells which the line segment passes through inside the grid
+	NextQueryStamp();
+	const glm::vec2 vec2GridMax = vec2Origin + vec2CellSize * glm::vec2(static_cast<float>(iNumCols), static_cast<float>(iNumRows));
+	if ((vCells.empty() == false) && SegmentBoxOverlap(vec2Start, vec2Direction, vec2Origin, vec2GridMax, tEnter, tExit))
+	{
+		const glm::vec2 vec2Enter = vec2Start + vec2Direction * tEnter;
+		const glm::vec2 vec2Exit = vec2Start + vec2Direction * tExit;
+		int iCol, iRow, iEndCol, iEndRow;
+		GetCellRange(vec2Enter, vec2Enter, iCol, iRow, iCol, iRow);
+		GetCellRange(vec2Exit, vec2Exit, iEndCol, iEndRow, iEndCol, iEndRow);
+
+		// Work out the fraction of the line segment to the next column and row, and the fraction to cross a cell
+		const int iStepCol = (vec2Direction.x > 0.0f) ? 1 : -1;
+		const int iStepRow = (vec2Direction.y > 0.0f) ? 1 : -1;
+		float tNextCol = FLT_MAX, tNextRow = FLT_MAX;
+		float tDeltaCol = FLT_MAX, tDeltaRow = FLT_MAX;
+		if (vec2Direction.x != 0.0f)
+		{
+			const float fEdgeX = vec2Origin.x + vec2CellSize.x * (iCol + (iStepCol > 0 ? 1 : 0));
+			tNextCol = (fEdgeX - vec2Start.x) / vec2Direction.x;
+			tDeltaCol = vec2CellSize.x / fabs(vec2Direction.x);
+		}
+		if (vec2Direction.y != 0.0f)
+		{
+			const float fEdgeY = vec2Origin.y + vec2CellSize.y * (iRow + (iStepRow > 0 ? 1 : 0));
+			tNextRow = (fEdgeY - vec2Start.y) / vec2Direction.y;
+			tDeltaRow = vec2CellSize.y / fabs(vec2Direction.y);
+		}
+
+		// Walk the cells, but never more than the line segment can cross
+		int iNumSteps = abs(iEndCol - iCol) + abs(iEndRow - iRow);
+		while (true)
+		{
+			const std::vector<unsigned int>& vCell = vCells[iRow * iNumCols + iCol];
+			for (size_t k = 0; k < vCell.size(); k++)
+			{
+				Proxy& proxy = vProxies[vCell[k]];
+				if (proxy.uiQueryStamp == uiQueryStamp)
+					continue;
+				proxy.uiQueryStamp = uiQueryStamp;
+				if (SegmentBoxOverlap(vec2Start, vec2Direction, proxy.vec2Min, proxy.vec2Max, tEnter, tExit))
+					vResults.push_back(vCell[k]);
+			}
+
+			if ((iNumSteps-- <= 0) || ((iCol == iEndCol) && (iRow == iEndRow)))
+				break;
+			if (tNextCol < tNextRow)
+			{
+				iCol += iStepCol;
+				tNextCol += tDeltaCol;
+			}
+			else
+			{
+				iRow += iStepRow;
+				tNextRow += tDeltaRow;
+			}
+			if ((iCol < 0) || (iCol >= iNumCols) || (iRow < 0) || (iRow >= iNumRows))
+				break;
+		}
+	}
+
+	// Find the dynamic boxes which overlap the bounding box of the line segment
+	SortSweepList();
+	const glm::vec2 vec2Min = glm::min(vec2Start, vec2End);
+	const glm::vec2 vec2Max = glm::max(vec2Start, vec2End);
+	const float fStartX = vec2Min.x - fMaxDynamicWidth;
+	std::vector<unsigned int>::const_iterator it = std::lower_bound(vSweepList.begin(), vSweepList.end(), fStartX,
+		[this](const unsigned int uiProxy, const float fX) { return vProxies[uiProxy].vec2Min.x < fX; });
+	for (; it != vSweepList.end(); ++it)
+	{
+		const Proxy& proxy = vProxies[*it];
+		if (proxy.vec2Min.x > vec2Max.x)
+			break;
+		if (SegmentBoxOverlap(vec2Start, vec2Direction, proxy.vec2Min, proxy.vec2Max, tEnter, tExit))
+			vResults.push_back(*it);
+	}
+}
+
+/**
+ @brief Get the user data of a box, e.g. the index of its entity
+ @param uiProxy The index of the box
+ */
+unsigned int CBroadphase::GetUserData(const unsigned int uiProxy) const
+{
+	if (uiProxy >= vProxies.size())
+		return 0;
+	return vProxies[uiProxy].uiUserData;
+}
+
+/**
+ @brief Get the number of boxes
+ */
+unsigned int CBroadphase::GetNumProxies(void) const
+{
+	return uiNumProxies;
+}
+
+/**
+ @brief Get the cells which a box overlaps. The box is clamped to the grid
+ @param vec2Min The bottom left corner of the box
+ @param vec2Max The top right corner of the box
+ @param iMinCol Returns the first column
+ @param iMinRow Returns the first row
+ @param iMaxCol Returns the last column
+ @param iMaxRow Returns the last row
+ */
+void CBroadphase::GetCellRange(	const glm::vec2& vec2Min, const glm::vec2& vec2Max,
+								int& iMinCol, int& iMinRow, int& iMaxCol, int& iMaxRow) const
+{
+	const glm::vec2 vec2CellMin = glm::floor((vec2Min - vec2Origin) / vec2CellSize);
+	const glm::vec2 vec2CellMax = glm::floor((vec2Max - vec2Origin) / vec2CellSize);
+	// Clamp as floats first, so a box far from the grid does not overflow the int
+	iMinCol = static_cast<int>(glm::clamp(vec2CellMin.x, 0.0f, static_cast<float>(iNumCols - 1)));
+	iMinRow = static_cast<int>(glm::clamp(vec2CellMin.y, 0.0f, static_cast<float>(iNumRows - 1)));
+	iMaxCol = static_cast<int>(glm::clamp(vec2CellMax.x, 0.0f, static_cast<float>(iNumCols - 1)));
+	iMaxRow = static_cast<int>(glm::clamp(vec2CellMax.y, 0.0f, static_cast<float>(iNumRows - 1)));
+}
+
+/**
+ @brief Add a static box to the cells which it overlaps
+ @param uiProxy The index of the box
+ */
+void CBroadphase::AddToCells(const unsigned int uiProxy)
+{
+	const Proxy& proxy = vProxies[uiProxy];
+	int iMinCol, iMinRow, iMaxCol, iMaxRow;
+	GetCellRange(proxy.vec2Min, proxy.vec2Max, iMinCol, iMinRow, iMaxCol, iMaxRow);
+	for (int iRow = iMinRow; iRow <= iMaxRow; iRow++)
+	{
+		for (int iCol = iMinCol; iCol <= iMaxCol; iCol++)
+			vCells[iRow * iNumCols + iCol].push_back(uiProxy);
+	}
+}
+
+/**
+ @brief Remove a static box from the cells which it overlaps. The order of the boxes in a cell does not matter,
+		so the box is swapped with the last one in the cell
+ @param uiProxy The index of the box
+ */
+void CBroadphase::RemoveFromCells(const unsigned int uiProxy)
+{
+	const Proxy& proxy = vProxies[uiProxy];
+	int iMinCol, iMinRow, iMaxCol, iMaxRow;
+	GetCellRange(proxy.vec2Min, proxy.vec2Max, iMinCol, iMinRow, iMaxCol, iMaxRow);
+	for (int iRow = iMinRow; iRow <= iMaxRow; iRow++)
+	{
+		for (int iCol = iMinCol; iCol <= iMaxCol; iCol++)
+		{
+			std::vector<unsigned int>& vCell = vCells[iRow * iNumCols + iCol];
+			std::vector<unsigned int>::iterator it = std::find(vCell.begin(), vCell.end(), uiProxy);
+			if (it != vCell.end())
+			{
+				*it = vCell.back();
+				vCell.pop_back();
+			}
+		}
+	}
+}
+
+/**
+ @brief Sort the dynamic boxes by their left edges. The boxes move a little in each tick, so the list is
+		nearly sorted, and an insertion sort takes close to linear time
+ */
+void CBroadphase::SortSweepList(void)
+{
+	for (size_t i = 1; i < vSweepList.size(); i++)
+	{
+		const unsigned int uiProxy = vSweepList[i];
+		const float fMinX = vProxies[uiProxy].vec2Min.x;
+		size_t j = i;
+		while ((j > 0) && (vProxies[vSweepList[j - 1]].vec2Min.x > fMinX))
+		{
+			vSweepList[j] = vSweepList[j - 1];
+			j--;
+		}
+		vSweepList[j] = uiProxy;
+	}
+}
+
+/**
+ @brief Start a new query, so that no box is marked as found by it
+ */
+void CBroadphase::NextQueryStamp(void)
+{
+	uiQueryStamp++;
+	if (uiQueryStamp == 0)
+	{
+		// The stamp has wrapped around, so clear the old stamps
+		for (size_t i = 0; i < vProxies.size(); i++)
+			vProxies[i].uiQueryStamp = 0;
+		uiQueryStamp = 1;
+	}
+}
+
+/**
+ @brief Add the static boxes in a cell which overlap a box, and were not found by this query yet
+ @param iCol The column of the cell
+ @param iRow The row of the cell
+ @param vec2Min The bottom left corner of the box
+ @param vec2Max The top right corner of the box
+ @param vResults The indices of the boxes which were found
+ */
+void CBroadphase::QueryCell(const int iCol, const int iRow, const glm::vec2& vec2Min, const glm::vec2& vec2Max, std::vector<unsigned int>& vResults)
+{
+	const std::vector<unsigned int>& vCell = vCells[iRow * iNumCols + iCol];
+	for (size_t k = 0; k < vCell.size(); k++)
+	{
+		Proxy& proxy = vProxies[vCell[k]];
+		if (proxy.uiQueryStamp == uiQueryStamp)
+			continue;
+		proxy.uiQueryStamp = uiQueryStamp;
+		if (BoxBoxOverlap(vec2Min, vec2Max, proxy.vec2Min, proxy.vec2Max))
+			vResults.push_back(vCell[k]);
+	}
+}
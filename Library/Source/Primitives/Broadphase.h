@@ -0,0 +1,103 @@
+/**
+ CBroadphase
+ @brief A class which finds the boxes which may collide, without testing every pair of them.
+		Static boxes, e.g. tiles and items, are kept in a uniform grid, which is usually aligned to the
+		tiles of the map. Dynamic boxes, e.g. the player and the enemies, are kept in a list sorted by
+		their left edges (sweep and prune), which hardly changes from one tick to the next, so it is
+		sorted again in near linear time. The boxes are in the x-y plane.
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <vector>
+
+// A pair of boxes which overlap
+struct BroadphasePair
+{
+	unsigned int uiProxyA;
+	unsigned int uiProxyB;
+};
+
+class CBroadphase
+{
+public:
+	// The index of a box which does not exist
+	static const unsigned int INVALID_PROXY = 0xFFFFFFFF;
+
+	// Constructor
+	CBroadphase(void);
+
+	// Destructor
+	virtual ~CBroadphase(void);
+
+	// Set up the grid for the static boxes, and remove all the boxes
+	void Init(const glm::vec2& vec2Origin, const glm::vec2& vec2CellSize, const int iNumCols, const int iNumRows);
+
+	// Add a box, and get its index
+	unsigned int Insert(const glm::vec2& vec2Min, const glm::vec2& vec2Max, const bool bDynamic, const unsigned int uiUserData = 0);
+	// Move a box
+	void Move(const unsigned int uiProxy, const glm::vec2& vec2Min, const glm::vec2& vec2Max);
+	// Remove a box. Its index may be given to a box which is added later
+	void Remove(const unsigned int uiProxy);
+
+	// Find the pairs of overlapping boxes in which at least one box is dynamic
+	void FindOverlappingPairs(std::vector<BroadphasePair>& vPairs);
+	// Find the boxes which overlap a region
+	void QueryRegion(const glm::vec2& vec2Min, const glm::vec2& vec2Max, std::vector<unsigned int>& vResults);
+	// Find the boxes which a line segment passes through
+	void QueryRay(const glm::vec2& vec2Start, const glm::vec2& vec2End, std::vector<unsigned int>& vResults);
+
+	// Get the user data of a box, e.g. the index of its entity
+	unsigned int GetUserData(const unsigned int uiProxy) const;
+	// Get the number of boxes
+	unsigned int GetNumProxies(void) const;
+
+protected:
+	// A box
+	struct Proxy
+	{
+		glm::vec2 vec2Min;
+		glm::vec2 vec2Max;
+		unsigned int uiUserData;
+		// The last query which found this box, so a box in several cells is only found once
+		unsigned int uiQueryStamp;
+		bool bDynamic;
+		bool bInUse;
+	};
+
+	// The boxes, by their indices
+	std::vector<Proxy> vProxies;
+	// The indices of the removed boxes, to be used again
+	std::vector<unsigned int> vFreeProxies;
+	// The number of boxes
+	unsigned int uiNumProxies;
+
+	// The grid of the static boxes. Each cell has the indices of the boxes which overlap it
+	glm::vec2 vec2Origin;
+	glm::vec2 vec2CellSize;
+	int iNumCols;
+	int iNumRows;
+	std::vector<std::vector<unsigned int>> vCells;
+
+	// The indices of the dynamic boxes, sorted by their left edges before each query
+	std::vector<unsigned int> vSweepList;
+	// The widest dynamic box, so that a query knows how far to the left a box may start and still reach it
+	float fMaxDynamicWidth;
+
+	// The number of the current query
+	unsigned int uiQueryStamp;
+
+	// Get the cells which a box overlaps. The box is clamped to the grid
+	void GetCellRange(const glm::vec2& vec2Min, const glm::vec2& vec2Max, int& iMinCol, int& iMinRow, int& iMaxCol, int& iMaxRow) const;
+	// Add a static box to the cells which it overlaps, or remove it from them
+	void AddToCells(const unsigned int uiProxy);
+	void RemoveFromCells(const unsigned int uiProxy);
+	// Sort the dynamic boxes by their left edges
+	void SortSweepList(void);
+	// Start a new query, so that no box is marked as found by it
+	void NextQueryStamp(void);
+	// Add the static boxes in a cell which overlap a box, and were not found by this query yet
+	void QueryCell(const int iCol, const int iRow, const glm::vec2& vec2Min, const glm::vec2& vec2Max, std::vector<unsigned int>& vResults);
+};
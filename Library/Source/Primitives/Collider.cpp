@@ -1,7 +1,12 @@
 #include "Collider.h"
 
+// Include CMemoryTracker to count the OpenGL objects
+#include "..\System\MemoryTracker.h"
+
 // Include Shader Manager
 #include "..\RenderControl\ShaderManager.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "..\RenderControl\GLStateCache.h"
 
 #include <GLFW/glfw3.h>
 
@@ -86,11 +91,13 @@ bool CCollider::InitCollider(	const std::string& _name,
 	};
 
 	glGenVertexArrays(1, &colliderVAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
 	glGenBuffers(1, &colliderVBO);
+	MEMORY_TRACK_GL(BUFFER_OBJECT, 1);
 
-	glBindVertexArray(colliderVAO);
+	CGLStateCache::GetInstance()->BindVertexArray(colliderVAO);
 
-	glBindBuffer(GL_ARRAY_BUFFER, colliderVBO);
+	CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, colliderVBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
 	// position attribute
@@ -120,8 +127,8 @@ void CCollider::SetColliderShader(const std::string& _name)
 void CCollider::PreRender(void)
 {
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CGLStateCache::GetInstance()->SetBlend(true);
+	CGLStateCache::GetInstance()->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Use the shader defined for this class
 	CShaderManager::GetInstance()->Use(sColliderShaderName);
@@ -140,9 +147,8 @@ void CCollider::Render(void)
 	CShaderManager::GetInstance()->activeShader->setMat4("projection", colliderProjection);
 
 	// render box
-	glBindVertexArray(colliderVAO);
+	CGLStateCache::GetInstance()->BindVertexArray(colliderVAO);
 	glDrawArrays(GL_LINE_LOOP, 0, 36);
-	glBindVertexArray(0);
 }
 
 /**
@@ -151,5 +157,5 @@ void CCollider::Render(void)
 void CCollider::PostRender(void)
 {
 	// Deactivate blending mode
-	glDisable(GL_BLEND);
+	CGLStateCache::GetInstance()->SetBlend(false);
 }
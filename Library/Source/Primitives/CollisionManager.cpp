@@ -223,3 +223,63 @@ bool CCollisionManager::RayBoxCollision(const glm::vec3 boxMin,
 
     return false;
 }
+
+/**
+ @brief Ray-Oriented Box Collision Test in the x-y plane, using the slab method on the box's own axes.
+        The z-axis is not tested, as the boxes are tiles in a 2D map.
+ @param rayOrigin The origin of the ray in world space
+ @param rayDirection The direction of the ray in world space
+ @param boxMin The untransformed minimum corner of the box
+ @param boxMax The untransformed maximum corner of the box
+ @param modelMatrix The translation and rotation which is applied to the box
+ @param t The distance along the ray to the nearest intersection
+ @return true if the ray intersects the box, otherwise false
+ */
+bool CCollisionManager::RayOBBCollision(const glm::vec3& rayOrigin,
+                                        const glm::vec3& rayDirection,
+                                        const glm::vec3& boxMin,
+                                        const glm::vec3& boxMax,
+                                        const glm::mat4& modelMatrix,
+                                        float& t)
+{
+    float tMin = 0.0f;
+    float tMax = 100000.0f;
+
+    glm::vec3 boxPosition(modelMatrix[3][0], modelMatrix[3][1], modelMatrix[3][2]);
+    glm::vec3 delta = boxPosition - rayOrigin;
+
+    // Test the intersection with the 2 planes perpendicular to each of the box's x and y axes
+    for (int iAxis = 0; iAxis < 2; iAxis++)
+    {
+        glm::vec3 axis(modelMatrix[iAxis][0], modelMatrix[iAxis][1], modelMatrix[iAxis][2]);
+        float e = glm::dot(axis, delta);
+        float f = glm::dot(rayDirection, axis);
+
+        if (fabs(f) > 0.001f)
+        {
+            // The distances from the ray origin to the near and far planes
+            float t1 = (e + boxMin[iAxis]) / f;
+            float t2 = (e + boxMax[iAxis]) / f;
+            if (t1 > t2) swap(t1, t2);
+
+            // tMax is the nearest far intersection and tMin is the farthest near intersection
+            if (t2 < tMax)
+                tMax = t2;
+            if (t1 > tMin)
+                tMin = t1;
+
+            // If the far intersection is closer than the near intersection, then there is no intersection
+            if (tMax < tMin)
+                return false;
+        }
+        else
+        {
+            // The ray is almost parallel to the planes, so it only hits the box if it starts between them
+            if (-e + boxMin[iAxis] > 0.0f || -e + boxMax[iAxis] < 0.0f)
+                return false;
+        }
+    }
+
+    t = tMin;
+    return true;
+}
@@ -40,4 +40,11 @@ class CCollisionManager
 										const glm::vec3 boxMax,
 										const glm::vec3 rayStart,
 										const glm::vec3 rayEnd);
+		// Ray-Oriented Box Collision Test in the x-y plane
+		static bool RayOBBCollision(	const glm::vec3& rayOrigin,
+										const glm::vec3& rayDirection,
+										const glm::vec3& boxMin,
+										const glm::vec3& boxMax,
+										const glm::mat4& modelMatrix,
+										float& t);
 };
@@ -4,14 +4,22 @@
  Date: Mar 2020
  */
 #include "Entity2D.h"
+
+// Include CMemoryTracker to count the OpenGL objects
+#include "..\System\MemoryTracker.h"
 #include "MeshBuilder.h"
 
  // Include Shader Manager
 #include "..\RenderControl\ShaderManager.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "..\RenderControl\GLStateCache.h"
 
 // Include ImageLoader
 #include "..\System\ImageLoader.h"
 
+// Include CFixedTimeStep to interpolate between simulation ticks
+#include "..\TimeControl\FixedTimeStep.h"
+
 #include <iostream>
 using namespace std;
 
@@ -25,6 +33,7 @@ CEntity2D::CEntity2D(void)
 	, iTextureID(0)
 	, cSettings(NULL)
 	, mesh(NULL)
+	, iShaderHandle(-1)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
@@ -36,6 +45,7 @@ CEntity2D::CEntity2D(void)
 
 	// Initialise vec2UVCoordinate
 	vec2UVCoordinate = glm::vec2(0.0f);
+	vec2PrevUVCoordinate = glm::vec2(0.0f);
 }
 
 /**
@@ -76,17 +86,18 @@ bool CEntity2D::Init(void)
 	};*/
 
 	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
 	//glGenBuffers(1, &VBO);
 	//glGenBuffers(1, &EBO);
 
 	//Draw a quad for a default entity2D
 	mesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), 1.0f);
 	/*
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, VBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	CGLStateCache::GetInstance()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
 
 	// position attribute
@@ -116,6 +127,7 @@ bool CEntity2D::Init(void)
  void CEntity2D::SetShader(const std::string& _name)
  {
 	 this->sShaderName = _name;
+	 this->iShaderHandle = CShaderManager::GetInstance()->GetHandle(_name);
  }
 
 /**
@@ -125,20 +137,42 @@ void CEntity2D::Update(const double dElapsedTime)
 {
 }
 
+/**
+ @brief Store the current UV coordinates as the previous state, before a simulation tick
+ */
+void CEntity2D::StorePreviousState(void)
+{
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+}
+
+/**
+ @brief Get the UV coordinates interpolated between the previous and current simulation tick.
+		Jumps of more than a tile (spawning, respawning, changing levels) are not interpolated.
+ @return A glm::vec2 containing the UV coordinates to render the Entity2D at
+ */
+glm::vec2 CEntity2D::GetInterpolatedUVCoordinate(void) const
+{
+	glm::vec2 vec2Delta = vec2UVCoordinate - vec2PrevUVCoordinate;
+	if ((fabs(vec2Delta.x) > CSettings::GetInstance()->TILE_WIDTH) ||
+		(fabs(vec2Delta.y) > CSettings::GetInstance()->TILE_HEIGHT))
+		return vec2UVCoordinate;
+
+	return vec2PrevUVCoordinate + vec2Delta * CFixedTimeStep::GetInstance()->GetAlpha();
+}
+
 /**
  @brief Set up the OpenGL display environment before rendering
  */
 void CEntity2D::PreRender(void)
 {
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CGLStateCache::GetInstance()->SetBlend(true);
+	CGLStateCache::GetInstance()->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
-	CShaderManager::GetInstance()->Use("Shader2D");
+	if (iShaderHandle < 0)
+		SetShader("Shader2D");
+	CShaderManager::GetInstance()->Use(iShaderHandle);
 }
 
 /**
@@ -147,8 +181,7 @@ void CEntity2D::PreRender(void)
 void CEntity2D::Render(void)
 {
 	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	GLint transformLoc = CShaderManager::GetInstance()->activeShader->getUniformLocation("transform");
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
@@ -158,22 +191,16 @@ void CEntity2D::Render(void)
 	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
 
 	// Get the texture to be rendered
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-		glBindVertexArray(VAO);
-
-		//CS: Use mesh to render
-		mesh->Render();
+	CGLStateCache::GetInstance()->BindTexture(0, iTextureID);
 
-		glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	//CS: Use mesh to render. It binds its own vertex array
+	mesh->Render();
 }
 
 /**
  @brief PostRender Set up the OpenGL display environment after rendering.
+		Blending is left on, as the next 2D entity enables it again
  */
 void CEntity2D::PostRender(void)
 {
-	// Disable blending
-	glDisable(GL_BLEND);
 }
@@ -61,9 +61,20 @@ public:
 	// The vec2 variable which stores the UV coordinates to render the Entity2D
 	glm::vec2 vec2UVCoordinate;
 
+	// The vec2 variable which stores the UV coordinates of the Entity2D at the previous simulation tick
+	glm::vec2 vec2PrevUVCoordinate;
+
+	// Store the current UV coordinates as the previous state, before a simulation tick
+	void StorePreviousState(void);
+
+	// Get the UV coordinates interpolated between the previous and current simulation tick
+	glm::vec2 GetInterpolatedUVCoordinate(void) const;
+
 protected:
 	// Name of Shader Program instance
 	std::string sShaderName;
+	// Handle of Shader Program instance, so that it is used without looking up its name
+	int iShaderHandle;
 
 	//CS: The mesh that is used to draw objects
 	CMesh* mesh;
@@ -5,6 +5,11 @@
  */
 #include "Entity3D.h"
 
+// Include CMemoryTracker to count the OpenGL objects
+#include "..\System\MemoryTracker.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "..\RenderControl\GLStateCache.h"
+
 // Include ImageLoader
 #include "..\System\ImageLoader.h"
 
@@ -56,17 +61,20 @@ CEntity3D::~CEntity3D(void)
 	// Delete the rendering objects in the graphics card
 	if (VAO != 0)
 	{
-		glDeleteVertexArrays(1, &VAO);
+		CGLStateCache::GetInstance()->DeleteVertexArrays(1, &VAO);
+		MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, -1);
 		VAO = 0;
 	}
 	if (VBO != 0)
 	{
-		glDeleteBuffers(1, &VBO);
+		CGLStateCache::GetInstance()->DeleteBuffers(1, &VBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
 		VBO = 0;
 	}
 	if (IBO != 0)
 	{
-		glDeleteBuffers(1, &IBO);
+		CGLStateCache::GetInstance()->DeleteBuffers(1, &IBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
 		IBO = 0;
 	}
 }
@@ -1,11 +1,18 @@
 #include "Mesh.h"
 
+// Include CMemoryTracker to count the OpenGL objects
+#include "..\System\MemoryTracker.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "..\RenderControl\GLStateCache.h"
+
 // Include GLEW
 #ifndef GLEW_STATIC
 #include <GL/glew.h>
 #define GLEW_STATIC
 #endif
 
+#include <cstddef>
+
 /**
  @brief Constructor
  */
@@ -13,7 +20,9 @@ CMesh::CMesh(void)
 	: mode(DRAW_TRIANGLES)
 {
 	glGenBuffers(1, &vertexBuffer);
+	MEMORY_TRACK_GL(BUFFER_OBJECT, 1);
 	glGenBuffers(1, &indexBuffer);
+	MEMORY_TRACK_GL(BUFFER_OBJECT, 1);
 }
 
 /**
@@ -21,8 +30,10 @@ CMesh::CMesh(void)
  */
 CMesh::~CMesh(void)
 {
-	glDeleteBuffers(1, &vertexBuffer);
-	glDeleteBuffers(1, &indexBuffer);
+	CGLStateCache::GetInstance()->DeleteBuffers(1, &vertexBuffer);
+	MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
+	CGLStateCache::GetInstance()->DeleteBuffers(1, &indexBuffer);
+	MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
 }
 
 unsigned CMesh::locationKa;
@@ -49,16 +60,16 @@ void CMesh::Render(void)
 	glEnableVertexAttribArray(2);
 	glEnableVertexAttribArray(3);
 
-	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3) + sizeof(glm::vec4)));
-	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3) + sizeof(glm::vec4) + sizeof(glm::vec3)));
+	CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
 	//glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
 	//glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
 	//glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3) + sizeof(glm::vec4)));
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	CGLStateCache::GetInstance()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
 
 	// No material, do default rendering
 	if (materials.size() == 0)
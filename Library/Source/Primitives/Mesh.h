@@ -65,7 +65,7 @@ public:
 	// Constructor
 	CMesh(void);
 	// Destructor
-	~CMesh(void);
+	virtual ~CMesh(void);
 	virtual void Render();
 };
 
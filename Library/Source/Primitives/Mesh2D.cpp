@@ -0,0 +1,87 @@
+#include "Mesh2D.h"
+
+// Include CMemoryTracker to count the OpenGL objects
+#include "..\System\MemoryTracker.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "..\RenderControl\GLStateCache.h"
+
+#include <cstddef>
+
+static_assert(sizeof(Vertex2D) == 16, "Vertex2D should be packed into 16 bytes");
+
+/**
+ @brief Constructor
+ */
+CMesh2D::CMesh2D(void)
+	: CMesh()
+	, VAO(0)
+{
+	glGenVertexArrays(1, &VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+}
+
+/**
+ @brief Destructor
+ */
+CMesh2D::~CMesh2D(void)
+{
+	CGLStateCache::GetInstance()->DeleteVertexArrays(1, &VAO);
+	MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, -1);
+}
+
+/**
+ @brief Upload the vertices and indices, and set up the vertex layout in the vertex array object.
+		The attribute locations are the same as the 2D shaders: 0 for position, 1 for colour and 3 for texture coordinates
+ @param vertices The vertices of the mesh
+ @param indices The indices of the triangles
+ */
+void CMesh2D::Upload(const std::vector<Vertex2D>& vertices, const std::vector<unsigned>& indices)
+{
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
+
+	CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex2D), &vertices[0], GL_STATIC_DRAW);
+	CGLStateCache::GetInstance()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex2D), (void*)offsetof(Vertex2D, position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex2D), (void*)offsetof(Vertex2D, color));
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(Vertex2D), (void*)offsetof(Vertex2D, texCoord));
+
+	indexSize = (unsigned)indices.size();
+}
+
+/**
+ @brief Render this mesh
+ */
+void CMesh2D::Render(void)
+{
+	DrawElements(indexSize, 0);
+}
+
+/**
+ @brief Draw a range of the indices with the vertex array of this mesh
+ @param count The number of indices
+ @param offset The first index
+ */
+void CMesh2D::DrawElements(const unsigned count, const unsigned offset)
+{
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
+
+	if (mode == DRAW_LINES)
+		glDrawElements(GL_LINES, count, GL_UNSIGNED_INT, (void*)(offset * sizeof(GLuint)));
+	else if (mode == DRAW_TRIANGLE_STRIP)
+		glDrawElements(GL_TRIANGLE_STRIP, count, GL_UNSIGNED_INT, (void*)(offset * sizeof(GLuint)));
+	else
+		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, (void*)(offset * sizeof(GLuint)));
+}
@@ -0,0 +1,65 @@
+/**
+ CMesh2D
+ @brief A mesh of packed 2D vertices, with its own vertex array object
+ */
+#ifndef MESH_2D_H
+#define MESH_2D_H
+
+#include "Mesh.h"
+
+/**
+	Vertex2D Struct
+	A packed vertex for 2D meshes, which need no normal or z coordinate.
+	It is 16 bytes, instead of the 48 bytes of Vertex
+*/
+struct Vertex2D
+{
+	glm::vec2 position;
+	// Texture coordinates, normalized to 0 - 65535
+	unsigned short texCoord[2];
+	// Colour, normalized to 0 - 255
+	unsigned char color[4];
+
+	Vertex2D()
+	{
+		Set(glm::vec2(0.0f), glm::vec2(0.0f), glm::vec4(1.0f));
+	}
+
+	// Set the vertex, packing the texture coordinates and colour
+	void Set(const glm::vec2& position, const glm::vec2& texCoord, const glm::vec4& color)
+	{
+		this->position = position;
+		this->texCoord[0] = static_cast<unsigned short>(glm::clamp(texCoord.x, 0.0f, 1.0f) * 65535.0f + 0.5f);
+		this->texCoord[1] = static_cast<unsigned short>(glm::clamp(texCoord.y, 0.0f, 1.0f) * 65535.0f + 0.5f);
+		for (int i = 0; i < 4; ++i)
+			this->color[i] = static_cast<unsigned char>(glm::clamp(color[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+};
+
+/**
+	Mesh2D
+	A mesh of Vertex2D with its own vertex array object.
+	The vertex layout is set up once when the mesh is uploaded, so rendering only binds the vertex array
+*/
+class CMesh2D : public CMesh
+{
+public:
+	// The vertex array object, which stores the buffers and vertex layout of this mesh
+	unsigned VAO;
+
+	// Constructor
+	CMesh2D(void);
+	// Destructor
+	virtual ~CMesh2D(void);
+
+	// Upload the vertices and indices, and set up the vertex layout
+	void Upload(const std::vector<Vertex2D>& vertices, const std::vector<unsigned>& indices);
+
+	virtual void Render();
+
+protected:
+	// Draw a range of the indices
+	void DrawElements(const unsigned count, const unsigned offset);
+};
+
+#endif
@@ -6,63 +6,23 @@
 #define GLEW_STATIC
 #endif
 
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "..\RenderControl\GLStateCache.h"
+
 #include <vector>
 
-CMesh* CMeshBuilder::GenerateQuad(glm::vec4 color, float width, float height)
+CMesh2D* CMeshBuilder::GenerateQuad(glm::vec4 color, float width, float height)
 {
-	Vertex v;
-	std::vector<Vertex> vertex_buffer_data;
-	std::vector<GLuint> index_buffer_data;
-
-	v.position = glm::vec3(-0.5f * width, -0.5f * height, 0);
-	v.color = color;
-	v.normal = glm::vec3(0, 0, 1);
-	v.texCoord = glm::vec2(0, 0);
-	vertex_buffer_data.push_back(v);
-
-	v.position = glm::vec3(0.5f * width, -0.5f * height, 0);
-	v.color = color;
-	v.normal = glm::vec3(0, 0, 1);
-	v.texCoord = glm::vec2(1.0f, 0);
-	vertex_buffer_data.push_back(v);
-
-	v.position = glm::vec3(0.5f * width, 0.5f * height, 0);
-	v.color = color;
-	v.normal = glm::vec3(0, 0, 1);
-	v.texCoord = glm::vec2(1.0f, 1.0f);
-	vertex_buffer_data.push_back(v);
-
-	v.position = glm::vec3(-0.5f * width, 0.5f * height, 0);
-	v.color = color;
-	v.normal = glm::vec3(0, 0, 1);
-	v.texCoord = glm::vec2(0, 1.0f);
-	vertex_buffer_data.push_back(v);
-
-	index_buffer_data.push_back(3);
-	index_buffer_data.push_back(0);
-	index_buffer_data.push_back(2);
-	index_buffer_data.push_back(1);
-	index_buffer_data.push_back(2);
-	index_buffer_data.push_back(0);
-
-	CMesh* mesh = new CMesh();
-
-	glBindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
-	glBufferData(GL_ARRAY_BUFFER, vertex_buffer_data.size() * sizeof(Vertex), &vertex_buffer_data[0], GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint), &index_buffer_data[0], GL_STATIC_DRAW);
-
-	mesh->indexSize = index_buffer_data.size();
-	mesh->mode = CMesh::DRAW_TRIANGLES;
-
-	return mesh;
+	return GenerateQuadWithPosition(color, 0.0f, 0.0f, width, height);
 }
 
 CSpriteAnimation* CMeshBuilder::GenerateSpriteAnimation(unsigned numRow, unsigned numCol, float tile_width, float tile_height)
 {
-	Vertex v;
-	std::vector<Vertex> vertex_buffer_data;
+	Vertex2D v;
+	std::vector<Vertex2D> vertex_buffer_data;
 	std::vector<GLuint> index_buffer_data;
+	vertex_buffer_data.reserve(numRow * numCol * 4);
+	index_buffer_data.reserve(numRow * numCol * 6);
 
 	float width = 1.f / numCol;
 	float height = 1.f / numRow;
@@ -73,24 +33,16 @@ CSpriteAnimation* CMeshBuilder::GenerateSpriteAnimation(unsigned numRow, unsigne
 		{
 			float u1 = j * width;
 			float v1 = 1.f - height - i * height;
-			v.position = glm::vec3(-0.5f * tile_width, -0.5f * tile_height, 0);
-			v.normal = glm::vec3(0, 0, 1);
-			v.texCoord = glm::vec2(u1, v1);
+			v.Set(glm::vec2(-0.5f * tile_width, -0.5f * tile_height), glm::vec2(u1, v1), glm::vec4(1.0f));
 			vertex_buffer_data.push_back(v);
 
-			v.position = glm::vec3(0.5f * tile_width, -0.5f * tile_height, 0);
-			v.normal = glm::vec3(0, 0, 1);
-			v.texCoord = glm::vec2(u1 + width, v1);
+			v.Set(glm::vec2(0.5f * tile_width, -0.5f * tile_height), glm::vec2(u1 + width, v1), glm::vec4(1.0f));
 			vertex_buffer_data.push_back(v);
 
-			v.position = glm::vec3(0.5f * tile_width, 0.5f * tile_height, 0);
-			v.normal = glm::vec3(0, 0, 1);
-			v.texCoord = glm::vec2(u1 + width, v1 + height);
+			v.Set(glm::vec2(0.5f * tile_width, 0.5f * tile_height), glm::vec2(u1 + width, v1 + height), glm::vec4(1.0f));
 			vertex_buffer_data.push_back(v);
 
-			v.position = glm::vec3(-0.5f * tile_width, 0.5f * tile_height, 0);
-			v.normal = glm::vec3(0, 0, 1);
-			v.texCoord = glm::vec2(u1, v1 + height);
+			v.Set(glm::vec2(-0.5f * tile_width, 0.5f * tile_height), glm::vec2(u1, v1 + height), glm::vec4(1.0f));
 			vertex_buffer_data.push_back(v);
 
 			index_buffer_data.push_back(offset + 3);
@@ -104,50 +56,32 @@ CSpriteAnimation* CMeshBuilder::GenerateSpriteAnimation(unsigned numRow, unsigne
 	}
 
 	CSpriteAnimation* mesh = new CSpriteAnimation(numRow, numCol);
-
-	glBindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
-	glBufferData(GL_ARRAY_BUFFER, vertex_buffer_data.size() * sizeof(Vertex), &vertex_buffer_data[0], GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint), &index_buffer_data[0], GL_STATIC_DRAW);
-
-	mesh->indexSize = index_buffer_data.size();
+	mesh->Upload(vertex_buffer_data, index_buffer_data);
 	mesh->mode = CMesh::DRAW_TRIANGLES;
 
 	return mesh;
 }
 
-CMesh* CMeshBuilder::GenerateQuadWithPosition(const glm::vec4 color,
+CMesh2D* CMeshBuilder::GenerateQuadWithPosition(const glm::vec4 color,
 	const float x,
 	const float y,
 	const float width,
 	const float height)
 {
-	Vertex v;
-	std::vector<Vertex> vertex_buffer_data;
+	Vertex2D v;
+	std::vector<Vertex2D> vertex_buffer_data;
 	std::vector<GLuint> index_buffer_data;
 
-	v.position = glm::vec3(x - 0.5f * width, y - 0.5f * height, 0);
-	v.color = color;
-	v.normal = glm::vec3(0, 0, 1);
-	v.texCoord = glm::vec2(0, 0);
+	v.Set(glm::vec2(x - 0.5f * width, y - 0.5f * height), glm::vec2(0, 0), color);
 	vertex_buffer_data.push_back(v);
 
-	v.position = glm::vec3(x + 0.5f * width, y - 0.5f * height, 0);
-	v.color = color;
-	v.normal = glm::vec3(0, 0, 1);
-	v.texCoord = glm::vec2(1.0f, 0);
+	v.Set(glm::vec2(x + 0.5f * width, y - 0.5f * height), glm::vec2(1.0f, 0), color);
 	vertex_buffer_data.push_back(v);
 
-	v.position = glm::vec3(x + 0.5f * width, y + 0.5f * height, 0);
-	v.color = color;
-	v.normal = glm::vec3(0, 0, 1);
-	v.texCoord = glm::vec2(1.0f, 1.0f);
+	v.Set(glm::vec2(x + 0.5f * width, y + 0.5f * height), glm::vec2(1.0f, 1.0f), color);
 	vertex_buffer_data.push_back(v);
 
-	v.position = glm::vec3(x - 0.5f * width, y + 0.5f * height, 0);
-	v.color = color;
-	v.normal = glm::vec3(0, 0, 1);
-	v.texCoord = glm::vec2(0, 1.0f);
+	v.Set(glm::vec2(x - 0.5f * width, y + 0.5f * height), glm::vec2(0, 1.0f), color);
 	vertex_buffer_data.push_back(v);
 
 	index_buffer_data.push_back(3);
@@ -157,14 +91,8 @@ CMesh* CMeshBuilder::GenerateQuadWithPosition(const glm::vec4 color,
 	index_buffer_data.push_back(2);
 	index_buffer_data.push_back(0);
 
-	CMesh* mesh = new CMesh();
-
-	glBindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
-	glBufferData(GL_ARRAY_BUFFER, vertex_buffer_data.size() * sizeof(Vertex), &vertex_buffer_data[0], GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint), &index_buffer_data[0], GL_STATIC_DRAW);
-
-	mesh->indexSize = index_buffer_data.size();
+	CMesh2D* mesh = new CMesh2D();
+	mesh->Upload(vertex_buffer_data, index_buffer_data);
 	mesh->mode = CMesh::DRAW_TRIANGLES;
 
 	return mesh;
@@ -313,9 +241,9 @@ CMesh* CMeshBuilder::GenerateBox(const glm::vec4 color,
 
 	CMesh* mesh = new CMesh();
 
-	glBindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
+	CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, mesh->vertexBuffer);
 	glBufferData(GL_ARRAY_BUFFER, vertex_buffer_data.size() * sizeof(Vertex), &vertex_buffer_data[0], GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
+	CGLStateCache::GetInstance()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->indexBuffer);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint), &index_buffer_data[0], GL_STATIC_DRAW);
 
 	mesh->indexSize = index_buffer_data.size();
@@ -10,15 +10,17 @@
 #define MESH_BUILDER_H
 
 #include "Mesh.h"
+#include "Mesh2D.h"
 #include "SpriteAnimation.h"
 
 class CMeshBuilder
 {
 	public:
 		static CSpriteAnimation* GenerateSpriteAnimation(unsigned numRow, unsigned numCol, float tile_width = 1.0f, float tile_height = 1.0f);
-		static CMesh* GenerateQuad(glm::vec4 color = glm::vec4(1,1,1,1), float width = 1.0f, float height = 1.0f);
+		// The 2D meshes use the packed Vertex2D
+		static CMesh2D* GenerateQuad(glm::vec4 color = glm::vec4(1,1,1,1), float width = 1.0f, float height = 1.0f);
 
-		static CMesh* GenerateQuadWithPosition(	const glm::vec4 color = glm::vec4(1, 1, 1, 1), 
+		static CMesh2D* GenerateQuadWithPosition(	const glm::vec4 color = glm::vec4(1, 1, 1, 1), 
 												const float x = 0.0f, 
 												const float y = 0.0f,
 												const float width = 1.0f, 
@@ -17,14 +17,10 @@ Constructor
 */
 /******************************************************************************/
 CSpriteAnimation::CSpriteAnimation(int row, int col)
-	: CMesh()
-	, row(row)
-	, col(col)
-	, currentTime(0)
-	, currentFrame(0)
-	, playCount(0)
-	, currentAnimation("")
+	: CMesh2D()
 {
+	spriteSheet.Init(row, col);
+	animator.Init(&spriteSheet);
 }
 
 /******************************************************************************/
@@ -35,23 +31,13 @@ Destructor
 /******************************************************************************/
 CSpriteAnimation::~CSpriteAnimation()
 {
-	//Loop through the animation list
-	for (auto iter = animationList.begin(); iter != animationList.end(); ++iter)
-	{
-		if (iter->second != NULL)
-		{
-			//delete the animation
-			delete iter->second;
-		}
-	}
-	//Remove everything
-	animationList.clear();
 }
 
 /******************************************************************************/
 /*!
 \brief
-Update the current frame of the current animation
+Update the current frame of the current animation. It only reads the
+animation table by the index of the current animation
 
 param dt - the delta time
 
@@ -61,46 +47,7 @@ param dt - the delta time
 /******************************************************************************/
 void CSpriteAnimation::Update(double dt)
 {
-	//Check if the current animation is active
-	if (animationList[currentAnimation]->animActive)
-	{
-		//Add the delta time
-		currentTime += static_cast<float>(dt);
-
-		//Get the number of frame to get the frame per second
-		int numFrame = animationList[currentAnimation]->frames.size();
-		float frameTime = animationList[currentAnimation]->animTime / numFrame;
-
-		//Set the current frame based on the current time
-		currentFrame = animationList[currentAnimation]->frames[fmin((int)animationList[currentAnimation]->frames.size() - 1, static_cast<int>(currentTime / frameTime))];
-
-		//check if the current time is more than the total animated time
-		if (currentTime >= animationList[currentAnimation]->animTime)
-		{
-			//if it is less than the repeat count, increase the count and repeat
-			if (playCount < animationList[currentAnimation]->repeatCount)
-			{
-				++playCount;
-				currentTime = 0;
-				currentFrame = animationList[currentAnimation]->frames[0];
-			}
-			//if we repeat count is 0 or we have reach same number of play count
-			else
-			{
-				animationList[currentAnimation]->animActive = false;
-				animationList[currentAnimation]->ended = true;
-			}
-
-			//If the animaton is infinite
-			if (animationList[currentAnimation]->repeatCount == -1)
-			{
-				currentTime = 0.f;
-				currentFrame = animationList[currentAnimation]->frames[0];
-				animationList[currentAnimation]->animActive = true;
-				animationList[currentAnimation]->ended = false;
-			}
-		}
-	}
+	animator.Update(dt);
 }
 
 /******************************************************************************/
@@ -116,31 +63,8 @@ param None
 /******************************************************************************/
 void CSpriteAnimation::Render()
 {
-	glEnableVertexAttribArray(0);
-	glEnableVertexAttribArray(1);
-	glEnableVertexAttribArray(2);
-	glEnableVertexAttribArray(3);
-
-	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3) + sizeof(glm::vec4)));
-	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3) + sizeof(glm::vec4) + sizeof(glm::vec3)));
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
-
-	//Draw based on the current frame
-	if (mode == DRAW_LINES)
-		glDrawElements(GL_LINES, 6, GL_UNSIGNED_INT, (void*)(currentFrame * 6 * sizeof(GLuint)));
-	else if (mode == DRAW_TRIANGLE_STRIP)
-		glDrawElements(GL_TRIANGLE_STRIP, 6, GL_UNSIGNED_INT, (void*)(currentFrame * 6 * sizeof(GLuint)));
-	else
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)(currentFrame * 6 * sizeof(GLuint)));
-
-	glDisableVertexAttribArray(1);
-	glDisableVertexAttribArray(0);
-	glDisableVertexAttribArray(2);
-	glDisableVertexAttribArray(3);
+	//Draw the quad of the current frame
+	DrawElements(6, animator.GetCurrentFrame() * 6);
 }
 
 /******************************************************************************/
@@ -155,32 +79,12 @@ param start - the starting frame based on the sprite sheet
 param end - the ending frame based on the sprite sheet
 
 \exception None
-\return None
+\return The index of the animation, to play it with
 */
 /******************************************************************************/
-void CSpriteAnimation::AddAnimation(std::string anim_name, int start, int end)
+int CSpriteAnimation::AddAnimation(const std::string& anim_name, int start, int end)
 {
-	CAnimation* anim = new CAnimation();
-
-	//Check if start is more than end
-	//Swap over if it is
-	if (start > end)
-		std::swap(start, end);
-
-	//Add in all the frames in the range
-	for (int i = start; i <= end; ++i)
-	{
-		anim->AddFrame(i);
-	}
-
-	//Link the animation to the animation list
-	animationList[anim_name] = anim;
-	//Set the current animation if it does not exisit
-	if (currentAnimation == "")
-	{
-		currentAnimation = anim_name;
-	}
-	animationList[anim_name]->animActive = false;
+	return spriteSheet.AddAnimation(anim_name, start, end);
 }
 
 /******************************************************************************/
@@ -195,12 +99,12 @@ param count - the number of frame in the animation
 param ... - the frames
 
 \exception None
-\return None
+\return The index of the animation, to play it with
 */
 /******************************************************************************/
-void CSpriteAnimation::AddSequeneAnimation(std::string anim_name, int count ...)
+int CSpriteAnimation::AddSequeneAnimation(const std::string& anim_name, int count ...)
 {
-	CAnimation* anim = new CAnimation();
+	std::vector<int> sequence;
 
 	va_list args;
 	va_start(args, count);
@@ -208,27 +112,38 @@ void CSpriteAnimation::AddSequeneAnimation(std::string anim_name, int count ...)
 	for (int i = 0; i < count; ++i)
 	{
 		int value = va_arg(args, int);
-		anim->AddFrame(value);
+		sequence.push_back(value);
 	}
 	va_end(args);
 
-	//Link the animation to the animation list
-	animationList[anim_name] = anim;
-	//Set the current animation if it does not exisit
-	if (currentAnimation == "")
-	{
-		currentAnimation = anim_name;
-	}
-	animationList[anim_name]->animActive = false;
+	return spriteSheet.AddSequenceAnimation(anim_name, sequence);
 }
 
 /******************************************************************************/
 /*!
 \brief
-Play the animation based on the given name
+Get the index of an animation by its name. It searches the names, so only
+use it to set up the sprite, and keep the index to play the animation
 
 param anim_name - the name of the animation
 
+\exception None
+\return The index of the animation, or INVALID_ANIMATION if there is none with the name
+*/
+/******************************************************************************/
+int CSpriteAnimation::GetAnimationID(const std::string& anim_name) const
+{
+	return spriteSheet.GetAnimationID(anim_name);
+}
+
+/******************************************************************************/
+/*!
+\brief
+Play the animation based on the given index. The frame rate is worked out
+here, so Update does not have to
+
+param animationID - the index of the animation, which AddAnimation returned
+
 param repeat - the number of repeats (-1 for infinite looping)
 
 param time - the total time of the animation
@@ -237,18 +152,30 @@ param time - the total time of the animation
 \return None
 */
 /******************************************************************************/
-void CSpriteAnimation::PlayAnimation(std::string anim_name, int repeat, float time)
+void CSpriteAnimation::PlayAnimation(const int animationID, int repeat, float time)
 {
-	//Reset the playCount if the animation is changing
-	if (currentAnimation != anim_name)
-		playCount = 0;
+	animator.PlayAnimation(animationID, repeat, time);
+}
 
-	//Check if the anim name exist 
-	if (animationList[anim_name] != nullptr)
-	{
-		currentAnimation = anim_name;
-		animationList[anim_name]->Set(repeat, time, true);
-	}
+/******************************************************************************/
+/*!
+\brief
+Play the animation based on the given name. It searches the names, so only
+use it to set up the sprite
+
+param anim_name - the name of the animation
+
+param repeat - the number of repeats (-1 for infinite looping)
+
+param time - the total time of the animation
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::PlayAnimation(const std::string& anim_name, int repeat, float time)
+{
+	PlayAnimation(GetAnimationID(anim_name), repeat, time);
 }
 
 /******************************************************************************/
@@ -262,7 +189,7 @@ Resume the current animation if it is Paused
 /******************************************************************************/
 void CSpriteAnimation::Resume()
 {
-	animationList[currentAnimation]->animActive = true;
+	animator.Resume();
 }
 
 /******************************************************************************/
@@ -276,7 +203,7 @@ Pause the current animation
 /******************************************************************************/
 void CSpriteAnimation::Pause()
 {
-	animationList[currentAnimation]->animActive = false;
+	animator.Pause();
 }
 
 /******************************************************************************/
@@ -290,6 +217,50 @@ Reset the current animation
 /******************************************************************************/
 void CSpriteAnimation::Reset()
 {
-	currentFrame = animationList[currentAnimation]->frames[0];
-	playCount = 0;
-}
\ No newline at end of file
+	animator.Reset();
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the texture coordinates of the current frame in the sprite sheet.
+This matches the frames which CMeshBuilder::GenerateSpriteAnimation builds,
+so a sprite batch can draw the frame without the mesh
+
+\exception None
+\return The bottom left (x, y) and top right (z, w) texture coordinates
+*/
+/******************************************************************************/
+glm::vec4 CSpriteAnimation::GetFrameUVRect() const
+{
+	return animator.GetFrameUVRect();
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the current frame in the sprite sheet, so a sprite batch can work out its
+texture coordinates on the graphics card
+
+\exception None
+\return The current frame
+*/
+/******************************************************************************/
+int CSpriteAnimation::GetCurrentFrame() const
+{
+	return animator.GetCurrentFrame();
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the sprite sheet of this sprite, for its number of rows and columns
+
+\exception None
+\return The sprite sheet
+*/
+/******************************************************************************/
+const CSpriteSheet& CSpriteAnimation::GetSpriteSheet() const
+{
+	return spriteSheet;
+}
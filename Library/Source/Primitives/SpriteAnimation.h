@@ -5,66 +5,30 @@
 \par	email: 
 \brief
 Sprite Animation that hold different classes 
--Animation Class - Managed frames and name of the animation
--Sprite Animation - Managed various animations of the sprite  
+-Sprite Sheet - Managed frames and names of the animations
+-Sprite Animator - Managed the playback of the current animation
+-Sprite Animation - A mesh with its own Sprite Sheet and Sprite Animator
+The animations are played by their index, which AddAnimation returns. The
+names are only used to find an index when the sprite is set up, so playing
+and updating an animation does not hash a string or allocate memory.
 */
 /******************************************************************************/
 #pragma once
-#include "Mesh.h"
+#include "Mesh2D.h"
+#include "SpriteSheet.h"
+#include "SpriteAnimator.h"
 #include <vector>
 #include <string>
-#include <unordered_map>
 #include <stdarg.h>
 #include <math.h>
 
-struct CAnimation
-{
-	//Constructor
-	CAnimation():repeatCount(0),
-		animTime(0.0f),
-		ended(false),
-		animActive(false)
-	{
-	}
-
-	//repeat count, total animation time, 
-	void Set(int repeat, float time, bool active)
-	{
-		this->repeatCount = repeat;
-		this->animTime = time;
-		this->animActive = active;
-	}
-
-	//Adding frames to the frame vector
-	void AddFrame(int i)
-	{
-		frames.push_back(i);
-	}
-
-private:
-	//name of the animation
-	std::string animationName;
-
-	//The frames
-	std::vector<int> frames;
-
-	//How many times to repeat
-	int repeatCount;
-	//The animation time
-	float animTime;
-	//Has the animation ended
-	bool ended;
-	//Is the animation active
-	bool animActive;
-
-	//Allow the Sprite Animation class to use private variable
-	friend class CSpriteAnimation;
-};
-
-//Sprite Animation that derives from Mesh for rendering
-class CSpriteAnimation : public CMesh
+//Sprite Animation that derives from Mesh2D for rendering
+class CSpriteAnimation : public CMesh2D
 {
 public:
+	//The index of an animation which does not exist
+	static const int INVALID_ANIMATION = CSpriteSheet::INVALID_ANIMATION;
+
 	CSpriteAnimation(int row, int col);
 	~CSpriteAnimation();
 
@@ -72,28 +36,29 @@ public:
 	void Update(double dt);
 	virtual void Render();
 
-	void AddAnimation(std::string name, int start, int end);
-	void AddSequeneAnimation(std::string name, int count ...);
-	void PlayAnimation(std::string name, int repeat, float time);
+	//Add an animation, and get its index
+	int AddAnimation(const std::string& name, int start, int end);
+	int AddSequeneAnimation(const std::string& name, int count ...);
+	//Get the index of an animation by its name. Only use it to set up the sprite
+	int GetAnimationID(const std::string& name) const;
+	//Play an animation by its index
+	void PlayAnimation(const int animationID, int repeat, float time);
+	//Play an animation by its name. Only use it to set up the sprite
+	void PlayAnimation(const std::string& name, int repeat, float time);
 	void Pause();
 	void Resume();
 	void Reset();
 
-private:
-	//number of rows
-	int row;
-	//number of columns 
-	int col;
-
-	//the current time of the animation
-	float currentTime;
-	//the current frame of the animation
-	int currentFrame;
-	//How many time it has play
-	int playCount;
+	//Get the texture coordinates of the current frame, as (u1, v1, u2, v2)
+	glm::vec4 GetFrameUVRect() const;
+	//Get the current frame, and the sprite sheet it is in
+	int GetCurrentFrame() const;
+	const CSpriteSheet& GetSpriteSheet() const;
 
-	//The name of the current animation
-	std::string currentAnimation;
-	//The list of the animations with their names
-	std::unordered_map<std::string, CAnimation*> animationList;
+private:
+	//The frames and animations of this sprite, which only this sprite uses.
+	//Entities which share a sprite sheet use CSpriteSheetManager and a CSpriteAnimator instead
+	CSpriteSheet spriteSheet;
+	//The playback of the current animation
+	CSpriteAnimator animator;
 };
@@ -0,0 +1,165 @@
+/**
+ CSpriteAnimator
+ @brief A class which plays the animations of a CSpriteSheet for one entity.
+ */
+#include "SpriteAnimator.h"
+
+/**
+ @brief Constructor
+ */
+CSpriteAnimator::CSpriteAnimator(void)
+	: pSpriteSheet(NULL)
+	, iCurrentAnimation(CSpriteSheet::INVALID_ANIMATION)
+	, fCurrentTime(0.0f)
+	, iCurrentFrame(0)
+	, iPlayCount(0)
+	, iRepeatCount(0)
+	, fAnimTime(0.0f)
+	, fFramesPerSecond(0.0f)
+	, bEnded(false)
+	, bActive(false)
+{
+}
+
+/**
+ @brief Set the sprite sheet to play the animations of, and stop the current animation
+ @param pSpriteSheet The shared sprite sheet
+ */
+void CSpriteAnimator::Init(const CSpriteSheet* pSpriteSheet)
+{
+	*this = CSpriteAnimator();
+	this->pSpriteSheet = pSpriteSheet;
+}
+
+/**
+ @brief Update the current frame of the current animation
+ @param dElapsedTime The time which has passed since the last update
+ */
+void CSpriteAnimator::Update(const double dElapsedTime)
+{
+	// Check if the current animation is active
+	if (bActive == false)
+		return;
+
+	const int iNumFrames = pSpriteSheet->GetNumFrames(iCurrentAnimation);
+
+	// Add the elapsed time
+	fCurrentTime += static_cast<float>(dElapsedTime);
+
+	// Set the current frame based on the current time
+	int iFrame = static_cast<int>(fCurrentTime * fFramesPerSecond);
+	if (iFrame > iNumFrames - 1)
+		iFrame = iNumFrames - 1;
+	iCurrentFrame = pSpriteSheet->GetFrame(iCurrentAnimation, iFrame);
+
+	// Check if the animation has played once
+	if (fCurrentTime >= fAnimTime)
+	{
+		// Repeat it if it has not played as many times as it should
+		if (iPlayCount < iRepeatCount)
+		{
+			++iPlayCount;
+			fCurrentTime = 0.0f;
+			iCurrentFrame = pSpriteSheet->GetFrame(iCurrentAnimation, 0);
+		}
+		else
+		{
+			bActive = false;
+			bEnded = true;
+		}
+
+		// Repeat it forever
+		if (iRepeatCount == -1)
+		{
+			fCurrentTime = 0.0f;
+			iCurrentFrame = pSpriteSheet->GetFrame(iCurrentAnimation, 0);
+			bActive = true;
+			bEnded = false;
+		}
+	}
+}
+
+/**
+ @brief Play an animation by its index in the sprite sheet. The frame rate is worked out here, so Update does not have to
+ @param iAnimationID The index of the animation, which CSpriteSheet::GetAnimationID returned
+ @param iRepeat The number of repeats. -1 repeats it forever
+ @param fTime The time to play the animation once
+ */
+void CSpriteAnimator::PlayAnimation(const int iAnimationID, const int iRepeat, const float fTime)
+{
+	// Reset the play count if the animation is changing
+	if (iCurrentAnimation != iAnimationID)
+		iPlayCount = 0;
+
+	// Check if the animation exists, and has frames to show
+	if ((pSpriteSheet == NULL) || (pSpriteSheet->IsValidAnimation(iAnimationID) == false))
+		return;
+
+	iCurrentAnimation = iAnimationID;
+	iRepeatCount = iRepeat;
+	fAnimTime = fTime;
+	fFramesPerSecond = (fTime > 0.0f ? pSpriteSheet->GetNumFrames(iAnimationID) / fTime : 0.0f);
+	bActive = true;
+}
+
+/**
+ @brief Pause the current animation
+ */
+void CSpriteAnimator::Pause(void)
+{
+	bActive = false;
+}
+
+/**
+ @brief Resume the current animation if it is paused
+ */
+void CSpriteAnimator::Resume(void)
+{
+	if (iCurrentAnimation != CSpriteSheet::INVALID_ANIMATION)
+		bActive = true;
+}
+
+/**
+ @brief Reset the current animation to its first frame
+ */
+void CSpriteAnimator::Reset(void)
+{
+	if (iCurrentAnimation != CSpriteSheet::INVALID_ANIMATION)
+		iCurrentFrame = pSpriteSheet->GetFrame(iCurrentAnimation, 0);
+	iPlayCount = 0;
+}
+
+/**
+ @brief Check if the current animation has ended
+ */
+bool CSpriteAnimator::HasEnded(void) const
+{
+	return bEnded;
+}
+
+/**
+ @brief Get the current frame in the sprite sheet
+ */
+int CSpriteAnimator::GetCurrentFrame(void) const
+{
+	return iCurrentFrame;
+}
+
+/**
+ @brief Get the shared sprite sheet
+ */
+const CSpriteSheet* CSpriteAnimator::GetSpriteSheet(void) const
+{
+	return pSpriteSheet;
+}
+
+/**
+ @brief Get the texture coordinates of the current frame, so a sprite batch can draw the frame without a mesh
+ @return The bottom left (x, y) and top right (z, w) texture coordinates
+ */
+glm::vec4 CSpriteAnimator::GetFrameUVRect(void) const
+{
+	if (pSpriteSheet == NULL)
+		return glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+	return pSpriteSheet->GetFrameUVRect(iCurrentFrame);
+}
@@ -0,0 +1,64 @@
+/**
+ CSpriteAnimator
+ @brief A class which plays the animations of a CSpriteSheet for one entity.
+		It only keeps a pointer to the shared sprite sheet and the playback of the current animation,
+		so it is small enough to be kept by value in each entity. It has no virtual destructor,
+		so that it does not need a virtual table.
+ */
+#pragma once
+
+#include "SpriteSheet.h"
+
+class CSpriteAnimator
+{
+public:
+	// Constructor
+	CSpriteAnimator(void);
+
+	// Set the sprite sheet to play the animations of, and stop the current animation
+	void Init(const CSpriteSheet* pSpriteSheet);
+
+	// Update the current frame of the current animation
+	void Update(const double dElapsedTime);
+
+	// Play an animation by its index in the sprite sheet
+	void PlayAnimation(const int iAnimationID, const int iRepeat, const float fTime);
+	// Pause the current animation
+	void Pause(void);
+	// Resume the current animation if it is paused
+	void Resume(void);
+	// Reset the current animation to its first frame
+	void Reset(void);
+
+	// Check if the current animation has ended
+	bool HasEnded(void) const;
+	// Get the current frame in the sprite sheet
+	int GetCurrentFrame(void) const;
+	// Get the shared sprite sheet
+	const CSpriteSheet* GetSpriteSheet(void) const;
+	// Get the texture coordinates of the current frame, as (u1, v1, u2, v2)
+	glm::vec4 GetFrameUVRect(void) const;
+
+protected:
+	// The shared sprite sheet
+	const CSpriteSheet* pSpriteSheet;
+
+	// The index of the current animation
+	int iCurrentAnimation;
+	// The current time of the animation
+	float fCurrentTime;
+	// The current frame in the sprite sheet
+	int iCurrentFrame;
+	// How many times the animation has played
+	int iPlayCount;
+	// How many times to repeat the animation. -1 repeats it forever
+	int iRepeatCount;
+	// The time to play the animation once
+	float fAnimTime;
+	// The number of frames which are shown per second
+	float fFramesPerSecond;
+	// Has the animation ended
+	bool bEnded;
+	// Is the animation active
+	bool bActive;
+};
@@ -0,0 +1,201 @@
+/**
+ CSpriteSheet
+ @brief A class which stores the frames of a sprite sheet and the animations made of them.
+		It does not change once it is set up, so every entity which uses the same sprite sheet
+		shares one CSpriteSheet, and only keeps its own CSpriteAnimator to play it.
+ */
+#include "SpriteSheet.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CSpriteSheet::CSpriteSheet(void)
+	: iNumRows(1)
+	, iNumCols(1)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CSpriteSheet::~CSpriteSheet(void)
+{
+}
+
+/**
+ @brief Set the number of rows and columns of frames, and remove the animations
+ @param iNumRows The number of rows of frames
+ @param iNumCols The number of columns of frames
+ */
+void CSpriteSheet::Init(const int iNumRows, const int iNumCols)
+{
+	this->iNumRows = iNumRows;
+	this->iNumCols = iNumCols;
+	vFrames.clear();
+	vAnimations.clear();
+}
+
+/**
+ @brief Load the rows, columns and animations from a data file
+ @param sFilePath The path of the file
+ @return false if the file could not be read, or a line could not be understood
+ */
+bool CSpriteSheet::LoadFromFile(const std::string& sFilePath)
+{
+	std::ifstream file(sFilePath);
+	if (!file.is_open())
+	{
+		cout << "CSpriteSheet::LoadFromFile - Unable to open " << sFilePath << endl;
+		return false;
+	}
+
+	Init(1, 1);
+
+	std::string sLine;
+	int iLine = 0;
+	while (std::getline(file, sLine))
+	{
+		iLine++;
+
+		std::istringstream line(sLine);
+		std::string sKeyword;
+		if (!(line >> sKeyword) || (sKeyword[0] == '#'))
+			continue;
+
+		bool bValid = false;
+		if (sKeyword == "rows")
+			bValid = (!(line >> iNumRows).fail() && (iNumRows > 0));
+		else if (sKeyword == "columns")
+			bValid = (!(line >> iNumCols).fail() && (iNumCols > 0));
+		else if (sKeyword == "animation")
+		{
+			std::string sName;
+			int iStart = 0, iEnd = 0;
+			bValid = !(line >> sName >> iStart >> iEnd).fail();
+			if (bValid)
+				AddAnimation(sName, iStart, iEnd);
+		}
+		else if (sKeyword == "sequence")
+		{
+			std::string sName;
+			std::vector<int> vSequence;
+			int iFrame = 0;
+			bValid = !(line >> sName).fail();
+			while (line >> iFrame)
+				vSequence.push_back(iFrame);
+			bValid = (bValid && (vSequence.empty() == false));
+			if (bValid)
+				AddSequenceAnimation(sName, vSequence);
+		}
+
+		if (bValid == false)
+		{
+			cout << "CSpriteSheet::LoadFromFile - Unable to read line " << iLine << " of " << sFilePath << endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ @brief Add an animation from a range of frames. The range may be given backwards
+ @param sName The name of the animation
+ @param iStart The first frame
+ @param iEnd The last frame
+ @return The index of the animation
+ */
+int CSpriteSheet::AddAnimation(const std::string& sName, int iStart, int iEnd)
+{
+	const int iFirstFrame = (int)vFrames.size();
+
+	if (iStart > iEnd)
+		std::swap(iStart, iEnd);
+	for (int i = iStart; i <= iEnd; ++i)
+		vFrames.push_back(i);
+
+	return AddAnimationFrames(sName, iFirstFrame);
+}
+
+/**
+ @brief Add an animation from a list of frames
+ @param sName The name of the animation
+ @param vSequence The frames, in the order they are shown
+ @return The index of the animation
+ */
+int CSpriteSheet::AddSequenceAnimation(const std::string& sName, const std::vector<int>& vSequence)
+{
+	const int iFirstFrame = (int)vFrames.size();
+	vFrames.insert(vFrames.end(), vSequence.begin(), vSequence.end());
+	return AddAnimationFrames(sName, iFirstFrame);
+}
+
+/**
+ @brief Get the index of an animation by its name. It searches the names, so only use it to set up
+		an entity, and keep the index to play the animation
+ @param sName The name of the animation
+ @return The index of the animation, or INVALID_ANIMATION if there is none with the name
+ */
+int CSpriteSheet::GetAnimationID(const std::string& sName) const
+{
+	for (unsigned int i = 0; i < vAnimations.size(); ++i)
+	{
+		if (vAnimations[i].animationName == sName)
+			return (int)i;
+	}
+	return INVALID_ANIMATION;
+}
+
+/**
+ @brief Get the texture coordinates of a frame in the sprite sheet.
+		This matches the frames which CMeshBuilder::GenerateSpriteAnimation builds
+ @param iFrame The frame
+ @return The bottom left (x, y) and top right (z, w) texture coordinates
+ */
+glm::vec4 CSpriteSheet::GetFrameUVRect(const int iFrame) const
+{
+	const float fWidth = 1.f / iNumCols;
+	const float fHeight = 1.f / iNumRows;
+	const int i = iFrame / iNumCols;
+	const int j = iFrame % iNumCols;
+	const float u1 = j * fWidth;
+	const float v1 = 1.f - fHeight - i * fHeight;
+	return glm::vec4(u1, v1, u1 + fWidth, v1 + fHeight);
+}
+
+/**
+ @brief Get the number of rows of frames
+ */
+int CSpriteSheet::GetNumRows(void) const
+{
+	return iNumRows;
+}
+
+/**
+ @brief Get the number of columns of frames
+ */
+int CSpriteSheet::GetNumCols(void) const
+{
+	return iNumCols;
+}
+
+/**
+ @brief Add an animation whose frames were added to the end of the frame table
+ @param sName The name of the animation
+ @param iFirstFrame The index of its first frame in the frame table
+ @return The index of the animation
+ */
+int CSpriteSheet::AddAnimationFrames(const std::string& sName, const int iFirstFrame)
+{
+	CAnimation animation;
+	animation.animationName = sName;
+	animation.firstFrame = iFirstFrame;
+	animation.numFrames = (int)vFrames.size() - iFirstFrame;
+	vAnimations.push_back(animation);
+	return (int)vAnimations.size() - 1;
+}
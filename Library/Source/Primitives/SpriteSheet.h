@@ -0,0 +1,104 @@
+/**
+ CSpriteSheet
+ @brief A class which stores the frames of a sprite sheet and the animations made of them.
+		It does not change once it is set up, so every entity which uses the same sprite sheet
+		shares one CSpriteSheet, and only keeps its own CSpriteAnimator to play it.
+		A sprite sheet can be loaded from a data file, which has one definition per line:
+			rows <number>
+			columns <number>
+			animation <name> <first frame> <last frame>
+			sequence <name> <frame> <frame> ...
+		Empty lines and lines which start with # are skipped. The frames are numbered from
+		the top left of the sprite sheet, row by row.
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <string>
+#include <vector>
+
+struct CAnimation
+{
+	//Constructor
+	CAnimation():firstFrame(0),
+		numFrames(0)
+	{
+	}
+
+private:
+	//name of the animation
+	std::string animationName;
+
+	//The index of the first frame of the animation in the frame table
+	int firstFrame;
+	//The number of frames of the animation
+	int numFrames;
+
+	//Allow the Sprite Sheet class to use private variable
+	friend class CSpriteSheet;
+};
+
+class CSpriteSheet
+{
+public:
+	// The index of an animation which does not exist
+	static const int INVALID_ANIMATION = -1;
+
+	// Constructor
+	CSpriteSheet(void);
+
+	// Destructor
+	virtual ~CSpriteSheet(void);
+
+	// Set the number of rows and columns of frames, and remove the animations
+	void Init(const int iNumRows, const int iNumCols);
+	// Load the rows, columns and animations from a data file
+	bool LoadFromFile(const std::string& sFilePath);
+
+	// Add an animation from a range of frames, and get its index
+	int AddAnimation(const std::string& sName, int iStart, int iEnd);
+	// Add an animation from a list of frames, and get its index
+	int AddSequenceAnimation(const std::string& sName, const std::vector<int>& vSequence);
+	// Get the index of an animation by its name. Only use it to set up an entity
+	int GetAnimationID(const std::string& sName) const;
+
+	// Check if an animation exists, and has frames to show
+	bool IsValidAnimation(const int iAnimationID) const
+	{
+		return ((iAnimationID >= 0) && (iAnimationID < (int)vAnimations.size()) &&
+			(vAnimations[iAnimationID].numFrames > 0));
+	}
+	// Get the number of frames of an animation. The animation must be valid
+	int GetNumFrames(const int iAnimationID) const
+	{
+		return vAnimations[iAnimationID].numFrames;
+	}
+	// Get a frame of an animation. The animation must be valid, and the index less than its number of frames
+	int GetFrame(const int iAnimationID, const int iIndex) const
+	{
+		return vFrames[vAnimations[iAnimationID].firstFrame + iIndex];
+	}
+
+	// Get the texture coordinates of a frame in the sprite sheet, as (u1, v1, u2, v2)
+	glm::vec4 GetFrameUVRect(const int iFrame) const;
+
+	// Get the number of rows of frames
+	int GetNumRows(void) const;
+	// Get the number of columns of frames
+	int GetNumCols(void) const;
+
+protected:
+	// The number of rows and columns of frames
+	int iNumRows;
+	int iNumCols;
+
+	// The frames of all the animations, one animation after another
+	std::vector<int> vFrames;
+	// The animations, by their indices
+	std::vector<CAnimation> vAnimations;
+
+	// Add an animation whose frames were added to the frame table from iFirstFrame
+	int AddAnimationFrames(const std::string& sName, const int iFirstFrame);
+};
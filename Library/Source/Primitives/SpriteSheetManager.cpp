@@ -0,0 +1,55 @@
+/**
+ CSpriteSheetManager
+ @brief A class which loads the sprite sheet data files, and keeps them by their file names
+		so that the entities which use the same sprite sheet share one CSpriteSheet.
+ */
+#include "SpriteSheetManager.h"
+
+#include <iostream>
+using namespace std;
+
+#include "../System/filesystem.h"
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CSpriteSheetManager::CSpriteSheetManager(void)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CSpriteSheetManager::~CSpriteSheetManager(void)
+{
+	// Delete the sprite sheets
+	std::map<std::string, CSpriteSheet*>::iterator it = mapSpriteSheets.begin();
+	for (; it != mapSpriteSheets.end(); ++it)
+		delete it->second;
+	mapSpriteSheets.clear();
+}
+
+/**
+ @brief Load a sprite sheet data file. A file which was loaded before returns the same CSpriteSheet,
+		so the entities which use it only keep a pointer to it
+ @param filename The name of the file
+ @return The sprite sheet, or NULL if the file could not be loaded
+ */
+const CSpriteSheet* CSpriteSheetManager::Load(const char* filename)
+{
+	// Return the sprite sheet if this file was loaded before
+	std::map<std::string, CSpriteSheet*>::iterator it = mapSpriteSheets.find(filename);
+	if (it != mapSpriteSheets.end())
+		return it->second;
+
+	CSpriteSheet* pSpriteSheet = new CSpriteSheet();
+	if (pSpriteSheet->LoadFromFile(FileSystem::getPath(filename)) == false)
+	{
+		cout << "CSpriteSheetManager::Load - Unable to load " << filename << endl;
+		delete pSpriteSheet;
+		return NULL;
+	}
+
+	mapSpriteSheets[filename] = pSpriteSheet;
+	return pSpriteSheet;
+}
@@ -0,0 +1,32 @@
+/**
+ CSpriteSheetManager
+ @brief A class which loads the sprite sheet data files, and keeps them by their file names
+		so that the entities which use the same sprite sheet share one CSpriteSheet.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include "SpriteSheet.h"
+
+#include <map>
+#include <string>
+
+class CSpriteSheetManager : public CSingletonTemplate<CSpriteSheetManager>
+{
+	friend CSingletonTemplate<CSpriteSheetManager>;
+public:
+	// Load a sprite sheet data file. A file which was loaded before returns the same CSpriteSheet
+	const CSpriteSheet* Load(const char* filename);
+
+protected:
+	// The loaded sprite sheets, by their file names
+	std::map<std::string, CSpriteSheet*> mapSpriteSheets;
+
+	// Constructor
+	CSpriteSheetManager(void);
+
+	// Destructor
+	virtual ~CSpriteSheetManager(void);
+};
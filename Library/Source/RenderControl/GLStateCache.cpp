@@ -0,0 +1,259 @@
+/**
+ CGLStateCache
+ @brief This class remembers the OpenGL state which the game sets most often, i.e. the shader program,
+		vertex array, buffers, textures and blending, and skips the calls which would not change it.
+		All the code which changes this state must go through this class, or call Invalidate() after it.
+ */
+#include "GLStateCache.h"
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CGLStateCache::CGLStateCache(void)
+	: uiCallsIssued(0)
+	, uiCallsSkipped(0)
+	, uiLastCallsIssued(0)
+	, uiLastCallsSkipped(0)
+{
+	Invalidate();
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CGLStateCache::~CGLStateCache(void)
+{
+}
+
+/**
+ @brief Use a shader program
+ @param uiProgram The ID of the program
+ */
+void CGLStateCache::UseProgram(const GLuint uiProgram)
+{
+	if (this->uiProgram == uiProgram)
+	{
+		uiCallsSkipped++;
+		return;
+	}
+	glUseProgram(uiProgram);
+	this->uiProgram = uiProgram;
+	uiCallsIssued++;
+}
+
+/**
+ @brief Bind a vertex array object
+ @param uiVAO The ID of the vertex array object
+ */
+void CGLStateCache::BindVertexArray(const GLuint uiVAO)
+{
+	if (this->uiVAO == uiVAO)
+	{
+		uiCallsSkipped++;
+		return;
+	}
+	glBindVertexArray(uiVAO);
+	this->uiVAO = uiVAO;
+	// Each vertex array has its own element array buffer
+	uiElementArrayBuffer = UNKNOWN;
+	uiCallsIssued++;
+}
+
+/**
+ @brief Bind a buffer. Other targets than GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER are always bound
+ @param eTarget The target to bind the buffer to
+ @param uiBuffer The ID of the buffer
+ */
+void CGLStateCache::BindBuffer(const GLenum eTarget, const GLuint uiBuffer)
+{
+	GLuint* pBinding = NULL;
+	if (eTarget == GL_ARRAY_BUFFER)
+		pBinding = &uiArrayBuffer;
+	else if (eTarget == GL_ELEMENT_ARRAY_BUFFER)
+		pBinding = &uiElementArrayBuffer;
+
+	if ((pBinding != NULL) && (*pBinding == uiBuffer))
+	{
+		uiCallsSkipped++;
+		return;
+	}
+	glBindBuffer(eTarget, uiBuffer);
+	if (pBinding != NULL)
+		*pBinding = uiBuffer;
+	uiCallsIssued++;
+}
+
+/**
+ @brief Select the active texture unit
+ @param uiUnit The index of the texture unit, i.e. 0 for GL_TEXTURE0
+ */
+void CGLStateCache::ActiveTexture(const unsigned int uiUnit)
+{
+	if (uiActiveTextureUnit == uiUnit)
+	{
+		uiCallsSkipped++;
+		return;
+	}
+	glActiveTexture(GL_TEXTURE0 + uiUnit);
+	uiActiveTextureUnit = uiUnit;
+	uiCallsIssued++;
+}
+
+/**
+ @brief Bind a 2D texture to a texture unit. The texture unit becomes the active one if the texture is bound
+ @param uiUnit The index of the texture unit, i.e. 0 for GL_TEXTURE0
+ @param uiTexture The ID of the texture
+ */
+void CGLStateCache::BindTexture(const unsigned int uiUnit, const GLuint uiTexture)
+{
+	if ((uiUnit < MAX_TEXTURE_UNITS) && (auiTextures[uiUnit] == uiTexture))
+	{
+		uiCallsSkipped++;
+		return;
+	}
+	ActiveTexture(uiUnit);
+	glBindTexture(GL_TEXTURE_2D, uiTexture);
+	if (uiUnit < MAX_TEXTURE_UNITS)
+		auiTextures[uiUnit] = uiTexture;
+	uiCallsIssued++;
+}
+
+/**
+ @brief Delete vertex arrays, and forget their bindings, as OpenGL may give their IDs to new vertex arrays
+ @param iCount The number of vertex arrays
+ @param pVAOs The IDs of the vertex arrays
+ */
+void CGLStateCache::DeleteVertexArrays(const GLsizei iCount, const GLuint* pVAOs)
+{
+	for (GLsizei i = 0; i < iCount; i++)
+	{
+		if (pVAOs[i] == uiVAO)
+		{
+			// OpenGL binds vertex array 0 when the bound vertex array is deleted
+			uiVAO = 0;
+			uiElementArrayBuffer = UNKNOWN;
+		}
+	}
+	glDeleteVertexArrays(iCount, pVAOs);
+}
+
+/**
+ @brief Delete buffers, and forget their bindings, as OpenGL may give their IDs to new buffers
+ @param iCount The number of buffers
+ @param pBuffers The IDs of the buffers
+ */
+void CGLStateCache::DeleteBuffers(const GLsizei iCount, const GLuint* pBuffers)
+{
+	for (GLsizei i = 0; i < iCount; i++)
+	{
+		// OpenGL binds buffer 0 when a bound buffer is deleted
+		if (pBuffers[i] == uiArrayBuffer)
+			uiArrayBuffer = 0;
+		if (pBuffers[i] == uiElementArrayBuffer)
+			uiElementArrayBuffer = 0;
+	}
+	glDeleteBuffers(iCount, pBuffers);
+}
+
+/**
+ @brief Delete textures, and forget their bindings, as OpenGL may give their IDs to new textures
+ @param iCount The number of textures
+ @param pTextures The IDs of the textures
+ */
+void CGLStateCache::DeleteTextures(const GLsizei iCount, const GLuint* pTextures)
+{
+	for (GLsizei i = 0; i < iCount; i++)
+	{
+		// OpenGL binds texture 0 to every unit which the deleted texture was bound to
+		for (unsigned int uiUnit = 0; uiUnit < MAX_TEXTURE_UNITS; uiUnit++)
+		{
+			if (pTextures[i] == auiTextures[uiUnit])
+				auiTextures[uiUnit] = 0;
+		}
+	}
+	glDeleteTextures(iCount, pTextures);
+}
+
+/**
+ @brief Enable or disable blending
+ @param bEnable true to enable blending
+ */
+void CGLStateCache::SetBlend(const bool bEnable)
+{
+	if (iBlendEnabled == (bEnable ? 1 : 0))
+	{
+		uiCallsSkipped++;
+		return;
+	}
+	if (bEnable)
+		glEnable(GL_BLEND);
+	else
+		glDisable(GL_BLEND);
+	iBlendEnabled = (bEnable ? 1 : 0);
+	uiCallsIssued++;
+}
+
+/**
+ @brief Set the blending function
+ @param eSource The source factor
+ @param eDestination The destination factor
+ */
+void CGLStateCache::SetBlendFunc(const GLenum eSource, const GLenum eDestination)
+{
+	if ((eBlendSource == eSource) && (eBlendDestination == eDestination))
+	{
+		uiCallsSkipped++;
+		return;
+	}
+	glBlendFunc(eSource, eDestination);
+	eBlendSource = eSource;
+	eBlendDestination = eDestination;
+	uiCallsIssued++;
+}
+
+/**
+ @brief Forget the state, so that the next calls are all made.
+		Use this after code which changes the state directly, e.g. deleting a bound object
+ */
+void CGLStateCache::Invalidate(void)
+{
+	uiProgram = UNKNOWN;
+	uiVAO = UNKNOWN;
+	uiArrayBuffer = UNKNOWN;
+	uiElementArrayBuffer = UNKNOWN;
+	uiActiveTextureUnit = UNKNOWN;
+	for (unsigned int i = 0; i < MAX_TEXTURE_UNITS; i++)
+		auiTextures[i] = UNKNOWN;
+	iBlendEnabled = -1;
+	eBlendSource = GL_NONE;
+	eBlendDestination = GL_NONE;
+}
+
+/**
+ @brief Store the counts of the frame and start counting the next one.
+		The state is forgotten too, so that a change made outside this class lasts at most one frame
+ */
+void CGLStateCache::EndFrame(void)
+{
+	uiLastCallsIssued = uiCallsIssued;
+	uiLastCallsSkipped = uiCallsSkipped;
+	uiCallsIssued = 0;
+	uiCallsSkipped = 0;
+	Invalidate();
+}
+
+/**
+ @brief Get the number of calls which were made in the last complete frame
+ */
+unsigned int CGLStateCache::GetCallsIssued(void) const
+{
+	return uiLastCallsIssued;
+}
+
+/**
+ @brief Get the number of calls which were skipped in the last complete frame
+ */
+unsigned int CGLStateCache::GetCallsSkipped(void) const
+{
+	return uiLastCallsSkipped;
+}
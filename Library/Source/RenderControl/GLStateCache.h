@@ -0,0 +1,89 @@
+/**
+ CGLStateCache
+ @brief This class remembers the OpenGL state which the game sets most often, i.e. the shader program,
+		vertex array, buffers, textures and blending, and skips the calls which would not change it.
+		All the code which changes this state must go through this class, or call Invalidate() after it.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "..\DesignPatterns\SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+class CGLStateCache : public CSingletonTemplate<CGLStateCache>
+{
+	friend CSingletonTemplate<CGLStateCache>;
+public:
+	// The number of texture units which are tracked
+	static const unsigned int MAX_TEXTURE_UNITS = 8;
+
+	// Use a shader program
+	void UseProgram(const GLuint uiProgram);
+
+	// Bind a vertex array object. The element array buffer is part of the vertex array's state
+	void BindVertexArray(const GLuint uiVAO);
+
+	// Bind a buffer to GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
+	void BindBuffer(const GLenum eTarget, const GLuint uiBuffer);
+
+	// Select the active texture unit
+	void ActiveTexture(const unsigned int uiUnit);
+
+	// Bind a 2D texture to a texture unit
+	void BindTexture(const unsigned int uiUnit, const GLuint uiTexture);
+
+	// Delete vertex arrays and buffers, and forget their bindings, as OpenGL may reuse their IDs
+	void DeleteVertexArrays(const GLsizei iCount, const GLuint* pVAOs);
+	void DeleteBuffers(const GLsizei iCount, const GLuint* pBuffers);
+	// Delete textures, and forget their bindings
+	void DeleteTextures(const GLsizei iCount, const GLuint* pTextures);
+
+	// Enable or disable blending, and set the blending function
+	void SetBlend(const bool bEnable);
+	void SetBlendFunc(const GLenum eSource, const GLenum eDestination);
+
+	// Forget the state, so that the next calls are all made. Use this after code which changes the state directly
+	void Invalidate(void);
+
+	// Store the counts of the frame and start counting the next one
+	void EndFrame(void);
+
+	// Get the number of calls which were made and skipped in the last complete frame
+	unsigned int GetCallsIssued(void) const;
+	unsigned int GetCallsSkipped(void) const;
+
+protected:
+	// The value of an unknown binding
+	static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+	// The bound objects
+	GLuint uiProgram;
+	GLuint uiVAO;
+	GLuint uiArrayBuffer;
+	GLuint uiElementArrayBuffer;
+	unsigned int uiActiveTextureUnit;
+	GLuint auiTextures[MAX_TEXTURE_UNITS];
+
+	// The blending state. -1 if unknown
+	int iBlendEnabled;
+	GLenum eBlendSource;
+	GLenum eBlendDestination;
+
+	// The counts of the current frame
+	unsigned int uiCallsIssued;
+	unsigned int uiCallsSkipped;
+	// The counts of the last complete frame
+	unsigned int uiLastCallsIssued;
+	unsigned int uiLastCallsSkipped;
+
+	// Constructor
+	CGLStateCache(void);
+
+	// Destructor
+	virtual ~CGLStateCache(void);
+};
@@ -0,0 +1,470 @@
+/**
+ CRetainedHUD
+ @brief This class keeps the geometry of HUD widgets which are built with IMGUI, and redraws it every frame
+		without running IMGUI. Each widget is rebuilt only when its state or the screen size changes.
+		The cached vertices of all the widgets are kept in one vertex buffer, and the commands are merged by
+		texture wherever the drawing order allows it, so an unchanged HUD costs a few draw calls and no CPU work.
+ */
+#include "RetainedHUD.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+#include <includes/gtc/matrix_transform.hpp>
+
+// Include CShaderManager to activate the shader of the HUD
+#include "ShaderManager.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "GLStateCache.h"
+// Include CMemoryTracker to count the OpenGL objects
+#include "..\System\MemoryTracker.h"
+// Include CProfiler to measure the rebuilds
+#include "..\TimeControl\Profiler.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Check if two rectangles (x1, y1, x2, y2) overlap
+ */
+static bool Overlaps(const ImVec4& a, const ImVec4& b)
+{
+	return (a.x < b.z) && (b.x < a.z) && (a.y < b.w) && (b.y < a.w);
+}
+
+/**
+ @brief Constructor
+ */
+CRetainedHUD::CRetainedHUD(void)
+	: VAO(0)
+	, VBO(0)
+	, EBO(0)
+	, iShaderHandle(-1)
+	, bUploadNeeded(false)
+	, iScreenWidth(0)
+	, iScreenHeight(0)
+	, vec2FramebufferScale(1.0f, 1.0f)
+	, uiDrawCalls(0)
+	, uiRebuiltWidgets(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CRetainedHUD::~CRetainedHUD(void)
+{
+	if (VAO != 0)
+	{
+		CGLStateCache::GetInstance()->DeleteVertexArrays(1, &VAO);
+		MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, -1);
+		VAO = 0;
+	}
+	if (VBO != 0)
+	{
+		CGLStateCache::GetInstance()->DeleteBuffers(1, &VBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
+		VBO = 0;
+	}
+	if (EBO != 0)
+	{
+		CGLStateCache::GetInstance()->DeleteBuffers(1, &EBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
+		EBO = 0;
+	}
+}
+
+/**
+ @brief Initialise the buffers, and set the shader and the number of widgets.
+		The vertex layout is the layout of ImDrawVert, and it is set up once here.
+ @param sShaderName The name of the shader in CShaderManager
+ @param uiNumWidgets The number of widgets. The widgets are drawn in the order of their indices
+ @return true if the HUD was initialised, otherwise false
+ */
+bool CRetainedHUD::Init(const std::string& sShaderName, const unsigned int uiNumWidgets)
+{
+	iShaderHandle = CShaderManager::GetInstance()->GetHandle(sShaderName);
+	if (iShaderHandle < 0)
+	{
+		cout << "CRetainedHUD::Init - Unable to find the shader " << sShaderName << endl;
+		return false;
+	}
+
+	if (VAO == 0)
+	{
+		glGenVertexArrays(1, &VAO);
+		MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+		glGenBuffers(1, &VBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, 1);
+		glGenBuffers(1, &EBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, 1);
+		if ((VAO == 0) || (VBO == 0) || (EBO == 0))
+		{
+			cout << "CRetainedHUD::Init - Unable to create the OpenGL buffers" << endl;
+			return false;
+		}
+
+		CGLStateCache::GetInstance()->BindVertexArray(VAO);
+		CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+		CGLStateCache::GetInstance()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+		// Use the same attribute locations as the other 2D shaders
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (void*)offsetof(ImDrawVert, pos));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (void*)offsetof(ImDrawVert, col));
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (void*)offsetof(ImDrawVert, uv));
+
+		CGLStateCache::GetInstance()->BindVertexArray(0);
+	}
+
+	vWidgets.clear();
+	vWidgets.resize(uiNumWidgets);
+	for (unsigned int i = 0; i < vWidgets.size(); i++)
+	{
+		vWidgets[i].bVisible = true;
+		vWidgets[i].iRebuildFrames = REBUILD_FRAMES;
+		vWidgets[i].pDrawList = NULL;
+	}
+	vRuns.clear();
+	bUploadNeeded = true;
+
+	return true;
+}
+
+/**
+ @brief Set the size of the screen. All the widgets are rebuilt when it changes
+ @param iWidth The width of the screen
+ @param iHeight The height of the screen
+ */
+void CRetainedHUD::SetScreenSize(const int iWidth, const int iHeight)
+{
+	if ((iScreenWidth == iWidth) && (iScreenHeight == iHeight))
+		return;
+
+	iScreenWidth = iWidth;
+	iScreenHeight = iHeight;
+	for (unsigned int i = 0; i < vWidgets.size(); i++)
+	{
+		if (vWidgets[i].bVisible)
+			vWidgets[i].iRebuildFrames = REBUILD_FRAMES;
+	}
+}
+
+/**
+ @brief Set the state of a widget. The widget is rebuilt when the state changes
+ @param uiWidget The index of the widget
+ @param state The values which the widget displays
+ */
+void CRetainedHUD::SetWidgetState(const unsigned int uiWidget, const WidgetState& state)
+{
+	if (uiWidget >= vWidgets.size())
+		return;
+
+	Widget& widget = vWidgets[uiWidget];
+	if ((widget.bVisible == false) || (widget.state != state))
+	{
+		widget.state = state;
+		widget.bVisible = true;
+		widget.iRebuildFrames = REBUILD_FRAMES;
+	}
+}
+
+/**
+ @brief Remove the geometry of a widget, e.g. when it is hidden. It is rebuilt when its state is set again
+ @param uiWidget The index of the widget
+ */
+void CRetainedHUD::ClearWidget(const unsigned int uiWidget)
+{
+	if (uiWidget >= vWidgets.size())
+		return;
+
+	Widget& widget = vWidgets[uiWidget];
+	if (widget.vCommands.size() > 0)
+		bUploadNeeded = true;
+	widget.vVertices.clear();
+	widget.vIndices.clear();
+	widget.vCommands.clear();
+	widget.pDrawList = NULL;
+	widget.bVisible = false;
+	widget.iRebuildFrames = 0;
+}
+
+/**
+ @brief Check if any widget must be rebuilt this frame
+ */
+bool CRetainedHUD::IsRebuildNeeded(void) const
+{
+	for (unsigned int i = 0; i < vWidgets.size(); i++)
+	{
+		if (vWidgets[i].iRebuildFrames > 0)
+			return true;
+	}
+	return false;
+}
+
+/**
+ @brief Check if a widget must be rebuilt this frame
+ @param uiWidget The index of the widget
+ */
+bool CRetainedHUD::IsRebuildNeeded(const unsigned int uiWidget) const
+{
+	return (uiWidget < vWidgets.size()) && (vWidgets[uiWidget].iRebuildFrames > 0);
+}
+
+/**
+ @brief Set the draw list which a widget is being rebuilt into. Call it between the Begin and End of the widget's window
+ @param uiWidget The index of the widget
+ @param pDrawList The draw list of the widget's window, i.e. ImGui::GetWindowDrawList()
+ */
+void CRetainedHUD::SetWidgetDrawList(const unsigned int uiWidget, ImDrawList* pDrawList)
+{
+	if (uiWidget >= vWidgets.size())
+		return;
+
+	vWidgets[uiWidget].pDrawList = pDrawList;
+}
+
+/**
+ @brief Copy the geometry of the rebuilt widgets from the draw data of ImGui::Render().
+		A widget whose window was not rendered, e.g. as IMGUI hides new windows for a frame, is rebuilt again
+ @param pDrawData The draw data of this frame
+ */
+void CRetainedHUD::Capture(const ImDrawData* pDrawData)
+{
+	PROFILE_SCOPE("CRetainedHUD::Capture");
+
+	uiRebuiltWidgets = 0;
+	if (pDrawData == NULL)
+		return;
+
+	vec2FramebufferScale = pDrawData->FramebufferScale;
+
+	for (unsigned int i = 0; i < vWidgets.size(); i++)
+	{
+		Widget& widget = vWidgets[i];
+		if (widget.pDrawList == NULL)
+			continue;
+
+		bool bRendered = false;
+		for (int j = 0; j < pDrawData->CmdListsCount; j++)
+		{
+			if (pDrawData->CmdLists[j] == widget.pDrawList)
+			{
+				bRendered = true;
+				break;
+			}
+		}
+
+		if (bRendered)
+		{
+			const ImDrawList* pDrawList = widget.pDrawList;
+			widget.vVertices.assign(pDrawList->VtxBuffer.begin(), pDrawList->VtxBuffer.end());
+			widget.vIndices.assign(pDrawList->IdxBuffer.begin(), pDrawList->IdxBuffer.end());
+			widget.vCommands.clear();
+			for (int j = 0; j < pDrawList->CmdBuffer.Size; j++)
+			{
+				// The HUD does not use callbacks
+				if ((pDrawList->CmdBuffer[j].UserCallback == NULL) && (pDrawList->CmdBuffer[j].ElemCount > 0))
+					widget.vCommands.push_back(pDrawList->CmdBuffer[j]);
+			}
+			widget.iRebuildFrames--;
+			bUploadNeeded = true;
+			uiRebuiltWidgets++;
+		}
+		widget.pDrawList = NULL;
+	}
+}
+
+/**
+ @brief Check if a draw list belongs to a widget which is being rebuilt,
+		so that it is not drawn again with the rest of the IMGUI draw data
+ @param pDrawList The draw list
+ */
+bool CRetainedHUD::IsWidgetDrawList(const ImDrawList* pDrawList) const
+{
+	for (unsigned int i = 0; i < vWidgets.size(); i++)
+	{
+		if (vWidgets[i].pDrawList == pDrawList)
+			return true;
+	}
+	return false;
+}
+
+/**
+ @brief Merge the geometry of all the widgets into the buffers.
+		A command is added to the latest run with the same texture and clipping, unless a run drawn after that one
+		overlaps it. This keeps the result of the drawing order, while most commands share a few runs
+ */
+void CRetainedHUD::Upload(void)
+{
+	PROFILE_SCOPE("CRetainedHUD::Upload");
+
+	vRuns.clear();
+	std::vector<ImDrawVert> vVertices;
+	for (unsigned int i = 0; i < vWidgets.size(); i++)
+	{
+		const Widget& widget = vWidgets[i];
+		const unsigned int uiBaseVertex = (unsigned int)vVertices.size();
+		vVertices.insert(vVertices.end(), widget.vVertices.begin(), widget.vVertices.end());
+
+		for (unsigned int j = 0; j < widget.vCommands.size(); j++)
+		{
+			const ImDrawCmd& command = widget.vCommands[j];
+
+			// Find the bounds of the command's triangles
+			ImVec4 bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+			for (unsigned int k = command.IdxOffset; k < command.IdxOffset + command.ElemCount; k++)
+			{
+				const ImVec2& pos = widget.vVertices[command.VtxOffset + widget.vIndices[k]].pos;
+				bounds.x = std::min(bounds.x, pos.x);
+				bounds.y = std::min(bounds.y, pos.y);
+				bounds.z = std::max(bounds.z, pos.x);
+				bounds.w = std::max(bounds.w, pos.y);
+			}
+
+			// The clipping only matters if it cuts the triangles
+			const ImVec4& clipRect = command.ClipRect;
+			const bool bClip = (bounds.x < clipRect.x) || (bounds.y < clipRect.y) ||
+								(bounds.z > clipRect.z) || (bounds.w > clipRect.w);
+
+			// Look for a run which the command can be merged into
+			int iRun = -1;
+			for (int k = (int)vRuns.size() - 1; k >= 0; k--)
+			{
+				const DrawRun& run = vRuns[k];
+				if ((run.textureID == command.TextureId) && (run.bClip == bClip) &&
+					((bClip == false) ||
+					 ((run.clipRect.x == clipRect.x) && (run.clipRect.y == clipRect.y) &&
+					  (run.clipRect.z == clipRect.z) && (run.clipRect.w == clipRect.w))))
+				{
+					iRun = k;
+					break;
+				}
+				// The command must be drawn after this run
+				if (Overlaps(run.bounds, bounds))
+					break;
+			}
+			if (iRun < 0)
+			{
+				vRuns.push_back(DrawRun());
+				DrawRun& run = vRuns.back();
+				run.textureID = command.TextureId;
+				run.clipRect = clipRect;
+				run.bClip = bClip;
+				run.bounds = bounds;
+				iRun = (int)vRuns.size() - 1;
+			}
+
+			DrawRun& run = vRuns[iRun];
+			run.bounds.x = std::min(run.bounds.x, bounds.x);
+			run.bounds.y = std::min(run.bounds.y, bounds.y);
+			run.bounds.z = std::max(run.bounds.z, bounds.z);
+			run.bounds.w = std::max(run.bounds.w, bounds.w);
+			for (unsigned int k = command.IdxOffset; k < command.IdxOffset + command.ElemCount; k++)
+				run.vIndices.push_back(uiBaseVertex + command.VtxOffset + widget.vIndices[k]);
+		}
+	}
+
+	// Put the indices of the runs one after another
+	std::vector<unsigned int> vIndices;
+	for (unsigned int i = 0; i < vRuns.size(); i++)
+	{
+		DrawRun& run = vRuns[i];
+		run.uiIndexOffset = (unsigned int)vIndices.size();
+		run.uiIndexCount = (unsigned int)run.vIndices.size();
+		vIndices.insert(vIndices.end(), run.vIndices.begin(), run.vIndices.end());
+		run.vIndices.clear();
+	}
+
+	if (vIndices.size() > 0)
+	{
+		CGLStateCache::GetInstance()->BindVertexArray(VAO);
+		CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBufferData(GL_ARRAY_BUFFER, vVertices.size() * sizeof(ImDrawVert), &vVertices[0], GL_DYNAMIC_DRAW);
+		CGLStateCache::GetInstance()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, vIndices.size() * sizeof(GLuint), &vIndices[0], GL_DYNAMIC_DRAW);
+	}
+
+	bUploadNeeded = false;
+}
+
+/**
+ @brief Draw the cached geometry of all the widgets
+ */
+void CRetainedHUD::Render(void)
+{
+	uiDrawCalls = 0;
+	if ((iScreenWidth <= 0) || (iScreenHeight <= 0))
+		return;
+
+	if (bUploadNeeded)
+		Upload();
+	if (vRuns.size() == 0)
+		return;
+
+	// Same projection as IMGUI: the origin is at the top left of the screen, in pixels
+	CShaderManager::GetInstance()->Use(iShaderHandle);
+	CShaderManager::GetInstance()->activeShader->setMat4("projection",
+		glm::ortho(0.0f, (float)iScreenWidth, (float)iScreenHeight, 0.0f));
+
+	// Activate blending mode
+	CGLStateCache::GetInstance()->SetBlend(true);
+	CGLStateCache::GetInstance()->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
+
+	const float fFramebufferHeight = iScreenHeight * vec2FramebufferScale.y;
+	bool bScissor = false;
+	for (unsigned int i = 0; i < vRuns.size(); i++)
+	{
+		const DrawRun& run = vRuns[i];
+		if (run.bClip)
+		{
+			if (bScissor == false)
+			{
+				glEnable(GL_SCISSOR_TEST);
+				bScissor = true;
+			}
+			glScissor(	(int)(run.clipRect.x * vec2FramebufferScale.x),
+						(int)(fFramebufferHeight - run.clipRect.w * vec2FramebufferScale.y),
+						(int)((run.clipRect.z - run.clipRect.x) * vec2FramebufferScale.x),
+						(int)((run.clipRect.w - run.clipRect.y) * vec2FramebufferScale.y));
+		}
+		else if (bScissor)
+		{
+			glDisable(GL_SCISSOR_TEST);
+			bScissor = false;
+		}
+
+		CGLStateCache::GetInstance()->BindTexture(0, (GLuint)(intptr_t)run.textureID);
+		glDrawElements(GL_TRIANGLES, run.uiIndexCount, GL_UNSIGNED_INT, (void*)(run.uiIndexOffset * sizeof(GLuint)));
+		uiDrawCalls++;
+	}
+	if (bScissor)
+		glDisable(GL_SCISSOR_TEST);
+}
+
+/**
+ @brief Get the number of draw calls of the last Render
+ */
+unsigned int CRetainedHUD::GetDrawCalls(void) const
+{
+	return uiDrawCalls;
+}
+
+/**
+ @brief Get the number of widgets which were rebuilt by the last Capture
+ */
+unsigned int CRetainedHUD::GetRebuiltWidgets(void) const
+{
+	return uiRebuiltWidgets;
+}
@@ -0,0 +1,141 @@
+/**
+ CRetainedHUD
+ @brief This class keeps the geometry of HUD widgets which are built with IMGUI, and redraws it every frame
+		without running IMGUI. Each widget is rebuilt only when its state or the screen size changes.
+		The cached vertices of all the widgets are kept in one vertex buffer, and the commands are merged by
+		texture wherever the drawing order allows it, so an unchanged HUD costs a few draw calls and no CPU work.
+ */
+#pragma once
+
+// Include IMGUI for its draw lists
+#include "..\GUI\imgui.h"
+
+#include <string>
+#include <vector>
+
+class CRetainedHUD
+{
+public:
+	// The number of values which describe the state of a widget
+	static const unsigned int MAX_STATE_VALUES = 4;
+	// IMGUI fits an auto-resized window to its contents one frame late, so a changed widget is rebuilt on this many frames
+	static const int REBUILD_FRAMES = 2;
+
+	// The values which a widget displays. The widget is rebuilt when any of them changes
+	struct WidgetState
+	{
+		int aiValues[MAX_STATE_VALUES];
+
+		WidgetState(const int iValue0 = 0, const int iValue1 = 0, const int iValue2 = 0, const int iValue3 = 0)
+		{
+			aiValues[0] = iValue0;
+			aiValues[1] = iValue1;
+			aiValues[2] = iValue2;
+			aiValues[3] = iValue3;
+		}
+
+		bool operator!=(const WidgetState& rhs) const
+		{
+			for (unsigned int i = 0; i < MAX_STATE_VALUES; i++)
+			{
+				if (aiValues[i] != rhs.aiValues[i])
+					return true;
+			}
+			return false;
+		}
+	};
+
+	// Constructor
+	CRetainedHUD(void);
+
+	// Destructor
+	virtual ~CRetainedHUD(void);
+
+	// Initialise the buffers, and set the shader and the number of widgets
+	bool Init(const std::string& sShaderName, const unsigned int uiNumWidgets);
+
+	// Set the size of the screen. All the widgets are rebuilt when it changes
+	void SetScreenSize(const int iWidth, const int iHeight);
+
+	// Set the state of a widget. The widget is rebuilt when the state changes
+	void SetWidgetState(const unsigned int uiWidget, const WidgetState& state);
+
+	// Remove the geometry of a widget, e.g. when it is hidden
+	void ClearWidget(const unsigned int uiWidget);
+
+	// Check if any widget, or a widget, must be rebuilt this frame
+	bool IsRebuildNeeded(void) const;
+	bool IsRebuildNeeded(const unsigned int uiWidget) const;
+
+	// Set the draw list which a widget is being rebuilt into. Call it between the Begin and End of the widget's window
+	void SetWidgetDrawList(const unsigned int uiWidget, ImDrawList* pDrawList);
+
+	// Check if a draw list belongs to a widget which is being rebuilt. Call it before Capture
+	bool IsWidgetDrawList(const ImDrawList* pDrawList) const;
+
+	// Copy the geometry of the rebuilt widgets from the draw data of ImGui::Render()
+	void Capture(const ImDrawData* pDrawData);
+
+	// Draw the cached geometry of all the widgets
+	void Render(void);
+
+	// Get the number of draw calls of the last Render, and the number of rebuilt widgets of the last Capture
+	unsigned int GetDrawCalls(void) const;
+	unsigned int GetRebuiltWidgets(void) const;
+
+protected:
+	// The cached geometry and state of a widget
+	struct Widget
+	{
+		WidgetState state;
+		// false if the widget is hidden
+		bool bVisible;
+		// The number of frames which the widget must still be rebuilt on. 0 if the geometry matches the state
+		int iRebuildFrames;
+		// The draw list which the widget is being rebuilt into. NULL when the widget is not being rebuilt
+		ImDrawList* pDrawList;
+		// The vertices, indices and commands copied from the draw list
+		std::vector<ImDrawVert> vVertices;
+		std::vector<ImDrawIdx> vIndices;
+		std::vector<ImDrawCmd> vCommands;
+	};
+
+	// A run of indices which is drawn with one glDrawElements
+	struct DrawRun
+	{
+		ImTextureID textureID;
+		// The clipping rectangle (x1, y1, x2, y2). Unused if bClip is false
+		ImVec4 clipRect;
+		bool bClip;
+		// The bounding rectangle of the run's triangles, to check if a later command may be merged into it
+		ImVec4 bounds;
+		std::vector<unsigned int> vIndices;
+		// The first index and number of indices in the index buffer
+		unsigned int uiIndexOffset;
+		unsigned int uiIndexCount;
+	};
+
+	// OpenGL objects
+	unsigned int VAO, VBO, EBO;
+
+	// The handle of the shader in CShaderManager
+	int iShaderHandle;
+
+	// The widgets
+	std::vector<Widget> vWidgets;
+	// The runs of the merged geometry
+	std::vector<DrawRun> vRuns;
+	// true if the merged geometry must be uploaded again
+	bool bUploadNeeded;
+
+	// The screen size, and the scale from the screen to the framebuffer
+	int iScreenWidth, iScreenHeight;
+	ImVec2 vec2FramebufferScale;
+
+	// The statistics
+	unsigned int uiDrawCalls;
+	unsigned int uiRebuiltWidgets;
+
+	// Merge the geometry of all the widgets into the buffers
+	void Upload(void);
+};
@@ -7,6 +7,9 @@
 #include "ShaderManager.h"
 #include <stdexcept>      // std::invalid_argument
 
+// Include CGLStateCache to skip using a shader which is already in use
+#include "GLStateCache.h"
+
 /**
 @brief Constructor
 */
@@ -32,14 +35,17 @@ void CShaderManager::Exit(void)
 	// Delete all scenes stored and empty the entire map
 	//activeShader->Release();
 	//activeShader = nullptr;
-	std::map<std::string, CShader*>::iterator it, end;
-	end = shaderMap.end();
-	for (it = shaderMap.begin(); it != end; ++it)
+	for (unsigned int i = 0; i < shaderList.size(); i++)
 	{
-		delete it->second;
-		it->second = nullptr;
+		delete shaderList[i];
+		shaderList[i] = nullptr;
 	}
+	shaderList.clear();
 	shaderMap.clear();
+	activeShader = nullptr;
+
+	// A new program may get the ID of a deleted one
+	CGLStateCache::GetInstance()->Invalidate();
 }
 
 /**
@@ -61,7 +67,8 @@ void CShaderManager::Add(	const std::string& _name,
 	CShader* cNewShader = new CShader(vertexPath, fragmentPath);
 
 	// Nothing wrong, add the scene to our map
-	shaderMap[_name] = cNewShader;
+	shaderMap[_name] = (int)shaderList.size();
+	shaderList.push_back(cNewShader);
 }
 
 /**
@@ -73,7 +80,8 @@ void CShaderManager::Remove(const std::string& _name)
 	if (!Check(_name))
 		return;
 
-	CShader* target = shaderMap[_name];
+	const int iHandle = shaderMap[_name];
+	CShader* target = shaderList[iHandle];
 	try {
 		if (target == activeShader)
 		{
@@ -86,16 +94,44 @@ void CShaderManager::Remove(const std::string& _name)
 
 	// Delete and remove from our map
 	delete target;
+	shaderList[iHandle] = nullptr;
 	shaderMap.erase(_name);
+	if (target == activeShader)
+		activeShader = nullptr;
+
+	// A new program may get the ID of the deleted one
+	CGLStateCache::GetInstance()->Invalidate();
 }
 
 /**
 @brief Use a Shader
 */
 void CShaderManager::Use(const std::string& _name)
+{
+	Use(GetHandle(_name));
+}
+
+/**
+@brief Get the handle of a Shader, so that it can be used without looking up its name
+@param _name The name of the Shader
+@return The handle of the Shader, or -1 if it does not exist
+*/
+int CShaderManager::GetHandle(const std::string& _name)
+{
+	std::map<std::string, int>::iterator it = shaderMap.find(_name);
+	if (it == shaderMap.end())
+		return -1;
+	return it->second;
+}
+
+/**
+@brief Use a Shader by its handle
+@param iHandle The handle from GetHandle
+*/
+void CShaderManager::Use(const int iHandle)
 {
 	try {
-		if (!Check(_name))
+		if ((iHandle < 0) || (iHandle >= (int)shaderList.size()) || (shaderList[iHandle] == nullptr))
 		{
 			// Shader does not exist
 			throw std::exception("Shader does not exist");
@@ -103,11 +139,12 @@ void CShaderManager::Use(const std::string& _name)
 	}
 	catch (const std::exception& e) {
 		std::cerr << e.what() << std::endl;
+		return;
 	}
 
 	// if Shader exist, set the activeShader pointer to that Shader
-	activeShader = shaderMap[_name];
-	activeShader->use();
+	activeShader = shaderList[iHandle];
+	CGLStateCache::GetInstance()->UseProgram(activeShader->ID);
 }
 
 /**
@@ -11,6 +11,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include "Shader.h"
 
 class CShaderManager : public CSingletonTemplate<CShaderManager>
@@ -25,6 +26,11 @@ public:
 	void Use(const std::string& _name);
 	bool Check(const std::string& _name);
 
+	// Get the handle of a shader, so that it can be used without looking up its name. -1 if it does not exist
+	int GetHandle(const std::string& _name);
+	// Use a shader by its handle
+	void Use(const int iHandle);
+
 	// The current active shader
 	CShader* activeShader;
 
@@ -35,6 +41,8 @@ protected:
 	// Destructor
 	virtual ~CShaderManager(void);
 
-	// The map containing all the shaders loaded
-	std::map<std::string, CShader*> shaderMap;
+	// The map containing the handles of all the shaders loaded
+	std::map<std::string, int> shaderMap;
+	// The shaders, indexed by their handles. A removed shader leaves a nullptr, so the other handles stay valid
+	std::vector<CShader*> shaderList;
 };
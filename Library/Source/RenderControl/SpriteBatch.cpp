@@ -0,0 +1,347 @@
+/**
+ CSpriteBatch
+ @brief This class collects textured quads during a frame, and draws them with as few draw calls as possible.
+		Each quad is one instance in a streaming instance buffer, and the vertex shader works out its corners
+		and the texture coordinates of its frame, so the sprites of a sheet are drawn together whichever
+		frames they show. Each run of instances with the same shader and texture is drawn with one call.
+ */
+#include "SpriteBatch.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include CShaderManager to activate the shaders of the sprites
+#include "ShaderManager.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "GLStateCache.h"
+// Include CFrameArena for the sort keys, which only live for a Flush
+#include "..\System\FrameArena.h"
+// Include CMemoryTracker to count the OpenGL objects
+#include "..\System\MemoryTracker.h"
+// Include CProfiler to measure the Flush
+#include "..\TimeControl\Profiler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CSpriteBatch::CSpriteBatch(void)
+	: VAO(0)
+	, VBO(0)
+	, EBO(0)
+	, IBO(0)
+	, uiCurrentShader(0)
+	, uiSpriteCount(0)
+	, uiDrawCalls(0)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CSpriteBatch::~CSpriteBatch(void)
+{
+	if (VAO != 0)
+	{
+		CGLStateCache::GetInstance()->DeleteVertexArrays(1, &VAO);
+		MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, -1);
+		VAO = 0;
+	}
+	if (VBO != 0)
+	{
+		CGLStateCache::GetInstance()->DeleteBuffers(1, &VBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
+		VBO = 0;
+	}
+	if (EBO != 0)
+	{
+		CGLStateCache::GetInstance()->DeleteBuffers(1, &EBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
+		EBO = 0;
+	}
+	if (IBO != 0)
+	{
+		CGLStateCache::GetInstance()->DeleteBuffers(1, &IBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, -1);
+		IBO = 0;
+	}
+}
+
+/**
+ @brief Initialise the vertex, index and instance buffers, and set the default shader.
+		The vertex layout is set up once here, so drawing only binds the VAO.
+ @param sShaderName The name of the default shader in CShaderManager
+ @return true if the batch was initialised, otherwise false
+ */
+bool CSpriteBatch::Init(const std::string& sShaderName)
+{
+	// Only create the buffers once, as every game state shares this batch
+	if (VAO == 0)
+	{
+		glGenVertexArrays(1, &VAO);
+		MEMORY_TRACK_GL(VERTEX_ARRAY_OBJECT, 1);
+		glGenBuffers(1, &VBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, 1);
+		glGenBuffers(1, &EBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, 1);
+		glGenBuffers(1, &IBO);
+		MEMORY_TRACK_GL(BUFFER_OBJECT, 1);
+		if ((VAO == 0) || (VBO == 0) || (EBO == 0) || (IBO == 0))
+		{
+			cout << "CSpriteBatch::Init - Unable to create the OpenGL buffers" << endl;
+			return false;
+		}
+
+		CGLStateCache::GetInstance()->BindVertexArray(VAO);
+
+		// The corners of the unit quad never change, so they are uploaded once.
+		// Same corners as CMeshBuilder::GenerateQuad: bottom left, bottom right, top right, top left
+		const GLfloat arrCorners[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+		CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(arrCorners), arrCorners, GL_STATIC_DRAW);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (void*)0);
+
+		// Same winding as CMeshBuilder::GenerateQuad
+		const GLuint arrIndices[] = { 3, 0, 2, 1, 2, 0 };
+		CGLStateCache::GetInstance()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(arrIndices), arrIndices, GL_STATIC_DRAW);
+
+		// The instance buffer is refilled every frame, and each attribute advances once per quad
+		CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, IBO);
+		glBufferData(GL_ARRAY_BUFFER, MAX_SPRITES * sizeof(BatchInstance), NULL, GL_STREAM_DRAW);
+		for (GLuint i = 1; i <= 6; i++)
+		{
+			glEnableVertexAttribArray(i);
+			glVertexAttribDivisor(i, 1);
+		}
+		SetInstanceOffset(0);
+
+		CGLStateCache::GetInstance()->BindVertexArray(0);
+
+		// Reserve the space for a full batch, so adding sprites does not allocate during a frame
+		vSprites.reserve(MAX_SPRITES);
+		vInstances.reserve(MAX_SPRITES);
+	}
+
+	vShaderHandles.clear();
+	uiCurrentShader = 0;
+	SetShader(sShaderName);
+
+	return true;
+}
+
+/**
+ @brief Set the shader which the following sprites are drawn with. It must use the BatchInstance layout
+ @param sShaderName The name of the shader in CShaderManager
+ */
+void CSpriteBatch::SetShader(const std::string& sShaderName)
+{
+	const int iHandle = CShaderManager::GetInstance()->GetHandle(sShaderName);
+	for (unsigned int i = 0; i < vShaderHandles.size(); i++)
+	{
+		if (vShaderHandles[i] == iHandle)
+		{
+			uiCurrentShader = i;
+			return;
+		}
+	}
+	vShaderHandles.push_back(iHandle);
+	uiCurrentShader = (unsigned int)vShaderHandles.size() - 1;
+}
+
+/**
+ @brief Add a quad to the batch
+ @param eLayer The layer of the quad. Lower layers are drawn first
+ @param uiTextureID The texture of the quad
+ @param transform The transformation from the quad's space to clip space, e.g. MVP * model
+ @param vec2Size The width and height of the quad, which is centred on the origin
+ @param vec4UVRect The texture coordinates of the bottom left (x, y) and top right (z, w) corners
+ @param vec4Colour The colour which the texture is multiplied with
+ */
+void CSpriteBatch::Draw(const SPRITE_LAYER eLayer,
+						const unsigned int uiTextureID,
+						const glm::mat4& transform,
+						const glm::vec2& vec2Size,
+						const glm::vec4& vec4UVRect,
+						const glm::vec4& vec4Colour)
+{
+	// The whole texture rectangle is one frame
+	AddSprite(eLayer, uiTextureID, transform, vec2Size, vec4UVRect, 0, 1, 1, vec4Colour);
+}
+
+/**
+ @brief Add a quad which shows a frame of a sprite sheet to the batch. The vertex shader works out
+		the texture coordinates of the frame, the same way as CSpriteSheet::GetFrameUVRect
+ @param eLayer The layer of the quad. Lower layers are drawn first
+ @param uiTextureID The texture of the sprite sheet
+ @param transform The transformation from the quad's space to clip space, e.g. MVP * model
+ @param vec2Size The width and height of the quad, which is centred on the origin
+ @param iFrame The frame, which is numbered from the top left of the sprite sheet, row by row
+ @param iNumRows The number of rows of frames in the sprite sheet
+ @param iNumCols The number of columns of frames in the sprite sheet
+ @param vec4Colour The colour which the texture is multiplied with
+ */
+void CSpriteBatch::DrawFrame(	const SPRITE_LAYER eLayer,
+								const unsigned int uiTextureID,
+								const glm::mat4& transform,
+								const glm::vec2& vec2Size,
+								const int iFrame,
+								const int iNumRows,
+								const int iNumCols,
+								const glm::vec4& vec4Colour)
+{
+	AddSprite(eLayer, uiTextureID, transform, vec2Size, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+			  iFrame, iNumRows, iNumCols, vec4Colour);
+}
+
+/**
+ @brief Sort and draw all the sprites added since the last Flush
+ */
+void CSpriteBatch::Flush(void)
+{
+	PROFILE_SCOPE("CSpriteBatch::Flush");
+
+	uiSpriteCount = (unsigned int)vSprites.size();
+	uiDrawCalls = 0;
+	if (vSprites.size() == 0)
+		return;
+
+	// Sort by layer, then shader, then texture. The index in the lowest bits keeps the sort stable
+	FrameVector<unsigned long long> vKeys;
+	vKeys.reserve(vSprites.size());
+	for (unsigned int i = 0; i < vSprites.size(); i++)
+	{
+		const BatchSprite& sprite = vSprites[i];
+		vKeys.push_back(((unsigned long long)(sprite.uiLayer & 0xFF) << 56) |
+						((unsigned long long)(sprite.uiShader & 0xFF) << 48) |
+						((unsigned long long)(sprite.uiTextureID & 0xFFFFFF) << 24) |
+						(unsigned long long)(i & 0xFFFFFF));
+	}
+	std::sort(vKeys.begin(), vKeys.end());
+
+	// Activate blending mode
+	CGLStateCache::GetInstance()->SetBlend(true);
+	CGLStateCache::GetInstance()->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CGLStateCache::GetInstance()->BindVertexArray(VAO);
+	CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, IBO);
+
+	for (unsigned int uiChunkStart = 0; uiChunkStart < vKeys.size(); uiChunkStart += MAX_SPRITES)
+	{
+		const unsigned int uiChunkEnd = std::min((unsigned int)vKeys.size(), uiChunkStart + MAX_SPRITES);
+
+		// Copy the sorted sprites of this chunk into the instance buffer
+		vInstances.clear();
+		for (unsigned int i = uiChunkStart; i < uiChunkEnd; i++)
+			vInstances.push_back(vSprites[vKeys[i] & 0xFFFFFF].instance);
+		// Orphan the old buffer, so the driver does not wait for the previous frame's draws to finish
+		glBufferData(GL_ARRAY_BUFFER, MAX_SPRITES * sizeof(BatchInstance), NULL, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, vInstances.size() * sizeof(BatchInstance), &vInstances[0]);
+
+		// Draw each run of sprites with the same shader and texture with one call
+		unsigned int uiRunStart = uiChunkStart;
+		while (uiRunStart < uiChunkEnd)
+		{
+			const BatchSprite& first = vSprites[vKeys[uiRunStart] & 0xFFFFFF];
+			unsigned int uiRunEnd = uiRunStart + 1;
+			while (uiRunEnd < uiChunkEnd)
+			{
+				const BatchSprite& sprite = vSprites[vKeys[uiRunEnd] & 0xFFFFFF];
+				if ((sprite.uiShader != first.uiShader) || (sprite.uiTextureID != first.uiTextureID))
+					break;
+				uiRunEnd++;
+			}
+
+			CShaderManager::GetInstance()->Use(vShaderHandles[first.uiShader]);
+			CGLStateCache::GetInstance()->BindTexture(0, first.uiTextureID);
+			SetInstanceOffset(uiRunStart - uiChunkStart);
+			glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)0, uiRunEnd - uiRunStart);
+			uiDrawCalls++;
+
+			uiRunStart = uiRunEnd;
+		}
+	}
+
+	vSprites.clear();
+}
+
+/**
+ @brief Get the number of sprites drawn by the last Flush
+ */
+unsigned int CSpriteBatch::GetSpriteCount(void) const
+{
+	return uiSpriteCount;
+}
+
+/**
+ @brief Get the number of draw calls of the last Flush
+ */
+unsigned int CSpriteBatch::GetDrawCalls(void) const
+{
+	return uiDrawCalls;
+}
+
+/**
+ @brief Add a quad with a sprite sheet of iNumRows by iNumCols frames to the batch
+ @param eLayer The layer of the quad. Lower layers are drawn first
+ @param uiTextureID The texture of the quad
+ @param transform The transformation from the quad's space to clip space, e.g. MVP * model
+ @param vec2Size The width and height of the quad, which is centred on the origin
+ @param vec4UVRect The texture coordinates of the bottom left (x, y) and top right (z, w) corners of the sprite sheet
+ @param iFrame The frame in the sprite sheet
+ @param iNumRows The number of rows of frames in the sprite sheet
+ @param iNumCols The number of columns of frames in the sprite sheet
+ @param vec4Colour The colour which the texture is multiplied with
+ */
+void CSpriteBatch::AddSprite(	const SPRITE_LAYER eLayer,
+								const unsigned int uiTextureID,
+								const glm::mat4& transform,
+								const glm::vec2& vec2Size,
+								const glm::vec4& vec4UVRect,
+								const int iFrame,
+								const int iNumRows,
+								const int iNumCols,
+								const glm::vec4& vec4Colour)
+{
+	// Nothing to draw
+	if (vec4Colour.a <= 0.0f)
+		return;
+
+	vSprites.push_back(BatchSprite());
+	BatchSprite& sprite = vSprites.back();
+	sprite.uiLayer = eLayer;
+	sprite.uiShader = uiCurrentShader;
+	sprite.uiTextureID = uiTextureID;
+
+	sprite.instance.centre = transform[3];
+	sprite.instance.xAxis = transform[0] * (0.5f * vec2Size.x);
+	sprite.instance.yAxis = transform[1] * (0.5f * vec2Size.y);
+	sprite.instance.colour = vec4Colour;
+	sprite.instance.uvRect = vec4UVRect;
+	sprite.instance.frame = glm::vec4((float)iFrame, (float)iNumCols, (float)iNumRows, 0.0f);
+}
+
+/**
+ @brief Point the instance attributes at an instance in IBO. OpenGL 3.3 has no base instance for
+		glDrawElementsInstanced, so each run of instances moves the attributes to its first instance instead.
+		The VAO must be bound
+ @param uiInstance The index of the instance in IBO
+ */
+void CSpriteBatch::SetInstanceOffset(const unsigned int uiInstance)
+{
+	const size_t uiOffset = uiInstance * sizeof(BatchInstance);
+	CGLStateCache::GetInstance()->BindBuffer(GL_ARRAY_BUFFER, IBO);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(BatchInstance), (void*)(uiOffset + offsetof(BatchInstance, centre)));
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(BatchInstance), (void*)(uiOffset + offsetof(BatchInstance, xAxis)));
+	glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(BatchInstance), (void*)(uiOffset + offsetof(BatchInstance, yAxis)));
+	glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(BatchInstance), (void*)(uiOffset + offsetof(BatchInstance, colour)));
+	glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(BatchInstance), (void*)(uiOffset + offsetof(BatchInstance, uvRect)));
+	glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(BatchInstance), (void*)(uiOffset + offsetof(BatchInstance, frame)));
+}
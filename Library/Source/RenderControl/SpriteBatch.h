@@ -0,0 +1,130 @@
+/**
+ CSpriteBatch
+ @brief This class collects textured quads during a frame, and draws them with as few draw calls as possible.
+		Each quad is one instance in a streaming instance buffer, which holds its axes in clip space, its colour
+		and its frame. The vertex shader expands a unit quad with them, and works out the texture coordinates
+		of the frame from the rows and columns of the sprite sheet, so the sprites of a sheet are drawn together
+		whichever frames they show. The instances are sorted by layer, shader and texture, and each run of
+		instances with the same shader and texture is drawn with one glDrawElementsInstanced.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "..\DesignPatterns\SingletonTemplate.h"
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <string>
+#include <vector>
+
+// The layers of the sprites. Lower layers are drawn first.
+// Within a layer, the sprites are grouped by shader and texture, so overlapping sprites should be on different layers
+enum SPRITE_LAYER
+{
+	SPRITE_LAYER_BACKGROUND = 0,
+	SPRITE_LAYER_ENTITIES,
+	SPRITE_LAYER_EFFECTS,
+	SPRITE_LAYER_PLAYER,
+	SPRITE_LAYER_FOREGROUND,
+	NUM_SPRITE_LAYERS
+};
+
+// An instance of the sprite batch. The corners of the quad are centre -/+ xAxis -/+ yAxis, in clip space
+struct BatchInstance
+{
+	glm::vec4 centre;
+	glm::vec4 xAxis;
+	glm::vec4 yAxis;
+	glm::vec4 colour;
+	// The texture coordinates of the bottom left (x, y) and top right (z, w) corners of the sprite sheet
+	glm::vec4 uvRect;
+	// The frame (x) in the sprite sheet, which has z rows of y columns of frames
+	glm::vec4 frame;
+};
+
+class CSpriteBatch : public CSingletonTemplate<CSpriteBatch>
+{
+	friend CSingletonTemplate<CSpriteBatch>;
+public:
+	// The max number of sprites in the instance buffer. More sprites are drawn in several uploads
+	static const unsigned int MAX_SPRITES = 4096;
+
+	// Initialise the vertex, index and instance buffers, and set the default shader
+	bool Init(const std::string& sShaderName);
+
+	// Set the shader which the following sprites are drawn with. It must use the BatchInstance layout
+	void SetShader(const std::string& sShaderName);
+
+	// Add a quad of this size, centred on the origin of the transform, to the batch
+	void Draw(	const SPRITE_LAYER eLayer,
+				const unsigned int uiTextureID,
+				const glm::mat4& transform,
+				const glm::vec2& vec2Size,
+				const glm::vec4& vec4UVRect,
+				const glm::vec4& vec4Colour);
+
+	// Add a quad which shows a frame of a sprite sheet to the batch
+	void DrawFrame(	const SPRITE_LAYER eLayer,
+					const unsigned int uiTextureID,
+					const glm::mat4& transform,
+					const glm::vec2& vec2Size,
+					const int iFrame,
+					const int iNumRows,
+					const int iNumCols,
+					const glm::vec4& vec4Colour);
+
+	// Sort and draw all the sprites added since the last Flush
+	void Flush(void);
+
+	// Get the number of sprites and draw calls of the last Flush
+	unsigned int GetSpriteCount(void) const;
+	unsigned int GetDrawCalls(void) const;
+
+protected:
+	// A sprite waiting to be drawn
+	struct BatchSprite
+	{
+		unsigned int uiLayer;
+		unsigned int uiShader;
+		unsigned int uiTextureID;
+		BatchInstance instance;
+	};
+
+	// OpenGL objects. VBO holds the unit quad, and IBO the instances
+	unsigned int VAO, VBO, EBO, IBO;
+
+	// The handles of the shaders used by the sprites. The sprites store indices into this
+	std::vector<int> vShaderHandles;
+	// The index of the shader for the next sprites
+	unsigned int uiCurrentShader;
+
+	// The sprites added since the last Flush
+	std::vector<BatchSprite> vSprites;
+	// The instances of the sorted sprites, uploaded to IBO
+	std::vector<BatchInstance> vInstances;
+
+	// The statistics of the last Flush
+	unsigned int uiSpriteCount;
+	unsigned int uiDrawCalls;
+
+	// Add a quad with a sprite sheet of iNumRows by iNumCols frames to the batch
+	void AddSprite(	const SPRITE_LAYER eLayer,
+					const unsigned int uiTextureID,
+					const glm::mat4& transform,
+					const glm::vec2& vec2Size,
+					const glm::vec4& vec4UVRect,
+					const int iFrame,
+					const int iNumRows,
+					const int iNumCols,
+					const glm::vec4& vec4Colour);
+
+	// Point the instance attributes at an instance in IBO, as OpenGL 3.3 cannot start an instanced draw at one
+	void SetInstanceOffset(const unsigned int uiInstance);
+
+	// Constructor
+	CSpriteBatch(void);
+
+	// Destructor
+	virtual ~CSpriteBatch(void);
+};
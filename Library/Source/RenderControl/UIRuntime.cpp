@@ -0,0 +1,185 @@
+/**
+ CUIRuntime
+ @brief This class owns the IMGUI context and its GLFW and OpenGL backends for the whole run.
+		They are created once, with the font atlas and the backend's shaders and buffers, so that switching
+		between game states does not rebuild them. The game states draw their UI into one shared frame,
+		which is started by the first state which needs it, and rendered once at the end of the frame.
+		A frame which runs no simulation tick starts no UI frame, so it draws the last UI frame again.
+ */
+#include "UIRuntime.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include the IMGUI backends
+// Important: GLEW and GLFW must be included before IMGUI
+#include "..\GUI\backends\imgui_impl_glfw.h"
+#include "..\GUI\backends\imgui_impl_opengl3.h"
+
+// Include CProfiler to measure the UI frame
+#include "..\TimeControl\Profiler.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CUIRuntime::CUIRuntime(void)
+	: bInitialised(false)
+	, bFrameStarted(false)
+	, pLastDrawData(NULL)
+{
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CUIRuntime::~CUIRuntime(void)
+{
+	if (bInitialised)
+	{
+		DiscardFrame();
+
+		// Cleanup
+		ImGui_ImplOpenGL3_Shutdown();
+		ImGui_ImplGlfw_Shutdown();
+		ImGui::DestroyContext();
+		bInitialised = false;
+		pLastDrawData = NULL;
+	}
+}
+
+/**
+ @brief Create the IMGUI context and backends, and build the font atlas and the backend's OpenGL objects.
+		The backend would otherwise create them in the first frame, which would cause a hitch
+ @param pWindow The GLFW window which the UI is drawn in
+ @return true if the UI runtime was initialised, otherwise false
+ */
+bool CUIRuntime::Init(GLFWwindow* pWindow)
+{
+	// Only initialise once, as every game state shares this runtime
+	if (bInitialised)
+		return true;
+
+	// Setup Dear ImGui context
+	IMGUI_CHECKVERSION();
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO(); (void)io;
+
+	// Setup Dear ImGui style
+	ImGui::StyleColorsDark();
+
+	// Setup Platform/Renderer bindings
+	if (ImGui_ImplGlfw_InitForOpenGL(pWindow, true) == false)
+	{
+		cout << "CUIRuntime::Init - Unable to initialise the GLFW backend" << endl;
+		ImGui::DestroyContext();
+		return false;
+	}
+	const char* glsl_version = "#version 330";
+	if (ImGui_ImplOpenGL3_Init(glsl_version) == false)
+	{
+		cout << "CUIRuntime::Init - Unable to initialise the OpenGL backend" << endl;
+		ImGui_ImplGlfw_Shutdown();
+		ImGui::DestroyContext();
+		return false;
+	}
+
+	// Build the font atlas and its texture, and the backend's shaders and buffers
+	if (ImGui_ImplOpenGL3_CreateDeviceObjects() == false)
+	{
+		cout << "CUIRuntime::Init - Unable to create the OpenGL objects of the UI" << endl;
+		ImGui_ImplOpenGL3_Shutdown();
+		ImGui_ImplGlfw_Shutdown();
+		ImGui::DestroyContext();
+		return false;
+	}
+
+	bInitialised = true;
+	bFrameStarted = false;
+	pLastDrawData = NULL;
+
+	return true;
+}
+
+/**
+ @brief Start the UI frame, if it has not been started yet. Call it before using IMGUI in an Update,
+		so that the game states which are updated in the same tick share one frame
+ */
+void CUIRuntime::BeginFrame(void)
+{
+	if ((bInitialised == false) || (bFrameStarted == true))
+		return;
+
+	// The new frame resets the draw lists of the last frame
+	pLastDrawData = NULL;
+
+	// Start the Dear ImGui frame
+	ImGui_ImplOpenGL3_NewFrame();
+	ImGui_ImplGlfw_NewFrame();
+	ImGui::NewFrame();
+	bFrameStarted = true;
+}
+
+/**
+ @brief Check if the UI frame has been started and not rendered yet
+ */
+bool CUIRuntime::IsFrameStarted(void) const
+{
+	return bFrameStarted;
+}
+
+/**
+ @brief Finish the UI frame, and get its draw data. If no tick ran in this frame, no UI frame was started,
+		so the draw data of the last frame is returned, as the game states' UI has not changed since then
+ @return The draw data of the frame, or of the last frame if it was not started.
+		NULL if no frame was rendered since a frame was last started and discarded
+ */
+ImDrawData* CUIRuntime::EndFrame(void)
+{
+	if (bFrameStarted == false)
+		return pLastDrawData;
+
+	ImGui::Render();
+	bFrameStarted = false;
+	pLastDrawData = ImGui::GetDrawData();
+	return pLastDrawData;
+}
+
+/**
+ @brief Draw the draw data of a UI frame
+ @param pDrawData The draw data
+ */
+void CUIRuntime::RenderDrawData(ImDrawData* pDrawData)
+{
+	if ((pDrawData == NULL) || (pDrawData->CmdListsCount == 0))
+		return;
+
+	PROFILE_SCOPE("CUIRuntime::RenderDrawData");
+	ImGui_ImplOpenGL3_RenderDrawData(pDrawData);
+}
+
+/**
+ @brief Finish and draw the UI frame, if it was started
+ */
+void CUIRuntime::Render(void)
+{
+	RenderDrawData(EndFrame());
+}
+
+/**
+ @brief Discard the UI frame without drawing it, e.g. if several simulation ticks run before a render,
+		the UI frame started by the previous tick is not rendered
+ */
+void CUIRuntime::DiscardFrame(void)
+{
+	if (bFrameStarted == false)
+		return;
+
+	ImGui::EndFrame();
+	bFrameStarted = false;
+}
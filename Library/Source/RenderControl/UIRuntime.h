@@ -0,0 +1,57 @@
+/**
+ CUIRuntime
+ @brief This class owns the IMGUI context and its GLFW and OpenGL backends for the whole run.
+		They are created once, with the font atlas and the backend's shaders and buffers, so that switching
+		between game states does not rebuild them. The game states draw their UI into one shared frame,
+		which is started by the first state which needs it, and rendered once at the end of the frame.
+		A frame which runs no simulation tick starts no UI frame, so it draws the last UI frame again.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "..\DesignPatterns\SingletonTemplate.h"
+
+// Include IMGUI
+#include "..\GUI\imgui.h"
+
+struct GLFWwindow;
+
+class CUIRuntime : public CSingletonTemplate<CUIRuntime>
+{
+	friend CSingletonTemplate<CUIRuntime>;
+public:
+	// Create the IMGUI context and backends, and build the font atlas and the backend's OpenGL objects
+	bool Init(GLFWwindow* pWindow);
+
+	// Start the UI frame, if it has not been started yet. Call it before using IMGUI in an Update
+	void BeginFrame(void);
+
+	// Check if the UI frame has been started and not rendered yet
+	bool IsFrameStarted(void) const;
+
+	// Finish the UI frame, and get its draw data. The last frame's draw data if the frame was not started
+	ImDrawData* EndFrame(void);
+
+	// Draw the draw data of a UI frame
+	void RenderDrawData(ImDrawData* pDrawData);
+
+	// Finish and draw the UI frame, if it was started
+	void Render(void);
+
+	// Discard the UI frame without drawing it, e.g. for simulation ticks which are not rendered
+	void DiscardFrame(void);
+
+protected:
+	// true if the context and backends were created
+	bool bInitialised;
+	// true if the UI frame has been started and not rendered yet
+	bool bFrameStarted;
+	// The draw data of the last UI frame which was rendered. IMGUI keeps it until the next ImGui::NewFrame
+	ImDrawData* pLastDrawData;
+
+	// Constructor
+	CUIRuntime(void);
+
+	// Destructor
+	virtual ~CUIRuntime(void);
+};
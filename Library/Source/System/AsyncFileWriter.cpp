@@ -0,0 +1,185 @@
+/**
+ CAsyncFileWriter
+ @brief This class writes files on a background thread, so that saving does not stall the game loop.
+		Each file is written to a temporary file first, which then replaces the file in one rename,
+		so a crash in the middle of a save never leaves a half-written file behind.
+ */
+#include "AsyncFileWriter.h"
+
+// Include CProfiler to measure the writing of files
+#include "..\TimeControl\Profiler.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CAsyncFileWriter::CAsyncFileWriter(void)
+	: bWriting(false)
+	, bWriteError(false)
+	, bStop(false)
+{
+	threadWriter = std::thread(&CAsyncFileWriter::Run, this);
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CAsyncFileWriter::~CAsyncFileWriter(void)
+{
+	// Write the files which are still queued, then stop the background thread
+	{
+		std::lock_guard<std::mutex> lock(mutexQueue);
+		bStop = true;
+	}
+	conditionQueued.notify_one();
+
+	if (threadWriter.joinable())
+		threadWriter.join();
+}
+
+/**
+ @brief Queue the data to be written to a file. If the file is still queued, its data is replaced,
+		as only the latest data needs to reach the disk
+ @param sFilePath The path of the file
+ @param vData The data, which is moved into the queue
+ */
+void CAsyncFileWriter::Write(const std::string& sFilePath, std::vector<unsigned char>&& vData)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutexQueue);
+
+		bool bReplaced = false;
+		for (auto it = queueFiles.begin(); it != queueFiles.end(); ++it)
+		{
+			if (it->first == sFilePath)
+			{
+				it->second = std::move(vData);
+				bReplaced = true;
+				break;
+			}
+		}
+
+		if (bReplaced == false)
+			queueFiles.push_back(std::make_pair(sFilePath, std::move(vData)));
+	}
+	conditionQueued.notify_one();
+}
+
+/**
+ @brief Wait until every queued file has been written
+ */
+void CAsyncFileWriter::Flush(void)
+{
+	std::unique_lock<std::mutex> lock(mutexQueue);
+	conditionIdle.wait(lock, [this] { return (queueFiles.empty() && (bWriting == false)); });
+}
+
+/**
+ @brief Check if a file is queued or being written
+ */
+bool CAsyncFileWriter::IsBusy(void)
+{
+	std::lock_guard<std::mutex> lock(mutexQueue);
+	return ((queueFiles.empty() == false) || (bWriting == true));
+}
+
+/**
+ @brief Check if the last write failed, and clear the flag
+ */
+bool CAsyncFileWriter::TakeWriteError(void)
+{
+	std::lock_guard<std::mutex> lock(mutexQueue);
+	const bool bError = bWriteError;
+	bWriteError = false;
+	return bError;
+}
+
+/**
+ @brief The loop of the background thread. It writes the queued files one at a time, without holding the lock
+ */
+void CAsyncFileWriter::Run(void)
+{
+	std::unique_lock<std::mutex> lock(mutexQueue);
+	while (true)
+	{
+		conditionQueued.wait(lock, [this] { return (bStop || (queueFiles.empty() == false)); });
+
+		if (queueFiles.empty())
+		{
+			// bStop was set and nothing is left to write
+			break;
+		}
+
+		std::pair<std::string, std::vector<unsigned char> > file = std::move(queueFiles.front());
+		queueFiles.pop_front();
+		bWriting = true;
+
+		lock.unlock();
+		const bool bResult = WriteFile(file.first, file.second);
+		lock.lock();
+
+		bWriting = false;
+		if (bResult == false)
+			bWriteError = true;
+
+		if (queueFiles.empty())
+			conditionIdle.notify_all();
+	}
+}
+
+/**
+ @brief Write the data to a temporary file, and rename it over the file
+ @param sFilePath The path of the file
+ @param vData The data
+ @return true if the file was written, otherwise false
+ */
+bool CAsyncFileWriter::WriteFile(const std::string& sFilePath, const std::vector<unsigned char>& vData)
+{
+	PROFILE_SCOPE("CAsyncFileWriter::WriteFile");
+
+	const std::string sTempFilePath = sFilePath + ".tmp";
+
+	{
+		ofstream file(sTempFilePath, ios::binary | ios::trunc);
+		if (!file.is_open())
+		{
+			cout << "CAsyncFileWriter::WriteFile - Unable to open " << sTempFilePath << endl;
+			return false;
+		}
+
+		if (vData.empty() == false)
+			file.write((const char*)vData.data(), vData.size());
+		file.flush();
+		if (!file.good())
+		{
+			cout << "CAsyncFileWriter::WriteFile - Unable to write " << sTempFilePath << endl;
+			file.close();
+			remove(sTempFilePath.c_str());
+			return false;
+		}
+	}
+
+#ifdef _WIN32
+	// Replace the file in one step, and make sure the rename reaches the disk before returning
+	if (MoveFileExA(sTempFilePath.c_str(), sFilePath.c_str(),
+					MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) == FALSE)
+#else
+	// rename replaces the file in one step on POSIX systems
+	if (rename(sTempFilePath.c_str(), sFilePath.c_str()) != 0)
+#endif
+	{
+		cout << "CAsyncFileWriter::WriteFile - Unable to replace " << sFilePath << endl;
+		remove(sTempFilePath.c_str());
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,66 @@
+/**
+ CAsyncFileWriter
+ @brief This class writes files on a background thread, so that saving does not stall the game loop.
+		Each file is written to a temporary file first, which then replaces the file in one rename,
+		so a crash in the middle of a save never leaves a half-written file behind.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "..\DesignPatterns\SingletonTemplate.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class CAsyncFileWriter : public CSingletonTemplate<CAsyncFileWriter>
+{
+	friend CSingletonTemplate<CAsyncFileWriter>;
+public:
+	// Queue the data to be written to a file. If the file is still queued, its data is replaced
+	void Write(const std::string& sFilePath, std::vector<unsigned char>&& vData);
+
+	// Wait until every queued file has been written
+	void Flush(void);
+
+	// Check if a file is queued or being written
+	bool IsBusy(void);
+
+	// Check if the last write failed, and clear the flag
+	bool TakeWriteError(void);
+
+protected:
+	// The files which are waiting to be written, in the order they were queued
+	std::deque<std::pair<std::string, std::vector<unsigned char> > > queueFiles;
+	// true while the background thread is writing a file
+	bool bWriting;
+	// true if a write failed since the last TakeWriteError
+	bool bWriteError;
+	// true when the background thread must stop
+	bool bStop;
+
+	// The mutex which guards the queue and the flags
+	std::mutex mutexQueue;
+	// Signalled when a file is queued, or the background thread must stop
+	std::condition_variable conditionQueued;
+	// Signalled when the background thread has written every queued file
+	std::condition_variable conditionIdle;
+	// The background thread
+	std::thread threadWriter;
+
+	// Constructor
+	CAsyncFileWriter(void);
+
+	// Destructor
+	virtual ~CAsyncFileWriter(void);
+
+	// The loop of the background thread
+	void Run(void);
+
+	// Write the data to a temporary file, and rename it over the file
+	static bool WriteFile(const std::string& sFilePath, const std::vector<unsigned char>& vData);
+};
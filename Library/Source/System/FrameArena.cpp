@@ -0,0 +1,146 @@
+/**
+ CFrameArena
+ @brief A linear (bump) allocator for data which only lives until the end of a frame, e.g. paths and
+		temporary lists. Allocating only moves an offset, and everything is freed at once by Reset().
+		Each thread has its own arena, so that worker threads can use it without locks.
+ */
+#include "FrameArena.h"
+
+#include <cstdint>
+using namespace std;
+
+/**
+ @brief Constructor
+ @param uiCapacity The size of the arena in bytes
+ */
+CFrameArena::CFrameArena(const size_t uiCapacity)
+	: pBuffer(NULL)
+	, uiCapacity(uiCapacity)
+	, uiOffset(0)
+	, uiPeak(0)
+	, uiOverflowBytes(0)
+	, uiNumOverflows(0)
+{
+	pBuffer = new char[uiCapacity];
+}
+
+/**
+ @brief Destructor
+ */
+CFrameArena::~CFrameArena(void)
+{
+	for (unsigned int i = 0; i < vOverflowBlocks.size(); i++)
+		delete[] vOverflowBlocks[i];
+	vOverflowBlocks.clear();
+
+	delete[] pBuffer;
+	pBuffer = NULL;
+}
+
+/**
+ @brief Allocate a block of memory which stays valid until the next Reset()
+ @param uiSize The number of bytes
+ @param uiAlignment The alignment of the block, which must be a power of 2
+ @return A pointer to the block
+ */
+void* CFrameArena::Allocate(const size_t uiSize, const size_t uiAlignment)
+{
+	// Align the address, not the offset, so that the alignment of pBuffer does not matter
+	uintptr_t uiAddress = reinterpret_cast<uintptr_t>(pBuffer) + uiOffset;
+	uintptr_t uiAligned = (uiAddress + (uiAlignment - 1)) & ~(uintptr_t)(uiAlignment - 1);
+	size_t uiNewOffset = (uiAligned - reinterpret_cast<uintptr_t>(pBuffer)) + uiSize;
+	if (uiNewOffset <= uiCapacity)
+	{
+		uiOffset = uiNewOffset;
+		return reinterpret_cast<void*>(uiAligned);
+	}
+
+	// The arena is full, so take this block from the heap until the next Reset()
+	char* pBlock = new char[uiSize + uiAlignment];
+	vOverflowBlocks.push_back(pBlock);
+	uiOverflowBytes += uiSize + uiAlignment;
+	uiNumOverflows++;
+
+	uiAddress = reinterpret_cast<uintptr_t>(pBlock);
+	uiAligned = (uiAddress + (uiAlignment - 1)) & ~(uintptr_t)(uiAlignment - 1);
+	return reinterpret_cast<void*>(uiAligned);
+}
+
+/**
+ @brief Give back a block. Only the last block from pBuffer can be reused; the others are freed by Reset()
+ @param pMemory The block
+ @param uiSize The number of bytes which were allocated
+ */
+void CFrameArena::Deallocate(void* pMemory, const size_t uiSize)
+{
+	char* pBlock = static_cast<char*>(pMemory);
+	if ((pBlock >= pBuffer) && (pBlock + uiSize == pBuffer + uiOffset))
+		uiOffset = pBlock - pBuffer;
+}
+
+/**
+ @brief Free all the blocks. If the arena overflowed, it grows so that the next frame fits
+ */
+void CFrameArena::Reset(void)
+{
+	const size_t uiUsed = uiOffset + uiOverflowBytes;
+	if (uiUsed > uiPeak)
+		uiPeak = uiUsed;
+
+	if (vOverflowBlocks.size() > 0)
+	{
+		for (unsigned int i = 0; i < vOverflowBlocks.size(); i++)
+			delete[] vOverflowBlocks[i];
+		vOverflowBlocks.clear();
+		uiOverflowBytes = 0;
+
+		// Grow by half again of the peak, so that the steady state does not allocate from the heap
+		delete[] pBuffer;
+		uiCapacity = uiPeak + uiPeak / 2;
+		pBuffer = new char[uiCapacity];
+	}
+
+	uiOffset = 0;
+}
+
+/**
+ @brief Get the number of bytes used since the last Reset()
+ */
+size_t CFrameArena::GetUsed(void) const
+{
+	return uiOffset + uiOverflowBytes;
+}
+
+/**
+ @brief Get the size of the arena in bytes
+ */
+size_t CFrameArena::GetCapacity(void) const
+{
+	return uiCapacity;
+}
+
+/**
+ @brief Get the largest number of bytes used in a frame
+ */
+size_t CFrameArena::GetPeak(void) const
+{
+	return uiPeak;
+}
+
+/**
+ @brief Get the number of allocations which did not fit and came from the heap
+ */
+unsigned int CFrameArena::GetNumOverflows(void) const
+{
+	return uiNumOverflows;
+}
+
+/**
+ @brief Get the arena of the calling thread. It is created on the first call in each thread
+ @return The arena of the calling thread
+ */
+CFrameArena* CFrameArena::GetThreadArena(void)
+{
+	thread_local CFrameArena cThreadArena;
+	return &cThreadArena;
+}
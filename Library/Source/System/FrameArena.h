@@ -0,0 +1,104 @@
+/**
+ CFrameArena
+ @brief A linear (bump) allocator for data which only lives until the end of a frame, e.g. paths and
+		temporary lists. Allocating only moves an offset, and everything is freed at once by Reset().
+		Each thread has its own arena, so that worker threads can use it without locks.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class CFrameArena
+{
+public:
+	// The default size of an arena in bytes
+	static const size_t DEFAULT_CAPACITY = 256 * 1024;
+
+	// Constructor
+	explicit CFrameArena(const size_t uiCapacity = DEFAULT_CAPACITY);
+
+	// Destructor
+	~CFrameArena(void);
+
+	// Allocate a block of memory which stays valid until the next Reset()
+	void* Allocate(const size_t uiSize, const size_t uiAlignment = alignof(std::max_align_t));
+
+	// Give back a block. Only the last block can be reused, so that a growing vector does not waste space
+	void Deallocate(void* pMemory, const size_t uiSize);
+
+	// Free all the blocks. If the arena overflowed, it grows so that the next frame fits
+	void Reset(void);
+
+	// Get the number of bytes used since the last Reset()
+	size_t GetUsed(void) const;
+	// Get the size of the arena in bytes
+	size_t GetCapacity(void) const;
+	// Get the largest number of bytes used in a frame
+	size_t GetPeak(void) const;
+	// Get the number of allocations which did not fit and came from the heap
+	unsigned int GetNumOverflows(void) const;
+
+	// Get the arena of the calling thread
+	static CFrameArena* GetThreadArena(void);
+
+protected:
+	// The memory of the arena
+	char* pBuffer;
+	// The size of pBuffer
+	size_t uiCapacity;
+	// The offset of the next free byte in pBuffer
+	size_t uiOffset;
+	// The largest number of bytes used in a frame
+	size_t uiPeak;
+	// The heap blocks of the allocations which did not fit into pBuffer
+	std::vector<char*> vOverflowBlocks;
+	// The number of bytes in vOverflowBlocks
+	size_t uiOverflowBytes;
+	// The total number of overflows
+	unsigned int uiNumOverflows;
+
+	// Copying an arena would free its memory twice
+	CFrameArena(const CFrameArena&);
+	CFrameArena& operator=(const CFrameArena&);
+};
+
+// An STL allocator which takes its memory from a CFrameArena.
+// Containers using it must not be kept after the arena is Reset()
+template <class T>
+class CFrameAllocator
+{
+public:
+	typedef T value_type;
+
+	// Use the arena of the calling thread
+	CFrameAllocator(void)
+		: pArena(CFrameArena::GetThreadArena()) {}
+	// Use a specific arena
+	explicit CFrameAllocator(CFrameArena* pArena)
+		: pArena(pArena) {}
+	template <class U>
+	CFrameAllocator(const CFrameAllocator<U>& other)
+		: pArena(other.pArena) {}
+
+	T* allocate(const size_t uiCount)
+	{
+		return static_cast<T*>(pArena->Allocate(uiCount * sizeof(T), alignof(T)));
+	}
+	void deallocate(T* pMemory, const size_t uiCount)
+	{
+		pArena->Deallocate(pMemory, uiCount * sizeof(T));
+	}
+
+	// The arena which the memory is taken from
+	CFrameArena* pArena;
+};
+
+template <class T, class U>
+inline bool operator==(const CFrameAllocator<T>& a, const CFrameAllocator<U>& b) { return a.pArena == b.pArena; }
+template <class T, class U>
+inline bool operator!=(const CFrameAllocator<T>& a, const CFrameAllocator<U>& b) { return a.pArena != b.pArena; }
+
+// A vector for per-frame data, which is allocated from the arena of the calling thread
+template <class T>
+using FrameVector = std::vector<T, CFrameAllocator<T> >;
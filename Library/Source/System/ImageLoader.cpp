@@ -6,6 +6,14 @@
  */
 #include "ImageLoader.h"
 
+// Include CMemoryTracker to count the allocations and OpenGL objects
+#include "MemoryTracker.h"
+// Include CGLStateCache to skip the redundant OpenGL state changes
+#include "..\RenderControl\GLStateCache.h"
+
+// Include CProfiler to measure the loading of images
+#include "../TimeControl/Profiler.h"
+
 #include <iostream>
 using namespace std;
 
@@ -34,6 +42,23 @@ CImageLoader::CImageLoader(void)
  */
 CImageLoader::~CImageLoader(void)
 {
+	CancelPreloads();
+}
+
+/**
+ @brief Wait for the images which are still being decoded on other threads, and free them.
+		It is called before the threads' resources are destroyed, e.g. when the game exits
+ */
+void CImageLoader::CancelPreloads(void)
+{
+	std::map<std::string, std::future<DecodedImage>>::iterator it;
+	for (it = mapPendingImages.begin(); it != mapPendingImages.end(); ++it)
+	{
+		DecodedImage image = it->second.get();
+		if (image.data)
+			stbi_image_free(image.data);
+	}
+	mapPendingImages.clear();
 }
 
 /**
@@ -54,6 +79,8 @@ bool CImageLoader::Init(void)
  */
 unsigned char * CImageLoader::Load(const char* filename, int& width, int& height, int& nrChannels, const bool bInvert)
 {
+	std::lock_guard<std::mutex> lock(decodeMutex);
+
 	// tell stb_image.h to flip loaded texture's on the y-axis.
 	stbi_set_flip_vertically_on_load(bInvert);
 
@@ -67,22 +94,40 @@ unsigned char * CImageLoader::Load(const char* filename, int& width, int& height
 
 /**
  @brief Load an image into the graphics card and return its ID.
+		An image which was loaded before is not loaded again, and returns the same ID.
  @param filename A const char* storing the name of the image file
  @param bInvert A const bool
  */
 unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bInvert)
 {
-	// Load from file
-	int image_width = 0;
-	int image_height = 0;
-	int nrChannels = 0;
+	PROFILE_SCOPE("CImageLoader::LoadTextureGetID");
+	MEMORY_TAG("CImageLoader::LoadTextureGetID");
 
-	// tell stb_image.h to flip loaded texture's on the y-axis.
-	stbi_set_flip_vertically_on_load(bInvert);
+	// Return the texture if this image was loaded before
+	std::string sKey = std::string(filename) + (bInvert ? "|inverted" : "");
+	std::map<std::string, unsigned int>::iterator it = mapTextureIDs.find(sKey);
+	if (it != mapTextureIDs.end())
+	{
+		mapTextureInfo[it->second].uiRefCount++;
+		return it->second;
+	}
 
-	// load image, create texture and generate mipmaps
-	unsigned char* data = stbi_load(FileSystem::getPath(filename).c_str(),
-		&image_width, &image_height, &nrChannels, 0);
+	// Take the image if it was preloaded, otherwise load it from file now
+	DecodedImage image;
+	std::map<std::string, std::future<DecodedImage>>::iterator itPending = mapPendingImages.find(sKey);
+	if (itPending != mapPendingImages.end())
+	{
+		// Wait for the other thread, if it has not finished decoding the image
+		image = itPending->second.get();
+		mapPendingImages.erase(itPending);
+	}
+	else
+		image = Decode(FileSystem::getPath(filename), bInvert);
+
+	unsigned char* data = image.data;
+	const int image_width = image.width;
+	const int image_height = image.height;
+	const int nrChannels = image.nrChannels;
 
 	if (data == NULL)
 	{
@@ -93,7 +138,8 @@ unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bI
 	// Create a OpenGL texture identifier
 	GLuint image_texture;
 	glGenTextures(1, &image_texture);
-	glBindTexture(GL_TEXTURE_2D, image_texture);
+	MEMORY_TRACK_GL(TEXTURE_OBJECT, 1);
+	CGLStateCache::GetInstance()->BindTexture(0, image_texture);
 
 	// Setup filtering parameters for display
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -117,6 +163,80 @@ unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bI
 //	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image_width, image_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
 	stbi_image_free(data);
 
+	mapTextureIDs[sKey] = image_texture;
+	TextureInfo info;
+	info.sKey = sKey;
+	info.uiRefCount = 1;
+	mapTextureInfo[image_texture] = info;
 	return image_texture;
 }
 
+/**
+ @brief Release a Texture ID which LoadTextureGetID returned. Each call of LoadTextureGetID needs one release.
+		The texture is deleted from the graphics card when it has been released as many times as it was loaded
+ @param uiTextureID The Texture ID
+ @return true if the Texture ID was released, false if it was not loaded by this class
+ */
+bool CImageLoader::ReleaseTexture(const unsigned int uiTextureID)
+{
+	if (uiTextureID == 0)
+		return false;
+
+	std::map<unsigned int, TextureInfo>::iterator it = mapTextureInfo.find(uiTextureID);
+	if (it == mapTextureInfo.end())
+	{
+		cout << "CImageLoader::ReleaseTexture(): Texture " << uiTextureID << " was not loaded by CImageLoader" << endl;
+		return false;
+	}
+
+	// Keep the texture while other users still have it
+	if (--it->second.uiRefCount > 0)
+		return true;
+
+	GLuint image_texture = uiTextureID;
+	CGLStateCache::GetInstance()->DeleteTextures(1, &image_texture);
+	MEMORY_TRACK_GL(TEXTURE_OBJECT, -1);
+
+	mapTextureIDs.erase(it->second.sKey);
+	mapTextureInfo.erase(it);
+	return true;
+}
+
+/**
+ @brief Start reading and decoding an image on another thread, e.g. for a game state which may be entered soon.
+		LoadTextureGetID then only has to upload it to the graphics card. An image which was loaded or
+		preloaded before is ignored
+ @param filename A const char* storing the name of the image file
+ @param bInvert A const bool
+ */
+void CImageLoader::PreloadTexture(const char* filename, const bool bInvert)
+{
+	std::string sKey = std::string(filename) + (bInvert ? "|inverted" : "");
+	if ((mapTextureIDs.count(sKey) != 0) || (mapPendingImages.count(sKey) != 0))
+		return;
+
+	// Resolve the path here, as FileSystem is not used from other threads
+	std::string sFilePath = FileSystem::getPath(filename);
+	mapPendingImages[sKey] = std::async(std::launch::async, &CImageLoader::Decode, this, sFilePath, bInvert);
+}
+
+/**
+ @brief Read and decode an image. It may be called from another thread
+ @param sFilePath The full path of the image file
+ @param bInvert A const bool
+ */
+CImageLoader::DecodedImage CImageLoader::Decode(const std::string& sFilePath, const bool bInvert)
+{
+	DecodedImage image;
+	image.width = 0;
+	image.height = 0;
+	image.nrChannels = 0;
+
+	std::lock_guard<std::mutex> lock(decodeMutex);
+
+	// tell stb_image.h to flip loaded texture's on the y-axis.
+	stbi_set_flip_vertically_on_load(bInvert);
+
+	image.data = stbi_load(sFilePath.c_str(), &image.width, &image.height, &image.nrChannels, 0);
+	return image;
+}
@@ -15,6 +15,11 @@
 #define GLEW_STATIC
 #endif
 
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+
 class CImageLoader : public CSingletonTemplate<CImageLoader>
 {
 	friend CSingletonTemplate<CImageLoader>;
@@ -27,9 +32,45 @@ public:
 							int& width, int& height, 
 							int& nrChannels, const bool bInvert = false);
 
-	// Load an image and return as a Texture ID
+	// Load an image and return as a Texture ID. An image which was loaded before returns the same Texture ID
 	unsigned int LoadTextureGetID(const char* filename, const bool bInvert);
+
+	// Release a Texture ID from LoadTextureGetID. The texture is deleted when every user has released it
+	bool ReleaseTexture(const unsigned int uiTextureID);
+
+	// Start reading and decoding an image on another thread, so that LoadTextureGetID only has to upload it
+	void PreloadTexture(const char* filename, const bool bInvert);
+	// Wait for the images which are still being decoded on other threads, and discard them
+	void CancelPreloads(void);
 protected:
+	// An image which was read and decoded, and is waiting to be uploaded to the graphics card
+	struct DecodedImage
+	{
+		unsigned char* data;
+		int width, height, nrChannels;
+	};
+
+	// A loaded texture
+	struct TextureInfo
+	{
+		// The key of the texture in mapTextureIDs
+		std::string sKey;
+		// The number of LoadTextureGetID calls which have not been released yet
+		unsigned int uiRefCount;
+	};
+
+	// The Texture IDs of the loaded images, so that entities using the same image share one texture
+	std::map<std::string, unsigned int> mapTextureIDs;
+	// The loaded textures, by their Texture IDs
+	std::map<unsigned int, TextureInfo> mapTextureInfo;
+	// The images which are being decoded on other threads, by the same key as mapTextureIDs
+	std::map<std::string, std::future<DecodedImage>> mapPendingImages;
+	// stb_image keeps the flip setting in a global variable, so only one thread may decode at a time
+	std::mutex decodeMutex;
+
+	// Read and decode an image
+	DecodedImage Decode(const std::string& sFilePath, const bool bInvert);
+
 	// Constructor
 	CImageLoader(void);
 
@@ -0,0 +1,340 @@
+/**
+ CMemoryTracker
+ @brief A class to count the heap allocations and the OpenGL objects of the game, so that leaks and
+		per-frame allocations can be found. It replaces the global operator new and delete when
+		ENABLE_MEMORY_TRACKER is defined, and does nothing otherwise.
+		All its members are static, as operator new can be called before any singleton is created.
+ */
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <new>
+using namespace std;
+
+std::atomic<unsigned long long> CMemoryTracker::ullTotalAllocs(0);
+std::atomic<unsigned long long> CMemoryTracker::ullTotalBytes(0);
+std::atomic<long long> CMemoryTracker::llLiveAllocs(0);
+std::atomic<long long> CMemoryTracker::llLiveBytes(0);
+std::atomic<long long> CMemoryTracker::allTagLiveAllocs[CMemoryTracker::MAX_TAGS];
+std::atomic<long long> CMemoryTracker::allTagLiveBytes[CMemoryTracker::MAX_TAGS];
+const char* CMemoryTracker::apTagNames[CMemoryTracker::MAX_TAGS] = { "Untagged" };
+std::atomic<unsigned int> CMemoryTracker::uiNumTags(1);
+std::atomic<int> CMemoryTracker::aiGLObjects[CMemoryTracker::NUM_GL_OBJECTS];
+unsigned long long CMemoryTracker::ullFrameStartAllocs = 0;
+unsigned long long CMemoryTracker::ullFrameStartBytes = 0;
+unsigned long long CMemoryTracker::ullFrameAllocs = 0;
+unsigned long long CMemoryTracker::ullFrameAllocBytes = 0;
+int CMemoryTracker::iFrameAllocBudget = -1;
+unsigned int CMemoryTracker::uiFramesOverBudget = 0;
+unsigned long long CMemoryTracker::ullWorstFrameAllocs = 0;
+
+// The tag of the calling thread's allocations
+static thread_local unsigned int uiThreadTag = 0;
+// The lock for adding tags
+static std::mutex tagsMutex;
+
+/**
+ @brief Get the ID of a tag, adding it if it is new
+ @param pName The name of the tag. It must be a string literal
+ @return The ID of the tag, or 0 if there are too many tags
+ */
+unsigned int CMemoryTracker::RegisterTag(const char* pName)
+{
+	std::lock_guard<std::mutex> lock(tagsMutex);
+	const unsigned int uiCount = uiNumTags.load();
+	for (unsigned int i = 1; i < uiCount; i++)
+	{
+		if (strcmp(apTagNames[i], pName) == 0)
+			return i;
+	}
+	if (uiCount >= MAX_TAGS)
+		return 0;
+
+	apTagNames[uiCount] = pName;
+	uiNumTags.store(uiCount + 1);
+	return uiCount;
+}
+
+/**
+ @brief Set the tag of the calling thread's allocations
+ @param uiTag The ID of the tag from RegisterTag
+ @return The previous tag
+ */
+unsigned int CMemoryTracker::SetThreadTag(const unsigned int uiTag)
+{
+	const unsigned int uiPrevTag = uiThreadTag;
+	uiThreadTag = uiTag;
+	return uiPrevTag;
+}
+
+/**
+ @brief Get the tag of the calling thread's allocations
+ */
+unsigned int CMemoryTracker::GetThreadTag(void)
+{
+	return uiThreadTag;
+}
+
+/**
+ @brief Count a heap allocation
+ @param uiSize The number of bytes
+ @param uiTag The tag of the allocation
+ */
+void CMemoryTracker::OnAllocate(const size_t uiSize, const unsigned int uiTag)
+{
+	ullTotalAllocs.fetch_add(1, memory_order_relaxed);
+	ullTotalBytes.fetch_add(uiSize, memory_order_relaxed);
+	llLiveAllocs.fetch_add(1, memory_order_relaxed);
+	llLiveBytes.fetch_add(uiSize, memory_order_relaxed);
+	allTagLiveAllocs[uiTag].fetch_add(1, memory_order_relaxed);
+	allTagLiveBytes[uiTag].fetch_add(uiSize, memory_order_relaxed);
+}
+
+/**
+ @brief Count a heap free
+ @param uiSize The number of bytes which were allocated
+ @param uiTag The tag which the block was allocated under
+ */
+void CMemoryTracker::OnFree(const size_t uiSize, const unsigned int uiTag)
+{
+	llLiveAllocs.fetch_sub(1, memory_order_relaxed);
+	llLiveBytes.fetch_sub(uiSize, memory_order_relaxed);
+	allTagLiveAllocs[uiTag].fetch_sub(1, memory_order_relaxed);
+	allTagLiveBytes[uiTag].fetch_sub(uiSize, memory_order_relaxed);
+}
+
+/**
+ @brief Count OpenGL objects
+ @param eType The type of the objects
+ @param iCount The number of objects created, or negative for the number deleted
+ */
+void CMemoryTracker::TrackGLObjects(const GL_OBJECT eType, const int iCount)
+{
+	aiGLObjects[eType].fetch_add(iCount, memory_order_relaxed);
+}
+
+/**
+ @brief Mark the end of a frame, and check the allocations of the frame against the budget.
+		Only the main thread should call this.
+ */
+void CMemoryTracker::EndFrame(void)
+{
+	const unsigned long long ullAllocs = ullTotalAllocs.load(memory_order_relaxed);
+	const unsigned long long ullBytes = ullTotalBytes.load(memory_order_relaxed);
+	ullFrameAllocs = ullAllocs - ullFrameStartAllocs;
+	ullFrameAllocBytes = ullBytes - ullFrameStartBytes;
+	ullFrameStartAllocs = ullAllocs;
+	ullFrameStartBytes = ullBytes;
+
+	if (ullFrameAllocs > ullWorstFrameAllocs)
+		ullWorstFrameAllocs = ullFrameAllocs;
+
+	if ((iFrameAllocBudget >= 0) && (ullFrameAllocs > (unsigned long long)iFrameAllocBudget))
+	{
+		// Only print the first frame which went over, as printing every frame would slow the game down
+		if (uiFramesOverBudget == 0)
+			cout << "CMemoryTracker::EndFrame - " << ullFrameAllocs << " allocations in a frame, over the budget of "
+				<< iFrameAllocBudget << endl;
+		uiFramesOverBudget++;
+	}
+}
+
+/**
+ @brief Set the maximum number of heap allocations per frame
+ @param iBudget The budget. -1 for no budget
+ */
+void CMemoryTracker::SetFrameAllocBudget(const int iBudget)
+{
+	iFrameAllocBudget = iBudget;
+}
+
+/**
+ @brief Get the number of heap allocations in the last complete frame
+ */
+unsigned long long CMemoryTracker::GetFrameAllocs(void)
+{
+	return ullFrameAllocs;
+}
+
+/**
+ @brief Get the number of bytes allocated in the last complete frame
+ */
+unsigned long long CMemoryTracker::GetFrameAllocBytes(void)
+{
+	return ullFrameAllocBytes;
+}
+
+/**
+ @brief Get the number of frames which went over the budget
+ */
+unsigned int CMemoryTracker::GetFramesOverBudget(void)
+{
+	return uiFramesOverBudget;
+}
+
+/**
+ @brief Get the number of live heap blocks
+ */
+long long CMemoryTracker::GetLiveAllocs(void)
+{
+	return llLiveAllocs.load(memory_order_relaxed);
+}
+
+/**
+ @brief Get the number of live heap bytes
+ */
+long long CMemoryTracker::GetLiveBytes(void)
+{
+	return llLiveBytes.load(memory_order_relaxed);
+}
+
+/**
+ @brief Get the number of live OpenGL objects of a type
+ @param eType The type of the objects
+ */
+int CMemoryTracker::GetGLObjectCount(const GL_OBJECT eType)
+{
+	return aiGLObjects[eType].load(memory_order_relaxed);
+}
+
+/**
+ @brief Print the live bytes by tag, the OpenGL object counts and the budget results
+ */
+void CMemoryTracker::PrintReport(void)
+{
+	cout << "CMemoryTracker - " << llLiveAllocs.load() << " live blocks, " << llLiveBytes.load() << " live bytes, "
+		<< ullTotalAllocs.load() << " allocations in total" << endl;
+
+	// Print the tags with the most live bytes first
+	const unsigned int uiCount = uiNumTags.load();
+	unsigned int auiOrder[MAX_TAGS];
+	for (unsigned int i = 0; i < uiCount; i++)
+		auiOrder[i] = i;
+	std::sort(auiOrder, auiOrder + uiCount, [](const unsigned int a, const unsigned int b)
+	{
+		return allTagLiveBytes[a].load() > allTagLiveBytes[b].load();
+	});
+	for (unsigned int i = 0; i < uiCount; i++)
+	{
+		const unsigned int uiTag = auiOrder[i];
+		cout << "\t" << apTagNames[uiTag] << ": " << allTagLiveBytes[uiTag].load() << " bytes in "
+			<< allTagLiveAllocs[uiTag].load() << " blocks" << endl;
+	}
+
+	cout << "\tGL buffers: " << aiGLObjects[BUFFER_OBJECT].load()
+		<< ", vertex arrays: " << aiGLObjects[VERTEX_ARRAY_OBJECT].load()
+		<< ", textures: " << aiGLObjects[TEXTURE_OBJECT].load() << endl;
+
+	cout << "\tWorst frame: " << ullWorstFrameAllocs << " allocations";
+	if (iFrameAllocBudget >= 0)
+		cout << ", " << uiFramesOverBudget << " frames over the budget of " << iFrameAllocBudget;
+	cout << endl;
+}
+
+#ifdef ENABLE_MEMORY_TRACKER
+
+// Each block starts with a header which stores its size and tag, so that a free can be counted.
+// The header keeps the block aligned like a normal allocation.
+// Memory allocated in a DLL with its own operator new must not be freed here, and vice versa
+struct MemoryBlockHeader
+{
+	size_t uiSize;
+	unsigned int uiTag;
+};
+static const size_t MEMORY_HEADER_SIZE = 16;
+static_assert(sizeof(MemoryBlockHeader) <= MEMORY_HEADER_SIZE, "The memory block header is too big");
+
+/**
+ @brief Allocate a block with a header, and count it
+ @param uiSize The number of bytes
+ @return The block after the header, or NULL if out of memory
+ */
+static void* TrackedAlloc(size_t uiSize)
+{
+	char* pBlock = static_cast<char*>(malloc(uiSize + MEMORY_HEADER_SIZE));
+	if (pBlock == NULL)
+		return NULL;
+
+	MemoryBlockHeader* pHeader = reinterpret_cast<MemoryBlockHeader*>(pBlock);
+	pHeader->uiSize = uiSize;
+	pHeader->uiTag = CMemoryTracker::GetThreadTag();
+	CMemoryTracker::OnAllocate(pHeader->uiSize, pHeader->uiTag);
+	return pBlock + MEMORY_HEADER_SIZE;
+}
+
+/**
+ @brief Count a block and free it with its header
+ @param pMemory The block after the header
+ */
+static void TrackedFree(void* pMemory)
+{
+	if (pMemory == NULL)
+		return;
+
+	char* pBlock = static_cast<char*>(pMemory) - MEMORY_HEADER_SIZE;
+	MemoryBlockHeader* pHeader = reinterpret_cast<MemoryBlockHeader*>(pBlock);
+	CMemoryTracker::OnFree(pHeader->uiSize, pHeader->uiTag);
+	free(pBlock);
+}
+
+void* operator new(size_t uiSize)
+{
+	void* pMemory = TrackedAlloc(uiSize);
+	if (pMemory == NULL)
+		throw std::bad_alloc();
+	return pMemory;
+}
+
+void* operator new[](size_t uiSize)
+{
+	void* pMemory = TrackedAlloc(uiSize);
+	if (pMemory == NULL)
+		throw std::bad_alloc();
+	return pMemory;
+}
+
+void* operator new(size_t uiSize, const std::nothrow_t&) noexcept
+{
+	return TrackedAlloc(uiSize);
+}
+
+void* operator new[](size_t uiSize, const std::nothrow_t&) noexcept
+{
+	return TrackedAlloc(uiSize);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	TrackedFree(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	TrackedFree(pMemory);
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+	TrackedFree(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t) noexcept
+{
+	TrackedFree(pMemory);
+}
+
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept
+{
+	TrackedFree(pMemory);
+}
+
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept
+{
+	TrackedFree(pMemory);
+}
+
+#endif
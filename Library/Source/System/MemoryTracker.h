@@ -0,0 +1,129 @@
+/**
+ CMemoryTracker
+ @brief A class to count the heap allocations and the OpenGL objects of the game, so that leaks and
+		per-frame allocations can be found. It replaces the global operator new and delete when
+		ENABLE_MEMORY_TRACKER is defined, and does nothing otherwise.
+		All its members are static, as operator new can be called before any singleton is created.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Define ENABLE_MEMORY_TRACKER in the preprocessor definitions to track the allocations
+#ifdef ENABLE_MEMORY_TRACKER
+	#define MEMORY_CONCAT_INNER(a, b) a##b
+	#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_INNER(a, b)
+	// Count the allocations until the end of the current scope under this tag. The name must be a string literal
+	#define MEMORY_TAG(name) \
+		static const unsigned int MEMORY_CONCAT(memoryTagID_, __LINE__) = CMemoryTracker::RegisterTag(name); \
+		CMemoryTag MEMORY_CONCAT(memoryTag_, __LINE__)(MEMORY_CONCAT(memoryTagID_, __LINE__))
+	// Count OpenGL objects which were created (positive) or deleted (negative)
+	#define MEMORY_TRACK_GL(type, count) CMemoryTracker::TrackGLObjects(CMemoryTracker::type, count)
+	// Mark the end of a frame, to count the allocations per frame
+	#define MEMORY_FRAME() CMemoryTracker::EndFrame()
+#else
+	#define MEMORY_TAG(name) ((void)0)
+	#define MEMORY_TRACK_GL(type, count) ((void)0)
+	#define MEMORY_FRAME() ((void)0)
+#endif
+
+class CMemoryTracker
+{
+public:
+	// The types of OpenGL objects which are counted
+	enum GL_OBJECT
+	{
+		BUFFER_OBJECT = 0,
+		VERTEX_ARRAY_OBJECT,
+		TEXTURE_OBJECT,
+		NUM_GL_OBJECTS
+	};
+
+	// The maximum number of tags. Allocations under further tags are counted as untagged
+	static const unsigned int MAX_TAGS = 64;
+
+	// Get the ID of a tag, adding it if it is new. The name must be a string literal
+	static unsigned int RegisterTag(const char* pName);
+
+	// Set the tag of the calling thread's allocations, and return the previous tag
+	static unsigned int SetThreadTag(const unsigned int uiTag);
+
+	// Count a heap allocation or free. Called by operator new and delete
+	static void OnAllocate(const size_t uiSize, const unsigned int uiTag);
+	static void OnFree(const size_t uiSize, const unsigned int uiTag);
+
+	// Get the tag of the calling thread's allocations
+	static unsigned int GetThreadTag(void);
+
+	// Count OpenGL objects which were created (positive) or deleted (negative)
+	static void TrackGLObjects(const GL_OBJECT eType, const int iCount);
+
+	// Mark the end of a frame, and check the allocations of the frame against the budget
+	static void EndFrame(void);
+
+	// Set the maximum number of heap allocations per frame. -1 for no budget
+	static void SetFrameAllocBudget(const int iBudget);
+
+	// Get the number of heap allocations and bytes in the last complete frame
+	static unsigned long long GetFrameAllocs(void);
+	static unsigned long long GetFrameAllocBytes(void);
+
+	// Get the number of frames which went over the budget
+	static unsigned int GetFramesOverBudget(void);
+
+	// Get the number of live heap blocks and bytes
+	static long long GetLiveAllocs(void);
+	static long long GetLiveBytes(void);
+
+	// Get the number of live OpenGL objects of a type
+	static int GetGLObjectCount(const GL_OBJECT eType);
+
+	// Print the live bytes by tag, the OpenGL object counts and the budget results
+	static void PrintReport(void);
+
+protected:
+	// The total number of allocations and bytes since the program started
+	static std::atomic<unsigned long long> ullTotalAllocs;
+	static std::atomic<unsigned long long> ullTotalBytes;
+	// The number of live blocks and bytes
+	static std::atomic<long long> llLiveAllocs;
+	static std::atomic<long long> llLiveBytes;
+	// The live blocks and bytes of each tag
+	static std::atomic<long long> allTagLiveAllocs[MAX_TAGS];
+	static std::atomic<long long> allTagLiveBytes[MAX_TAGS];
+	// The names of the tags. Tag 0 is for untagged allocations
+	static const char* apTagNames[MAX_TAGS];
+	static std::atomic<unsigned int> uiNumTags;
+	// The number of live OpenGL objects of each type
+	static std::atomic<int> aiGLObjects[NUM_GL_OBJECTS];
+
+	// The totals at the end of the last frame, and the allocations of the last complete frame
+	static unsigned long long ullFrameStartAllocs;
+	static unsigned long long ullFrameStartBytes;
+	static unsigned long long ullFrameAllocs;
+	static unsigned long long ullFrameAllocBytes;
+	// The budget of allocations per frame, and the number of frames which went over it
+	static int iFrameAllocBudget;
+	static unsigned int uiFramesOverBudget;
+	static unsigned long long ullWorstFrameAllocs;
+};
+
+// Sets the tag of the calling thread's allocations until the end of the scope
+class CMemoryTag
+{
+public:
+	// Constructor
+	explicit CMemoryTag(const unsigned int uiTag)
+		: uiPrevTag(CMemoryTracker::SetThreadTag(uiTag)) {}
+
+	// Destructor
+	~CMemoryTag(void)
+	{
+		CMemoryTracker::SetThreadTag(uiPrevTag);
+	}
+
+protected:
+	// The tag to restore
+	unsigned int uiPrevTag;
+};
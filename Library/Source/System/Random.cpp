@@ -0,0 +1,141 @@
+/**
+ CRandom
+ @brief A seeded random number generator (PCG32), so that a play session can be repeated exactly.
+		The same seed gives the same sequence of numbers on every compiler and platform.
+ */
+#include "Random.h"
+
+// Include CSnapshotBuffer for the save games
+#include "SnapshotBuffer.h"
+
+#include <ctime>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CRandom::CRandom(void)
+	: uiSeed(0)
+	, ullState(0)
+	, ullIncrement(1)
+{
+	Seed(0);
+}
+
+/**
+ @brief Destructor
+ */
+CRandom::~CRandom(void)
+{
+}
+
+/**
+ @brief Set the seed of the generator
+ @param uiSeed The seed. 0 picks a seed from the current time
+ */
+void CRandom::Seed(const unsigned int uiSeed)
+{
+	this->uiSeed = uiSeed;
+	if (this->uiSeed == 0)
+	{
+		this->uiSeed = (unsigned int)time(NULL);
+		// 0 is reserved to mean "pick a seed"
+		if (this->uiSeed == 0)
+			this->uiSeed = 1;
+	}
+
+	// Seeding procedure of the PCG32 reference implementation
+	ullState = 0;
+	ullIncrement = (0xda3e39cb94b95bdbULL << 1) | 1;
+	Next();
+	ullState += this->uiSeed;
+	Next();
+}
+
+/**
+ @brief Get the seed which the generator was last seeded with
+ @return The seed
+ */
+unsigned int CRandom::GetSeed(void) const
+{
+	return uiSeed;
+}
+
+/**
+ @brief Get the next random number
+ @return An unsigned int in [0, 2^32)
+ */
+unsigned int CRandom::Next(void)
+{
+	unsigned long long ullOldState = ullState;
+	ullState = ullOldState * 6364136223846793005ULL + ullIncrement;
+	unsigned int uiXorShifted = (unsigned int)(((ullOldState >> 18u) ^ ullOldState) >> 27u);
+	unsigned int uiRotation = (unsigned int)(ullOldState >> 59u);
+	return (uiXorShifted >> uiRotation) | (uiXorShifted << ((32u - uiRotation) & 31u));
+}
+
+/**
+ @brief Get a random integer in a range, without the bias of the modulo operator
+ @param iMin The lowest number which can be returned
+ @param iMax The highest number which can be returned
+ @return An int in [iMin, iMax]
+ */
+int CRandom::Range(const int iMin, const int iMax)
+{
+	if (iMax <= iMin)
+		return iMin;
+
+	const unsigned int uiBound = (unsigned int)(iMax - iMin) + 1u;
+	// A bound of 0 means the whole range of an unsigned int
+	if (uiBound == 0)
+		return (int)Next();
+
+	// Reject the numbers below the threshold, so that every result is equally likely
+	const unsigned int uiThreshold = (0u - uiBound) % uiBound;
+	unsigned int uiValue = Next();
+	while (uiValue < uiThreshold)
+		uiValue = Next();
+	return iMin + (int)(uiValue % uiBound);
+}
+
+/**
+ @brief Get a random float
+ @return A float in [0, 1)
+ */
+float CRandom::Uniform(void)
+{
+	// Use the top 24 bits, which fit exactly in a float
+	return (Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ @brief Write the state of the generator to a snapshot
+ @param cSnapshot The snapshot to write to
+ */
+void CRandom::WriteSnapshot(CSnapshotBuffer& cSnapshot) const
+{
+	cSnapshot.Write(uiSeed);
+	cSnapshot.Write(ullState);
+	cSnapshot.Write(ullIncrement);
+}
+
+/**
+ @brief Read the state of the generator from a snapshot, so that it continues the same sequence
+ @param cSnapshot The snapshot to read from
+ @return false if the snapshot ended too early. The generator is not changed in that case
+ */
+bool CRandom::ReadSnapshot(CSnapshotBuffer& cSnapshot)
+{
+	unsigned int uiSnapshotSeed = 0;
+	unsigned long long ullSnapshotState = 0, ullSnapshotIncrement = 0;
+	cSnapshot.Read(uiSnapshotSeed);
+	cSnapshot.Read(ullSnapshotState);
+	cSnapshot.Read(ullSnapshotIncrement);
+	if ((cSnapshot.HasReadError() == true) || ((ullSnapshotIncrement & 1) == 0))
+		return false;
+
+	uiSeed = uiSnapshotSeed;
+	ullState = ullSnapshotState;
+	ullIncrement = ullSnapshotIncrement;
+	return true;
+}
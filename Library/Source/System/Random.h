@@ -0,0 +1,52 @@
+/**
+ CRandom
+ @brief A seeded random number generator (PCG32), so that a play session can be repeated exactly.
+		The same seed gives the same sequence of numbers on every compiler and platform.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CSnapshotBuffer for the save games
+class CSnapshotBuffer;
+
+class CRandom : public CSingletonTemplate<CRandom>
+{
+	friend CSingletonTemplate<CRandom>;
+
+public:
+	// Constructor. Instances can also be created outside of the singleton, e.g. for a separate stream of numbers
+	CRandom(void);
+
+	// Destructor
+	virtual ~CRandom(void);
+
+	// Set the seed of the generator. 0 picks a seed from the current time
+	void Seed(const unsigned int uiSeed);
+
+	// Get the seed which the generator was last seeded with
+	unsigned int GetSeed(void) const;
+
+	// Get the next random number in [0, 2^32)
+	unsigned int Next(void);
+
+	// Get a random integer in [iMin, iMax]
+	int Range(const int iMin, const int iMax);
+
+	// Get a random float in [0, 1)
+	float Uniform(void);
+
+	// Write the state of the generator to a snapshot
+	void WriteSnapshot(CSnapshotBuffer& cSnapshot) const;
+	// Read the state of the generator from a snapshot, so that it continues the same sequence
+	bool ReadSnapshot(CSnapshotBuffer& cSnapshot);
+
+protected:
+	// The seed which the generator was last seeded with
+	unsigned int uiSeed;
+	// The state of the generator
+	unsigned long long ullState;
+	// The increment of the generator, which must be odd
+	unsigned long long ullIncrement;
+};
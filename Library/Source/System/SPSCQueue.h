@@ -0,0 +1,69 @@
+/**
+ CSPSCQueue
+ @brief A lock-free ring buffer of a fixed number of values, for exactly one thread which pushes
+		and one thread which pops. Neither thread ever waits for the other. The two indices are
+		kept on separate cache lines, so the threads do not slow each other down by sharing one.
+ */
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+template <typename T, unsigned int CAPACITY>
+class CSPSCQueue
+{
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "The capacity of CSPSCQueue must be a power of 2");
+	static_assert(std::is_trivially_copyable<T>::value, "CSPSCQueue can only store trivially copyable values");
+
+public:
+	// Constructor
+	CSPSCQueue(void)
+		: uiHead(0)
+		, uiTail(0)
+	{
+	}
+
+	// Add a value at the back. Only the producer thread may call it. It returns false if the queue is full
+	bool Push(const T& value)
+	{
+		const unsigned int uiCurrentTail = uiTail.load(std::memory_order_relaxed);
+		if (uiCurrentTail - uiHead.load(std::memory_order_acquire) == CAPACITY)
+			return false;
+
+		values[uiCurrentTail & (CAPACITY - 1)] = value;
+		uiTail.store(uiCurrentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Remove the value at the front. Only the consumer thread may call it. It returns false if the queue is empty
+	bool Pop(T& value)
+	{
+		const unsigned int uiCurrentHead = uiHead.load(std::memory_order_relaxed);
+		if (uiCurrentHead == uiTail.load(std::memory_order_acquire))
+			return false;
+
+		value = values[uiCurrentHead & (CAPACITY - 1)];
+		uiHead.store(uiCurrentHead + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Check if the queue is empty. The answer may be out of date as soon as it is returned
+	bool IsEmpty(void) const
+	{
+		return uiHead.load(std::memory_order_acquire) == uiTail.load(std::memory_order_acquire);
+	}
+
+	// Get the number of values which the queue can hold
+	static unsigned int GetCapacity(void)
+	{
+		return CAPACITY;
+	}
+
+protected:
+	// The number of values which were popped. Only the consumer writes it
+	alignas(64) std::atomic<unsigned int> uiHead;
+	// The number of values which were pushed. Only the producer writes it
+	alignas(64) std::atomic<unsigned int> uiTail;
+	// The values
+	alignas(64) T values[CAPACITY];
+};
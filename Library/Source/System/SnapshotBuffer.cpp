@@ -0,0 +1,150 @@
+/**
+ CSnapshotBuffer
+ @brief A class which stores the state of the game as a compact binary blob. Values are copied into it
+		byte by byte, so capturing the state costs little more than a memcpy, and read back in the same order.
+ */
+#include "SnapshotBuffer.h"
+
+#include <cstring>
+
+/**
+ @brief Constructor
+ */
+CSnapshotBuffer::CSnapshotBuffer(void)
+	: uiReadPosition(0)
+	, bReadError(false)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CSnapshotBuffer::~CSnapshotBuffer(void)
+{
+}
+
+/**
+ @brief Remove all the data, and reserve memory for a number of bytes, so that writing does not grow the buffer
+ @param uiReserveBytes The number of bytes to reserve
+ */
+void CSnapshotBuffer::Clear(const size_t uiReserveBytes)
+{
+	vData.clear();
+	vData.reserve(uiReserveBytes);
+	uiReadPosition = 0;
+	bReadError = false;
+}
+
+/**
+ @brief Write a number of bytes
+ @param pData The bytes
+ @param uiNumBytes The number of bytes
+ */
+void CSnapshotBuffer::WriteBytes(const void* pData, const size_t uiNumBytes)
+{
+	const unsigned char* pBytes = (const unsigned char*)pData;
+	vData.insert(vData.end(), pBytes, pBytes + uiNumBytes);
+}
+
+/**
+ @brief Write a string, with its length
+ @param sValue The string
+ */
+void CSnapshotBuffer::WriteString(const std::string& sValue)
+{
+	Write((unsigned int)sValue.size());
+	WriteBytes(sValue.data(), sValue.size());
+}
+
+/**
+ @brief Read a number of bytes. Nothing is read if there are not enough bytes left
+ @param pData The memory to read the bytes into
+ @param uiNumBytes The number of bytes
+ @return false if there are not enough bytes left
+ */
+bool CSnapshotBuffer::ReadBytes(void* pData, const size_t uiNumBytes)
+{
+	if ((bReadError == true) || (uiNumBytes > GetRemaining()))
+	{
+		bReadError = true;
+		return false;
+	}
+
+	memcpy(pData, &vData[uiReadPosition], uiNumBytes);
+	uiReadPosition += uiNumBytes;
+	return true;
+}
+
+/**
+ @brief Read a string which was written with WriteString
+ @param sValue The string
+ @return false if there are not enough bytes left
+ */
+bool CSnapshotBuffer::ReadString(std::string& sValue)
+{
+	unsigned int uiLength = 0;
+	if ((Read(uiLength) == false) || (uiLength > GetRemaining()))
+	{
+		bReadError = true;
+		return false;
+	}
+
+	sValue.assign((const char*)&vData[uiReadPosition], uiLength);
+	uiReadPosition += uiLength;
+	return true;
+}
+
+/**
+ @brief Get the data
+ */
+const std::vector<unsigned char>& CSnapshotBuffer::GetData(void) const
+{
+	return vData;
+}
+
+/**
+ @brief Take the data out of this buffer, e.g. to pass it to another thread without copying it. The buffer is empty afterwards
+ */
+std::vector<unsigned char> CSnapshotBuffer::TakeData(void)
+{
+	std::vector<unsigned char> vTakenData;
+	vTakenData.swap(vData);
+	uiReadPosition = 0;
+	bReadError = false;
+	return vTakenData;
+}
+
+/**
+ @brief Replace the data, e.g. with the contents of a file, and start reading from its beginning
+ @param vNewData The new data
+ */
+void CSnapshotBuffer::SetData(std::vector<unsigned char>&& vNewData)
+{
+	vData = std::move(vNewData);
+	uiReadPosition = 0;
+	bReadError = false;
+}
+
+/**
+ @brief Get the number of bytes
+ */
+size_t CSnapshotBuffer::GetSize(void) const
+{
+	return vData.size();
+}
+
+/**
+ @brief Get the number of bytes which have not been read yet
+ */
+size_t CSnapshotBuffer::GetRemaining(void) const
+{
+	return vData.size() - uiReadPosition;
+}
+
+/**
+ @brief Check if a read went past the end of the data
+ */
+bool CSnapshotBuffer::HasReadError(void) const
+{
+	return bReadError;
+}
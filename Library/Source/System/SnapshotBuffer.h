@@ -0,0 +1,70 @@
+/**
+ CSnapshotBuffer
+ @brief A class which stores the state of the game as a compact binary blob. Values are copied into it
+		byte by byte, so capturing the state costs little more than a memcpy, and read back in the same order.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class CSnapshotBuffer
+{
+public:
+	// Constructor
+	CSnapshotBuffer(void);
+
+	// Destructor
+	virtual ~CSnapshotBuffer(void);
+
+	// Remove all the data, and reserve memory for a number of bytes
+	void Clear(const size_t uiReserveBytes = 0);
+
+	// Write a value which can be copied byte by byte, e.g. an int or a glm::vec2
+	template <typename T>
+	void Write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "CSnapshotBuffer can only write trivially copyable values");
+		WriteBytes(&value, sizeof(T));
+	}
+	// Write a number of bytes
+	void WriteBytes(const void* pData, const size_t uiNumBytes);
+	// Write a string, with its length
+	void WriteString(const std::string& sValue);
+
+	// Read a value which was written with Write
+	template <typename T>
+	bool Read(T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "CSnapshotBuffer can only read trivially copyable values");
+		return ReadBytes(&value, sizeof(T));
+	}
+	// Read a number of bytes
+	bool ReadBytes(void* pData, const size_t uiNumBytes);
+	// Read a string which was written with WriteString
+	bool ReadString(std::string& sValue);
+
+	// Get the data
+	const std::vector<unsigned char>& GetData(void) const;
+	// Take the data out of this buffer, e.g. to pass it to another thread without copying it
+	std::vector<unsigned char> TakeData(void);
+	// Replace the data, e.g. with the contents of a file, and start reading from its beginning
+	void SetData(std::vector<unsigned char>&& vNewData);
+
+	// Get the number of bytes
+	size_t GetSize(void) const;
+	// Get the number of bytes which have not been read yet
+	size_t GetRemaining(void) const;
+	// Check if a read went past the end of the data
+	bool HasReadError(void) const;
+
+protected:
+	// The data
+	std::vector<unsigned char> vData;
+	// The position of the next read
+	size_t uiReadPosition;
+	// true if a read went past the end of the data
+	bool bReadError;
+};
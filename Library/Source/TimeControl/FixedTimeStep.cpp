@@ -0,0 +1,118 @@
+/**
+ CFixedTimeStep
+ @brief A class to run the simulation at a fixed tick rate, independently of the render frame rate
+ */
+#include "FixedTimeStep.h"
+
+CFixedTimeStep::CFixedTimeStep()
+	: dTickTime(1.0 / 30.0)
+	, uiTickRate(30)
+	, uiMaxTicksPerFrame(5)
+	, dAccumulator(0.0)
+	, ullTotalTicks(0)
+	, uiFrameTicks(0)
+	, dDroppedTime(0.0)
+{
+}
+
+
+CFixedTimeStep::~CFixedTimeStep()
+{
+}
+
+/**
+ @brief Initialise the class instance
+ @param uiTickRate The number of simulation ticks per second
+ @param uiMaxTicksPerFrame The maximum number of ticks to run in one frame to catch up with real time
+ */
+void CFixedTimeStep::Init(const unsigned int uiTickRate, const unsigned int uiMaxTicksPerFrame)
+{
+	this->uiTickRate = (uiTickRate > 0 ? uiTickRate : 1);
+	this->uiMaxTicksPerFrame = (uiMaxTicksPerFrame > 0 ? uiMaxTicksPerFrame : 1);
+	dTickTime = 1.0 / double(this->uiTickRate);
+	dAccumulator = 0.0;
+	ullTotalTicks = 0;
+	uiFrameTicks = 0;
+	dDroppedTime = 0.0;
+}
+
+/**
+ @brief Add the real time which has passed since the last frame to the accumulator.
+		If the simulation has fallen too far behind, the excess time is dropped so that
+		a slow frame does not cause a burst of ticks which makes the next frame slower too.
+ @param dFrameTime The real time in seconds which has passed since the last frame
+ */
+void CFixedTimeStep::AddFrameTime(const double dFrameTime)
+{
+	uiFrameTicks = 0;
+
+	if (dFrameTime > 0.0)
+		dAccumulator += dFrameTime;
+
+	const double dMaxAccumulator = dTickTime * uiMaxTicksPerFrame;
+	if (dAccumulator > dMaxAccumulator)
+	{
+		dDroppedTime += dAccumulator - dMaxAccumulator;
+		dAccumulator = dMaxAccumulator;
+	}
+}
+
+/**
+ @brief Consume one tick from the accumulator, if there is enough accumulated time for it
+ @return true if a tick should be run, otherwise false
+ */
+bool CFixedTimeStep::ConsumeTick(void)
+{
+	if (dAccumulator < dTickTime)
+		return false;
+
+	dAccumulator -= dTickTime;
+	ullTotalTicks++;
+	uiFrameTicks++;
+	return true;
+}
+
+// Get the duration of one simulation tick in seconds
+double CFixedTimeStep::GetTickTime(void) const
+{
+	return dTickTime;
+}
+
+// Get the number of simulation ticks per second
+unsigned int CFixedTimeStep::GetTickRate(void) const
+{
+	return uiTickRate;
+}
+
+// Get the real time in seconds which has not been simulated yet
+double CFixedTimeStep::GetAccumulatedTime(void) const
+{
+	return dAccumulator;
+}
+
+// Get the fraction of a tick left in the accumulator
+float CFixedTimeStep::GetAlpha(void) const
+{
+	float fAlpha = (float)(dAccumulator / dTickTime);
+	if (fAlpha > 1.0f)
+		fAlpha = 1.0f;
+	return fAlpha;
+}
+
+// Get the number of ticks which were run since Init
+unsigned long long CFixedTimeStep::GetTotalTicks(void) const
+{
+	return ullTotalTicks;
+}
+
+// Get the number of ticks which were run in the current frame
+unsigned int CFixedTimeStep::GetFrameTicks(void) const
+{
+	return uiFrameTicks;
+}
+
+// Get the total simulation time in seconds which was dropped due to the catch-up cap
+double CFixedTimeStep::GetDroppedTime(void) const
+{
+	return dDroppedTime;
+}
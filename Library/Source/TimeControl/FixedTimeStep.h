@@ -0,0 +1,66 @@
+/**
+ CFixedTimeStep
+ @brief A class to run the simulation at a fixed tick rate, independently of the render frame rate
+ */
+#pragma once
+
+// Include SingtonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+class CFixedTimeStep : public CSingletonTemplate<CFixedTimeStep>
+{
+	friend CSingletonTemplate<CFixedTimeStep>;
+
+public:
+	// Destructor
+	virtual ~CFixedTimeStep(void);
+
+	// Initialise the class instance
+	void Init(const unsigned int uiTickRate = 30, const unsigned int uiMaxTicksPerFrame = 5);
+
+	// Add the real time which has passed since the last frame to the accumulator
+	void AddFrameTime(const double dFrameTime);
+
+	// Consume one tick from the accumulator, if there is enough accumulated time for it
+	bool ConsumeTick(void);
+
+	// Get the duration of one simulation tick in seconds
+	double GetTickTime(void) const;
+
+	// Get the number of simulation ticks per second
+	unsigned int GetTickRate(void) const;
+
+	// Get the fraction of a tick left in the accumulator, used to interpolate between ticks when rendering
+	float GetAlpha(void) const;
+
+	// Get the real time in seconds which has not been simulated yet
+	double GetAccumulatedTime(void) const;
+
+	// Get the number of ticks which were run since Init
+	unsigned long long GetTotalTicks(void) const;
+
+	// Get the number of ticks which were run in the current frame
+	unsigned int GetFrameTicks(void) const;
+
+	// Get the total simulation time in seconds which was dropped due to the catch-up cap
+	double GetDroppedTime(void) const;
+
+protected:
+	// The duration of one simulation tick in seconds
+	double dTickTime;
+	// The number of simulation ticks per second
+	unsigned int uiTickRate;
+	// The maximum number of ticks to run in one frame before dropping time
+	unsigned int uiMaxTicksPerFrame;
+	// The real time which has not been simulated yet
+	double dAccumulator;
+	// The number of ticks which were run since Init
+	unsigned long long ullTotalTicks;
+	// The number of ticks which were run in the current frame
+	unsigned int uiFrameTicks;
+	// The total simulation time which was dropped due to the catch-up cap
+	double dDroppedTime;
+
+	// Constructor
+	CFixedTimeStep(void);
+};
@@ -0,0 +1,151 @@
+/**
+ CFramePacer
+ @brief A class to pace the frames to a target frame time, and to measure how well it is achieved
+ */
+#include "FramePacer.h"
+
+#include <math.h>
+
+// A frame is counted as missed if it is longer than the target by more than this time in seconds
+#define MISSED_DEADLINE_TOLERANCE 0.0005
+// The weight of the latest frame in the moving average
+#define MOVING_AVERAGE_WEIGHT 0.05
+
+CFramePacer::CFramePacer()
+	: dTargetFrameTime(1.0 / 30.0)
+	, dSpinTime(0.002)
+	, dLastFrameTime(0.0)
+	, dAverageFrameTime(0.0)
+	, dFrameTimeVariance(0.0)
+	, uiMissedDeadlines(0)
+	, uiFrameCount(0)
+{
+}
+
+
+CFramePacer::~CFramePacer()
+{
+}
+
+/**
+ @brief Initialise the class instance
+ @param dTargetFrameTime The target frame time in seconds
+ @param dSpinTime The time in seconds before the deadline to stop sleeping and start spinning
+ */
+void CFramePacer::Init(const double dTargetFrameTime, const double dSpinTime)
+{
+	this->dSpinTime = dSpinTime;
+	dLastFrameTime = 0.0;
+	dAverageFrameTime = dTargetFrameTime;
+	dFrameTimeVariance = 0.0;
+	uiMissedDeadlines = 0;
+	uiFrameCount = 0;
+
+	frameStartTime = CStopWatch::Clock::now();
+	SetTargetFrameTime(dTargetFrameTime);
+}
+
+/**
+ @brief Set the target frame time in seconds
+ @param dTargetFrameTime The target frame time in seconds
+ */
+void CFramePacer::SetTargetFrameTime(const double dTargetFrameTime)
+{
+	this->dTargetFrameTime = dTargetFrameTime;
+	deadline = frameStartTime + std::chrono::duration_cast<CStopWatch::Clock::duration>(
+		std::chrono::duration<double>(dTargetFrameTime));
+}
+
+/**
+ @brief Wait until the target frame time has passed since the start of the frame.
+		The deadlines are scheduled back to back, so that small overshoots do not accumulate into drift.
+ @return The time of the frame which has just ended, in seconds
+ */
+double CFramePacer::WaitForNextFrame(void)
+{
+	CStopWatch::SleepUntil(deadline, dSpinTime);
+
+	CStopWatch::Clock::time_point now = CStopWatch::Clock::now();
+	double dFrameTime = RecordFrame(now);
+
+	// Schedule the next deadline from this one. If this frame was too late, restart the schedule from now
+	const CStopWatch::Clock::duration targetDuration = std::chrono::duration_cast<CStopWatch::Clock::duration>(
+		std::chrono::duration<double>(dTargetFrameTime));
+	if (now - deadline > targetDuration)
+		deadline = now + targetDuration;
+	else
+		deadline += targetDuration;
+
+	return dFrameTime;
+}
+
+/**
+ @brief End the frame without waiting, e.g. when the frame rate is not limited
+ @return The time of the frame which has just ended, in seconds
+ */
+double CFramePacer::EndFrame(void)
+{
+	CStopWatch::Clock::time_point now = CStopWatch::Clock::now();
+	double dFrameTime = RecordFrame(now);
+	deadline = now + std::chrono::duration_cast<CStopWatch::Clock::duration>(
+		std::chrono::duration<double>(dTargetFrameTime));
+	return dFrameTime;
+}
+
+/**
+ @brief Record the statistics of a frame which ended now
+ @param now The time at the end of the frame
+ @return The time of the frame in seconds
+ */
+double CFramePacer::RecordFrame(const CStopWatch::Clock::time_point& now)
+{
+	dLastFrameTime = CStopWatch::ToSecs(now - frameStartTime);
+	frameStartTime = now;
+	uiFrameCount++;
+
+	if (dLastFrameTime > dTargetFrameTime + MISSED_DEADLINE_TOLERANCE)
+		uiMissedDeadlines++;
+
+	// Exponentially weighted moving average and variance
+	double dDifference = dLastFrameTime - dAverageFrameTime;
+	dAverageFrameTime += MOVING_AVERAGE_WEIGHT * dDifference;
+	dFrameTimeVariance = (1.0 - MOVING_AVERAGE_WEIGHT) * (dFrameTimeVariance + MOVING_AVERAGE_WEIGHT * dDifference * dDifference);
+
+	return dLastFrameTime;
+}
+
+// Get the target frame time in seconds
+double CFramePacer::GetTargetFrameTime(void) const
+{
+	return dTargetFrameTime;
+}
+
+// Get the achieved time of the last frame in seconds
+double CFramePacer::GetLastFrameTime(void) const
+{
+	return dLastFrameTime;
+}
+
+// Get the average achieved frame time in seconds
+double CFramePacer::GetAverageFrameTime(void) const
+{
+	return dAverageFrameTime;
+}
+
+// Get the standard deviation of the achieved frame time in seconds
+double CFramePacer::GetFrameTimeDeviation(void) const
+{
+	return sqrt(dFrameTimeVariance);
+}
+
+// Get the number of frames which missed their deadline
+unsigned int CFramePacer::GetMissedDeadlines(void) const
+{
+	return uiMissedDeadlines;
+}
+
+// Get the number of frames since Init
+unsigned int CFramePacer::GetFrameCount(void) const
+{
+	return uiFrameCount;
+}
@@ -0,0 +1,75 @@
+/**
+ CFramePacer
+ @brief A class to pace the frames to a target frame time, and to measure how well it is achieved
+ */
+#pragma once
+
+// Include SingtonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CStopWatch for the clock and the hybrid sleep
+#include "StopWatch.h"
+
+class CFramePacer : public CSingletonTemplate<CFramePacer>
+{
+	friend CSingletonTemplate<CFramePacer>;
+
+public:
+	// Destructor
+	virtual ~CFramePacer(void);
+
+	// Initialise the class instance
+	void Init(const double dTargetFrameTime, const double dSpinTime = 0.002);
+
+	// Set the target frame time in seconds
+	void SetTargetFrameTime(const double dTargetFrameTime);
+
+	// Wait until the target frame time has passed since the start of the frame. Returns the frame time
+	double WaitForNextFrame(void);
+
+	// End the frame without waiting. Returns the frame time
+	double EndFrame(void);
+
+	// Get the target frame time in seconds
+	double GetTargetFrameTime(void) const;
+
+	// Get the achieved time of the last frame in seconds
+	double GetLastFrameTime(void) const;
+
+	// Get the average achieved frame time in seconds
+	double GetAverageFrameTime(void) const;
+
+	// Get the standard deviation of the achieved frame time in seconds
+	double GetFrameTimeDeviation(void) const;
+
+	// Get the number of frames which missed their deadline
+	unsigned int GetMissedDeadlines(void) const;
+
+	// Get the number of frames since Init
+	unsigned int GetFrameCount(void) const;
+
+protected:
+	// The target frame time
+	double dTargetFrameTime;
+	// The time before the deadline to stop sleeping and start spinning
+	double dSpinTime;
+	// The start time of the current frame
+	CStopWatch::Clock::time_point frameStartTime;
+	// The deadline of the current frame
+	CStopWatch::Clock::time_point deadline;
+	// The achieved time of the last frame
+	double dLastFrameTime;
+	// The moving average and variance of the achieved frame time
+	double dAverageFrameTime;
+	double dFrameTimeVariance;
+	// The number of frames which missed their deadline
+	unsigned int uiMissedDeadlines;
+	// The number of frames since Init
+	unsigned int uiFrameCount;
+
+	// Constructor
+	CFramePacer(void);
+
+	// Record the statistics of a frame which ended now
+	double RecordFrame(const CStopWatch::Clock::time_point& now);
+};
@@ -0,0 +1,141 @@
+/**
+ CFrameTimeLog
+ @brief A class to collect the timings of every frame of a benchmark run, write them to a CSV file
+		and print a summary, so that runs of the same session can be compared across builds
+ */
+#include "FrameTimeLog.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Get a percentile from a sorted list of values
+ @param vSorted The values, sorted in ascending order
+ @param dPercentile The percentile, from 0 to 100
+ @return The value at the percentile
+ */
+static double GetPercentile(const std::vector<double>& vSorted, const double dPercentile)
+{
+	if (vSorted.empty())
+		return 0.0;
+	size_t index = (size_t)(dPercentile / 100.0 * (vSorted.size() - 1) + 0.5);
+	return vSorted[std::min(index, vSorted.size() - 1)];
+}
+
+/**
+ @brief Constructor
+ */
+CFrameTimeLog::CFrameTimeLog(void)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CFrameTimeLog::~CFrameTimeLog(void)
+{
+}
+
+/**
+ @brief Reserve space for a number of frames
+ @param uiNumFrames The number of frames
+ */
+void CFrameTimeLog::Reserve(const unsigned int uiNumFrames)
+{
+	vFrameTimings.reserve(uiNumFrames);
+}
+
+/**
+ @brief Remove all the logged frames
+ */
+void CFrameTimeLog::Clear(void)
+{
+	vFrameTimings.clear();
+}
+
+/**
+ @brief Log the timings of one frame
+ @param dTickTime The time spent in the simulation ticks, in seconds
+ @param dRenderTime The time spent rendering, in seconds
+ @param dFrameTime The time of the whole frame, in seconds
+ */
+void CFrameTimeLog::Add(const double dTickTime, const double dRenderTime, const double dFrameTime)
+{
+	FrameTiming timing;
+	timing.dTickTime = dTickTime;
+	timing.dRenderTime = dRenderTime;
+	timing.dFrameTime = dFrameTime;
+	vFrameTimings.push_back(timing);
+}
+
+/**
+ @brief Get the number of logged frames
+ @return The number of frames
+ */
+unsigned int CFrameTimeLog::GetCount(void) const
+{
+	return (unsigned int)vFrameTimings.size();
+}
+
+/**
+ @brief Write the timings of every frame to a CSV file, in milliseconds
+ @param sFilename The name of the file
+ @return true if the file was written, otherwise false
+ */
+bool CFrameTimeLog::WriteCSV(const std::string& sFilename) const
+{
+	ofstream file(sFilename.c_str(), ios::out | ios::trunc);
+	if (!file.is_open())
+	{
+		cout << "CFrameTimeLog::WriteCSV - Unable to open " << sFilename << endl;
+		return false;
+	}
+
+	file << "frame,tick_ms,render_ms,frame_ms\n";
+	for (size_t i = 0; i < vFrameTimings.size(); i++)
+	{
+		file << i << ','
+			<< vFrameTimings[i].dTickTime * 1000.0 << ','
+			<< vFrameTimings[i].dRenderTime * 1000.0 << ','
+			<< vFrameTimings[i].dFrameTime * 1000.0 << '\n';
+	}
+
+	cout << "CFrameTimeLog::WriteCSV - Wrote " << vFrameTimings.size() << " frames to " << sFilename << endl;
+	return true;
+}
+
+/**
+ @brief Print the average and percentiles of the frame times
+ */
+void CFrameTimeLog::PrintSummary(void) const
+{
+	if (vFrameTimings.empty())
+	{
+		cout << "Frame times: no frames were logged" << endl;
+		return;
+	}
+
+	std::vector<double> vFrameTimes;
+	vFrameTimes.reserve(vFrameTimings.size());
+	double dTotalTickTime = 0.0, dTotalRenderTime = 0.0, dTotalFrameTime = 0.0;
+	for (size_t i = 0; i < vFrameTimings.size(); i++)
+	{
+		dTotalTickTime += vFrameTimings[i].dTickTime;
+		dTotalRenderTime += vFrameTimings[i].dRenderTime;
+		dTotalFrameTime += vFrameTimings[i].dFrameTime;
+		vFrameTimes.push_back(vFrameTimings[i].dFrameTime);
+	}
+	std::sort(vFrameTimes.begin(), vFrameTimes.end());
+
+	const double dCount = (double)vFrameTimings.size();
+	cout << "Frame times over " << vFrameTimings.size() << " frames (" << dTotalFrameTime << "s):" << endl
+		<< "  average " << dTotalFrameTime / dCount * 1000.0 << "ms (tick "
+		<< dTotalTickTime / dCount * 1000.0 << "ms, render " << dTotalRenderTime / dCount * 1000.0 << "ms)" << endl
+		<< "  min " << vFrameTimes.front() * 1000.0
+		<< "ms, p50 " << GetPercentile(vFrameTimes, 50.0) * 1000.0
+		<< "ms, p95 " << GetPercentile(vFrameTimes, 95.0) * 1000.0
+		<< "ms, p99 " << GetPercentile(vFrameTimes, 99.0) * 1000.0
+		<< "ms, max " << vFrameTimes.back() * 1000.0 << "ms" << endl;
+}
@@ -0,0 +1,52 @@
+/**
+ CFrameTimeLog
+ @brief A class to collect the timings of every frame of a benchmark run, write them to a CSV file
+		and print a summary, so that runs of the same session can be compared across builds
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+// The timings of one frame in seconds
+struct FrameTiming
+{
+	// The time spent in the simulation ticks
+	double dTickTime;
+	// The time spent rendering and swapping the buffers
+	double dRenderTime;
+	// The time of the whole frame
+	double dFrameTime;
+};
+
+class CFrameTimeLog
+{
+public:
+	// Constructor
+	CFrameTimeLog(void);
+
+	// Destructor
+	~CFrameTimeLog(void);
+
+	// Reserve space for a number of frames, so that logging does not allocate during the run
+	void Reserve(const unsigned int uiNumFrames);
+
+	// Remove all the logged frames
+	void Clear(void);
+
+	// Log the timings of one frame
+	void Add(const double dTickTime, const double dRenderTime, const double dFrameTime);
+
+	// Get the number of logged frames
+	unsigned int GetCount(void) const;
+
+	// Write the timings of every frame to a CSV file
+	bool WriteCSV(const std::string& sFilename) const;
+
+	// Print the average and percentiles of the frame times
+	void PrintSummary(void) const;
+
+protected:
+	// The timings of every frame
+	std::vector<FrameTiming> vFrameTimings;
+};
@@ -0,0 +1,365 @@
+/**
+ CProfiler
+ @brief A class to measure the time spent in scoped zones of code, with one lock-free event buffer per thread.
+		The events can be exported as a Chrome/Perfetto trace (chrome://tracing or ui.perfetto.dev)
+		or viewed in game as a flame graph.
+ */
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+// Include ImGui for the flame view
+#include "../GUI/imgui.h"
+
+// The buffer of each thread, created when the thread records its first event
+static thread_local CProfilerThreadBuffer* tl_pThreadBuffer = NULL;
+// The generation of the profiler which created tl_pThreadBuffer. The buffer was deleted if the profiler has a newer one
+static thread_local unsigned int tl_uiGeneration = 0;
+// The generation of the latest profiler
+static std::atomic<unsigned int> s_uiGeneration(0);
+
+/**
+ @brief Get the time of the steady clock in nanoseconds
+ */
+static long long GetClockTime(void)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ @brief Write a string into a JSON file, escaping the characters which JSON does not allow
+ */
+static void WriteJSONString(ofstream& file, const char* pString)
+{
+	file << '"';
+	for (const char* p = pString; *p != '\0'; p++)
+	{
+		if ((*p == '"') || (*p == '\\'))
+			file << '\\' << *p;
+		else if ((unsigned char)*p < 0x20)
+			file << ' ';
+		else
+			file << *p;
+	}
+	file << '"';
+}
+
+/**
+ @brief Constructor
+ */
+CProfiler::CProfiler(void)
+	: bEnabled(true)
+	, llEpoch(GetClockTime())
+	, uiGeneration(++s_uiGeneration)
+	, pFrameThreadBuffer(NULL)
+	, llFrameStart(0)
+	, llPrevFrameStart(0)
+	, bFlameViewFrozen(false)
+	, bCaptureFlameFrame(false)
+	, llFlameFrameStart(0)
+	, llFlameFrameEnd(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CProfiler::~CProfiler(void)
+{
+	// The buffers are only deleted here, as threads may still hold a pointer to theirs until they end.
+	// A thread which records an event later gets a new buffer from the next profiler, as the generations differ.
+	// The threads must not be inside a zone now, so the threads which record events are joined before this
+	for (size_t i = 0; i < vThreadBuffers.size(); i++)
+	{
+		delete vThreadBuffers[i];
+	}
+	vThreadBuffers.clear();
+}
+
+/**
+ @brief Enable or disable the recording of events
+ @param bEnabled true to record events, false to ignore them
+ */
+void CProfiler::SetEnabled(const bool bEnabled)
+{
+	this->bEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+// Check if events are recorded
+bool CProfiler::IsEnabled(void) const
+{
+	return bEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ @brief Set the name of the calling thread in the trace
+ @param sThreadName The name of the thread
+ */
+void CProfiler::SetThreadName(const std::string& sThreadName)
+{
+	CProfilerThreadBuffer* pBuffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(threadBuffersMutex);
+	pBuffer->sThreadName = sThreadName;
+}
+
+/**
+ @brief Mark the start of a new frame on the calling thread. The flame view shows the frames of this thread
+ */
+void CProfiler::BeginFrame(void)
+{
+	if (pFrameThreadBuffer == NULL)
+		pFrameThreadBuffer = GetThreadBuffer();
+
+	llPrevFrameStart = llFrameStart;
+	llFrameStart = GetTime();
+
+	// Only copy the events if the flame view was drawn since the last frame
+	if ((bCaptureFlameFrame == true) && (bFlameViewFrozen == false) && (llPrevFrameStart > 0))
+		CaptureFlameFrame();
+	bCaptureFlameFrame = false;
+}
+
+/**
+ @brief Get the current time in nanoseconds since the profiler was created
+ */
+long long CProfiler::GetTime(void) const
+{
+	return GetClockTime() - llEpoch;
+}
+
+/**
+ @brief Get the buffer of the calling thread, creating it if needed
+ @return The CProfilerThreadBuffer of the calling thread
+ */
+CProfilerThreadBuffer* CProfiler::GetThreadBuffer(void)
+{
+	if ((tl_pThreadBuffer == NULL) || (tl_uiGeneration != uiGeneration))
+	{
+		CProfilerThreadBuffer* pBuffer = new CProfilerThreadBuffer();
+		pBuffer->uiDepth = 0;
+		pBuffer->uiWriteCount.store(0, std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(threadBuffersMutex);
+		pBuffer->uiThreadID = (unsigned int)vThreadBuffers.size();
+		pBuffer->sThreadName = "Thread " + to_string(pBuffer->uiThreadID);
+		vThreadBuffers.push_back(pBuffer);
+		tl_pThreadBuffer = pBuffer;
+		tl_uiGeneration = uiGeneration;
+	}
+	return tl_pThreadBuffer;
+}
+
+/**
+ @brief Write all the recorded events to a Chrome trace JSON file
+ @param sFilename The name of the file to write to
+ @return true if the file was written, otherwise false
+ */
+bool CProfiler::ExportChromeTrace(const std::string& sFilename)
+{
+	ofstream file(sFilename.c_str(), ios::out | ios::trunc);
+	if (!file.is_open())
+	{
+		cout << "CProfiler::ExportChromeTrace - Unable to open " << sFilename << endl;
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(threadBuffersMutex);
+
+	unsigned int uiNumEvents = 0;
+	std::vector<ProfileEvent> vEvents;
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool bFirst = true;
+	for (size_t i = 0; i < vThreadBuffers.size(); i++)
+	{
+		CProfilerThreadBuffer* pBuffer = vThreadBuffers[i];
+
+		// Name the thread
+		file << (bFirst ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+			<< pBuffer->uiThreadID << ",\"args\":{\"name\":";
+		WriteJSONString(file, pBuffer->sThreadName.c_str());
+		file << "}}";
+		bFirst = false;
+
+		// Copy the events first, as the thread may still be writing to its buffer
+		CopyEvents(pBuffer, vEvents);
+		for (size_t j = 0; j < vEvents.size(); j++)
+		{
+			const ProfileEvent& event = vEvents[j];
+			file << ",\n{\"name\":";
+			WriteJSONString(file, event.pName);
+			file << ",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":" << pBuffer->uiThreadID
+				<< ",\"ts\":" << (double)event.llStart * 0.001
+				<< ",\"dur\":" << (double)(event.llEnd - event.llStart) * 0.001 << "}";
+			uiNumEvents++;
+		}
+	}
+	file << "\n]}\n";
+	file.close();
+
+	cout << "CProfiler::ExportChromeTrace - Wrote " << uiNumEvents << " events to " << sFilename << endl;
+	return true;
+}
+
+/**
+ @brief Copy the events of the last complete frame of the frame thread into vFlameEvents
+ */
+void CProfiler::CaptureFlameFrame(void)
+{
+	std::vector<ProfileEvent> vEvents;
+
+	// The events are stored in the order they ended, so walk backwards until the frame's start
+	unsigned int uiWriteCount = pFrameThreadBuffer->uiWriteCount.load(std::memory_order_acquire);
+	unsigned int uiFirst = (uiWriteCount > CProfilerThreadBuffer::CAPACITY ? uiWriteCount - CProfilerThreadBuffer::CAPACITY : 0);
+	unsigned int j = uiWriteCount;
+	for (; j > uiFirst; j--)
+	{
+		const ProfileEvent event = pFrameThreadBuffer->events[(j - 1) % CProfilerThreadBuffer::CAPACITY];
+		if (event.llEnd < llPrevFrameStart)
+			break;
+		if ((event.llStart >= llPrevFrameStart) && (event.llEnd <= llFrameStart))
+			vEvents.push_back(event);
+	}
+
+	// Keep the last frame if the buffer was written to past the oldest event which was read.
+	// Only the frame thread writes to its buffer, so this only happens if another thread marks the frames
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const unsigned int uiNewWriteCount = pFrameThreadBuffer->uiWriteCount.load(std::memory_order_relaxed);
+	if (uiNewWriteCount - (j > uiFirst ? j - 1 : j) >= CProfilerThreadBuffer::CAPACITY)
+		return;
+
+	vFlameEvents.swap(vEvents);
+	llFlameFrameStart = llPrevFrameStart;
+	llFlameFrameEnd = llFrameStart;
+}
+
+/**
+ @brief Copy the events of a buffer, leaving out those which its thread may have overwritten while they were copied.
+		The thread writes each event before publishing the new count, and the next event goes into the slot of the
+		oldest one, so after copying, every event older than the new count minus the capacity may be torn
+ @param pBuffer The buffer to copy the events of
+ @param vEvents Returns the events, oldest first
+ */
+void CProfiler::CopyEvents(const CProfilerThreadBuffer* pBuffer, std::vector<ProfileEvent>& vEvents) const
+{
+	vEvents.clear();
+
+	// Only the events up to the acquired count are complete
+	const unsigned int uiWriteCount = pBuffer->uiWriteCount.load(std::memory_order_acquire);
+	const unsigned int uiFirst = (uiWriteCount > CProfilerThreadBuffer::CAPACITY ? uiWriteCount - CProfilerThreadBuffer::CAPACITY : 0);
+	vEvents.reserve(uiWriteCount - uiFirst);
+	for (unsigned int j = uiFirst; j < uiWriteCount; j++)
+		vEvents.push_back(pBuffer->events[j % CProfilerThreadBuffer::CAPACITY]);
+
+	// Drop the events whose slots were, or are being, written to again while they were copied
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const unsigned int uiNewWriteCount = pBuffer->uiWriteCount.load(std::memory_order_relaxed);
+	const unsigned int uiValidFirst = uiNewWriteCount + 1 > CProfilerThreadBuffer::CAPACITY ? uiNewWriteCount + 1 - CProfilerThreadBuffer::CAPACITY : 0;
+	if (uiValidFirst > uiFirst)
+		vEvents.erase(vEvents.begin(), vEvents.begin() + std::min<size_t>(uiValidFirst - uiFirst, vEvents.size()));
+}
+
+/**
+ @brief Draw the zones of the last complete frame as a flame graph in an ImGui window.
+		Must be called between ImGui::NewFrame() and ImGui::Render()
+ @param pbOpen A pointer to a bool which is set to false when the window is closed
+ */
+void CProfiler::RenderFlameView(bool* pbOpen)
+{
+	bCaptureFlameFrame = true;
+
+	ImGui::SetNextWindowSize(ImVec2(800.0f, 240.0f), ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin("Profiler", pbOpen))
+	{
+		ImGui::End();
+		return;
+	}
+
+	const double dFrameTime = (double)(llFlameFrameEnd - llFlameFrameStart) * 0.000001;
+	ImGui::Text("Frame: %.3fms, %d zones", dFrameTime, (int)vFlameEvents.size());
+	ImGui::SameLine();
+	ImGui::Checkbox("Freeze", &bFlameViewFrozen);
+
+	ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+	const ImVec2 vOrigin = ImGui::GetCursorScreenPos();
+	const float fWidth = ImGui::GetContentRegionAvail().x;
+	const float fRowHeight = ImGui::GetTextLineHeight() + 4.0f;
+	const double dScale = (llFlameFrameEnd > llFlameFrameStart ? fWidth / (double)(llFlameFrameEnd - llFlameFrameStart) : 0.0);
+
+	unsigned int uiMaxDepth = 0;
+	for (size_t i = 0; i < vFlameEvents.size(); i++)
+	{
+		const ProfileEvent& event = vFlameEvents[i];
+		if (event.uiDepth > uiMaxDepth)
+			uiMaxDepth = event.uiDepth;
+
+		ImVec2 vMin(vOrigin.x + (float)((event.llStart - llFlameFrameStart) * dScale), vOrigin.y + event.uiDepth * fRowHeight);
+		ImVec2 vMax(vOrigin.x + (float)((event.llEnd - llFlameFrameStart) * dScale), vMin.y + fRowHeight - 1.0f);
+		if (vMax.x - vMin.x < 1.0f)
+			vMax.x = vMin.x + 1.0f;
+
+		// Give each zone name a stable colour
+		unsigned int uiHash = (unsigned int)((size_t)event.pName * 2654435761u);
+		ImU32 colour = IM_COL32(120 + (uiHash & 0x7F), 80 + ((uiHash >> 8) & 0x7F), 60 + ((uiHash >> 16) & 0x3F), 255);
+		pDrawList->AddRectFilled(vMin, vMax, colour);
+
+		// Label the zone if it is wide enough
+		if (vMax.x - vMin.x > 20.0f)
+		{
+			pDrawList->PushClipRect(vMin, vMax, true);
+			pDrawList->AddText(ImVec2(vMin.x + 2.0f, vMin.y + 2.0f), IM_COL32(0, 0, 0, 255), event.pName);
+			pDrawList->PopClipRect();
+		}
+
+		if (ImGui::IsMouseHoveringRect(vMin, vMax))
+		{
+			ImGui::SetTooltip("%s\n%.3fms", event.pName, (double)(event.llEnd - event.llStart) * 0.000001);
+		}
+	}
+
+	// Reserve the space which was drawn into
+	ImGui::Dummy(ImVec2(fWidth, (uiMaxDepth + 1) * fRowHeight));
+	ImGui::End();
+}
+
+/**
+ @brief Constructor
+ @param pName The name of the zone. Must point to a string literal
+ */
+CProfileZone::CProfileZone(const char* pName)
+	: pName(pName)
+	, llStart(-1)
+	, pBuffer(NULL)
+{
+	CProfiler* pProfiler = CProfiler::GetInstance();
+	if (pProfiler->IsEnabled() == false)
+		return;
+
+	pBuffer = pProfiler->GetThreadBuffer();
+	pBuffer->uiDepth++;
+	llStart = pProfiler->GetTime();
+}
+
+/**
+ @brief Destructor
+ */
+CProfileZone::~CProfileZone(void)
+{
+	if (pBuffer == NULL)
+		return;
+
+	pBuffer->uiDepth--;
+
+	// Only this thread writes to its buffer, so the event can be written before publishing the new count
+	unsigned int uiWriteCount = pBuffer->uiWriteCount.load(std::memory_order_relaxed);
+	ProfileEvent& event = pBuffer->events[uiWriteCount % CProfilerThreadBuffer::CAPACITY];
+	event.pName = pName;
+	event.llStart = llStart;
+	event.llEnd = CProfiler::GetInstance()->GetTime();
+	event.uiDepth = pBuffer->uiDepth;
+	pBuffer->uiWriteCount.store(uiWriteCount + 1, std::memory_order_release);
+}
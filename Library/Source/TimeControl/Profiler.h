@@ -0,0 +1,148 @@
+/**
+ CProfiler
+ @brief A class to measure the time spent in scoped zones of code, with one lock-free event buffer per thread.
+		The events can be exported as a Chrome/Perfetto trace (chrome://tracing or ui.perfetto.dev)
+		or viewed in game as a flame graph.
+ */
+#pragma once
+
+// Include SingtonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Define DISABLE_PROFILER in the preprocessor definitions to compile out all the profile zones
+#ifndef DISABLE_PROFILER
+	#define PROFILE_CONCAT_INNER(a, b) a##b
+	#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+	// Measure the time until the end of the current scope. The name must be a string literal
+	#define PROFILE_SCOPE(name) CProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+	// Measure the time until the end of the current function
+	#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+	// Mark the start of a new frame
+	#define PROFILE_FRAME() CProfiler::GetInstance()->BeginFrame()
+	// Name the current thread in the trace
+	#define PROFILE_THREAD(name) CProfiler::GetInstance()->SetThreadName(name)
+#else
+	#define PROFILE_SCOPE(name) ((void)0)
+	#define PROFILE_FUNCTION() ((void)0)
+	#define PROFILE_FRAME() ((void)0)
+	#define PROFILE_THREAD(name) ((void)0)
+#endif
+
+// A completed profile zone
+struct ProfileEvent
+{
+	// The name of the zone. Must point to a string literal
+	const char* pName;
+	// The start and end times in nanoseconds since the profiler was created
+	long long llStart;
+	long long llEnd;
+	// The nesting depth of the zone in its thread
+	unsigned int uiDepth;
+};
+
+// The events of one thread. Only the owning thread writes to it, so no locks are needed
+struct CProfilerThreadBuffer
+{
+	// The number of events kept per thread. Older events are overwritten
+	static const unsigned int CAPACITY = 65536;
+
+	// The ID of the thread in the trace
+	unsigned int uiThreadID;
+	// The name of the thread in the trace
+	std::string sThreadName;
+	// The current nesting depth of the zones
+	unsigned int uiDepth;
+	// The total number of events written. The latest event is at (uiWriteCount - 1) % CAPACITY
+	std::atomic<unsigned int> uiWriteCount;
+	// The ring buffer of events
+	ProfileEvent events[CAPACITY];
+};
+
+class CProfiler : public CSingletonTemplate<CProfiler>
+{
+	friend CSingletonTemplate<CProfiler>;
+
+public:
+	// Destructor
+	virtual ~CProfiler(void);
+
+	// Enable or disable the recording of events
+	void SetEnabled(const bool bEnabled);
+	bool IsEnabled(void) const;
+
+	// Set the name of the calling thread in the trace
+	void SetThreadName(const std::string& sThreadName);
+
+	// Mark the start of a new frame on the calling thread
+	void BeginFrame(void);
+
+	// Get the current time in nanoseconds since the profiler was created
+	long long GetTime(void) const;
+
+	// Get the buffer of the calling thread, creating it if needed
+	CProfilerThreadBuffer* GetThreadBuffer(void);
+
+	// Write all the recorded events to a Chrome trace JSON file
+	bool ExportChromeTrace(const std::string& sFilename);
+
+	// Draw the zones of the last complete frame of the main thread as a flame graph in an ImGui window
+	void RenderFlameView(bool* pbOpen = NULL);
+
+protected:
+	// Whether events are recorded
+	std::atomic<bool> bEnabled;
+	// The time when the profiler was created
+	long long llEpoch;
+	// The buffers of all threads which recorded events
+	std::vector<CProfilerThreadBuffer*> vThreadBuffers;
+	// The lock for vThreadBuffers, only taken when a thread records its first event or when exporting
+	std::mutex threadBuffersMutex;
+	// The generation of this profiler, so a thread does not keep using a buffer of a profiler which was destroyed
+	unsigned int uiGeneration;
+	// The buffer of the thread which marks the frames
+	CProfilerThreadBuffer* pFrameThreadBuffer;
+	// The start times of the current and the previous frame
+	long long llFrameStart;
+	long long llPrevFrameStart;
+	// Whether the flame view is frozen on the frame it is showing
+	bool bFlameViewFrozen;
+	// Whether the flame view was drawn since the last frame, so the next frame should be captured
+	bool bCaptureFlameFrame;
+	// The events of the frame shown in the flame view
+	std::vector<ProfileEvent> vFlameEvents;
+	long long llFlameFrameStart;
+	long long llFlameFrameEnd;
+
+	// Constructor
+	CProfiler(void);
+
+	// Copy the events of the last complete frame of the frame thread into vFlameEvents
+	void CaptureFlameFrame(void);
+
+	// Copy the events of a buffer, leaving out those which its thread may have overwritten while they were copied
+	void CopyEvents(const CProfilerThreadBuffer* pBuffer, std::vector<ProfileEvent>& vEvents) const;
+};
+
+// Measures the time from its construction to its destruction, and records it as an event
+class CProfileZone
+{
+public:
+	// Constructor
+	explicit CProfileZone(const char* pName);
+
+	// Destructor
+	~CProfileZone(void);
+
+protected:
+	// The name of the zone
+	const char* pName;
+	// The start time of the zone, or -1 if the profiler was disabled
+	long long llStart;
+	// The buffer of the thread
+	CProfilerThreadBuffer* pBuffer;
+};
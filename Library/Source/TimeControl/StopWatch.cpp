@@ -6,24 +6,23 @@
  */
 #include "StopWatch.h"
 
+#include <thread>
+
+#ifdef _WIN32
+// Include windows.h to raise the resolution of Sleep
+#include <windows.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
 #define TARGET_RESOLUTION 1         // 1-millisecond target resolution
 
 /**
 @brief Constructor
 */
 CStopWatch::CStopWatch(void)
+	: bTimerResRaised(false)
 {
-	QueryPerformanceFrequency(&frequency);
-
-	TIMECAPS tc;
-
-	if (timeGetDevCaps(&tc, sizeof(TIMECAPS)) != TIMERR_NOERROR)
-	{
-		// Error; application can't continue.
-	}
-
-	wTimerRes = min(max(tc.wPeriodMin, TARGET_RESOLUTION), tc.wPeriodMax);
-	timeBeginPeriod(wTimerRes);
+	Init();
 }
 
 /**
@@ -37,9 +36,17 @@ CStopWatch::~CStopWatch(void)
 /**
 @brief Initialise this class instance
 */
-void Init(void)
+void CStopWatch::Init(void)
 {
-
+#ifdef _WIN32
+	// The default Windows timer resolution is about 15.6ms, which makes sleeping very coarse
+	if (bTimerResRaised == false)
+	{
+		bTimerResRaised = (timeBeginPeriod(TARGET_RESOLUTION) == TIMERR_NOERROR);
+	}
+#endif
+	prevTime = Clock::now();
+	currTime = prevTime;
 }
 
 /**
@@ -47,7 +54,7 @@ void Init(void)
 */ 
 void CStopWatch::StartTimer(void)
 {
-	QueryPerformanceCounter(&prevTime);
+	prevTime = Clock::now();
 }
 
 
@@ -56,7 +63,13 @@ void CStopWatch::StartTimer(void)
  */
 void CStopWatch::StopTimer(void)
 {
-	timeEndPeriod(wTimerRes);
+#ifdef _WIN32
+	if (bTimerResRaised == true)
+	{
+		timeEndPeriod(TARGET_RESOLUTION);
+		bTimerResRaised = false;
+	}
+#endif
 }
 
 /**
@@ -64,37 +77,63 @@ void CStopWatch::StopTimer(void)
  */ 
 double CStopWatch::GetElapsedTime(void)
 {
-	LARGE_INTEGER time;
-	QueryPerformanceCounter(&currTime);
-	time.QuadPart = currTime.QuadPart - prevTime.QuadPart;
+	currTime = Clock::now();
+	Clock::duration time = currTime - prevTime;
 	prevTime = currTime;
-	return LIToSecs(time);
+	return ToSecs(time);
 }
 
 /**
- @brief Wait until this time in milliseconds has passed
+ @brief Get elapsed time in seconds since the last call to GetElapsedTime or StartTimer, without resetting it
+ */
+double CStopWatch::PeekElapsedTime(void) const
+{
+	return ToSecs(Clock::now() - prevTime);
+}
+
+/**
+ @brief Wait until this time in milliseconds has passed since the last call to GetElapsedTime or StartTimer
+ @param llTime The time in milliseconds
  */
 void CStopWatch::WaitUntil(const long long llTime)
 {
-	LARGE_INTEGER nowTime;
-	LONGLONG timeElapsed;
-	while (true)
+	if (llTime <= 0)
+		return;
+
+	SleepUntil(prevTime + std::chrono::milliseconds(llTime));
+}
+
+/**
+ @brief Sleep for most of the remaining time and then spin-wait the last part,
+		as the OS may wake a sleeping thread up later than requested
+ @param deadline The point in time to wait until
+ @param dSpinTime The time in seconds before the deadline to stop sleeping and start spinning
+ */
+void CStopWatch::SleepUntil(const Clock::time_point& deadline, const double dSpinTime)
+{
+	const Clock::duration spinDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dSpinTime));
+
+	// Sleep in small steps, so that an oversleep cannot go far past the deadline
+	Clock::time_point now = Clock::now();
+	while (deadline - now > spinDuration)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		now = Clock::now();
+	}
+
+	// Spin for the rest of the time
+	while (Clock::now() < deadline)
 	{
-		QueryPerformanceCounter(&nowTime);
-		timeElapsed = ((nowTime.QuadPart - prevTime.QuadPart) * 1000 / frequency.QuadPart);
-		if (timeElapsed > llTime)
-			return;
-		else if (llTime - timeElapsed > 1)
-			Sleep(1);
+		std::this_thread::yield();
 	}
 }
 
 /**
- @brief Convert from Large Integer to seconds in double
- @param L A LARGE_INTEGER & containing the time value
+ @brief Convert a duration to seconds in double
+ @param duration A Clock::duration containing the time value
  @return The time in seconds unit and in double data type
  */
-double CStopWatch::LIToSecs(LARGE_INTEGER & L)
+double CStopWatch::ToSecs(const Clock::duration& duration)
 {
-	return ((double)L.QuadPart / (double)frequency.QuadPart);
+	return std::chrono::duration<double>(duration).count();
 }
@@ -6,11 +6,15 @@
  */
 #pragma once
 
-#include <windows.h>
+// Include chrono for a portable, monotonic high resolution clock
+#include <chrono>
 
 class CStopWatch
 {
 public:
+	// The clock used for all timing. steady_clock never jumps backwards, unlike the system clock
+	typedef std::chrono::steady_clock Clock;
+
 	// Constructor
 	CStopWatch(void);
 
@@ -29,14 +33,21 @@ public:
 	// Get elapsed time in seconds since the last call to this function
 	double GetElapsedTime(void);
 
+	// Get elapsed time in seconds since the last call to GetElapsedTime or StartTimer, without resetting it
+	double PeekElapsedTime(void) const;
+
 	// Wait until this time in milliseconds has passed
 	void WaitUntil(const long long llTime);
 
+	// Sleep and then spin until a point in time is reached
+	static void SleepUntil(const Clock::time_point& deadline, const double dSpinTime = 0.002);
+
+	// Convert a duration to seconds in double
+	static double ToSecs(const Clock::duration& duration);
+
 protected:
-	LARGE_INTEGER frequency;
-	LARGE_INTEGER prevTime, currTime;
-	UINT     wTimerRes;
+	Clock::time_point prevTime, currTime;
 
-	// Convert from Large Integer to seconds in double
-	double LIToSecs(LARGE_INTEGER & L);
+	// Whether the system timer resolution was raised by this instance
+	bool bTimerResRaised;
 };